@@ -6,6 +6,7 @@
 
 #include "BusyPeriodicRunner.h"
 
+#include <algorithm>
 #include <iostream>
 using std::cout;
 using std::endl;
@@ -77,6 +78,24 @@ void* PeriodicScheduler::request_next_event(WallClock timestamp){
         return event.event;
     }
 }
+size_t PeriodicScheduler::request_due_events(std::vector<void*>& events, WallClock timestamp){
+    size_t count = 0;
+    while (true){
+        void* event = request_next_event(timestamp);
+        if (event == nullptr){
+            return count;
+        }
+
+        //  An event with a period shorter than the time it took to get here
+        //  will be rescheduled at "timestamp". Don't run it twice.
+        if (std::find(events.end() - count, events.end(), event) != events.end()){
+            return count;
+        }
+
+        events.emplace_back(event);
+        count++;
+    }
+}
 
 
 
@@ -104,8 +123,9 @@ private:
 
 
 
-BusyPeriodicRunner::BusyPeriodicRunner(ThreadPool& thread_pool)
+BusyPeriodicRunner::BusyPeriodicRunner(ThreadPool& thread_pool, bool batch_due_events)
     : m_thread_pool(thread_pool)
+    , m_batch_due_events(batch_due_events)
     , m_pending_waits(0)
 {}
 bool BusyPeriodicRunner::add_event(void* event, std::chrono::milliseconds period, WallClock start){
@@ -126,11 +146,18 @@ bool BusyPeriodicRunner::add_event(void* event, std::chrono::milliseconds period
 }
 void BusyPeriodicRunner::remove_event(void* event){
     m_pending_waits++;
-    std::lock_guard<Mutex> lg(m_lock);
+    std::unique_lock<Mutex> lg(m_lock);
     m_pending_waits--;
     m_scheduler.remove_event(event);
     m_cv.notify_all();
 
+    //  The caller may destroy the event once this returns. So if it's in the
+    //  batch that is running right now, wait for the batch to finish.
+    m_cv.wait(lg, [&]{
+        return !m_batch_running ||
+            std::find(m_due_events.begin(), m_due_events.end(), event) == m_due_events.end();
+    });
+
     if (m_scheduler.events() == 0){
         WriteSpinLock lg1(m_stats_lock);
         m_utilization.push_idle();
@@ -169,13 +196,30 @@ void BusyPeriodicRunner::thread_loop(){
         idle_since_last_check = WallDuration(0);
 //        cout << m_utilization.utilization() << endl;
 
-        void* event = m_scheduler.request_next_event(now);
-
-        //  Event is available now. Run it.
-        if (event != nullptr){
-            run(event, is_back_to_back);
-            is_back_to_back = true;
-            continue;
+        //  Events are available now. Run them all together.
+        if (m_batch_due_events){
+            m_due_events.clear();
+            if (m_scheduler.request_due_events(m_due_events, now) != 0){
+                //  A batch can take as long as its slowest event. Don't make
+                //  everyone who adds or removes events wait for all of it.
+                m_batch_running = true;
+                lg.unlock();
+                run_batch(m_due_events.data(), m_due_events.size(), is_back_to_back);
+                lg.lock();
+                m_batch_running = false;
+                m_cv.notify_all();
+                is_back_to_back = true;
+                continue;
+            }
+        }else{
+            void* event = m_scheduler.request_next_event(now);
+
+            //  Event is available now. Run it.
+            if (event != nullptr){
+                run(event, is_back_to_back);
+                is_back_to_back = true;
+                continue;
+            }
         }
         is_back_to_back = false;
 
@@ -196,6 +240,12 @@ void BusyPeriodicRunner::thread_loop(){
         idle_since_last_check += end - start;
     }
 }
+void BusyPeriodicRunner::run_batch(void* const* events, size_t count, bool is_back_to_back) noexcept{
+    for (size_t c = 0; c < count; c++){
+        run(events[c], is_back_to_back);
+        is_back_to_back = true;
+    }
+}
 void BusyPeriodicRunner::stop_thread() noexcept{
     BusyPeriodicRunner::cancel(nullptr);
     m_runner.wait_and_ignore_exceptions();
@@ -11,6 +11,7 @@
 
 #include <chrono>
 #include <map>
+#include <vector>
 #include "Common/Cpp/Time.h"
 #include "Common/Cpp/EventRateTracker.h"
 #include "Common/Cpp/CancellableScope.h"
@@ -42,6 +43,10 @@ public:
     //  If nothing is before the current timestamp, return nullptr.
     void* request_next_event(WallClock timestamp = current_time());
 
+    //  Same as "request_next_event()", but drain every event that is due at
+    //  "timestamp" into "events". Returns the number of events appended.
+    size_t request_due_events(std::vector<void*>& events, WallClock timestamp = current_time());
+
 private:
     //  "id" is needed to solve the ABA problem if the same pointer is removed/re-added.
     struct PeriodicEvent{
@@ -74,7 +79,9 @@ public:
     double current_utilization() const;
 
 protected:
-    BusyPeriodicRunner(ThreadPool& thread_pool);
+    //  If "batch_due_events" is true, all events that are due at the same
+    //  time are handed to "run_batch()" together instead of one at a time.
+    BusyPeriodicRunner(ThreadPool& thread_pool, bool batch_due_events = false);
     bool add_event(void* event, std::chrono::milliseconds period, WallClock start = current_time());
     void remove_event(void* event);
 
@@ -85,6 +92,14 @@ protected:
     //  is too slow to keep up.
     virtual void run(void* event, bool is_back_to_back) noexcept = 0;
 
+    //  Run a set of events that are all due now. Only called in batch mode.
+    //  The default implementation runs them one after another.
+    //
+    //  Unlike "run()", this is called without holding the lock. So events can
+    //  be added and removed while it runs. Removing an event that is in the
+    //  running batch waits for the batch to finish.
+    virtual void run_batch(void* const* events, size_t count, bool is_back_to_back) noexcept;
+
 private:
     void thread_loop();
 protected:
@@ -92,6 +107,7 @@ protected:
 
 private:
     ThreadPool& m_thread_pool;
+    const bool m_batch_due_events;
 
     std::atomic<size_t> m_pending_waits;
     Mutex m_lock;
@@ -102,6 +118,10 @@ private:
 
     PeriodicScheduler m_scheduler;
 
+    //  The batch that is running right now if "m_batch_running".
+    std::vector<void*> m_due_events;
+    bool m_batch_running = false;
+
     AsyncTask m_runner;
 };
 
@@ -27,6 +27,11 @@ JsonArray JsonArray::clone() const{
 
 
 std::string JsonArray::dump(int indent) const{
+    std::string str;
+    if (dump_json_direct(str, *this, indent)){
+        return str;
+    }
+    //  Invalid UTF-8. Let nlohmann report it.
     nlohmann::json::array_t ret;
     for (const auto& item : *this){
         ret.emplace_back(to_nlohmann(item));
@@ -221,6 +221,11 @@ bool JsonObject::read_string(std::string& value, const std::string& key) const{
 
 
 std::string JsonObject::dump(int indent) const{
+    std::string str;
+    if (dump_json_direct(str, *this, indent)){
+        return str;
+    }
+    //  Invalid UTF-8. Let nlohmann report it.
     nlohmann::json ret;
     for (const auto& item : *this){
         ret[item.first] = to_nlohmann(item.second);
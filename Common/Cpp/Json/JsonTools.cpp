@@ -4,8 +4,12 @@
  *
  */
 
+#include <cmath>
+#include <charconv>
+#include <vector>
 #include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/Filesystem/FileIO.h"
+#include "Common/Cpp/TestRunners/UnitTestDatabase.h"
 #include "JsonTools.h"
 #include "JsonArray.h"
 #include "JsonObject.h"
@@ -96,6 +100,423 @@ nlohmann::json to_nlohmann(const JsonValue& json){
 
 
 
+namespace{
+
+
+//  SAX handler for nlohmann::json::sax_parse() that builds the JsonValue as
+//  the events come in. Strings and keys are moved out of the parser.
+class JsonBuilder{
+public:
+    using json = nlohmann::json;
+
+    JsonValue& root(){ return m_root; }
+
+    bool null(){
+        add(JsonValue());
+        return true;
+    }
+    bool boolean(bool x){
+        add(JsonValue(x));
+        return true;
+    }
+    bool number_integer(json::number_integer_t x){
+        add(JsonValue((int64_t)x));
+        return true;
+    }
+    bool number_unsigned(json::number_unsigned_t x){
+        add(JsonValue((int64_t)x));
+        return true;
+    }
+    bool number_float(json::number_float_t x, const json::string_t&){
+        add(JsonValue((double)x));
+        return true;
+    }
+    bool string(json::string_t& x){
+        add(JsonValue(std::move(x)));
+        return true;
+    }
+    bool binary(json::binary_t&){
+        //  Never produced by JSON text.
+        add(JsonValue());
+        return true;
+    }
+
+    bool start_object(size_t){
+        m_stack.emplace_back(&add(JsonObject()));
+        return true;
+    }
+    bool key(json::string_t& x){
+        m_key = std::move(x);
+        return true;
+    }
+    bool end_object(){
+        m_stack.pop_back();
+        return true;
+    }
+    bool start_array(size_t){
+        m_stack.emplace_back(&add(JsonArray()));
+        return true;
+    }
+    bool end_array(){
+        m_stack.pop_back();
+        return true;
+    }
+
+    bool parse_error(size_t, const std::string&, const nlohmann::detail::exception&){
+        return false;
+    }
+
+private:
+    //  Returns the value where it ended up. It stays put while it's the
+    //  innermost open container since nothing else is added to its parent.
+    JsonValue& add(JsonValue&& value){
+        if (m_stack.empty()){
+            m_root = std::move(value);
+            return m_root;
+        }
+        JsonValue& parent = *m_stack.back();
+        JsonArray* array = parent.to_array();
+        if (array != nullptr){
+            array->push_back(std::move(value));
+            return (*array)[array->size() - 1];
+        }
+        JsonValue& slot = (*parent.to_object())[std::move(m_key)];
+        slot = std::move(value);
+        return slot;
+    }
+
+private:
+    JsonValue m_root;
+    std::vector<JsonValue*> m_stack;
+    std::string m_key;
+};
+
+
+
+//  Length of the UTF-8 sequence at "str" or 0 if it's invalid. Rejects the
+//  same sequences as nlohmann. (overlong, surrogates, beyond U+10FFFF)
+size_t utf8_sequence_length(const unsigned char* str, size_t length){
+    unsigned char lead = str[0];
+    if (0xc2 <= lead && lead <= 0xdf){
+        return length >= 2 && (str[1] & 0xc0) == 0x80 ? 2 : 0;
+    }
+    if (0xe0 <= lead && lead <= 0xef){
+        unsigned char min = lead == 0xe0 ? 0xa0 : 0x80;
+        unsigned char max = lead == 0xed ? 0x9f : 0xbf;
+        if (length < 3 || str[1] < min || str[1] > max || (str[2] & 0xc0) != 0x80){
+            return 0;
+        }
+        return 3;
+    }
+    if (0xf0 <= lead && lead <= 0xf4){
+        unsigned char min = lead == 0xf0 ? 0x90 : 0x80;
+        unsigned char max = lead == 0xf4 ? 0x8f : 0xbf;
+        if (length < 4 || str[1] < min || str[1] > max ||
+            (str[2] & 0xc0) != 0x80 || (str[3] & 0xc0) != 0x80
+        ){
+            return 0;
+        }
+        return 4;
+    }
+    return 0;
+}
+
+
+//  Writes the same text as nlohmann::json::dump() with the default
+//  arguments. (space indentation, no ASCII escaping, strict UTF-8)
+class JsonWriter{
+public:
+    JsonWriter(std::string& out, int indent)
+        : m_out(out)
+        , m_indent(indent)
+    {}
+
+    bool write(const JsonValue& json, size_t level){
+        switch (json.type()){
+        case JsonType::EMPTY:
+            m_out += "null";
+            return true;
+        case JsonType::BOOLEAN:
+            m_out += json.to_boolean_default() ? "true" : "false";
+            return true;
+        case JsonType::INTEGER:
+            write_integer(json.to_integer_default());
+            return true;
+        case JsonType::FLOAT:
+            write_float(json.to_double_default());
+            return true;
+        case JsonType::STRING:
+            return write_string(*json.to_string());
+        case JsonType::ARRAY:
+            return write(*json.to_array(), level);
+        case JsonType::OBJECT:
+            return write(*json.to_object(), level);
+        }
+        m_out += "null";
+        return true;
+    }
+    bool write(const JsonArray& json, size_t level){
+        if (json.empty()){
+            m_out += "[]";
+            return true;
+        }
+        m_out += '[';
+        bool first = true;
+        for (const JsonValue& item : json){
+            if (!first){
+                m_out += ',';
+            }
+            first = false;
+            newline(level + 1);
+            if (!write(item, level + 1)){
+                return false;
+            }
+        }
+        newline(level);
+        m_out += ']';
+        return true;
+    }
+    bool write(const JsonObject& json, size_t level){
+        //  to_nlohmann() turns an empty object into null. Keep writing it
+        //  that way so existing files don't change.
+        if (json.empty()){
+            m_out += "null";
+            return true;
+        }
+        m_out += '{';
+        bool first = true;
+        for (const auto& item : json){
+            if (!first){
+                m_out += ',';
+            }
+            first = false;
+            newline(level + 1);
+            if (!write_string(item.first)){
+                return false;
+            }
+            m_out += m_indent < 0 ? ":" : ": ";
+            if (!write(item.second, level + 1)){
+                return false;
+            }
+        }
+        newline(level);
+        m_out += '}';
+        return true;
+    }
+
+private:
+    void newline(size_t level){
+        if (m_indent < 0){
+            return;
+        }
+        m_out += '\n';
+        m_out.append(level * m_indent, ' ');
+    }
+    void write_integer(int64_t x){
+        char buffer[32];
+        char* end = std::to_chars(buffer, buffer + sizeof(buffer), x).ptr;
+        m_out.append(buffer, end);
+    }
+    void write_float(double x){
+        if (!std::isfinite(x)){
+            m_out += "null";
+            return;
+        }
+        //  Use nlohmann's own formatting so the digits come out the same.
+        char buffer[64];
+        char* end = nlohmann::detail::to_chars(buffer, buffer + sizeof(buffer), x);
+        m_out.append(buffer, end);
+    }
+    bool write_string(const std::string& str){
+        const unsigned char* ptr = (const unsigned char*)str.data();
+        const size_t length = str.size();
+
+        m_out += '"';
+
+        //  Copy runs of characters that need no escaping in one go.
+        size_t run = 0;
+        size_t c = 0;
+        while (c < length){
+            unsigned char ch = ptr[c];
+            if (ch >= 0x80){
+                size_t bytes = utf8_sequence_length(ptr + c, length - c);
+                if (bytes == 0){
+                    return false;
+                }
+                c += bytes;
+                continue;
+            }
+            if (ch >= 0x20 && ch != '"' && ch != '\\'){
+                c++;
+                continue;
+            }
+
+            m_out.append(str, run, c - run);
+            switch (ch){
+            case '"':  m_out += "\\\""; break;
+            case '\\': m_out += "\\\\"; break;
+            case '\b': m_out += "\\b"; break;
+            case '\f': m_out += "\\f"; break;
+            case '\n': m_out += "\\n"; break;
+            case '\r': m_out += "\\r"; break;
+            case '\t': m_out += "\\t"; break;
+            default:{
+                const char HEX[] = "0123456789abcdef";
+                m_out += "\\u00";
+                m_out += HEX[ch >> 4];
+                m_out += HEX[ch & 0xf];
+            }
+            }
+            c++;
+            run = c;
+        }
+        m_out.append(str, run, length - run);
+
+        m_out += '"';
+        return true;
+    }
+
+private:
+    std::string& m_out;
+    const int m_indent;
+};
+
+
+}
+
+
+
+JsonValue parse_json_direct(const std::string& str){
+    JsonBuilder builder;
+    if (!nlohmann::json::sax_parse(str, &builder)){
+        return JsonValue();
+    }
+    return std::move(builder.root());
+}
+
+bool dump_json_direct(std::string& out, const JsonValue& json, int indent){
+    return JsonWriter(out, indent).write(json, 0);
+}
+bool dump_json_direct(std::string& out, const JsonArray& json, int indent){
+    return JsonWriter(out, indent).write(json, 0);
+}
+bool dump_json_direct(std::string& out, const JsonObject& json, int indent){
+    return JsonWriter(out, indent).write(json, 0);
+}
+
+
+
+//  Check parse_json_direct() and dump_json_direct() against the nlohmann DOM
+//  round trip that they replace.
+class Test_JsonDirect : public UnitTest{
+public:
+    Test_JsonDirect()
+        : UnitTest("Json::JsonDirect")
+    {}
+
+    virtual UnitTestResult run(Logger& logger, CancellableScope& scope) const override{
+        const char* const DOCUMENTS[] = {
+            //  Scalars
+            "null", "true", "false", "0", "-0", "1", "-1",
+            "9223372036854775807", "-9223372036854775808", "18446744073709551615",
+            "123456789012345678901234567890",
+            "0.0", "-0.0", "0.1", "1.5", "1e0", "1E+2", "-1.25e-3",
+            "1.7976931348623157e308", "5e-324", "2.2250738585072014e-308", "1e400",
+
+            //  Strings and escapes
+            R"("")",
+            R"("plain")",
+            R"("\"\\\/\b\f\n\r\t")",
+            R"("\u0000\u0001\u001f\u007f")",
+            R"("\u00e9\u4e2d\ud83d\ude00")",
+            "\"Flab\u00c3\u00a9b\u00c3\u00a9\"",
+            "\"\xc3\xa9\xe4\xb8\xad\xf0\x9f\x98\x80\"",
+
+            //  Containers
+            "[]", "{}", "[[]]", "[{}]", R"({"a":{}})", R"({"a":[]})",
+            "[[[[[[[[[[[[[[[[1]]]]]]]]]]]]]]]]",
+            R"([null, true, false, 0, -1, 0.5, "x", [], {}])",
+            R"({"b": 1, "a": 2, "c": {"z": [1, 2, {"y": null}]}})",
+            R"({"a": 1, "a": 2})",
+            R"({"": "", "\u0000": 0, "key with spaces": [ ]})",
+            " \t\r\n[ 1 ,\n 2 ]\n ",
+
+            //  Invalid
+            "", " ", "nul", "tru", "01", "1.", ".5", "-", "+1", "1e", "0x10", "NaN",
+            "[1,]", "[1 2]", "{\"a\"}", "{\"a\":}", "{a:1}", "{\"a\":1,}", "[", "{", "]",
+            "\"abc", "'abc'", "\"\\x\"", "\"\\u12\"", "\"\\ud800\"", "\"\\udc00\"",
+            "\"\t\"", "\"\xff\"", "\"\xc3\"", "\"\xed\xa0\x80\"",
+            "1 2", "[] []", "null x",
+        };
+        const int INDENTS[] = {-1, 0, 1, 2, 4};
+
+        size_t error_count = 0;
+        auto error = [&](const std::string& message){
+            if (error_count++ < 10){
+                logger.log(message, COLOR_RED);
+            }
+        };
+
+        for (const char* document : DOCUMENTS){
+            JsonValue expected = from_nlohmann(nlohmann::json::parse(document, nullptr, false));
+            JsonValue actual = parse_json_direct(document);
+
+            //  Compare through the old dump so that integers and floats with
+            //  the same value are still told apart.
+            std::string expected_text = to_nlohmann(expected).dump();
+            std::string actual_text = to_nlohmann(actual).dump();
+            if (expected_text != actual_text){
+                error("parse_json_direct() of " + std::string(document) + " gave " + actual_text + " instead of " + expected_text);
+                continue;
+            }
+
+            for (int indent : INDENTS){
+                std::string reference = to_nlohmann(expected).dump(indent);
+                std::string dumped = "prefix";
+                if (!dump_json_direct(dumped, actual, indent) || dumped != "prefix" + reference){
+                    error("dump_json_direct() of " + std::string(document) + " with indent " + std::to_string(indent) + " gave " + dumped);
+                }
+                if (const JsonArray* array = actual.to_array()){
+                    std::string text;
+                    if (!dump_json_direct(text, *array, indent) || text != reference){
+                        error("dump_json_direct(JsonArray) of " + std::string(document) + " gave " + text);
+                    }
+                }
+                if (const JsonObject* object = actual.to_object()){
+                    std::string text;
+                    if (!dump_json_direct(text, *object, indent) || text != reference){
+                        error("dump_json_direct(JsonObject) of " + std::string(document) + " gave " + text);
+                    }
+                }
+            }
+        }
+
+        //  Strings that aren't valid UTF-8 can only be built in code. The
+        //  direct dump must refuse them since nlohmann throws on them.
+        for (const char* bad : {"\xff", "a\xc3", "\xed\xa0\x80", "\xc0\xaf"}){
+            JsonArray array;
+            array.push_back(std::string(bad));
+            JsonValue value(std::move(array));
+            std::string text;
+            if (dump_json_direct(text, value, -1)){
+                error("dump_json_direct() accepted invalid UTF-8.");
+            }
+            try{
+                to_nlohmann(value).dump();
+                error("nlohmann accepted invalid UTF-8.");
+            }catch (nlohmann::json::type_error&){}
+        }
+
+        return error_count == 0;
+    }
+};
+
+void add_tests_JsonTools(UnitTestDatabase& database){
+    database.add<Test_JsonDirect>();
+}
+
+
+
 
 
 }
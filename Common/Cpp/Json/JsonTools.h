@@ -7,15 +7,35 @@
 #ifndef PokemonAutomation_Common_Json_JsonTools_H
 #define PokemonAutomation_Common_Json_JsonTools_H
 
+#include <string>
 #include "3rdParty/nlohmann/json.hpp"
 #include "JsonValue.h"
 
 namespace PokemonAutomation{
 
+class UnitTestDatabase;
+
 
 JsonValue from_nlohmann(const nlohmann::json& json);
 nlohmann::json to_nlohmann(const JsonValue& json);
 
 
+//  Same as from_nlohmann(nlohmann::json::parse(str, nullptr, false)), but
+//  builds the JsonValue directly from the parser events without the
+//  intermediate nlohmann DOM. Returns null if "str" is not valid JSON.
+JsonValue parse_json_direct(const std::string& str);
+
+//  Append the same text as to_nlohmann(json).dump(indent) to "out" without
+//  building the nlohmann DOM.
+//  Returns false if a string is not valid UTF-8. nlohmann throws on those so
+//  the caller should go through to_nlohmann() to get the same error.
+bool dump_json_direct(std::string& out, const JsonValue& json, int indent);
+bool dump_json_direct(std::string& out, const JsonArray& json, int indent);
+bool dump_json_direct(std::string& out, const JsonObject& json, int indent);
+
+
+void add_tests_JsonTools(UnitTestDatabase& database);
+
+
 }
 #endif
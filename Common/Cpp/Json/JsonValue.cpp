@@ -368,13 +368,18 @@ bool JsonValue::read_string(std::string& value) const{
 
 
 JsonValue parse_json(const std::string& str){
-    return from_nlohmann(nlohmann::json::parse(str, nullptr, false));
+    return parse_json_direct(str);
 }
 JsonValue load_json_file(const std::string& filename){
     std::string str = file_to_string(filename);
     return parse_json(str);
 }
 std::string JsonValue::dump(int indent) const{
+    std::string ret;
+    if (dump_json_direct(ret, *this, indent)){
+        return ret;
+    }
+    //  Invalid UTF-8. Let nlohmann report it.
     return to_nlohmann(*this).dump(indent);
 }
 void JsonValue::dump(const std::string& filename, int indent) const{
@@ -19,6 +19,8 @@ namespace PokemonAutomation{
 FileLogger::FileLogger(ThreadPool& thread_pool, FileLoggerConfig config)
     : m_config(std::move(config))
     , m_stopping(false)
+    , m_flush_requested(0)
+    , m_flush_completed(0)
 {
     Filesystem::Path file_path(m_config.file_path);
     bool exists = Filesystem::exists(file_path);
@@ -36,6 +38,7 @@ FileLogger::FileLogger(ThreadPool& thread_pool, FileLoggerConfig config)
     m_thread = thread_pool.dispatch_now_blocking([this]{
         thread_loop();
     });
+    add_panic_listener(*this);
 }
 FileLogger::~FileLogger(){
     stop();
@@ -44,6 +47,7 @@ void FileLogger::stop() noexcept{
     if (!m_thread){
         return;
     }
+    remove_panic_listener(*this);
     {
         std::lock_guard<Mutex> lg(m_lock);
         m_stopping = true;
@@ -68,73 +72,87 @@ void FileLogger::log(std::string&& msg, Color color){
     m_cv.notify_all();
 }
 
-std::string FileLogger::normalize_newlines(const std::string& msg){
-    std::string str;
-    size_t index = 0;
-
-    while (true){
-        auto pos = msg.find("\r\n", index);
-        if (pos == std::string::npos){
-            str += msg.substr(index, pos);
-            break;
-        }else{
-            str += msg.substr(index, pos - index);
-            str += "\n";
-            index = pos + 2;
-        }
-    }
-
-    if (!str.empty() && str.back() == '\n'){
-        str.pop_back();
+void FileLogger::flush(std::chrono::milliseconds timeout){
+    std::unique_lock<Mutex> lg(m_lock);
+    //  The thread flushes everything on its way out.
+    if (m_stopping){
+        return;
     }
-
-    return str;
+    uint64_t ticket = ++m_flush_requested;
+    m_cv.notify_all();
+    m_cv.wait_for(lg, timeout, [&]{ return m_flush_completed >= ticket; });
 }
+void FileLogger::on_panic() noexcept{
+    try{
+        flush(std::chrono::seconds(1));
+    }catch (...){}
+}
+
 
-std::string FileLogger::to_file_str(const std::string& msg){
-    // Replace all newlines with \r\n for the log file (Windows compatibility).
-    std::string str;
-    for (char ch : msg){
-        if (ch == '\n'){
-            str += "\r\n";
-            continue;
+void FileLogger::append_file_str(std::string& out, const std::string& msg){
+    // Drop one trailing newline.
+    size_t end = msg.size();
+    if (end > 0 && msg[end - 1] == '\n'){
+        end--;
+        if (end > 0 && msg[end - 1] == '\r'){
+            end--;
         }
-        str += ch;
     }
-    str += "\r\n";
-    return str;
-}
-
-void FileLogger::internal_log(const std::string& msg, Color color){
-    std::string line = normalize_newlines(msg);
 
-    // Write to file
-    if (m_file.is_open()){
-        std::string file_str = to_file_str(line);
-        m_file.write(file_str);
-        // Flush every time so if the program crashes we will still have the latest log in the log file
-        m_file.flush();
+    // Replace all newlines (\n or \r\n) with \r\n for the log file (Windows compatibility).
+    size_t index = 0;
+    while (true){
+        size_t pos = msg.find('\n', index);
+        if (pos >= end){
+            out.append(msg, index, end - index);
+            break;
+        }
+        size_t stop = pos > index && msg[pos - 1] == '\r' ? pos - 1 : pos;
+        out.append(msg, index, stop - index);
+        out += "\r\n";
+        index = pos + 1;
     }
+    out += "\r\n";
 }
 
 void FileLogger::thread_loop(){
+    using Clock = std::chrono::steady_clock;
+
     size_t file_size_check_counter = 100;
+    std::deque<std::pair<std::string, Color>> batch;
+    std::string buffer;
+    bool unflushed = false;
+    Clock::time_point last_flush = Clock::now();
+
     std::unique_lock<Mutex> lg(m_lock);
     while (true){
-        m_cv.wait(lg, [&]{
-            return m_stopping || !m_queue.empty();
-        });
-//        cout << "m_stopping = " << m_stopping << ", m_queue.size() = " << m_queue.size() << endl;
-        if (m_stopping && m_queue.empty()){
-            break;
+        auto ready = [&]{
+            return m_stopping || !m_queue.empty() || m_flush_completed < m_flush_requested;
+        };
+        if (unflushed){
+            //  Wake up when it's time to flush what we have already written.
+            if (!m_cv.wait_until(lg, last_flush + m_config.flush_interval, ready)){
+                lg.unlock();
+                m_file.flush();
+                unflushed = false;
+                last_flush = Clock::now();
+                lg.lock();
+                continue;
+            }
+        }else{
+            m_cv.wait(lg, ready);
         }
-        auto& item = m_queue.front();
-        std::string msg = std::move(item.first);
-        Color color = item.second;
-        m_queue.pop_front();
+//        cout << "m_stopping = " << m_stopping << ", m_queue.size() = " << m_queue.size() << endl;
 
+        //  Take everything that is queued and let the producers go.
+        bool stopping = m_stopping;
+        uint64_t flush_ticket = m_flush_requested;
+        batch.swap(m_queue);
         lg.unlock();
-        if (++file_size_check_counter >= 100){
+        m_cv.notify_all();
+
+        file_size_check_counter += batch.size();
+        if (file_size_check_counter >= 100){
             file_size_check_counter = 0;
             // We call Filesystem::file_size() to check file size, which may be slow.
             // So we only check every 100 lines.
@@ -143,12 +161,45 @@ void FileLogger::thread_loop(){
             // we will be able to rotate it.
             rotate_log_file();
         }
-        internal_log(msg, color);
-        lg.lock();
 
-        if (m_queue.size() <= m_config.max_queue_size / 2){
+        bool error = false;
+        buffer.clear();
+        for (const auto& item : batch){
+            append_file_str(buffer, item.first);
+            error |= item.second == COLOR_RED;
+        }
+        batch.clear();
+
+        if (m_file.is_open()){
+            if (!buffer.empty()){
+                m_file.write(buffer);
+                unflushed = true;
+            }
+            if (unflushed && (
+                error || stopping ||
+                flush_ticket > m_flush_completed ||
+                Clock::now() - last_flush >= m_config.flush_interval
+            )){
+                // Flush so if the program crashes we will still have the latest log in the log file.
+                m_file.flush();
+                unflushed = false;
+                last_flush = Clock::now();
+            }
+        }
+
+        //  Don't hang on to the memory of an unusually large burst.
+        if (buffer.capacity() > 1024 * 1024){
+            buffer = std::string();
+        }
+
+        lg.lock();
+        m_flush_completed = flush_ticket;
+        if (flush_ticket != 0){
             m_cv.notify_all();
         }
+        if (stopping && m_queue.empty()){
+            break;
+        }
     }
 }
 
@@ -11,12 +11,14 @@
 #define PokemonAutomation_Logging_FileLogger_H
 
 #include <deque>
+#include <chrono>
 #include "AbstractLogger.h"
 #include "Common/Cpp/Concurrency/Mutex.h"
 #include "Common/Cpp/Concurrency/ConditionVariable.h"
 #include "Common/Cpp/Concurrency/AsyncTask.h"
 #include "Common/Cpp/Concurrency/ThreadPool.h"
 #include "Common/Cpp/Filesystem/FileIO.h"
+#include "Common/Cpp/PanicDump.h"
 
 namespace PokemonAutomation{
 
@@ -27,6 +29,12 @@ struct FileLoggerConfig{
     size_t max_queue_size = 10000;                  // Max pending log entries before blocking
     size_t max_file_size_bytes = 50 * 1024 * 1024;  // Max file size before rotation (50MB default)
     size_t last_log_max_lines = 10000;              // Max lines to keep in memory for get_last()
+
+    // How long written lines may sit in the file buffer before they are flushed.
+    // Zero flushes after every batch so nothing that reached the logger thread
+    // is lost if the program crashes. Errors (COLOR_RED) and panics always flush
+    // right away.
+    std::chrono::milliseconds flush_interval = std::chrono::milliseconds(0);
 };
 
 
@@ -36,9 +44,13 @@ struct FileLoggerConfig{
 // 3. Notifies registered listeners when a log message is written (for UI integration)
 // 4. Keeps track of recent log lines for retrieval via get_last()
 //
+// The background thread takes everything that is queued at once and writes it
+// with a single call. So a burst of log lines costs one write and one flush
+// instead of one per line.
+//
 // The Listener interface allows Qt GUI components to receive log messages
 // without the core logger depending on Qt.
-class FileLogger : public Logger{
+class FileLogger : public Logger, private PanicListener{
 public:
     // Construct a FileLogger with the given configuration.
     // The log file is created if it doesn't exist, or appended to if it does.
@@ -52,15 +64,17 @@ public:
     virtual void log(const std::string& msg, Color color = Color()) override;
     virtual void log(std::string&& msg, Color color = Color()) override;
 
-private:
-    // Normalize newlines: convert \r\n to \n, remove trailing newline.
-    static std::string normalize_newlines(const std::string& msg);
+    // Block until everything logged before this call is written and flushed.
+    // Gives up after "timeout".
+    void flush(std::chrono::milliseconds timeout = std::chrono::seconds(5));
 
-    // Convert message to file format (with \r\n line endings for Windows compatibility).
-    static std::string to_file_str(const std::string& msg);
+private:
+    virtual void on_panic() noexcept override;
 
-    // Internal log processing (called from background thread).
-    void internal_log(const std::string& msg, Color color);
+    // Append message to "out" in file format: Newlines are normalized to \r\n
+    // (for Windows compatibility), a trailing newline is dropped and the line
+    // is terminated with \r\n.
+    static void append_file_str(std::string& out, const std::string& msg);
 
     // Background thread loop that processes the log queue.
     void thread_loop();
@@ -78,6 +92,11 @@ private:
     bool m_stopping;
     std::deque<std::pair<std::string, Color>> m_queue;
 
+    // flush() takes a ticket. The background thread completes all tickets that
+    // were taken before it grabbed its current batch.
+    uint64_t m_flush_requested;
+    uint64_t m_flush_completed;
+
     AsyncTask m_thread;
 };
 
@@ -5,6 +5,7 @@
  */
 
 #include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/ListenerSet.h"
 #include "PrettyPrint.h"
 #include "PanicDump.h"
 
@@ -12,7 +13,22 @@ namespace PokemonAutomation{
 
 
 
+ListenerSet<PanicListener>& panic_listeners(){
+    static ListenerSet<PanicListener> listeners(true);
+    return listeners;
+}
+void add_panic_listener(PanicListener& listener){
+    panic_listeners().add(listener);
+}
+void remove_panic_listener(PanicListener& listener) noexcept{
+    panic_listeners().remove(listener);
+}
+
+
+
 void panic_dump(const char* location, const char* message){
+    panic_listeners().run_method(&PanicListener::on_panic);
+
     std::string body;
     body += "\xef\xbb\xbf"; //  UTF-8 BOM
 //    body += "Panic Dump:\r\n";
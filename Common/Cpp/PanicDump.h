@@ -12,6 +12,16 @@
 namespace PokemonAutomation{
 
 
+//  Notified by panic_dump() before it writes the dump. Loggers that buffer
+//  their output use this to get everything to disk before the program dies.
+struct PanicListener{
+    //  May be called from any thread.
+    virtual void on_panic() noexcept = 0;
+};
+void add_panic_listener(PanicListener& listener);
+void remove_panic_listener(PanicListener& listener) noexcept;
+
+
 void panic_dump(const char* location, const char* message);
 
 void run_with_catch(const char* location, std::function<void()>&& lambda);
@@ -18,3 +18,15 @@ add_dependencies(SerialProgramsCommandLine SerialProgramsLib)
 # Apply common target properties (includes, compile flags, etc.)
 # This function is defined in the parent CMakeLists.txt
 apply_common_target_properties(SerialProgramsCommandLine)
+
+
+# Kernel benchmarks (GUI-free)
+# Times the SIMD kernels at every supported processor level and writes JSON.
+set(KERNEL_BENCHMARK_SOURCES
+    Source/CommandLine/KernelBenchmarks_Main.cpp
+)
+
+add_executable(SerialProgramsKernelBenchmarks ${KERNEL_BENCHMARK_SOURCES})
+target_link_libraries(SerialProgramsKernelBenchmarks PRIVATE SerialProgramsLib)
+add_dependencies(SerialProgramsKernelBenchmarks SerialProgramsLib)
+apply_common_target_properties(SerialProgramsKernelBenchmarks)
@@ -0,0 +1,427 @@
+/*  Kernel Benchmarks Main
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      GUI-free executable that times the SIMD kernels at every processor
+ *  level this machine supports and writes the results to a JSON file.
+ *  Compare the files between builds to catch kernel regressions.
+ *
+ *  Usage: SerialProgramsKernelBenchmarks [output.json]
+ *
+ *  "GBps" counts the bytes of the buffer being processed. (the RGB32 image,
+ *  the binary matrix for waterfill, or the float samples for the audio
+ *  kernels) Setup work such as refilling a buffer that the kernel destroys
+ *  is not timed.
+ *
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <chrono>
+#include <vector>
+#include "Common/Compiler.h"
+#include "Common/Cpp/Color.h"
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/CpuId/CpuId.h"
+#include "Common/Cpp/Containers/AlignedVector.tpp"
+#include "Common/Cpp/Json/JsonArray.h"
+#include "Common/Cpp/Json/JsonObject.h"
+#include "Common/Cpp/Logging/MultiOutputLogger.h"
+#include "Common/Cpp/Logging/LastLogTracker.h"
+#include "Common/Cpp/Logging/FileLogger.h"
+#include "Common/Cpp/Logging/GlobalLogger.h"
+#include "CommonFramework/Logging/Logger.h"
+#include "CommonFramework/Tools/GlobalThreadPools.h"
+#include "Kernels/BinaryMatrix/Kernels_BinaryMatrix.h"
+#include "Kernels/BinaryImageFilters/Kernels_BinaryImage_BasicFilters.h"
+#include "Kernels/Waterfill/Kernels_Waterfill.h"
+#include "Kernels/ImageFilters/RGB32_Range/Kernels_ImageFilter_RGB32_Range.h"
+#include "Kernels/ImageFilters/RGB32_EuclideanDistance/Kernels_ImageFilter_RGB32_Euclidean.h"
+#include "Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness.h"
+#include "Kernels/ImageStats/Kernels_ImagePixelSumSqr.h"
+#include "Kernels/AbsFFT/Kernels_AbsFFT.h"
+#include "Kernels/SpikeConvolution/Kernels_SpikeConvolution.h"
+
+using namespace PokemonAutomation;
+using namespace PokemonAutomation::Kernels;
+
+namespace PokemonAutomation{
+
+bool USE_QT_UI = false;
+
+
+FileLogger& global_file_logger(){
+    static FileLogger logger(
+        GlobalThreadPools::unlimited_normal(),
+        FileLoggerConfig{
+            .file_path = "./SerialProgramsKernelBenchmarks.log"
+        }
+    );
+    return logger;
+}
+
+
+}
+
+
+namespace{
+
+
+//  Each benchmark repeats until it has spent at least this much time in the
+//  kernel and has run at least this many times.
+const std::chrono::milliseconds MIN_TIME(200);
+const uint64_t MIN_ITERATIONS = 3;
+
+struct ImageSize{
+    size_t width;
+    size_t height;
+};
+const ImageSize IMAGE_SIZES[] = {
+    {640, 360},
+    {1280, 720},
+    {1920, 1080},
+    {3840, 2160},
+};
+
+//  FFT lengths as powers of two. The audio pipeline uses 2^12.
+const int FFT_SIZES[] = {10, 12, 14};
+
+//  Spectrum lengths for the spike convolution. Kernel length is what the
+//  spectrogram matcher builds for 2048 frequencies at 48 kHz.
+const size_t SPIKE_SIZES[] = {1024, 2048, 8192};
+const size_t SPIKE_KERNEL_LENGTH = 17;
+
+
+//  Results are folded into this so the compiler can't drop the kernel calls.
+volatile size_t SINK = 0;
+
+
+struct BenchmarkResult{
+    uint64_t iterations = 0;
+    double seconds = 0;
+};
+
+//  Run "body" repeatedly. Only the time spent in "body" is counted.
+template <typename SetupFunction, typename BodyFunction>
+BenchmarkResult measure(SetupFunction&& setup, BodyFunction&& body){
+    using Clock = std::chrono::steady_clock;
+    Clock::duration total(0);
+    uint64_t iterations = 0;
+    do{
+        setup();
+        Clock::time_point start = Clock::now();
+        body();
+        total += Clock::now() - start;
+        iterations++;
+    }while (total < MIN_TIME || iterations < MIN_ITERATIONS);
+
+    BenchmarkResult ret;
+    ret.iterations = iterations;
+    ret.seconds = std::chrono::duration<double>(total).count();
+    return ret;
+}
+template <typename BodyFunction>
+BenchmarkResult measure(BodyFunction&& body){
+    return measure([]{}, body);
+}
+
+
+class ResultList{
+public:
+    ResultList(Logger& logger)
+        : m_logger(logger)
+    {}
+
+    JsonArray& results(){ return m_results; }
+
+    //  "items" is the number of pixels or samples processed per iteration.
+    void add(
+        const std::string& kernel, const std::string& size,
+        const char* per_item_key, size_t items, size_t bytes,
+        const BenchmarkResult& result
+    ){
+        double ns_per_item = result.seconds * 1e9 / ((double)result.iterations * items);
+        double gbps = (double)bytes * result.iterations / result.seconds / 1e9;
+
+        JsonObject obj;
+        obj["Kernel"] = kernel;
+        obj["Size"] = size;
+        obj["Iterations"] = result.iterations;
+        obj[per_item_key] = ns_per_item;
+        obj["GBps"] = gbps;
+        m_results.push_back(std::move(obj));
+
+        m_logger.log(
+            "    " + kernel + " (" + size + "): " +
+            std::to_string(ns_per_item) + " ns, " +
+            std::to_string(gbps) + " GB/s"
+        );
+    }
+
+private:
+    Logger& m_logger;
+    JsonArray m_results;
+};
+
+
+
+//  Deterministic test image. 16x16 blocks are either noise or a noisy orange
+//  blob. This gives the filters a realistic mix of hits and misses and gives
+//  waterfill a realistic number of objects.
+AlignedVector<uint32_t> make_test_image(size_t width, size_t height){
+    AlignedVector<uint32_t> image(width * height);
+    uint32_t state = 0x12345678;
+    auto next = [&]{
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    };
+    for (size_t r = 0; r < height; r++){
+        for (size_t c = 0; c < width; c++){
+            uint32_t block = (uint32_t)((r >> 4) * 0x9e3779b1 ^ (c >> 4) * 0x85ebca6b);
+            block ^= block >> 15;
+            uint32_t noise = next();
+            uint32_t pixel;
+            if (block & 1){
+                uint32_t red   = 0xc0 + (noise & 0x3f);
+                uint32_t green = 0x40 + ((noise >> 8) & 0x3f);
+                uint32_t blue  = 0x20 + ((noise >> 16) & 0x1f);
+                pixel = 0xff000000 | (red << 16) | (green << 8) | blue;
+            }else{
+                pixel = 0xff000000 | (noise & 0x00ffffff);
+            }
+            image[r * width + c] = pixel;
+        }
+    }
+    return image;
+}
+
+
+const uint32_t FILTER_MINS = 0xffc00000;
+const uint32_t FILTER_MAXS = 0xffff8080;
+const uint32_t FILTER_EXPECTED = 0xffe06030;
+const double FILTER_DISTANCE = 80;
+
+
+void run_image_benchmarks(ResultList& results, const ImageSize& size, const AlignedVector<uint32_t>& image){
+    const size_t width = size.width;
+    const size_t height = size.height;
+    const size_t pixels = width * height;
+    const size_t bytes_per_row = width * sizeof(uint32_t);
+    const size_t image_bytes = pixels * sizeof(uint32_t);
+    const size_t matrix_bytes = pixels / 8;
+    const std::string label = std::to_string(width) + "x" + std::to_string(height);
+
+    AlignedVector<uint32_t> out(pixels);
+    std::unique_ptr<PackedBinaryMatrix_IB> matrix = make_PackedBinaryMatrix(get_BinaryMatrixType(), width, height);
+
+    results.add(
+        "compress_rgb32_to_binary_range", label, "NsPerPixel", pixels, image_bytes,
+        measure([&]{
+            compress_rgb32_to_binary_range(image.data(), bytes_per_row, *matrix, FILTER_MINS, FILTER_MAXS);
+        })
+    );
+    results.add(
+        "compress_rgb32_to_binary_euclidean", label, "NsPerPixel", pixels, image_bytes,
+        measure([&]{
+            compress_rgb32_to_binary_euclidean(image.data(), bytes_per_row, *matrix, FILTER_EXPECTED, FILTER_DISTANCE);
+        })
+    );
+    results.add(
+        "filter_by_mask", label, "NsPerPixel", pixels, image_bytes,
+        measure(
+            [&]{
+                compress_rgb32_to_binary_range(image.data(), bytes_per_row, *matrix, FILTER_MINS, FILTER_MAXS);
+                memcpy(out.data(), image.data(), image_bytes);
+            },
+            [&]{
+                filter_by_mask(*matrix, out.data(), bytes_per_row, 0xff000000, true);
+            }
+        )
+    );
+    results.add(
+        "waterfill", label, "NsPerPixel", pixels, matrix_bytes,
+        measure(
+            [&]{
+                compress_rgb32_to_binary_range(image.data(), bytes_per_row, *matrix, FILTER_MINS, FILTER_MAXS);
+            },
+            [&]{
+                SINK = SINK + Waterfill::find_objects_inplace(*matrix, 20).size();
+            }
+        )
+    );
+    results.add(
+        "filter_rgb32_range", label, "NsPerPixel", pixels, image_bytes,
+        measure([&]{
+            SINK = SINK + filter_rgb32_range(
+                image.data(), bytes_per_row, width, height,
+                out.data(), bytes_per_row,
+                0xff000000, true, FILTER_MINS, FILTER_MAXS
+            );
+        })
+    );
+    results.add(
+        "filter_rgb32_euclidean", label, "NsPerPixel", pixels, image_bytes,
+        measure([&]{
+            SINK = SINK + filter_rgb32_euclidean(
+                image.data(), bytes_per_row, width, height,
+                out.data(), bytes_per_row,
+                0xff000000, true, FILTER_EXPECTED, FILTER_DISTANCE
+            );
+        })
+    );
+    results.add(
+        "scale_brightness", label, "NsPerPixel", pixels, image_bytes,
+        measure(
+            [&]{
+                memcpy(out.data(), image.data(), image_bytes);
+            },
+            [&]{
+                scale_brightness(width, height, out.data(), bytes_per_row, 0.9f, 1.0f, 1.1f);
+            }
+        )
+    );
+    results.add(
+        "pixel_sum_sqr", label, "NsPerPixel", pixels, image_bytes,
+        measure([&]{
+            PixelSums sums;
+            pixel_sum_sqr(
+                sums, width, height,
+                image.data(), bytes_per_row,
+                image.data(), bytes_per_row
+            );
+            SINK = SINK + (size_t)sums.sqrR;
+        })
+    );
+}
+
+
+void run_audio_benchmarks(ResultList& results){
+    for (int k : FFT_SIZES){
+        const size_t length = (size_t)1 << k;
+        AlignedVector<float> input(length);
+        AlignedVector<float> real(length);
+        AlignedVector<float> abs(length / 2);
+        for (size_t c = 0; c < length; c++){
+            input[c] = (float)((c * 2654435761u) % 1000) / 1000.0f - 0.5f;
+        }
+        results.add(
+            "fft_abs", std::to_string(length), "NsPerSample", length, length * sizeof(float),
+            measure(
+                [&]{
+                    memcpy(real.data(), input.data(), length * sizeof(float));
+                },
+                [&]{
+                    AbsFFT::fft_abs(k, abs.data(), real.data());
+                }
+            )
+        );
+    }
+
+    std::vector<float> kernel(SPIKE_KERNEL_LENGTH);
+    for (size_t c = 0; c < SPIKE_KERNEL_LENGTH; c++){
+        kernel[c] = c == SPIKE_KERNEL_LENGTH / 2 ? 1.0f : -1.0f / (SPIKE_KERNEL_LENGTH - 1);
+    }
+    for (size_t length : SPIKE_SIZES){
+        const size_t floats_per_vector = PA_ALIGNMENT / sizeof(float);
+        size_t out_length = length - SPIKE_KERNEL_LENGTH + 1;
+        out_length = (out_length + floats_per_vector - 1) / floats_per_vector * floats_per_vector;
+
+        std::vector<float> input(length);
+        AlignedVector<float> out(out_length);
+        for (size_t c = 0; c < length; c++){
+            input[c] = (float)((c * 2654435761u) % 1000) / 1000.0f;
+        }
+        results.add(
+            "compute_spike_kernel", std::to_string(length), "NsPerSample", length, length * sizeof(float),
+            measure([&]{
+                SpikeConvolution::compute_spike_kernel(
+                    out.data(), input.data(), length,
+                    kernel.data(), SPIKE_KERNEL_LENGTH
+                );
+            })
+        );
+    }
+}
+
+
+JsonObject run_level(Logger& logger, const CpuCapabilityOption& level, const std::vector<AlignedVector<uint32_t>>& images){
+    logger.log("Processor Level: " + std::string(level.display));
+
+    ResultList results(logger);
+    for (size_t c = 0; c < std::size(IMAGE_SIZES); c++){
+        run_image_benchmarks(results, IMAGE_SIZES[c], images[c]);
+    }
+    run_audio_benchmarks(results);
+
+    JsonObject obj;
+    obj["Slug"] = level.slug;
+    obj["Display"] = level.display;
+    obj["Results"] = std::move(results.results());
+    return obj;
+}
+
+
+}
+
+
+
+int main(int argc, char* argv[]){
+    {
+        MultiOutputLogger& logger = global_multi_logger();
+        logger.add_listener(global_last_log_history());
+        logger.add_listener(global_file_logger());
+    }
+
+    Logger& logger = global_logger_command_line();
+
+    logger.log("================================================================================");
+    logger.log("Starting Program...");
+    logger.log("Pokemon Automation - Kernel Benchmarks");
+
+    const std::string output_path = argc >= 2 ? argv[1] : "KernelBenchmarks.json";
+
+    try{
+        std::vector<AlignedVector<uint32_t>> images;
+        for (const ImageSize& size : IMAGE_SIZES){
+            images.emplace_back(make_test_image(size.width, size.height));
+        }
+
+        const CPU_Features original = CPU_CAPABILITY_CURRENT;
+
+        JsonArray levels;
+        for (const CpuCapabilityOption& level : AVAILABLE_CAPABILITIES()){
+            if (!level.available){
+                logger.log("Skipping unsupported processor level: " + std::string(level.display));
+                continue;
+            }
+            CPU_CAPABILITY_CURRENT = level.features;
+            try{
+                levels.push_back(run_level(logger, level, images));
+            }catch (...){
+                CPU_CAPABILITY_CURRENT = original;
+                throw;
+            }
+        }
+        CPU_CAPABILITY_CURRENT = original;
+
+        JsonObject root;
+        root["Arch"] = PA_ARCH_STRING;
+        root["MinTimeMs"] = (uint64_t)MIN_TIME.count();
+        root["Levels"] = std::move(levels);
+        root.dump(output_path);
+    }catch (Exception& e){
+        logger.log("Benchmark failed: " + e.message(), COLOR_RED);
+        return 1;
+    }catch (std::exception& e){
+        logger.log("Benchmark failed: " + std::string(e.what()), COLOR_RED);
+        return 1;
+    }catch (const char* e){
+        logger.log("Benchmark failed: " + std::string(e), COLOR_RED);
+        return 1;
+    }
+
+    logger.log("Results written to: " + output_path);
+    return 0;
+}
@@ -46,11 +46,25 @@ public:
 
     //  Return all the spectrums with stamps greater or equal to `starting_stamp`
     //  Returned spectrums are ordered from newest (largest timestamp) to oldest (smallest timestamp) in the vector.
-    virtual std::vector<AudioSpectrum> spectrums_since(uint64_t starting_seqnum) = 0;
+    std::vector<AudioSpectrum> spectrums_since(uint64_t starting_seqnum){
+        std::vector<AudioSpectrum> spectrums;
+        read_spectrums_since(spectrums, starting_seqnum);
+        return spectrums;
+    }
 
     //  Return a specific number of latest spectrums.
     //  Returned spectrums are ordered from newest (largest timestamp) to oldest (smallest timestamp) in the vector.
-    virtual std::vector<AudioSpectrum> spectrums_latest(size_t num_last_spectrums) = 0;
+    std::vector<AudioSpectrum> spectrums_latest(size_t num_last_spectrums){
+        std::vector<AudioSpectrum> spectrums;
+        read_spectrums_latest(spectrums, num_last_spectrums);
+        return spectrums;
+    }
+
+    //  Same as above, but replace the contents of `spectrums` instead of
+    //  returning a new vector. Callers that poll can keep reusing the same
+    //  vector so that it doesn't allocate every time.
+    virtual void read_spectrums_since(std::vector<AudioSpectrum>& spectrums, uint64_t starting_seqnum) = 0;
+    virtual void read_spectrums_latest(std::vector<AudioSpectrum>& spectrums, size_t num_last_spectrums) = 0;
 
     //  Add visual overlay to the spectrums starting at `starting_stamp` and before `end_stamp` with `color`.
     virtual void add_overlay(uint64_t starting_seqnum, size_t end_seqnum, Color color) = 0;
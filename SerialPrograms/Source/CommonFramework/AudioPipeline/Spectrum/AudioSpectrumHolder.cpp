@@ -26,6 +26,8 @@ AudioSpectrumHolder::AudioSpectrumHolder()
 //    , m_freq_visualization_block_boundaries(m_num_freq_visualization_blocks + 1)
 //    , m_spectrograph(m_num_freq_visualization_blocks, m_num_freq_windows)
     , m_freqVisStamps(m_num_freq_windows)
+    , m_spectrums(m_spectrum_history_length, AudioSpectrum(0, 0, nullptr))
+    , m_spectrum_stamp_end(0)
 {
     // We will display frequencies in log scale, so need to convert
     // log scale: 0, 1/m_numFreqVisBlocks, 2/m_numFreqVisBlocks, ..., 1.0
@@ -114,11 +116,13 @@ void AudioSpectrumHolder::clear(){
         {
             // update m_spectrum_stamp_start in case the audio widget is used
             // again to store new spectrums.
-            if (m_spectrums.size() > 0){
-                m_spectrum_stamp_start = m_spectrums.front().stamp + 1;
+            WriteSpinLock lg1(m_spectrum_lock, PA_CURRENT_FUNCTION);
+            m_spectrum_stamp_start = m_spectrum_stamp_end.load(std::memory_order_relaxed);
+            for (AudioSpectrum& spectrum : m_spectrums){
+                spectrum.magnitudes.reset();
             }
-            m_spectrums.clear();
-
+        }
+        {
             m_spectrograph->clear();
             m_last_spectrum.timestamp = current_time();
             memset(m_last_spectrum.values.data(), 0, m_last_spectrum.values.size() * sizeof(float));
@@ -159,17 +163,24 @@ PA_FORCE_INLINE uint32_t jetColorMap(float v){
 void AudioSpectrumHolder::push_spectrum(size_t sample_rate, std::shared_ptr<const AlignedVector<float>> fft_output){
     WallClock timestamp = current_time();
 
+    //  Release the spectrum that falls off the end of the history outside
+    //  of the locks.
+    std::shared_ptr<const AlignedVector<float>> evicted;
+
     {
         std::lock_guard<Mutex> lg(m_state_lock);
 
         const AlignedVector<float>& output = *fft_output;
 
         {
-            const size_t stamp = (m_spectrums.size() > 0) ? m_spectrums.front().stamp + 1 : m_spectrum_stamp_start;
-            m_spectrums.emplace_front(stamp, sample_rate, fft_output);
-            if (m_spectrums.size() > m_spectrum_history_length){
-                m_spectrums.pop_back();
-            }
+            WriteSpinLock lg1(m_spectrum_lock, PA_CURRENT_FUNCTION);
+            const uint64_t stamp = m_spectrum_stamp_end.load(std::memory_order_relaxed);
+            AudioSpectrum& slot = m_spectrums[stamp % m_spectrum_history_length];
+            evicted = std::move(slot.magnitudes);
+            slot.stamp = stamp;
+            slot.sample_rate = sample_rate;
+            slot.magnitudes = fft_output;
+            m_spectrum_stamp_end.store(stamp + 1, std::memory_order_release);
 
             // std::cout << "Load FFT output , stamp " << spectrum->stamp << std::endl;
             m_freqVisStamps[m_nextFFTWindowIndex] = stamp;
@@ -257,34 +268,40 @@ void AudioSpectrumHolder::add_overlay(uint64_t starting_stamp, uint64_t end_stam
     m_listeners.run_method(&Listener::state_changed);
 }
 
-std::vector<AudioSpectrum> AudioSpectrumHolder::spectrums_since(uint64_t starting_stamp){
-    std::vector<AudioSpectrum> spectrums;
+void AudioSpectrumHolder::spectrums_since(std::vector<AudioSpectrum>& spectrums, uint64_t starting_stamp) const{
+    spectrums.clear();
 
-    std::lock_guard<Mutex> lg(m_state_lock);
+    //  Most polls come in before the next spectrum. Don't bother locking.
+    if (m_spectrum_stamp_end.load(std::memory_order_acquire) <= starting_stamp){
+        return;
+    }
 
-    for (const auto& ptr : m_spectrums){
-        if (ptr.stamp >= starting_stamp){
-            spectrums.emplace_back(ptr);
-        }else{
-            break;
-        }
+    ReadSpinLock lg(m_spectrum_lock, PA_CURRENT_FUNCTION);
+
+    const uint64_t end = m_spectrum_stamp_end.load(std::memory_order_relaxed);
+    uint64_t start = end < m_spectrum_history_length ? 0 : end - m_spectrum_history_length;
+    start = std::max(start, m_spectrum_stamp_start);
+    start = std::max(start, starting_stamp);
+
+    for (uint64_t stamp = end; stamp-- > start;){
+        spectrums.emplace_back(m_spectrums[stamp % m_spectrum_history_length]);
     }
-    return spectrums;
 }
-std::vector<AudioSpectrum> AudioSpectrumHolder::spectrums_latest(size_t num_latest_spectrums){
-    std::vector<AudioSpectrum> spectrums;
+void AudioSpectrumHolder::spectrums_latest(std::vector<AudioSpectrum>& spectrums, size_t num_latest_spectrums) const{
+    spectrums.clear();
 
-    std::lock_guard<Mutex> lg(m_state_lock);
+    ReadSpinLock lg(m_spectrum_lock, PA_CURRENT_FUNCTION);
 
-    size_t i = 0;
-    for (const auto& ptr : m_spectrums){
-        if (i == num_latest_spectrums){
-            break;
-        }
-        spectrums.push_back(ptr);
-        i++;
+    const uint64_t end = m_spectrum_stamp_end.load(std::memory_order_relaxed);
+    uint64_t start = end < m_spectrum_history_length ? 0 : end - m_spectrum_history_length;
+    start = std::max(start, m_spectrum_stamp_start);
+    if (end - start > num_latest_spectrums){
+        start = end - num_latest_spectrums;
+    }
+
+    for (uint64_t stamp = end; stamp-- > start;){
+        spectrums.emplace_back(m_spectrums[stamp % m_spectrum_history_length]);
     }
-    return spectrums;
 }
 AudioSpectrumHolder::SpectrumSnapshot AudioSpectrumHolder::get_last_spectrum() const{
     std::lock_guard<Mutex> lg(m_state_lock);
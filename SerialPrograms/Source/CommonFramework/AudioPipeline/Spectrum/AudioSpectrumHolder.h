@@ -8,10 +8,12 @@
 #define PokemonAutomation_AudioPipeline_AudioSpectrumHolder_H
 
 #include <list>
+#include <atomic>
 #include <fstream>
 #include "Common/Cpp/Time.h"
 #include "Common/Cpp/ListenerSet.h"
 #include "Common/Cpp/Concurrency/Mutex.h"
+#include "Common/Cpp/Concurrency/SpinLock.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "CommonFramework/AudioPipeline/AudioFeed.h"
 #include "Spectrograph.h"
@@ -44,8 +46,10 @@ public:
 public:
     //  Asynchronous and thread-safe getters.
 
-    std::vector<AudioSpectrum> spectrums_since(uint64_t starting_stamp);
-    std::vector<AudioSpectrum> spectrums_latest(size_t num_latest_spectrums);
+    //  These replace the contents of "spectrums". They don't touch the
+    //  display state so they never wait on the spectrograph.
+    void spectrums_since(std::vector<AudioSpectrum>& spectrums, uint64_t starting_stamp) const;
+    void spectrums_latest(std::vector<AudioSpectrum>& spectrums, size_t num_latest_spectrums) const;
 
     struct SpectrumSnapshot{
         WallClock timestamp;
@@ -90,12 +94,18 @@ private:
 
     // record the past FFT output frequencies to serve as the interface
     // of audio inference for automation programs.
-    // The head of the list is the most recent FFT window, while the tail
-    // is the oldest in history.
-    std::list<AudioSpectrum> m_spectrums;
-    size_t m_spectrum_history_length = 40;
+    // This is a fixed-size ring. The spectrum with stamp s is in slot
+    // (s % m_spectrum_history_length). The valid stamps are
+    // [max(m_spectrum_stamp_start, m_spectrum_stamp_end - m_spectrum_history_length), m_spectrum_stamp_end).
+    const size_t m_spectrum_history_length = 40;
+    std::vector<AudioSpectrum> m_spectrums;
     // The initial timestamp for the incoming spectrums.
-    size_t m_spectrum_stamp_start = 0;
+    uint64_t m_spectrum_stamp_start = 0;
+    // One past the stamp of the newest spectrum. Readers check this without
+    // the lock to see if there is anything new.
+    std::atomic<uint64_t> m_spectrum_stamp_end;
+    // Protects the ring. This is only held to copy a few pointers in and out.
+    mutable SpinLock m_spectrum_lock;
 
     // Develop purpose: used to save received frequencies to disk
     bool m_saveFreqToDisk = false;
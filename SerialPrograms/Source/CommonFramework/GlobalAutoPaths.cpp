@@ -151,6 +151,10 @@ const std::string& ML_MODEL_CACHE_PATH(){
     static const std::string path = RUNTIME_BASE_PATH() + "ModelCache/";
     return path;
 }
+const std::string& OCR_CACHE_PATH(){
+    static const std::string path = RUNTIME_BASE_PATH() + "OCRCache/";
+    return path;
+}
 
 
 
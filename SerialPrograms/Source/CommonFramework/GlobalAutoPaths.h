@@ -53,6 +53,10 @@ const std::string& ML_ANNOTATION_PATH();
 // sessions.
 const std::string& ML_MODEL_CACHE_PATH();
 
+// Folder path (end with "/") to hold the binary caches of the OCR dictionaries.
+// These are rebuilt from the JSON resources whenever they go stale.
+const std::string& OCR_CACHE_PATH();
+
 
 
 }
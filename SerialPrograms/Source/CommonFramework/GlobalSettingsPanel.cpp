@@ -302,6 +302,10 @@ void GlobalSettings::load_json(const JsonValue& json){
         if (!command_line_tests_setting->read_string(COMMAND_LINE_TEST_FOLDER, "FOLDER")){
             COMMAND_LINE_TEST_FOLDER = "CommandLineTests";
         }
+        command_line_tests_setting->read_boolean(COMMAND_LINE_TEST_PARALLEL, "PARALLEL");
+        command_line_tests_setting->read_string(COMMAND_LINE_TEST_REPORT, "REPORT");
+        command_line_tests_setting->read_string(COMMAND_LINE_TEST_BASELINE, "BASELINE");
+        command_line_tests_setting->read_float(COMMAND_LINE_TEST_REGRESSION_THRESHOLD, "REGRESSION_THRESHOLD");
 
         const JsonArray* test_list = command_line_tests_setting->get_array("TEST_LIST");
         if (test_list){
@@ -358,6 +362,10 @@ JsonValue GlobalSettings::to_json() const{
     JsonObject command_line_test_obj;
     command_line_test_obj["RUN"] = COMMAND_LINE_TEST_MODE;
     command_line_test_obj["FOLDER"] = COMMAND_LINE_TEST_FOLDER;
+    command_line_test_obj["PARALLEL"] = COMMAND_LINE_TEST_PARALLEL;
+    command_line_test_obj["REPORT"] = COMMAND_LINE_TEST_REPORT;
+    command_line_test_obj["BASELINE"] = COMMAND_LINE_TEST_BASELINE;
+    command_line_test_obj["REGRESSION_THRESHOLD"] = COMMAND_LINE_TEST_REGRESSION_THRESHOLD;
 
     {
         JsonArray test_list;
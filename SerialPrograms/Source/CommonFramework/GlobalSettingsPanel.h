@@ -129,6 +129,17 @@ public:
     // Which tests to ignore running under the command line test mode.
     // If a test path appears in both COMMAND_LINE_TEST_LIST and COMMAND_LINE_IGNORE_LIST, it's still ignored.
     std::vector<std::string> COMMAND_LINE_IGNORE_LIST;
+    // Run the test files in parallel. Off by default since the latencies in
+    // the report are only meaningful when measured one test at a time.
+    bool COMMAND_LINE_TEST_PARALLEL = false;
+    // Where to write the JSON timing report. (and the CSV next to it)
+    // No report is written if empty.
+    std::string COMMAND_LINE_TEST_REPORT = "CommandLineTestReport.json";
+    // A previous report to compare the detector latencies against.
+    std::string COMMAND_LINE_TEST_BASELINE;
+    // A detector regresses if its mean latency is more than this fraction
+    // slower than in the baseline.
+    double COMMAND_LINE_TEST_REGRESSION_THRESHOLD = 0.25;
 };
 
 
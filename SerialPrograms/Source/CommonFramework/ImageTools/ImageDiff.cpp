@@ -109,6 +109,62 @@ double pixel_RMSD_masked(const ImageViewRGB32& reference, const ImageViewRGB32&
     return std::sqrt((double)sumsqrs / (double)count);
 }
 
+double pixel_RMSD(const ImageViewRGB32& reference, const FloatPixel& reference_scale, const ImageViewRGB32& image){
+    if (!image){
+        return 765; //  Max possible deviation.
+    }
+    if (reference.width() != image.width() || reference.height() != image.height()){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Mismatching Dimensions");
+    }
+    uint64_t count = 0;
+    uint64_t sumsqrs = 0;
+    Kernels::sum_sqr_deviation_scaled(
+        count, sumsqrs,
+        reference.width(), reference.height(),
+        reference.data(), reference.bytes_per_row(),
+        image.data(), image.bytes_per_row(),
+        (float)reference_scale.r, (float)reference_scale.g, (float)reference_scale.b
+    );
+    return std::sqrt((double)sumsqrs / (double)count);
+}
+double pixel_RMSD(const ImageViewRGB32& reference, const FloatPixel& reference_scale, const ImageViewRGB32& image, Color background){
+    if (!image){
+        return 765; //  Max possible deviation.
+    }
+    if (reference.width() != image.width() || reference.height() != image.height()){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Mismatching Dimensions");
+    }
+    uint64_t count = 0;
+    uint64_t sumsqrs = 0;
+    Kernels::sum_sqr_deviation_scaled(
+        count, sumsqrs,
+        reference.width(), reference.height(),
+        reference.data(), reference.bytes_per_row(),
+        image.data(), image.bytes_per_row(),
+        (float)reference_scale.r, (float)reference_scale.g, (float)reference_scale.b,
+        (uint32_t)background
+    );
+    return std::sqrt((double)sumsqrs / (double)count);
+}
+double pixel_RMSD_masked(const ImageViewRGB32& reference, const FloatPixel& reference_scale, const ImageViewRGB32& image){
+    if (!image){
+        return 765; //  Max possible deviation.
+    }
+    if (reference.width() != image.width() || reference.height() != image.height()){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Mismatching Dimensions");
+    }
+    uint64_t count = 0;
+    uint64_t sumsqrs = 0;
+    Kernels::sum_sqr_deviation_scaled_masked(
+        count, sumsqrs,
+        reference.width(), reference.height(),
+        reference.data(), reference.bytes_per_row(),
+        image.data(), image.bytes_per_row(),
+        (float)reference_scale.r, (float)reference_scale.g, (float)reference_scale.b
+    );
+    return std::sqrt((double)sumsqrs / (double)count);
+}
+
 
 
 }
@@ -57,6 +57,12 @@ double pixel_RMSD(const ImageViewRGB32& reference, const ImageViewRGB32& image,
 //
 double pixel_RMSD_masked(const ImageViewRGB32& reference, const ImageViewRGB32& image);
 
+//  Same as the above, but "reference" is compared as if it were first passed
+//  through "scale_brightness(reference, reference_scale)". No copy is made.
+double pixel_RMSD(const ImageViewRGB32& reference, const FloatPixel& reference_scale, const ImageViewRGB32& image);
+double pixel_RMSD(const ImageViewRGB32& reference, const FloatPixel& reference_scale, const ImageViewRGB32& image, Color background);
+double pixel_RMSD_masked(const ImageViewRGB32& reference, const FloatPixel& reference_scale, const ImageViewRGB32& image);
+
 
 
 }
@@ -0,0 +1,64 @@
+/*  Image Tile Hashes
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <algorithm>
+#include "Kernels/ImageStats/Kernels_ImageTileHash.h"
+#include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+#include "ImageTileHashes.h"
+
+namespace PokemonAutomation{
+
+
+
+ImageTileHashes::ImageTileHashes(const ImageViewRGB32& image)
+    : m_width(image.width())
+    , m_height(image.height())
+    , m_tiles_x((m_width + TILE_SIZE - 1) / TILE_SIZE)
+    , m_tiles_y((m_height + TILE_SIZE - 1) / TILE_SIZE)
+    , m_hashes(m_tiles_x * m_tiles_y)
+{
+    Kernels::image_tile_hash(
+        m_hashes.data(),
+        m_width, m_height,
+        image.data(), image.bytes_per_row()
+    );
+}
+
+
+bool ImageTileHashes::changed(const ImageTileHashes& previous, const std::vector<ImageFloatBox>& boxes) const{
+    if (m_width != previous.m_width || m_height != previous.m_height){
+        return true;
+    }
+    for (const ImageFloatBox& box : boxes){
+        //  Same rounding and clipping as extract_box_reference().
+        size_t min_x = (size_t)(m_width * box.x + 0.5);
+        size_t min_y = (size_t)(m_height * box.y + 0.5);
+        size_t width = (size_t)(m_width * box.width + 0.5);
+        size_t height = (size_t)(m_height * box.height + 0.5);
+        if (min_x >= m_width || min_y >= m_height || width == 0 || height == 0){
+            continue;
+        }
+        size_t max_x = std::min(min_x + width, m_width);
+        size_t max_y = std::min(min_y + height, m_height);
+
+        size_t tx0 = min_x / TILE_SIZE;
+        size_t tx1 = (max_x - 1) / TILE_SIZE;
+        for (size_t ty = min_y / TILE_SIZE; ty <= (max_y - 1) / TILE_SIZE; ty++){
+            const uint64_t* current = &m_hashes[ty * m_tiles_x];
+            const uint64_t* old = &previous.m_hashes[ty * m_tiles_x];
+            for (size_t tx = tx0; tx <= tx1; tx++){
+                if (current[tx] != old[tx]){
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+
+
+}
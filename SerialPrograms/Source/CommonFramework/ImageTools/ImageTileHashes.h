@@ -0,0 +1,62 @@
+/*  Image Tile Hashes
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Split an image into 32 x 32 tiles and hash each tile. Comparing the
+ *  hashes of two frames tells which parts of the screen changed without
+ *  looking at the pixels again.
+ *
+ *  A change to any single pixel always changes the hash of its tile. Changes
+ *  to several pixels of a tile are only missed if the 64-bit hashes happen to
+ *  collide. (see Kernels_ImageTileHash.h)
+ *
+ */
+
+#ifndef PokemonAutomation_CommonFramework_ImageTileHashes_H
+#define PokemonAutomation_CommonFramework_ImageTileHashes_H
+
+#include <stdint.h>
+#include <vector>
+#include "Kernels/ImageStats/Kernels_ImageTileHash.h"
+#include "ImageBoxes.h"
+
+namespace PokemonAutomation{
+
+class ImageViewRGB32;
+
+
+class ImageTileHashes{
+public:
+    static constexpr size_t TILE_SIZE = Kernels::IMAGE_HASH_TILE_SIZE;
+
+public:
+    ImageTileHashes() = default;
+    explicit ImageTileHashes(const ImageViewRGB32& image);
+
+    size_t width() const{ return m_width; }
+    size_t height() const{ return m_height; }
+    size_t tiles_x() const{ return m_tiles_x; }
+    size_t tiles_y() const{ return m_tiles_y; }
+
+    uint64_t hash(size_t tile_x, size_t tile_y) const{
+        return m_hashes[tile_y * m_tiles_x + tile_x];
+    }
+
+    //  Returns true if any tile touched by any of the boxes is different from
+    //  "previous". Boxes are rounded the same way as extract_box_reference().
+    //  Images of different sizes are always considered changed.
+    bool changed(const ImageTileHashes& previous, const std::vector<ImageFloatBox>& boxes) const;
+
+
+private:
+    size_t m_width = 0;
+    size_t m_height = 0;
+    size_t m_tiles_x = 0;
+    size_t m_tiles_y = 0;
+    std::vector<uint64_t> m_hashes;
+};
+
+
+
+}
+#endif
@@ -9,6 +9,7 @@
 #include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/Containers/Pimpl.tpp"
 #include "Common/Cpp/Containers/AlignedVector.tpp"
+#include "Kernels/ImageFilters/RGB32_HSV/Kernels_ImageFilter_RGB32_HSV.h"
 #include "ImageViewRGB32.h"
 #include "ImageViewHSV32.h"
 #include "ImageHSV32.h"
@@ -57,7 +58,7 @@ ImageHSV32::ImageHSV32(size_t width, size_t height)
 }
 
 
-uint32_t hsv_to_rgb(uint32_t p){
+uint32_t rgb32_to_hsv32_reference(uint32_t p){
     int r = (uint32_t(0xff) & (p >> 16));
     int g = (uint32_t(0xff) & (p >> 8));
     int b = (uint32_t(0xff) & p);
@@ -110,7 +111,7 @@ ImageHSV32::ImageHSV32(const ImageViewRGB32& image)
     //     // XXX
     //     // auto p = combine_rgb(173,238,112);
     //     auto p = combine_rgb(200,255,133);
-    //     auto p2 = hsv_to_rgb(p);
+    //     auto p2 = rgb32_to_hsv32_reference(p);
     //     auto h = (p2 & 0x00ff0000) >> 16;
     //     auto s = (p2 & 0x0000ff00) >> 8;
     //     auto v = (p2 & 0x000000ff);
@@ -118,15 +119,10 @@ ImageHSV32::ImageHSV32(const ImageViewRGB32& image)
     //     exit(0);
     // }
 
-    size_t width = image.width();
-    size_t height = image.height();
-    for (size_t y = 0; y < height; y++){
-        for (size_t x = 0; x < width; x++){
-            uint32_t p = image.pixel(x, y);
-
-            this->pixel(x, y) = hsv_to_rgb(p);
-        }
-    }
+    Kernels::rgb32_to_hsv32(
+        image.data(), image.bytes_per_row(), m_width, m_height,
+        m_ptr, m_bytes_per_row
+    );
 }
 
 
@@ -71,6 +71,12 @@ private:
 };
 
 
+//  Convert a single RGB32 pixel to HSV32 using double-precision hue math.
+//  This is the reference the "Kernels::rgb32_to_hsv32()" kernels are tested
+//  against. It is slow. Use the ImageHSV32 constructor for whole images.
+uint32_t rgb32_to_hsv32_reference(uint32_t pixel);
+
+
 
 
 }
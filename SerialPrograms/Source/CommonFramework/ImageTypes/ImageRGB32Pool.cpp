@@ -0,0 +1,101 @@
+/*  Image (RGB32) Pool
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <vector>
+#include "Common/Cpp/Concurrency/SpinLock.h"
+#include "Common/Cpp/Containers/AlignedVector.tpp"
+#include "ImageRGB32Pool.h"
+
+namespace PokemonAutomation{
+
+
+
+struct ImageRGB32Pool::Core{
+    const size_t max_idle_buffers;
+
+    mutable SpinLock lock;
+    size_t words = 0;
+    std::vector<AlignedVector<uint32_t>> idle;
+
+    Core(size_t p_max_idle_buffers)
+        : max_idle_buffers(p_max_idle_buffers)
+    {}
+
+    AlignedVector<uint32_t> take(size_t p_words){
+        {
+            WriteSpinLock lg(lock);
+
+            //  Resolution changed. Everything in the pool is the wrong size.
+            if (words != p_words){
+                words = p_words;
+                idle.clear();
+            }
+
+            if (!idle.empty()){
+                AlignedVector<uint32_t> ret = std::move(idle.back());
+                idle.pop_back();
+                return ret;
+            }
+        }
+        return AlignedVector<uint32_t>(p_words);
+    }
+    void give_back(AlignedVector<uint32_t>&& buffer) noexcept{
+        try{
+            WriteSpinLock lg(lock);
+            if (buffer.size() == words && idle.size() < max_idle_buffers){
+                idle.emplace_back(std::move(buffer));
+            }
+        }catch (...){}
+    }
+};
+
+
+
+class ImageRGB32Pool::Owner : public CustomImageRGB32Owner{
+public:
+    Owner(std::shared_ptr<Core> core, size_t width, size_t height)
+        : m_core(std::move(core))
+        , m_view(width, height)
+    {
+        m_buffer = m_core->take(m_view.bytes_per_row() / sizeof(uint32_t) * height);
+    }
+    ~Owner(){
+        m_core->give_back(std::move(m_buffer));
+    }
+
+    virtual ImageViewRGB32 get_view() const override{
+        return ImageViewRGB32(
+            const_cast<uint32_t*>(m_buffer.data()),
+            m_view.bytes_per_row(),
+            m_view.width(), m_view.height()
+        );
+    }
+
+private:
+    std::shared_ptr<Core> m_core;
+    ImageViewRGB32 m_view;
+    AlignedVector<uint32_t> m_buffer;
+};
+
+
+
+ImageRGB32Pool::ImageRGB32Pool(size_t max_idle_buffers)
+    : m_core(std::make_shared<Core>(max_idle_buffers))
+{}
+ImageRGB32Pool::~ImageRGB32Pool() = default;
+
+ImageRGB32 ImageRGB32Pool::get(size_t width, size_t height){
+    return ImageRGB32(std::make_unique<Owner>(m_core, width, height));
+}
+size_t ImageRGB32Pool::idle_buffers() const{
+    ReadSpinLock lg(m_core->lock);
+    return m_core->idle.size();
+}
+
+
+
+
+}
@@ -0,0 +1,48 @@
+/*  Image (RGB32) Pool
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Recycle the pixel buffers of same-sized images.
+ *
+ *  Images handed out by this pool are ordinary ImageRGB32 objects. When the
+ *  last reference to one is destroyed, its buffer is returned to the pool
+ *  instead of being freed. The pool may be destroyed before the images it
+ *  handed out.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonFramework_ImageRGB32Pool_H
+#define PokemonAutomation_CommonFramework_ImageRGB32Pool_H
+
+#include <memory>
+#include "ImageRGB32.h"
+
+namespace PokemonAutomation{
+
+
+
+class ImageRGB32Pool{
+public:
+    //  Keep at most "max_idle_buffers" unused buffers around.
+    ImageRGB32Pool(size_t max_idle_buffers);
+    ~ImageRGB32Pool();
+
+    //  Return an image of the specified dimensions with uninitialized pixels.
+    //  Rows are padded to PA_ALIGNMENT bytes.
+    ImageRGB32 get(size_t width, size_t height);
+
+    size_t idle_buffers() const;
+
+
+private:
+    struct Core;
+    class Owner;
+
+    std::shared_ptr<Core> m_core;
+};
+
+
+
+
+}
+#endif
@@ -40,6 +40,7 @@
 #include "Startup/SetupSettings.h"
 #include "Startup/NewVersionCheck.h"
 #include "CommonFramework/VideoPipeline/Backends/CameraImplementations.h"
+#include "CommonFramework/VideoPipeline/VideoSources/VideoSource_File.h"
 #include "CommonTools/OCR/OCR_Routines.h"
 #include "ControllerInput/ControllerInput.h"
 #include "Controllers/SerialPortPollerQt.h"
@@ -178,9 +179,17 @@ int run_program(int argc, char *argv[]){
         logger.log(error.message(), COLOR_RED);
     }
 
+    std::string video_file;
+    bool video_file_unthrottled = false;
     for (size_t i = 0; i < argc; i++){
         constexpr const char* force_run_tests = "--command-line-test-mode";
         constexpr const char* command_line_test_folder = "--command-line-test-folder";
+        constexpr const char* command_line_test_report = "--command-line-test-report";
+        constexpr const char* command_line_test_baseline = "--command-line-test-baseline";
+        constexpr const char* command_line_test_serial = "--command-line-test-serial";
+        constexpr const char* command_line_test_parallel = "--command-line-test-parallel";
+        constexpr const char* video_file_path = "--video-file";
+        constexpr const char* video_file_unthrottled_flag = "--video-file-unthrottled";
 
         if (strcmp(argv[i], force_run_tests) == 0){
             GlobalSettings::instance().COMMAND_LINE_TEST_MODE = true;
@@ -188,6 +197,28 @@ int run_program(int argc, char *argv[]){
         if (strcmp(argv[i], command_line_test_folder) == 0 && (i + 1 < argc)){
             GlobalSettings::instance().COMMAND_LINE_TEST_FOLDER = argv[i + 1];
         }
+        if (strcmp(argv[i], command_line_test_report) == 0 && (i + 1 < argc)){
+            GlobalSettings::instance().COMMAND_LINE_TEST_REPORT = argv[i + 1];
+        }
+        if (strcmp(argv[i], command_line_test_baseline) == 0 && (i + 1 < argc)){
+            GlobalSettings::instance().COMMAND_LINE_TEST_BASELINE = argv[i + 1];
+        }
+        if (strcmp(argv[i], command_line_test_serial) == 0){
+            GlobalSettings::instance().COMMAND_LINE_TEST_PARALLEL = false;
+        }
+        if (strcmp(argv[i], command_line_test_parallel) == 0){
+            GlobalSettings::instance().COMMAND_LINE_TEST_PARALLEL = true;
+        }
+        if (strcmp(argv[i], video_file_path) == 0 && (i + 1 < argc)){
+            video_file = argv[i + 1];
+        }
+        if (strcmp(argv[i], video_file_unthrottled_flag) == 0){
+            video_file_unthrottled = true;
+        }
+    }
+    if (!video_file.empty()){
+        logger.log("Playing video file from the command line: " + video_file);
+        set_video_file_override(std::move(video_file), video_file_unthrottled);
     }
 
     if (GlobalSettings::instance().COMMAND_LINE_TEST_MODE){
@@ -56,6 +56,15 @@ PerformanceOptions::PerformanceOptions()
         DEFAULT_PRIORITY_NORMAL_INFERENCE,
         1.0
     )
+    , PARALLEL_VISUAL_INFERENCE(
+        "<b>Parallel Video Inference:</b><br>"
+        "Run video detectors that are due on the same frame in parallel on the "
+        "real-time thread pool instead of one after another on the inference pivot. "
+        "This reduces detection latency when a program watches for many things at once.<br>"
+        "Changes take effect on the next program start.",
+        LockMode::LOCK_WHILE_RUNNING,
+        false
+    )
     , PRECISE_WAKE_MARGIN(
         "<b>Precise Wake Time Margin:</b><br>"
         "Some operations require a thread to wake up at a very precise time - "
@@ -81,6 +90,8 @@ PerformanceOptions::PerformanceOptions()
     PA_ADD_OPTION(REALTIME_THREAD_POOL0);
     PA_ADD_OPTION(NORMAL_THREAD_POOL);
 
+    PA_ADD_OPTION(PARALLEL_VISUAL_INFERENCE);
+
     //  Used only by sys-botbase 2 which has been removed.
 //    PA_ADD_OPTION(PRECISE_WAKE_MARGIN);
 
@@ -7,6 +7,7 @@
 #ifndef PokemonAutomation_CommonFramework_ProgramDescriptor_H
 #define PokemonAutomation_CommonFramework_ProgramDescriptor_H
 
+#include "CommonFramework/Tools/ResourceWarmup.h"
 #include "PanelDescriptor.h"
 
 namespace PokemonAutomation{
@@ -32,6 +33,10 @@ public:
     using PanelDescriptor::PanelDescriptor;
 
     virtual std::unique_ptr<StatsTracker> make_stats() const;
+
+    //  Resources to load in the background when the program starts.
+    //  See ResourceWarmup.h.
+    virtual std::vector<WarmupResource> warmup_resources() const;
 };
 
 
@@ -51,6 +51,7 @@ ProgramSession::~ProgramSession(){
 
 void ProgramSession::join_program_thread() noexcept{
     m_program_thread.wait_and_ignore_exceptions();
+    m_warmup.wait_and_ignore_exceptions();
 }
 
 
@@ -141,10 +142,10 @@ void ProgramSession::load_historical_stats(){
     if (stats){
         m_logger.log("Loading historical stats...");
 //        m_current_stats = m_descriptor.make_stats();
-        StatSet set;
-        set.open_from_file(GlobalSettings::instance().STATS_FILE);
-        const std::string& identifier = m_descriptor.identifier();
-        StatList& list = set[identifier];
+        StatList list = StatSet::load_from_file(
+            GlobalSettings::instance().STATS_FILE,
+            m_descriptor.identifier()
+        );
         if (list.size() != 0){
             list.aggregate(*stats);
         }
@@ -193,6 +194,7 @@ std::string ProgramSession::start_program(){
         m_logger.log("Starting program...");
         m_timestamp.store(current_time(), std::memory_order_relaxed);
         set_state(ProgramState::RUNNING);
+        m_warmup = warm_up_resources(m_logger, m_descriptor.warmup_resources());
         m_program_thread = GlobalThreadPools::unlimited_realtime().dispatch_now_blocking(
             [this]{
                 run_with_catch(
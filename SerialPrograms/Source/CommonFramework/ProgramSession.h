@@ -161,6 +161,7 @@ private:
     // ProgramMissingResourceTracker m_missing_resource_tracker;
 
     AsyncTask m_program_thread;
+    AsyncTask m_warmup;
 
 //    Mutex m_stats_lock;
     std::unique_ptr<StatsTracker> m_historical_stats;
@@ -4,8 +4,13 @@
  *
  */
 
+#include <string.h>
+#include <stdlib.h>
+#include <random>
+#include <algorithm>
 #include <QFile>
 #include <QSaveFile>
+#include <QLockFile>
 #include "Common/Cpp/Time.h"
 #include "StatsDatabase.h"
 
@@ -41,6 +46,70 @@ const std::map<std::string, std::string> STATS_DATABASE_ALIASES{
 
 
 
+const char* const SECTION_DIVIDER = "================================================================================\r\n";
+
+const char* const JOURNAL_HEADER = "PA-Stats-Journal: ";
+const char* const COMPACTED_HEADER = "Compacted Journal: ";
+const char* const INDEX_HEADER = "PA-Stats-Index: ";
+
+//  Merge the journal into the stats file once it gets this big.
+const qint64 JOURNAL_COMPACT_BYTES = 64 * 1024;
+
+const int LOCK_TIMEOUT_MS = 5000;
+
+
+namespace{
+
+std::string journal_path(const std::string& filepath){
+    return filepath + ".journal";
+}
+std::string index_path(const std::string& filepath){
+    return filepath + ".index";
+}
+std::string lock_path(const std::string& filepath){
+    return filepath + ".lock";
+}
+
+std::string read_file(const std::string& filepath){
+    QFile file(QString::fromStdString(filepath));
+    if (!file.open(QIODevice::ReadOnly)){
+        return "";
+    }
+    QByteArray data = file.readAll();
+    return std::string(data.data(), data.size());
+}
+
+//  Return what follows "header" on the first line of "data". Empty if the
+//  first line doesn't start with "header".
+std::string header_value(const std::string& data, const char* header){
+    size_t length = strlen(header);
+    if (data.compare(0, length, header) != 0){
+        return "";
+    }
+    size_t end = data.find_first_of("\r\n", length);
+    return data.substr(length, end == std::string::npos ? std::string::npos : end - length);
+}
+std::string first_line(QFile& file){
+    QByteArray line = file.readLine(1024);
+    return std::string(line.data(), line.size());
+}
+
+//  A journal is live until the stats file says it has been merged.
+bool journal_is_live(const std::string& journal_token, const std::string& compacted_token){
+    return !journal_token.empty() && journal_token != compacted_token;
+}
+std::string new_journal_token(){
+    std::random_device rd;
+    uint64_t x = ((uint64_t)rd() << 32) | rd();
+    char buffer[17];
+    snprintf(buffer, sizeof(buffer), "%016llx", (unsigned long long)x);
+    return current_time_to_str() + " " + buffer;
+}
+
+}
+
+
+
 StatLine::StatLine(StatsTracker& tracker)
     : m_time(current_time_to_str())
     , m_stats(tracker.to_str(StatsTracker::SAVE_TO_STATS_FILE))
@@ -119,18 +188,30 @@ StatList& StatSet::operator[](const std::string& identifier){
 
 std::string StatSet::to_str() const{
     std::string str;
+    to_str(str, nullptr);
+    return str;
+}
+void StatSet::to_str(std::string& str, std::string* index) const{
     for (const auto& item : m_data){
         if (item.second.size() == 0){
             continue;
         }
-        str += "================================================================================\r\n";
+        size_t start = str.size();
+        str += SECTION_DIVIDER;
         str += item.first;
         str += "\r\n";
         str += "\r\n";
         str += item.second.to_str();
         str += "\r\n";
+        if (index){
+            *index += std::to_string(start);
+            *index += "\t";
+            *index += std::to_string(str.size() - start);
+            *index += "\t";
+            *index += item.first;
+            *index += "\r\n";
+        }
     }
-    return str;
 }
 
 void StatSet::save_to_file(const std::string& filepath){
@@ -141,13 +222,43 @@ void StatSet::save_to_file(const std::string& filepath){
     }
 }
 void StatSet::open_from_file(const std::string& filepath){
+    QLockFile lock(QString::fromStdString(lock_path(filepath)));
+    lock.tryLock(LOCK_TIMEOUT_MS);
+
+    std::string data = read_file(filepath);
+    load_from_string(data.c_str());
+
+    std::string journal = read_file(journal_path(filepath));
+    if (journal_is_live(header_value(journal, JOURNAL_HEADER), header_value(data, COMPACTED_HEADER))){
+        load_journal(journal.c_str());
+    }
+}
+
+StatList StatSet::load_from_file(const std::string& filepath, const std::string& identifier){
+    QLockFile lock(QString::fromStdString(lock_path(filepath)));
+    lock.tryLock(LOCK_TIMEOUT_MS);
+
+    StatSet set;
+
     QFile file(QString::fromStdString(filepath));
-    if (!file.open(QIODevice::ReadOnly)){
-        return;
+    std::string compacted;
+    if (file.open(QIODevice::ReadOnly)){
+        compacted = header_value(first_line(file), COMPACTED_HEADER);
+        if (!set.load_section(file, identifier)){
+            //  No usable index. Parse the whole thing.
+            file.seek(0);
+            QByteArray data = file.readAll();
+            set.load_from_string(std::string(data.data(), data.size()).c_str());
+        }
     }
 
-    std::string str = file.readAll().data();
-    load_from_string(str.c_str());
+    std::string journal = read_file(journal_path(filepath));
+    if (journal_is_live(header_value(journal, JOURNAL_HEADER), compacted)){
+        set.load_journal(journal.c_str());
+    }
+
+    auto iter = set.m_data.find(identifier);
+    return iter == set.m_data.end() ? StatList() : std::move(iter->second);
 }
 
 bool StatSet::update_file(
@@ -155,45 +266,202 @@ bool StatSet::update_file(
     const std::string& identifier,
     StatsTracker& tracker
 ){
-    QFile file(QString::fromStdString(filepath));
-    while (!file.open(QIODevice::ReadWrite)){
+    QLockFile lock(QString::fromStdString(lock_path(filepath)));
+    if (!lock.tryLock(LOCK_TIMEOUT_MS)){
         return false;
     }
-    std::string data = file.readAll().data();
+
+    std::string compacted;
+    qint64 main_size = 0;
+    {
+        QFile file(QString::fromStdString(filepath));
+        if (file.open(QIODevice::ReadOnly)){
+            compacted = header_value(first_line(file), COMPACTED_HEADER);
+            main_size = file.size();
+        }
+    }
+
+    QFile journal(QString::fromStdString(journal_path(filepath)));
+    if (!journal.open(QIODevice::ReadWrite)){
+        return false;
+    }
+
+    //  Start a new journal if there is none or the current one has already
+    //  been merged into the stats file.
+    std::string token = header_value(first_line(journal), JOURNAL_HEADER);
+    if (!journal_is_live(token, compacted)){
+        std::string header = JOURNAL_HEADER + new_journal_token() + "\r\n";
+        if (!journal.resize(0) || !journal.seek(0) ||
+            journal.write(header.c_str(), header.size()) != (qint64)header.size()
+        ){
+            return false;
+        }
+    }
+
+    std::string record = identifier + "\t" + StatLine(tracker).to_str() + "\r\n";
+    journal.seek(journal.size());
+    if (journal.write(record.c_str(), record.size()) != (qint64)record.size()){
+        return false;
+    }
+    if (!journal.flush()){
+        return false;
+    }
+
+    bool compact = journal.size() >= JOURNAL_COMPACT_BYTES;
+    journal.close();
+
+    //  Also compact if the index is missing or out of date. (first run, or
+    //  the stats file was edited or written by an older version)
+    if (!compact){
+        std::string index = read_file(index_path(filepath));
+        compact = header_value(index, INDEX_HEADER) != std::to_string(main_size);
+    }
+
+    //  The run is already recorded in the journal. So failing here is not a
+    //  failure to save. It will be retried next time.
+    if (compact){
+        compact_locked(filepath);
+    }
+
+    return true;
+}
+
+bool StatSet::compact_file(const std::string& filepath){
+    QLockFile lock(QString::fromStdString(lock_path(filepath)));
+    if (!lock.tryLock(LOCK_TIMEOUT_MS)){
+        return false;
+    }
+    return compact_locked(filepath);
+}
+bool StatSet::compact_locked(const std::string& filepath){
+    std::string data = read_file(filepath);
+    std::string compacted = header_value(data, COMPACTED_HEADER);
 
     StatSet set;
     set.load_from_string(data.c_str());
 
-    set[identifier] += tracker;
+    std::string journal = read_file(journal_path(filepath));
+    std::string token = header_value(journal, JOURNAL_HEADER);
+    if (journal_is_live(token, compacted)){
+        set.load_journal(journal.c_str());
+        compacted = token;
+    }
 
-    data = set.to_str();
-    file.seek(0);
-    file.write(data.c_str(), data.size());
-    file.resize(data.size());
+    //  Record which journal has been merged. If we die before the journal is
+    //  cleared, this keeps it from being counted twice.
+    data.clear();
+    if (!compacted.empty()){
+        data += COMPACTED_HEADER;
+        data += compacted;
+        data += "\r\n\r\n";
+    }
+    std::string index;
+    set.to_str(data, &index);
+    index = INDEX_HEADER + std::to_string(data.size()) + "\r\n" + index;
 
+    {
+        QSaveFile file(QString::fromStdString(filepath));
+        if (!file.open(QIODevice::WriteOnly)){
+            return false;
+        }
+        file.write(data.c_str(), data.size());
+        if (!file.commit()){
+            return false;
+        }
+    }
+    {
+        QSaveFile file(QString::fromStdString(index_path(filepath)));
+        if (file.open(QIODevice::WriteOnly)){
+            file.write(index.c_str(), index.size());
+            file.commit();
+        }
+    }
+
+    QFile::remove(QString::fromStdString(journal_path(filepath)));
     return true;
 }
 
 
-bool StatSet::get_line(std::string& line, const char*& ptr){
-    line.clear();
-    for (;; ptr++){
-        char ch = *ptr;
-        if (ch == '\0'){
-//            cout << line << endl;
-            ptr++;
+bool StatSet::load_section(QFile& file, const std::string& identifier){
+    std::string index = read_file(index_path(file.fileName().toStdString()));
+    if (header_value(index, INDEX_HEADER) != std::to_string(file.size())){
+        return false;
+    }
+
+    //  Lines are: offset \t length \t identifier
+    const char* ptr = index.c_str();
+    std::string line;
+    get_line(line, ptr);
+    while (get_line(line, ptr)){
+        size_t tab0 = line.find('\t');
+        size_t tab1 = tab0 == std::string::npos ? tab0 : line.find('\t', tab0 + 1);
+        if (tab1 == std::string::npos){
+            return false;
+        }
+        if (line.compare(tab1 + 1, std::string::npos, identifier) != 0){
+            continue;
+        }
+
+        qint64 offset = std::atoll(line.c_str());
+        qint64 length = std::atoll(line.c_str() + tab0 + 1);
+        if (!file.seek(offset)){
+            return false;
+        }
+        QByteArray bytes = file.read(length);
+        std::string section(bytes.data(), bytes.size());
+
+        //  Make sure the index actually points at this section.
+        std::string expected = SECTION_DIVIDER + identifier + "\r\n";
+        if (section.compare(0, expected.size(), expected) != 0){
             return false;
         }
-        if (ch == '\r'){
+        load_from_string(section.c_str());
+        return true;
+    }
+
+    //  Not in the index. Nothing recorded for this program yet.
+    m_data.clear();
+    return true;
+}
+void StatSet::load_journal(const char* ptr){
+    std::string line;
+
+    //  Skip header.
+    get_line(line, ptr);
+
+    while (get_line(line, ptr)){
+        size_t tab = line.find('\t');
+        if (tab == std::string::npos){
             continue;
         }
-        if (ch == '\n'){
-//            cout << line << endl;
-            ptr++;
-            return true;
+        std::string identifier = line.substr(0, tab);
+        auto iter = STATS_DATABASE_ALIASES.find(identifier);
+        if (iter != STATS_DATABASE_ALIASES.end()){
+            identifier = iter->second;
         }
-        line += ch;
+        m_data[identifier] += line.substr(tab + 1);
+    }
+}
+
+
+bool StatSet::get_line(std::string& line, const char*& ptr){
+    line.clear();
+    const char* end = strchr(ptr, '\n');
+    if (end == nullptr){
+        ptr += strlen(ptr) + 1;
+        return false;
     }
+    line.assign(ptr, end);
+    ptr = end + 1;
+
+    //  Drop all '\r'. It's almost always just the one at the end.
+    if (!line.empty() && line.back() == '\r'){
+        line.pop_back();
+    }
+    if (line.find('\r') != std::string::npos){
+        line.erase(std::remove(line.begin(), line.end(), '\r'), line.end());
+    }
+    return true;
 }
 void StatSet::load_from_string(const char* ptr){
     m_data.clear();
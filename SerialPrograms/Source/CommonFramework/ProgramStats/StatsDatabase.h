@@ -9,6 +9,8 @@
 
 #include "StatsTracking.h"
 
+class QFile;
+
 namespace PokemonAutomation{
 
 
@@ -46,6 +48,21 @@ private:
 
 
 
+//
+//  The stats file is plain text with one section per program. Recording a
+//  run does not rewrite it. The run is appended to "<stats file>.journal"
+//  instead. Once the journal gets large (or the stats file was changed behind
+//  our back) it is merged into the stats file, which also rewrites
+//  "<stats file>.index", the byte range of every section. So loading the
+//  stats of one program reads just its section and the journal.
+//
+//  The first line of the journal is a unique token. The stats file records
+//  the token of the last journal merged into it. So a journal that was merged
+//  but not yet deleted is never counted twice.
+//
+//  All access goes through "<stats file>.lock" so multiple instances can
+//  share the same file.
+//
 class StatSet{
 public:
 //    StatList* find(const std::string& label);
@@ -56,15 +73,33 @@ public:
     void save_to_file(const std::string& filepath);
     void open_from_file(const std::string& filepath);
 
+    //  Load the stats of a single program.
+    static StatList load_from_file(const std::string& filepath, const std::string& identifier);
+
+    //  Record a run of "identifier".
     static bool update_file(
         const std::string& filepath,
         const std::string& identifier,
         StatsTracker& tracker
     );
 
+    //  Merge the journal into the stats file and rebuild the index.
+    static bool compact_file(const std::string& filepath);
+
 private:
-    bool get_line(std::string& line, const char*& ptr);
+    static bool compact_locked(const std::string& filepath);
+
+    //  Append the sections to "str". If "index" is set, also append the index
+    //  lines of the sections to it.
+    void to_str(std::string& str, std::string* index) const;
+
+    static bool get_line(std::string& line, const char*& ptr);
     void load_from_string(const char* ptr);
+    void load_journal(const char* ptr);
+
+    //  Use the index to load just the section for "identifier".
+    //  Returns false if the index can't be used.
+    bool load_section(QFile& file, const std::string& identifier);
 
 private:
     std::map<std::string, StatList> m_data;
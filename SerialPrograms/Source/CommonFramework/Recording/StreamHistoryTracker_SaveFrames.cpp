@@ -16,7 +16,7 @@
 // #include <QMediaFormat>
 // #include <QMediaRecorder>
 // #include <QMediaCaptureSession>
-// #include <QScopeGuard>
+#include <QScopeGuard>
 #include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/Logging/AbstractLogger.h"
 #include "Common/Cpp/Concurrency/SpinLock.h"
@@ -302,7 +302,11 @@ bool StreamHistoryTracker::save(const std::string& filename) const{
     if (frames.empty()) return false;
 
     // Use first frame to get size
-    QImage first_img = decompress_video_frame(frames.front().compressed_frame);
+    QImage first_img = decompress_video_frame(*frames.front().compressed_frame);
+    if (first_img.isNull()){
+        m_logger.log("Unable to decompress first frame.", COLOR_RED);
+        return false;
+    }
     int width = first_img.width();
     int height = first_img.height();
 
@@ -316,14 +320,48 @@ bool StreamHistoryTracker::save(const std::string& filename) const{
         throw std::runtime_error("Could not open video file for writing.");
     }
 
-    std::vector<unsigned char> last_good_buffer = frames[0].compressed_frame;
+    //  Decode ahead of the writer on the computation threads. Each distinct
+    //  buffer is decoded only once. The writer consumes them in order.
+    struct DecodedFrame{
+        const std::vector<unsigned char>* buffer;
+        QImage image;
+        AsyncTask task;
+    };
+    ThreadPool& pool = GlobalThreadPools::computation_normal();
+    const size_t max_in_flight = 2 * std::max<size_t>(pool.max_threads(), 1);
+    std::deque<std::unique_ptr<DecodedFrame>> decoding;
+
+    //  The first frame is already decoded.
+    QImage img = std::move(first_img);
+    const std::vector<unsigned char>* current_buffer = frames[0].compressed_frame.get();
+
+    size_t next_to_decode = 1;
+    const std::vector<unsigned char>* last_dispatched = current_buffer;
+    auto decode_ahead = [&]{
+        while (decoding.size() < max_in_flight && next_to_decode < frames.size()){
+            const std::vector<unsigned char>* buffer = frames[next_to_decode++].compressed_frame.get();
+            if (buffer == last_dispatched){
+                continue;
+            }
+            last_dispatched = buffer;
+            DecodedFrame& decoded = *decoding.emplace_back(new DecodedFrame{buffer, {}, {}});
+            decoded.task = pool.dispatch([&decoded]{
+                decoded.image = decompress_video_frame(*decoded.buffer);
+            });
+        }
+    };
+
+    auto write_current = [&]{
+        cv::Mat mat(height, width, CV_8UC3, (void*)img.bits(), img.bytesPerLine());
+        writer.write(mat);
+    };
 
     size_t frame_index = 0;
     size_t frames_inserted = 0;
     WallClock start_time = frames[0].timestamp;
 
     // 2. Loop through frames
-    for (CompressedVideoFrame frame : frames){
+    for (const CompressedVideoFrame& frame : frames){
         if (frame_index % 100 == 0){
             m_logger.log("Saving frame " + std::to_string(frame_index) + " / " + std::to_string(frames.size()));
         }
@@ -337,19 +375,24 @@ bool StreamHistoryTracker::save(const std::string& filename) const{
         size_t target_frame_index = (size_t)std::round(elapsed/interval);
         // fill the gap with duplicate frames until we reach the target index
         while (frames_inserted < target_frame_index){
-            // Decompress last known good frame and write again
-            QImage img = decompress_video_frame(last_good_buffer);
-            cv::Mat mat(height, width, CV_8UC3, (void*)img.bits(), img.bytesPerLine());
-            writer.write(mat);
+            // Write last known good frame again
+            write_current();
             frames_inserted++;
         }
 
-        // 3. decompress frame and write to video
-        QImage img = decompress_video_frame(frame.compressed_frame);
-        cv::Mat mat(height, width, CV_8UC3, (void*)img.bits(), img.bytesPerLine());
-        writer.write(mat);
+        // 3. Pick up the decoded frame and write to video
+        decode_ahead();
+        if (frame.compressed_frame.get() != current_buffer){
+            DecodedFrame& decoded = *decoding.front();
+            decoded.task.wait_and_rethrow_exceptions();
+            if (!decoded.image.isNull() && decoded.image.width() == width && decoded.image.height() == height){
+                img = std::move(decoded.image);
+            }
+            current_buffer = decoded.buffer;
+            decoding.pop_front();
+        }
+        write_current();
 
-        last_good_buffer = frame.compressed_frame;
         frames_inserted++;
         frame_index++;
     }
@@ -360,38 +403,91 @@ bool StreamHistoryTracker::save(const std::string& filename) const{
 }
 
 
+struct StreamHistoryTracker::CompressionTask{
+    WallClock timestamp;
+    std::shared_ptr<const VideoFrame> frame;
+    std::vector<unsigned char> compressed;
+    std::atomic<bool> done{false};
+    AsyncTask task;
+};
+
+void StreamHistoryTracker::add_compressed_frame(WallClock timestamp, std::vector<unsigned char>&& compressed){
+    if (compressed.empty()){
+        //  Failed to compress. save() will fill the gap with the previous frame.
+        return;
+    }
+
+    //  Static screens compress to identical bytes. Share the buffer instead
+    //  of storing another copy.
+    if (!m_last_compressed || *m_last_compressed != compressed){
+        m_last_compressed = std::make_shared<const std::vector<unsigned char>>(std::move(compressed));
+    }
+
+    WriteSpinLock lg(m_lock, PA_CURRENT_FUNCTION);
+    m_compressed_frames.emplace_back(CompressedVideoFrame{timestamp, m_last_compressed});
+    clear_old(); // Cleanup happens here
+}
+
 void StreamHistoryTracker::worker_loop(){
-    while (!m_stopping){
+    //  Compression is fanned out to the computation threads. Frames are still
+    //  added in capture order. A frame that finishes early waits for the ones
+    //  before it.
+    ThreadPool& pool = GlobalThreadPools::computation_normal();
+    const size_t max_in_flight = std::max<size_t>(pool.max_threads(), 1);
+
+    std::deque<std::unique_ptr<CompressionTask>> in_flight;
+
+    while (true){
         std::shared_ptr<const VideoFrame> frame;
 
-        // 1. Wait for a frame to process
+        // 1. Wait for a frame to process or a compression to finish.
         {
             std::unique_lock<Mutex> lock(m_queue_lock);
-            m_cv.wait(lock, [this] { return !m_pending_frames.empty() || m_stopping; });
-            
-            if (m_stopping && m_pending_frames.empty()) return;
+            m_cv.wait(lock, [&]{
+                return m_stopping
+                    || (!in_flight.empty() && in_flight.front()->done.load(std::memory_order_acquire))
+                    || (!m_pending_frames.empty() && in_flight.size() < max_in_flight);
+            });
 
-            frame = std::move(m_pending_frames.front());
-            m_pending_frames.pop_front();
+            if (m_stopping) return;
+
+            if (!m_pending_frames.empty() && in_flight.size() < max_in_flight){
+                frame = std::move(m_pending_frames.front());
+                m_pending_frames.pop_front();
+            }
         }
 
-        // 2. Perform the expensive compression (Outside the lock)
-        auto compressed_data = compress_video_frame(frame->frame);
+        // 2. Move finished results into the main storage, in order.
+        while (!in_flight.empty() && in_flight.front()->done.load(std::memory_order_acquire)){
+            CompressionTask& task = *in_flight.front();
+            task.task.wait_and_rethrow_exceptions();
+            add_compressed_frame(task.timestamp, std::move(task.compressed));
+            in_flight.pop_front();
+        }
 
-        // 3. Move the result into the main storage
-        {
-            WriteSpinLock lg(m_lock, PA_CURRENT_FUNCTION);
-            m_compressed_frames.emplace_back(CompressedVideoFrame{
-                frame->timestamp, 
-                std::move(compressed_data)
-            });
-            clear_old(); // Cleanup happens here
+        if (!frame){
+            continue;
         }
+
+        // 3. Perform the expensive compression (Outside the lock)
+        CompressionTask& task = *in_flight.emplace_back(new CompressionTask);
+        task.timestamp = frame->timestamp;
+        task.frame = std::move(frame);
+        task.task = pool.dispatch([this, &task]{
+            auto guard = qScopeGuard([this, &task]{
+                task.frame.reset();
+                {
+                    std::lock_guard<Mutex> lock(m_queue_lock);
+                    task.done.store(true, std::memory_order_release);
+                }
+                m_cv.notify_all();
+            });
+            task.compressed = compress_video_frame(task.frame->frame);
+        });
     }
 }
 
 
-
 }
 
 // #include "StreamHistoryTracker_SaveFrames.moc" 
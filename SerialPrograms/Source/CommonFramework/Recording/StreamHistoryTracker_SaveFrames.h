@@ -40,7 +40,10 @@ struct AudioBlock{
 
 struct CompressedVideoFrame{
     WallClock timestamp;
-    std::vector<unsigned char> compressed_frame;
+
+    //  Consecutive frames that compress to the same bytes (static screen)
+    //  share the same buffer.
+    std::shared_ptr<const std::vector<unsigned char>> compressed_frame;
 };
 
 QImage decompress_video_frame(const std::vector<uchar> &compressed_buffer);
@@ -65,8 +68,11 @@ public:
     void on_frame(std::shared_ptr<const VideoFrame> frame);
 
 private:
+    struct CompressionTask;
+
     void clear_old();
     void worker_loop(); // The function that runs in the thread
+    void add_compressed_frame(WallClock timestamp, std::vector<unsigned char>&& compressed);
 
 private:
     static constexpr size_t MAX_PENDING_FRAMES = 10;
@@ -89,6 +95,9 @@ private:
     // std::deque<std::shared_ptr<const VideoFrame>> m_frames;
     std::deque<CompressedVideoFrame> m_compressed_frames;
 
+    //  Last buffer added to "m_compressed_frames". Only touched by the worker.
+    std::shared_ptr<const std::vector<unsigned char>> m_last_compressed;
+
     AsyncTask m_worker;
     std::atomic<bool> m_stopping{false};
     
@@ -0,0 +1,91 @@
+/*  Resource Warmup
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <set>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Time.h"
+#include "Common/Cpp/Logging/AbstractLogger.h"
+#include "Common/Cpp/Concurrency/Mutex.h"
+#include "GlobalThreadPools.h"
+#include "ResourceWarmup.h"
+
+namespace PokemonAutomation{
+
+
+
+namespace{
+
+//  Names of the resources that have already been warmed up (or are being
+//  warmed up) by any program. Failed warm-ups are removed again.
+struct WarmedUpResources{
+    Mutex lock;
+    std::set<std::string> names;
+
+    static WarmedUpResources& instance(){
+        static WarmedUpResources resources;
+        return resources;
+    }
+};
+
+void warm_up_failed(Logger& logger, const std::string& name, const std::string& error){
+    logger.log("Unable to warm up " + name + ": " + error, COLOR_RED);
+
+    //  Let the next program that needs it try again.
+    WarmedUpResources& warmed_up = WarmedUpResources::instance();
+    std::lock_guard<Mutex> lg(warmed_up.lock);
+    warmed_up.names.erase(name);
+}
+
+std::string elapsed_ms(WallClock start){
+    return std::to_string(std::chrono::duration_cast<Milliseconds>(current_time() - start).count()) + " ms";
+}
+
+}
+
+
+
+AsyncTask warm_up_resources(Logger& logger, std::vector<WarmupResource> resources){
+    {
+        WarmedUpResources& warmed_up = WarmedUpResources::instance();
+        std::lock_guard<Mutex> lg(warmed_up.lock);
+        std::erase_if(resources, [&](const WarmupResource& resource){
+            return !warmed_up.names.insert(resource.name).second;
+        });
+    }
+    if (resources.empty()){
+        return AsyncTask();
+    }
+
+    logger.log("Warming up " + std::to_string(resources.size()) + " resource(s)...");
+
+    return GlobalThreadPools::unlimited_normal().dispatch_now_blocking(
+        [&logger, resources = std::move(resources)]{
+            WallClock start = current_time();
+            GlobalThreadPools::computation_normal().run_in_parallel(
+                [&](size_t index){
+                    const WarmupResource& resource = resources[index];
+                    WallClock time0 = current_time();
+                    try{
+                        resource.load();
+                    }catch (Exception& e){
+                        warm_up_failed(logger, resource.name, e.message());
+                        return;
+                    }catch (std::exception& e){
+                        warm_up_failed(logger, resource.name, e.what());
+                        return;
+                    }
+                    logger.log("Warmed up " + resource.name + ": " + elapsed_ms(time0));
+                },
+                0, resources.size(), 1
+            );
+            logger.log("Done warming up resources: " + elapsed_ms(start));
+        }
+    );
+}
+
+
+
+}
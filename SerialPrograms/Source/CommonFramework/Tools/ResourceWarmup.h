@@ -0,0 +1,50 @@
+/*  Resource Warmup
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Many detectors load their templates on first use. (function-local
+ *  statics, caches, etc...) That first use then stalls on file IO and image
+ *  decoding, usually right when the program starts looking at the screen.
+ *
+ *  A program descriptor can list the resources its program will need. These
+ *  are loaded in parallel in the background as soon as the program starts.
+ *  If the program gets to a resource before it's done loading, it just waits
+ *  for it like it would have anyway.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonFramework_ResourceWarmup_H
+#define PokemonAutomation_CommonFramework_ResourceWarmup_H
+
+#include <string>
+#include <vector>
+#include <functional>
+#include "Common/Cpp/Concurrency/AsyncTask.h"
+
+namespace PokemonAutomation{
+
+class Logger;
+
+
+struct WarmupResource{
+    //  Resources are identified by name. Each is only loaded once per process
+    //  unless loading it throws. Then the next program to list it tries again.
+    std::string name;
+
+    //  Load the resource. This is normally just a call to the accessor that
+    //  lazily loads it. It must be safe to call from any thread.
+    std::function<void()> load;
+};
+
+
+//  Start loading "resources" on the computation threads and return
+//  immediately. Timings and failures are logged to "logger".
+//
+//  The returned task must be kept alive until the loads are done. Its
+//  destructor will wait for them.
+[[nodiscard]] AsyncTask warm_up_resources(Logger& logger, std::vector<WarmupResource> resources);
+
+
+
+}
+#endif
@@ -18,6 +18,7 @@ namespace PokemonAutomation{
 VideoStream::VideoStream(VideoStream&& x) = default;
 VideoStream::~VideoStream(){
     m_overlay.remove_stat(*m_audio_pivot);
+    m_overlay.remove_stat(m_video_pivot->unchanged_frame_stat());
     m_overlay.remove_stat(*m_video_pivot);
 }
 VideoStream::VideoStream(
@@ -44,6 +45,7 @@ void VideoStream::initialize_inference_threads(CancellableScope& scope){
     m_video_pivot.reset(scope, m_video);
     m_audio_pivot.reset(scope, m_audio);
     m_overlay.add_stat(*m_video_pivot);
+    m_overlay.add_stat(m_video_pivot->unchanged_frame_stat());
     m_overlay.add_stat(*m_audio_pivot);
 }
 
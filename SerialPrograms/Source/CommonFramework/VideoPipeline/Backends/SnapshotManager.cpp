@@ -4,9 +4,11 @@
  *
  */
 
+#include <QScopeGuard>
 //#include "Common/Cpp/Concurrency/ReverseLockGuard.h"
 #include "Common/Cpp/Concurrency/AsyncTask.h"
 #include "CommonFramework/ImageTypes/ImageRGB32_Qt.h"
+#include "Kernels/VideoFrameConversion/Kernels_VideoFrameConversion.h"
 #include "CommonFramework/Tools/GlobalThreadPools.h"
 #include "SnapshotManager.h"
 
@@ -17,6 +19,16 @@
 namespace PokemonAutomation{
 
 
+//  How many idle frame buffers to keep. A buffer is in use while its frame is
+//  being converted or while the archive holds its snapshot. Conversions run
+//  on the realtime pool (at most one per thread, see try_dispatch_now()) plus
+//  one on the thread calling snapshot_latest_blocking(). The archive always
+//  keeps the latest snapshot. Enough idle buffers for all of these means a
+//  burst of conversions never falls back to allocating.
+size_t frame_pool_size(){
+    return GlobalThreadPools::computation_realtime().max_threads() + 2;
+}
+
 
 
 SnapshotManager::~SnapshotManager(){
@@ -29,6 +41,7 @@ SnapshotManager::~SnapshotManager(){
 SnapshotManager::SnapshotManager(Logger& logger, QVideoFrameCache& cache)
     : m_logger(logger)
     , m_cache(cache)
+    , m_frame_pool(frame_pool_size())
     , m_stats_conversion("ConvertFrame", "ms", 1000, std::chrono::seconds(10))
 {}
 
@@ -41,14 +54,83 @@ QImage SnapshotManager::frame_to_image(const QVideoFrame& frame){
     }
     return image;
 }
+ImageRGB32 SnapshotManager::frame_to_image_direct(QVideoFrame& frame){
+    switch (frame.pixelFormat()){
+    case QVideoFrameFormat::Format_NV12:
+    case QVideoFrameFormat::Format_YUYV:
+    case QVideoFrameFormat::Format_BGRA8888:
+    case QVideoFrameFormat::Format_BGRX8888:
+        break;
+    default:
+        return ImageRGB32();
+    }
+
+    //  Leave anything that needs to be reoriented to Qt.
+    QVideoFrameFormat format = frame.surfaceFormat();
+    if (format.isMirrored() || format.scanLineDirection() != QVideoFrameFormat::TopToBottom){
+        return ImageRGB32();
+    }
+#if QT_VERSION >= QT_VERSION_CHECK(6, 7, 0)
+    if (frame.rotation() != QtVideo::Rotation::None){
+        return ImageRGB32();
+    }
+#else
+    if (frame.rotationAngle() != QVideoFrame::Rotation0){
+        return ImageRGB32();
+    }
+#endif
+
+    if (!frame.map(QVideoFrame::ReadOnly)){
+        return ImageRGB32();
+    }
+    auto guard = qScopeGuard([&frame]{ frame.unmap(); });
+
+    size_t width = frame.width();
+    size_t height = frame.height();
+    ImageRGB32 image = m_frame_pool.get(width, height);
+
+    Kernels::YUVtoRGBMatrix matrix = Kernels::yuv_to_rgb_matrix(
+        format.colorSpace() != QVideoFrameFormat::ColorSpace_BT601,
+        format.colorRange() == QVideoFrameFormat::ColorRange_Full
+    );
+
+    switch (frame.pixelFormat()){
+    case QVideoFrameFormat::Format_NV12:
+        Kernels::convert_NV12_to_RGB32(
+            matrix, width, height,
+            frame.bits(0), frame.bytesPerLine(0),
+            frame.bits(1), frame.bytesPerLine(1),
+            image.data(), image.bytes_per_row()
+        );
+        break;
+    case QVideoFrameFormat::Format_YUYV:
+        Kernels::convert_YUYV_to_RGB32(
+            matrix, width, height,
+            frame.bits(0), frame.bytesPerLine(0),
+            image.data(), image.bytes_per_row()
+        );
+        break;
+    default:
+        Kernels::convert_BGRX_to_RGB32(
+            width, height,
+            (const uint32_t*)frame.bits(0), frame.bytesPerLine(0),
+            image.data(), image.bytes_per_row()
+        );
+    }
+
+    return image;
+}
 VideoSnapshot SnapshotManager::convert(QVideoFrame frame, WallClock timestamp) noexcept{
     VideoSnapshot snapshot;
     snapshot.timestamp = timestamp;
     try{
         WallClock time0 = current_time();
-        snapshot.frame = std::make_shared<const ImageRGB32>(
-            QImage_to_ImageRGB32(frame_to_image(frame))
-        );
+        ImageRGB32 image = frame_to_image_direct(frame);
+        if (!image){
+            image = QImage_to_ImageRGB32(frame_to_image(frame));
+        }
+        snapshot.tile_hashes = std::make_shared<const ImageTileHashes>(image);
+        snapshot.frame = std::make_shared<const ImageRGB32>(std::move(image));
         WallClock time1 = current_time();
         WriteSpinLock lg(m_stats_lock);
         m_stats_conversion.report_data(
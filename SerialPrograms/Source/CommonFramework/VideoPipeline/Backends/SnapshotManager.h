@@ -12,6 +12,7 @@
 #include "Common/Cpp/Concurrency/ConditionVariable.h"
 #include "Common/Cpp/Logging/AbstractLogger.h"
 #include "CommonFramework/Tools/StatAccumulator.h"
+#include "CommonFramework/ImageTypes/ImageRGB32Pool.h"
 #include "CommonFramework/VideoPipeline/VideoFeed.h"
 #include "QVideoFrameCache.h"
 
@@ -30,6 +31,11 @@ public:
 
 private:
     static QImage frame_to_image(const QVideoFrame& frame);
+
+    //  Map the frame and convert it straight into a pooled image.
+    //  Returns an empty image if the frame format isn't supported here.
+    ImageRGB32 frame_to_image_direct(QVideoFrame& frame);
+
     VideoSnapshot convert(QVideoFrame frame, WallClock timestamp) noexcept;
     void convert(uint64_t seqnum, QVideoFrame frame, WallClock timestamp) noexcept;
     bool try_dispatch_conversion(uint64_t seqnum, QVideoFrame frame, WallClock timestamp) noexcept;
@@ -61,6 +67,9 @@ private:
     //  will periodically clear out on the conversion threads.
     std::map<uint64_t, VideoSnapshot> m_converted_snapshot_archive;
 
+    //  Recycled frame buffers for the direct conversion path.
+    ImageRGB32Pool m_frame_pool;
+
     SpinLock m_stats_lock;
     PeriodicStatsReporterI32 m_stats_conversion;
 };
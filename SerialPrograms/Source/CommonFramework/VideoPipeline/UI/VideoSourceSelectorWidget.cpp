@@ -137,6 +137,7 @@ void VideoSourceSelectorWidget::update_source_list(){
         m_session.get(option);
         m_sources.emplace_back(option.get_descriptor_from_cache(VideoSourceType::None));
         m_sources.emplace_back(option.get_descriptor_from_cache(VideoSourceType::StillImage));
+        m_sources.emplace_back(option.get_descriptor_from_cache(VideoSourceType::VideoPlayback));
     }
 
     //  Now add all the cameras.
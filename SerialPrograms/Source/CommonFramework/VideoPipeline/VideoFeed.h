@@ -10,6 +10,7 @@
 #include <memory>
 #include "Common/Cpp/Time.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
+#include "CommonFramework/ImageTools/ImageTileHashes.h"
 
 namespace PokemonAutomation{
 
@@ -22,6 +23,11 @@ struct VideoSnapshot{
     //  This will be as close as possible to when the frame was taken.
     WallClock timestamp = WallClock::min();
 
+    //  Per-tile hashes of "frame". Filled in by the frame converter so that
+    //  inference can tell which parts of the screen changed between frames.
+    //  Null if the source doesn't provide them.
+    std::shared_ptr<const ImageTileHashes> tile_hashes;
+
     VideoSnapshot()
          : frame(std::make_shared<const ImageRGB32>())
          , timestamp(WallClock::min())
@@ -42,6 +48,7 @@ struct VideoSnapshot{
     void clear(){
         frame.reset();
         timestamp = WallClock::min();
+        tile_hashes.reset();
     }
 };
 
@@ -12,6 +12,7 @@
 
 #include "VideoSources/VideoSource_Null.h"
 #include "VideoSources/VideoSource_StillImage.h"
+#include "VideoSources/VideoSource_File.h"
 #include "VideoSources/VideoSource_Camera.h"
 
 //#include <iostream>
@@ -34,7 +35,12 @@ VideoSourceOption::VideoSourceOption()
     , m_format(VideoFormat::OTHER)
     , m_fps(0)
     , m_descriptor(new VideoSourceDescriptor_Null())
-{}
+{
+    std::shared_ptr<VideoSourceDescriptor_File> file = video_file_override();
+    if (file){
+        set_descriptor(std::move(file));
+    }
+}
 
 void VideoSourceOption::set_descriptor(std::shared_ptr<VideoSourceDescriptor> descriptor){
     m_descriptor_cache[descriptor->type] = descriptor;
@@ -54,6 +60,9 @@ std::shared_ptr<VideoSourceDescriptor> VideoSourceOption::get_descriptor_from_ca
     case VideoSourceType::StillImage:
         descriptor.reset(new VideoSourceDescriptor_StillImage());
         break;
+    case VideoSourceType::VideoPlayback:
+        descriptor.reset(new VideoSourceDescriptor_File());
+        break;
     case VideoSourceType::Camera:
         descriptor.reset(new VideoSourceDescriptor_Camera());
         break;
@@ -128,7 +137,9 @@ void VideoSourceOption::load_json(const JsonValue& json){
         }
         params = obj->get_value(VIDEO_TYPE_STRINGS.get_string(VideoSourceType::VideoPlayback));
         if (params != nullptr){
-//            m_descriptor_cache[VideoSourceType::VideoPlayback] =
+            auto x = std::make_unique<VideoSourceDescriptor_File>();
+            x->load_json(*params);
+            m_descriptor_cache[VideoSourceType::VideoPlayback] = std::move(x);
         }
         params = obj->get_value(VIDEO_TYPE_STRINGS.get_string(VideoSourceType::Camera));
         if (params != nullptr){
@@ -145,6 +156,13 @@ void VideoSourceOption::load_json(const JsonValue& json){
         descriptor = iter->second;
     }while (false);
 
+    //  The command line wins over the settings.
+    std::shared_ptr<VideoSourceDescriptor_File> file = video_file_override();
+    if (file){
+        m_descriptor_cache[file->type] = file;
+        descriptor = std::move(file);
+    }
+
     if (descriptor == nullptr){
         descriptor.reset(new VideoSourceDescriptor_Null());
     }
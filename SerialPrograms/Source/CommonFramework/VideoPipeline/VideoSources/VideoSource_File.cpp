@@ -0,0 +1,339 @@
+/*  Video Source (File)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <string.h>
+#include <QWidget>
+#include <QPainter>
+#include <QTimer>
+#include <QFileDialog>
+#include <QVideoFrame>
+#include <QVideoFrameFormat>
+#include <opencv2/imgproc.hpp>
+#include <opencv2/videoio.hpp>
+#include "Common/Cpp/Json/JsonObject.h"
+#include "Common/Cpp/Logging/AbstractLogger.h"
+#include "CommonFramework/ImageTypes/ImageRGB32_OpenCV.h"
+#include "CommonFramework/ImageTypes/ImageRGB32_Qt.h"
+#include "CommonFramework/Tools/GlobalThreadPools.h"
+#include "CommonFramework/VideoPipeline/Backends/VideoFrameQt.h"
+#include "VideoSource_File.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+
+
+
+bool VideoSourceDescriptor_File::operator==(const VideoSourceDescriptor& x) const{
+    if (typeid(*this) != typeid(x)){
+        return false;
+    }
+
+    const VideoSourceDescriptor_File& other = static_cast<const VideoSourceDescriptor_File&>(x);
+    std::string other_path = other.path();
+    bool other_unthrottled = other.unthrottled();
+
+    ReadSpinLock lg(m_lock, PA_CURRENT_FUNCTION);
+    return m_path == other_path && m_unthrottled == other_unthrottled;
+}
+
+std::string VideoSourceDescriptor_File::path() const{
+    ReadSpinLock lg(m_lock, PA_CURRENT_FUNCTION);
+    return m_path;
+}
+void VideoSourceDescriptor_File::set_path(std::string path){
+    WriteSpinLock lg(m_lock, PA_CURRENT_FUNCTION);
+    m_path = std::move(path);
+}
+bool VideoSourceDescriptor_File::unthrottled() const{
+    ReadSpinLock lg(m_lock, PA_CURRENT_FUNCTION);
+    return m_unthrottled;
+}
+void VideoSourceDescriptor_File::set_unthrottled(bool unthrottled){
+    WriteSpinLock lg(m_lock, PA_CURRENT_FUNCTION);
+    m_unthrottled = unthrottled;
+}
+
+void VideoSourceDescriptor_File::run_post_select(){
+    std::string path = QFileDialog::getOpenFileName(
+        nullptr, "Open video file", ".", "*.mp4 *.mkv *.avi *.mov"
+    ).toStdString();
+    set_path(std::move(path));
+}
+void VideoSourceDescriptor_File::load_json(const JsonValue& json){
+    const JsonObject* obj = json.to_object();
+    if (obj == nullptr){
+        return;
+    }
+    WriteSpinLock lg(m_lock, PA_CURRENT_FUNCTION);
+    obj->read_string(m_path, "Path");
+    obj->read_boolean(m_unthrottled, "Unthrottled");
+}
+JsonValue VideoSourceDescriptor_File::to_json() const{
+    ReadSpinLock lg(m_lock, PA_CURRENT_FUNCTION);
+    JsonObject obj;
+    obj["Path"] = m_path;
+    obj["Unthrottled"] = m_unthrottled;
+    return obj;
+}
+
+std::unique_ptr<VideoSource> VideoSourceDescriptor_File::make_VideoSource(
+    Logger& logger,
+    Resolution resolution,
+    VideoFormat format,
+    FramesPerSecond fps
+) const{
+    std::string path;
+    bool unthrottled;
+    {
+        ReadSpinLock lg(m_lock, PA_CURRENT_FUNCTION);
+        path = m_path;
+        unthrottled = m_unthrottled;
+    }
+    return std::make_unique<VideoSource_File>(logger, path, resolution, unthrottled);
+}
+
+
+
+struct VideoFileOverride{
+    SpinLock lock;
+    std::string path;
+    bool unthrottled = false;
+
+    static VideoFileOverride& instance(){
+        static VideoFileOverride override;
+        return override;
+    }
+};
+void set_video_file_override(std::string path, bool unthrottled){
+    VideoFileOverride& override = VideoFileOverride::instance();
+    WriteSpinLock lg(override.lock, PA_CURRENT_FUNCTION);
+    override.path = std::move(path);
+    override.unthrottled = unthrottled;
+}
+std::shared_ptr<VideoSourceDescriptor_File> video_file_override(){
+    VideoFileOverride& override = VideoFileOverride::instance();
+    ReadSpinLock lg(override.lock, PA_CURRENT_FUNCTION);
+    if (override.path.empty()){
+        return nullptr;
+    }
+    return std::make_shared<VideoSourceDescriptor_File>(override.path, override.unthrottled);
+}
+
+
+
+
+
+VideoSource_File::~VideoSource_File(){
+    {
+        std::lock_guard<Mutex> lg(m_lock);
+        m_stopping = true;
+    }
+    m_cv.notify_all();
+    m_decoder.wait_and_ignore_exceptions();
+}
+VideoSource_File::VideoSource_File(
+    Logger& logger,
+    const std::string& path,
+    Resolution resolution,
+    bool unthrottled
+)
+    : VideoSource(logger, false)
+    , m_logger(logger)
+    , m_path(path)
+    , m_unthrottled(unthrottled)
+    , m_capture(std::make_unique<cv::VideoCapture>(path))
+{
+    if (!m_capture->isOpened()){
+        logger.log("Unable to open video file: " + path, COLOR_RED);
+        m_finished = true;
+        return;
+    }
+
+    m_native_resolution = Resolution(
+        (size_t)m_capture->get(cv::CAP_PROP_FRAME_WIDTH),
+        (size_t)m_capture->get(cv::CAP_PROP_FRAME_HEIGHT)
+    );
+    m_resolution = resolution ? resolution : m_native_resolution;
+
+    double fps = m_capture->get(cv::CAP_PROP_FPS);
+    m_fps = fps > 0 ? (FramesPerSecond)(fps + 0.5) : 30;
+
+    m_formats[{1280, 720}][VideoFormat::OTHER] = {m_fps};
+    m_formats[{1920, 1080}][VideoFormat::OTHER] = {m_fps};
+    m_formats[m_native_resolution][VideoFormat::OTHER] = {m_fps};
+
+    logger.log(
+        "Playing video file: " + path +
+        " (" + m_native_resolution.to_string() + " @ " + std::to_string(m_fps) + " fps" +
+        (unthrottled ? ", unthrottled)" : ")")
+    );
+
+    m_decoder = GlobalThreadPools::unlimited_normal().dispatch_now_blocking(
+        [this]{ decode_loop(); }
+    );
+}
+
+
+//  Wrap a decoded BGRA frame for the source frame listeners. (stream history)
+static QVideoFrame to_QVideoFrame(const cv::Mat& bgra){
+    QVideoFrame frame(QVideoFrameFormat(QSize(bgra.cols, bgra.rows), QVideoFrameFormat::Format_BGRA8888));
+    if (!frame.map(QVideoFrame::WriteOnly)){
+        return QVideoFrame();
+    }
+    size_t bytes = (size_t)bgra.cols * 4;
+    for (int r = 0; r < bgra.rows; r++){
+        memcpy(frame.bits(0) + (size_t)r * frame.bytesPerLine(0), bgra.ptr(r), bytes);
+    }
+    frame.unmap();
+    return frame;
+}
+
+void VideoSource_File::decode_loop(){
+    const std::chrono::microseconds period((int64_t)(1000000 / m_fps));
+    const WallClock start = current_time();
+
+    try{
+        cv::Mat frame;
+        cv::Mat scaled;
+        for (uint64_t index = 0;; index++){
+            //  Decode the next frame before waiting for its turn. That way it's
+            //  ready to go as soon as the current one has been consumed.
+            if (!m_capture->read(frame) || frame.empty()){
+                m_logger.log("Reached the end of video file: " + m_path);
+                break;
+            }
+
+            const cv::Mat* source = &frame;
+            if ((size_t)frame.cols != m_resolution.width || (size_t)frame.rows != m_resolution.height){
+                cv::resize(
+                    frame, scaled,
+                    cv::Size((int)m_resolution.width, (int)m_resolution.height),
+                    0, 0, cv::INTER_LINEAR
+                );
+                source = &scaled;
+            }
+            cv::Mat bgra;
+            cv::cvtColor(*source, bgra, source->channels() == 1 ? cv::COLOR_GRAY2BGRA : cv::COLOR_BGR2BGRA);
+            QVideoFrame video_frame = to_QVideoFrame(bgra);
+
+            //  Same as SnapshotManager::convert(). Hash here on the decoder
+            //  thread so inference can skip the parts that didn't change.
+            VideoSnapshot snapshot;
+            ImageRGB32 image(std::make_unique<ImageRGB32OpenCV>(std::move(bgra)));
+            snapshot.tile_hashes = std::make_shared<const ImageTileHashes>(image);
+            snapshot.frame = std::make_shared<const ImageRGB32>(std::move(image));
+
+            WallClock now;
+            {
+                std::unique_lock<Mutex> lg(m_lock);
+                if (m_unthrottled){
+                    m_cv.wait(lg, [this]{ return m_stopping || m_consumed; });
+                }else{
+                    m_cv.wait_until(lg, start + index * period, [this]{ return m_stopping; });
+                }
+                if (m_stopping){
+                    return;
+                }
+                now = current_time();
+                snapshot.timestamp = now;
+                m_snapshot = std::move(snapshot);
+                m_consumed = false;
+            }
+            m_cv.notify_all();
+
+            if (video_frame.isValid()){
+                report_source_frame(std::make_shared<VideoFrame>(now, std::move(video_frame)));
+            }
+        }
+    }catch (std::exception& e){
+        m_logger.log("Unable to decode video file: " + m_path + ": " + e.what(), COLOR_RED);
+    }
+
+    {
+        std::lock_guard<Mutex> lg(m_lock);
+        m_finished = true;
+    }
+    m_cv.notify_all();
+}
+
+
+VideoSnapshot VideoSource_File::snapshot_latest_blocking(){
+    VideoSnapshot ret;
+    {
+        std::unique_lock<Mutex> lg(m_lock);
+
+        //  Only block at the start before the first frame is decoded.
+        m_cv.wait(lg, [this]{ return m_stopping || m_finished || (bool)m_snapshot; });
+
+        ret = m_snapshot;
+        m_consumed = true;
+    }
+    m_cv.notify_all();
+    return ret;
+}
+VideoSnapshot VideoSource_File::snapshot_recent_nonblocking(WallClock min_time){
+    VideoSnapshot ret;
+    {
+        std::lock_guard<Mutex> lg(m_lock);
+        ret = m_snapshot;
+        if (ret.timestamp < min_time){
+            return VideoSnapshot();
+        }
+        m_consumed = true;
+    }
+    m_cv.notify_all();
+    return ret;
+}
+VideoSnapshot VideoSource_File::latest_frame() const{
+    std::lock_guard<Mutex> lg(m_lock);
+    return m_snapshot;
+}
+
+
+
+class VideoWidget_File : public QWidget{
+public:
+    VideoWidget_File(QWidget* parent, VideoSource_File& source)
+        : QWidget(parent)
+        , m_source(source)
+        , m_timer(new QTimer(this))
+    {
+        connect(m_timer, &QTimer::timeout, this, [this]{ update(); });
+        m_timer->start(1000 / (int)std::max<FramesPerSecond>(source.current_fps(), 1));
+    }
+
+private:
+    virtual void paintEvent(QPaintEvent* event) override{
+        QWidget::paintEvent(event);
+
+        VideoSnapshot snapshot = m_source.latest_frame();
+        if (!snapshot){
+            return;
+        }
+
+        QRect rect(0, 0, this->width(), this->height());
+        QPainter painter(this);
+        painter.drawImage(rect, to_QImage_ref(*snapshot.frame));
+    }
+
+private:
+    VideoSource_File& m_source;
+    QTimer* m_timer;
+};
+
+
+
+QWidget* VideoSource_File::make_display_QtWidget(QWidget* parent){
+    return new VideoWidget_File(parent, *this);
+}
+
+
+
+
+}
@@ -0,0 +1,160 @@
+/*  Video Source (File)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Play back a recorded video file (such as a video saved by the stream
+ *  history) as if it were a live capture. This lets inference and programs
+ *  run against a recording without any capture hardware.
+ *
+ *  By default the file plays at its own frame rate. In unthrottled mode the
+ *  next frame is released as soon as someone has taken a snapshot of the
+ *  current one. So the video runs as fast as inference can consume it.
+ *  Frame timestamps are still wall clock, so anything that waits for a
+ *  duration will see the video sped up.
+ *
+ *  Instead of picking the file in the UI, you can start the program with:
+ *      --video-file <path> [--video-file-unthrottled]
+ *  Every console then starts on that file without opening the file dialog.
+ *  Like picking it in the UI, the choice is saved with the settings.
+ *
+ */
+
+#ifndef PokemonAutomation_VideoPipeline_VideoSource_File_H
+#define PokemonAutomation_VideoPipeline_VideoSource_File_H
+
+#include "Common/Cpp/Concurrency/SpinLock.h"
+#include "Common/Cpp/Concurrency/Mutex.h"
+#include "Common/Cpp/Concurrency/ConditionVariable.h"
+#include "Common/Cpp/Concurrency/AsyncTask.h"
+#include "CommonFramework/VideoPipeline/VideoSourceDescriptor.h"
+#include "CommonFramework/VideoPipeline/VideoSource.h"
+
+namespace cv{
+    class VideoCapture;
+}
+
+namespace PokemonAutomation{
+
+
+class VideoSourceDescriptor_File : public VideoSourceDescriptor{
+public:
+    VideoSourceDescriptor_File()
+        : VideoSourceDescriptor(VideoSourceType::VideoPlayback)
+    {}
+    VideoSourceDescriptor_File(std::string path, bool unthrottled = false)
+        : VideoSourceDescriptor(VideoSourceType::VideoPlayback)
+        , m_path(std::move(path))
+        , m_unthrottled(unthrottled)
+    {}
+
+public:
+    std::string path() const;
+    void set_path(std::string path);
+
+    //  If true, play the video as fast as it is consumed instead of at its
+    //  own frame rate.
+    bool unthrottled() const;
+    void set_unthrottled(bool unthrottled);
+
+    virtual bool should_reload() const override{ return true; }
+    virtual bool operator==(const VideoSourceDescriptor& x) const override;
+    virtual std::string display_name() const override{
+        return "Play Video File";
+    }
+
+    virtual void run_post_select() override;
+    virtual void load_json(const JsonValue& json) override;
+    virtual JsonValue to_json() const override;
+
+    virtual std::unique_ptr<VideoSource> make_VideoSource(
+        Logger& logger,
+        Resolution resolution,
+        VideoFormat format,
+        FramesPerSecond fps
+    ) const override;
+
+
+private:
+    mutable SpinLock m_lock;
+    std::string m_path;
+    bool m_unthrottled = false;
+};
+
+
+//  Set from the command line. (see above)
+//  Once set, "video_file_override()" returns a new descriptor for the file.
+//  Returns null if it was never set.
+void set_video_file_override(std::string path, bool unthrottled);
+std::shared_ptr<VideoSourceDescriptor_File> video_file_override();
+
+
+
+class VideoSource_File : public VideoSource{
+public:
+    VideoSource_File(
+        Logger& logger,
+        const std::string& path,
+        Resolution resolution,
+        bool unthrottled
+    );
+    virtual ~VideoSource_File();
+
+    const std::string& path() const{
+        return m_path;
+    }
+
+    virtual Resolution current_resolution() const override{
+        return m_resolution;
+    }
+    virtual VideoFormat current_format() const override{
+        return VideoFormat::OTHER;
+    }
+    virtual FramesPerSecond current_fps() const override{
+        return m_fps;
+    }
+    virtual const VideoFormatSet& supported_formats() const override{
+        return m_formats;
+    }
+
+    virtual VideoSnapshot snapshot_latest_blocking() override;
+    virtual VideoSnapshot snapshot_recent_nonblocking(WallClock min_time) override;
+
+    //  The most recently decoded frame. Unlike the snapshot functions, this
+    //  doesn't count as consuming the frame. (used by the display)
+    VideoSnapshot latest_frame() const;
+
+    virtual QWidget* make_display_QtWidget(QWidget* parent) override;
+
+
+private:
+    void decode_loop();
+
+
+private:
+    Logger& m_logger;
+    const std::string m_path;
+    const bool m_unthrottled;
+
+    std::unique_ptr<cv::VideoCapture> m_capture;
+    Resolution m_native_resolution;
+    Resolution m_resolution;
+    FramesPerSecond m_fps = 0;
+    VideoFormatSet m_formats;
+
+    mutable Mutex m_lock;
+    ConditionVariable m_cv;
+    bool m_stopping = false;
+    bool m_finished = false;
+    //  Whether someone has taken a snapshot of "m_snapshot".
+    bool m_consumed = true;
+    VideoSnapshot m_snapshot;
+
+    AsyncTask m_decoder;
+};
+
+
+
+
+
+}
+#endif
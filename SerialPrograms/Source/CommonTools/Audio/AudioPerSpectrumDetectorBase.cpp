@@ -106,6 +106,7 @@ bool AudioPerSpectrumDetectorBase::process_spectrums(
     if (m_matcher == nullptr || m_matcher->sample_rate() != sample_rate){
         m_logger.log("Loading spectrogram...");
         m_matcher = build_spectrogram_matcher(sample_rate);
+        m_matcher->set_filter_bank(m_filter_bank);
     }
 
     // Feed spectrum one by one to the matcher:
@@ -210,6 +211,13 @@ bool AudioPerSpectrumDetectorBase::process_spectrums(
     return m_detected_callback(m_last_error);
 }
 
+void AudioPerSpectrumDetectorBase::set_spectrum_filter_bank(SpectrumFilterBank* bank){
+    m_filter_bank = bank;
+    if (m_matcher != nullptr){
+        m_matcher->set_filter_bank(bank);
+    }
+}
+
 void AudioPerSpectrumDetectorBase::clear(){
     if (m_matcher != nullptr){
         m_matcher->clear();
@@ -39,6 +39,7 @@ namespace PokemonAutomation{
 
 class Logger;
 class SpectrogramMatcher;
+class SpectrumFilterBank;
 
 // A virtual base class for audio detectors to match an audio template starting at each incoming
 // spectrum in the audio stream.
@@ -84,6 +85,9 @@ public:
         AudioFeed& audio_feed
     ) override;
 
+    // Implement AudioInferenceCallback::set_spectrum_filter_bank()
+    virtual void set_spectrum_filter_bank(SpectrumFilterBank* bank) override;
+
     // Clear internal data to be used on another audio stream.
     void clear();
 
@@ -124,6 +128,7 @@ protected:
     bool m_last_reported = false;
     
     std::unique_ptr<SpectrogramMatcher> m_matcher;
+    SpectrumFilterBank* m_filter_bank = nullptr;
 
     std::vector<std::pair<float, std::string>> m_errors;
 };
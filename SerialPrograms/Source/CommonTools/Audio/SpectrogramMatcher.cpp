@@ -2,10 +2,13 @@
 
 #include <cfloat>
 #include <cmath>
+#include <algorithm>
+#include <string.h>
 #include <iostream>
 #include <fstream>
 //#include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/Containers/AlignedVector.tpp"
+#include "Kernels/Kernels_Alignment.h"
 #include "Kernels/ScaleInvariantMatrixMatch/Kernels_ScaleInvariantMatrixMatch.h"
 #include "Kernels/SpikeConvolution/Kernels_SpikeConvolution.h"
 #include "CommonFramework/AudioPipeline/AudioFeed.h"
@@ -145,13 +148,36 @@ SpectrogramMatcher::SpectrogramMatcher(
 //    cout << "m_numSpectrumsNeeded = " << m_numSpectrumsNeeded << endl;
 
     m_templateNorm = buildTemplateNorm();
+
+    m_filterKey.mode = (size_t)m_mode;
+    m_filterKey.sample_rate = m_sample_rate;
+    m_filterKey.original_frequencies = m_numOriginalFrequencies;
+    m_filterKey.freq_start = m_originalFreqStart;
+    m_filterKey.freq_end = m_originalFreqEnd;
+
+    // match_sub_template() compares the stream against the first `m_numSpectrumsNeeded`
+    // template windows.
+    for (size_t i = 0; i < m_numSpectrumsNeeded; i++){
+        const float* window = m_template.getWindow(i);
+        for (size_t j = m_freqStart; j < m_freqEnd; j++){
+            m_matchedTemplateSumSqr += (double)window[j] * window[j];
+        }
+    }
+
+    if (m_numSpectrumsNeeded > 0){
+        m_spectrumStride = Kernels::align_int_up<PA_ALIGNMENT>(m_template.numFrequencies() * sizeof(float)) / sizeof(float);
+        m_spectrums = AlignedVector<float>(m_numSpectrumsNeeded * m_spectrumStride);
+        memset(m_spectrums.data(), 0, m_spectrums.size() * sizeof(float));
+        m_spectrumStamps.resize(m_numSpectrumsNeeded);
+        m_spectrumNormSqrs.resize(m_numSpectrumsNeeded);
+    }
 }
 
 uint64_t SpectrogramMatcher::latestTimestamp() const{
-    if (m_spectrums.size() == 0){
+    if (m_numSpectrums == 0){
         return SIZE_MAX;
     }
-    return m_spectrums.front().stamp;
+    return m_spectrumStamps[m_newestSlot];
 }
 
 void SpectrogramMatcher::conv(const float* src, size_t num, float* dst){
@@ -194,50 +220,62 @@ std::vector<float> SpectrogramMatcher::buildTemplateNorm() const{
     return ret;
 }
 
-bool SpectrogramMatcher::update_to_new_spectrum(AudioSpectrum spectrum){
-    if (m_numOriginalFrequencies != spectrum.magnitudes->size()){
-        std::cout << "Error: number of frequencies don't match in SpectrogramMatcher::match() " << 
-            m_numOriginalFrequencies << " " << spectrum.magnitudes->size() << std::endl;
-        return false;
-    }
-
+void SpectrogramMatcher::filter_spectrum(const AudioSpectrum& spectrum, float* row){
+    const float* magnitudes = spectrum.magnitudes->data();
     switch(m_mode){
     case Mode::SPIKE_CONV:
-    {
         // Do the conv on new spectrum too.
-        AlignedVector<float> convedSpectrum(m_template.bufferSize());
-        conv(spectrum.magnitudes->data() + m_originalFreqStart,
-            m_originalFreqEnd - m_originalFreqStart, convedSpectrum.data());
-        
-        spectrum.magnitudes = std::make_unique<AlignedVector<float>>(std::move(convedSpectrum));
+        conv(magnitudes + m_originalFreqStart, m_originalFreqEnd - m_originalFreqStart, row);
         break;
-    }
     case Mode::AVERAGE_5:
-    {
-        AlignedVector<float> avgedSpectrum(m_template.bufferSize());
         for (size_t j = 0; j < m_template.numFrequencies(); j++){
-            const float * rawFreqMag = spectrum.magnitudes->data() + m_originalFreqStart + j*5;
+            const float * rawFreqMag = magnitudes + m_originalFreqStart + j*5;
             const float newMag = (rawFreqMag[0] + rawFreqMag[1] + rawFreqMag[2] + rawFreqMag[3] + rawFreqMag[4]) / 5.0f;
-            avgedSpectrum[j] = newMag;
+            row[j] = newMag;
         }
-        spectrum.magnitudes = std::make_unique<AlignedVector<float>>(std::move(avgedSpectrum));
         break;
-    }
     case Mode::RAW:
+        memcpy(row + m_freqStart, magnitudes + m_freqStart, (m_freqEnd - m_freqStart) * sizeof(float));
         break;
     }
+}
+
+bool SpectrogramMatcher::update_to_new_spectrum(const AudioSpectrum& spectrum){
+    if (m_numOriginalFrequencies != spectrum.magnitudes->size()){
+        std::cout << "Error: number of frequencies don't match in SpectrogramMatcher::match() " << 
+            m_numOriginalFrequencies << " " << spectrum.magnitudes->size() << std::endl;
+        return false;
+    }
+    if (m_numSpectrumsNeeded == 0){
+        return false;
+    }
 
-    // Compute the norm square (= sum squares) of the spectrum, used for matching:
-    // TODO: if there will be multiple SpectrogramMatcher running on the same audio stream, can
-    // move this per-spectrum computation to a shared struct for those matchers to save computation.
-    float spectrumNormSqr = 0.0f;
-    for (size_t i = m_freqStart; i < m_freqEnd; i++){
-        float mag = (*spectrum.magnitudes)[i];
-        spectrumNormSqr += mag * mag;
+    // Overwrite the oldest row.
+    const size_t slot = (m_newestSlot + 1) % m_numSpectrumsNeeded;
+    float* row = spectrum_row(slot);
+
+    // Another matcher with the same filter may have already done the work.
+    SpectrumFilterBank::FilteredSpectrum shared;
+    if (m_filterBank != nullptr && m_filterBank->lookup(m_filterKey, spectrum, shared)){
+        memcpy(row + m_freqStart, shared.filtered->data() + m_freqStart, (m_freqEnd - m_freqStart) * sizeof(float));
+        m_spectrumNormSqrs[slot] = shared.norm_sqr;
+    }else{
+        filter_spectrum(spectrum, row);
+
+        // Compute the norm square (= sum squares) of the spectrum, used for matching:
+        const float* normRow = row + m_freqStart;
+        m_spectrumNormSqrs[slot] = Kernels::ScaleInvariantMatrixMatch::compute_dot(
+            m_freqEnd - m_freqStart, 1, &normRow, &normRow
+        );
+
+        if (m_filterBank != nullptr){
+            m_filterBank->publish(m_filterKey, spectrum, row, m_freqEnd, m_spectrumNormSqrs[slot]);
+        }
     }
-    m_spectrumNormSqrs.push_front(spectrumNormSqr);
+    m_spectrumStamps[slot] = spectrum.stamp;
 
-    m_spectrums.emplace_front(std::move(spectrum));
+    m_newestSlot = slot;
+    m_numSpectrums = std::min(m_numSpectrums + 1, m_numSpectrumsNeeded);
 
     return true;
 }
@@ -248,81 +286,40 @@ bool SpectrogramMatcher::update_to_new_spectrums(const std::vector<AudioSpectrum
             return false;
         }
     }
-
-    // pop out too old spectrums
-    while (m_spectrums.size() > m_numSpectrumsNeeded){
-        m_spectrums.pop_back();
-        m_spectrumNormSqrs.pop_back();
-    }
-
     return true;
 }
 
 std::pair<float, float> SpectrogramMatcher::match_sub_template(size_t sub_index) const{
-#if 0
-    auto iter = m_spectrums.begin();
-    auto iter2 = m_spectrumNormSqrs.begin();
-    float streamSumSqr = 0.0f;
-    float sumMulti = 0.0f;
-
-    const size_t template_start = m_templateRange[sub_index].first;
-    const size_t template_end = m_templateRange[sub_index].second;
-    for (size_t i = template_start; i < template_end; i++, iter++, iter2++){
-        // match in order from latest window to oldest
-        const float* templateData = m_template.getWindow(template_end-1-i);
-        const float* streamData = iter->magnitudes->data();
-        streamSumSqr += *iter2;
-        for (size_t j = m_freqStart; j < m_freqEnd; j++){
-            sumMulti += templateData[j] * streamData[j];
-        }
-    }
-//    cout << "sumMulti = " << sumMulti << ", streamSumSqr = " << streamSumSqr << endl;
-    const float scale = (streamSumSqr < 1e-6f ? 1.0f : sumMulti / streamSumSqr);
-
-    iter = m_spectrums.begin();
-    float sum = 0.0f;
-    for (size_t i = template_start; i < template_end; i++, iter++){
-        // match in order from latest window to oldest
-        const float* templateData = m_template.getWindow(template_end-1-i);
-        const float* streamData = iter->magnitudes->data();
-        for (size_t j = m_freqStart; j < m_freqEnd; j++){
-            float d = templateData[j] - scale * streamData[j];
-            sum += d * d;
-        }
-    }
-#else
     //  Build matrix.
-    auto iter = m_spectrums.begin();
     const size_t template_start = m_templateRange[sub_index].first;
     const size_t template_end = m_templateRange[sub_index].second;
     size_t windows = template_end - template_start;
-//    cout << windows << endl;
-//    cout << m_spectrums.size() << " / " << windows << endl;
     size_t freqs = m_freqEnd - m_freqStart;
     std::vector<const float*> matrixA(windows);
     std::vector<const float*> matrixT(windows);
-    for (size_t i = 0; i < windows; i++, iter++){
-//        cout << "Template: " << ((size_t)m_template.getWindow(template_end - 1 - i) % 64) << endl;
-//        cout << "Samples:  " << ((size_t)iter->magnitudes->data() % 64) << endl;
+    double sumA2 = 0;
+    for (size_t i = 0; i < windows; i++){
+        const size_t slot = slot_of(i);
         matrixT[i] = m_freqStart + m_template.getWindow(windows - 1 - i);
-        matrixA[i] = m_freqStart + iter->magnitudes->data();
-//        cout << matrixT[i] << " : " << matrixA[i] << endl;
+        matrixA[i] = m_freqStart + spectrum_row(slot);
+        sumA2 += m_spectrumNormSqrs[slot];
     }
 
-    //  Compute scale.
-    float scale = Kernels::ScaleInvariantMatrixMatch::compute_scale(
+    //  Only the cross term needs a pass over the spectrums. The norms of both
+    //  the stream and the template are already known, so the error
+    //  |s A - T|^2 = s^2 |A|^2 - 2 s (A . T) + |T|^2 is computed directly.
+    float sumAT = Kernels::ScaleInvariantMatrixMatch::compute_dot(
         freqs, windows,
         matrixA.data(), matrixT.data()
     );
+
+    //  Compute scale.
+    float scale = sumAT / (float)sumA2;
     scale = std::min<float>(scale, 1000000);
 
     //  Compute error.
-    float sum = Kernels::ScaleInvariantMatrixMatch::compute_error(
-        freqs, windows,
-        scale,
-        matrixA.data(), matrixT.data()
-    );
-#endif
+    double error = (double)scale * scale * sumA2 - 2.0 * scale * sumAT + m_matchedTemplateSumSqr;
+    float sum = (float)std::max(error, 0.0);
 
 
     float score = sqrt(sum) / m_templateNorm[0];
@@ -337,23 +334,21 @@ float SpectrogramMatcher::match(const std::vector<AudioSpectrum>& new_spectrums)
         return FLT_MAX;
     }
 
-    if (m_spectrums.size() < m_numSpectrumsNeeded){
+    if (m_numSpectrums < m_numSpectrumsNeeded){
         return FLT_MAX;
     }
 
     // Check whether the stored spectrums' timestamps are continuous:
-    size_t curStamp = m_spectrums.front().stamp;
-    size_t lastStamp = curStamp + 1;
-    for (const auto& s : m_spectrums){
-        if (s.stamp != lastStamp - 1){
+    size_t curStamp = m_spectrumStamps[m_newestSlot];
+    for (size_t i = 0; i < m_numSpectrums; i++){
+        if (m_spectrumStamps[slot_of(i)] != curStamp - i){
             std::cout << "Error: SpectrogramMatcher (" + m_name + ") spectrum timestamps are not continuous:" << std::endl;
-            for (const auto& sp : m_spectrums){
-                std::cout << sp.stamp << ", ";
+            for (size_t j = 0; j < m_numSpectrums; j++){
+                std::cout << m_spectrumStamps[slot_of(j)] << ", ";
             }
             std::cout << std::endl;
             return FLT_MAX;
         }
-        lastStamp--;
     }
 
     if (m_lastStampTested != SIZE_MAX && curStamp <= m_lastStampTested){
@@ -392,8 +387,8 @@ bool SpectrogramMatcher::skip(const std::vector<AudioSpectrum>& new_spectrums){
 }
 
 void SpectrogramMatcher::clear(){
-    m_spectrums.clear();
-    m_spectrumNormSqrs.clear();
+    m_newestSlot = 0;
+    m_numSpectrums = 0;
     m_lastStampTested = SIZE_MAX;
     m_lastScale = 0.0;
 }
@@ -11,9 +11,10 @@
 #include <array>
 #include <memory>
 #include <vector>
-#include <list>
+#include "Common/Cpp/Containers/AlignedVector.h"
 #include "CommonFramework/AudioPipeline/AudioFeed.h"
 #include "CommonFramework/AudioPipeline/AudioTemplate.h"
+#include "SpectrumFilterBank.h"
 
 namespace PokemonAutomation{
 
@@ -49,6 +50,10 @@ public:
 
     size_t sample_rate() const{ return m_sample_rate; }
 
+    // Share the filtered spectrums with other matchers on the same audio feed.
+    // `bank` may be nullptr, which disables sharing.
+    void set_filter_bank(SpectrumFilterBank* bank){ m_filterBank = bank; }
+
     // Match the newest spectrums and return a match score.
     // Newer (larger timestamp) spectrums at beginning of `new_spectrums` while older (smaller
     // timestamp) spectrums at the end.
@@ -86,9 +91,20 @@ private:
     // For a given sub-template, return its match score and scaling factor
     std::pair<float, float> match_sub_template(size_t sub_index) const;
 
+    // Index of the row in `m_spectrums` that stores the spectrum `age` windows older than
+    // the newest one.
+    size_t slot_of(size_t age) const{
+        return (m_newestSlot + m_numSpectrumsNeeded - age) % m_numSpectrumsNeeded;
+    }
+    const float* spectrum_row(size_t slot) const{ return m_spectrums.data() + slot * m_spectrumStride; }
+    float* spectrum_row(size_t slot){ return m_spectrums.data() + slot * m_spectrumStride; }
+
+    // Apply `m_mode` to a raw spectrum and write the result to a row of `m_spectrums`.
+    void filter_spectrum(const AudioSpectrum& spectrum, float* row);
+
     // Update internal data for the next new spectrum. Called by `update_to_new_spectrums()`.
     // Return true if there is no error.
-    bool update_to_new_spectrum(AudioSpectrum newSpectrum);
+    bool update_to_new_spectrum(const AudioSpectrum& newSpectrum);
 
     // Update internal data for the new specttrums.
     // Return true if there is no error.
@@ -113,18 +129,32 @@ private:
     std::vector<std::pair<size_t, size_t>> m_templateRange;
     // For each subdivided template, store its sepctrogram matrix norm
     std::vector<float> m_templateNorm;
+    // Sum squares of the template windows that `match_sub_template()` compares against.
+    double m_matchedTemplateSumSqr = 0;
 
     Mode m_mode = Mode::RAW;
 
+    SpectrumFilterBank* m_filterBank = nullptr;
+    SpectrumFilterBank::FilterKey m_filterKey;
+
     std::vector<float> m_convKernel;
 
-    // Spectrums from audio feed. They will be matched against the template.
-    std::list<AudioSpectrum> m_spectrums;
-    // Norm squares of each spectrum in `m_spectrums`.
-    std::list<float> m_spectrumNormSqrs;
     // How many spectrums needed to store.
     size_t m_numSpectrumsNeeded = 0;
 
+    // Spectrums from audio feed, after the same filtering as the template. They will be
+    // matched against the template.
+    // This is a ring buffer of `m_numSpectrumsNeeded` rows. Each row has the same layout
+    // and alignment as a template window.
+    AlignedVector<float> m_spectrums;
+    size_t m_spectrumStride = 0;
+    // Timestamp and norm square (= sum squares) of each row in `m_spectrums`.
+    std::vector<uint64_t> m_spectrumStamps;
+    std::vector<float> m_spectrumNormSqrs;
+    // Row of the newest spectrum and how many rows are filled.
+    size_t m_newestSlot = 0;
+    size_t m_numSpectrums = 0;
+
     size_t m_lastStampTested = SIZE_MAX;
     float m_lastScale = 0.0f;
 };
@@ -0,0 +1,63 @@
+/*  Spectrum Filter Bank
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <string.h>
+#include <tuple>
+#include "Common/Cpp/Containers/AlignedVector.tpp"
+#include "CommonFramework/AudioPipeline/AudioFeed.h"
+#include "SpectrumFilterBank.h"
+
+namespace PokemonAutomation{
+
+
+
+bool SpectrumFilterBank::FilterKey::operator<(const FilterKey& x) const{
+    return std::tie(mode, sample_rate, original_frequencies, freq_start, freq_end)
+         < std::tie(x.mode, x.sample_rate, x.original_frequencies, x.freq_start, x.freq_end);
+}
+
+
+bool SpectrumFilterBank::lookup(const FilterKey& key, const AudioSpectrum& spectrum, FilteredSpectrum& result) const{
+    ReadSpinLock lg(m_lock, PA_CURRENT_FUNCTION);
+    auto iter = m_filters.find(key);
+    if (iter == m_filters.end()){
+        return false;
+    }
+
+    //  Stamps restart when the audio source changes. So match on the
+    //  magnitudes object itself rather than the stamp.
+    const FilteredSpectrum& entry = iter->second[spectrum.stamp % HISTORY];
+    if (entry.source == nullptr || entry.source != spectrum.magnitudes){
+        return false;
+    }
+    result = entry;
+    return true;
+}
+void SpectrumFilterBank::publish(
+    const FilterKey& key, const AudioSpectrum& spectrum,
+    const float* filtered, size_t length, float norm_sqr
+){
+    std::shared_ptr<AlignedVector<float>> copy = std::make_shared<AlignedVector<float>>(length);
+    memcpy(copy->data(), filtered, length * sizeof(float));
+
+    WriteSpinLock lg(m_lock, PA_CURRENT_FUNCTION);
+    std::vector<FilteredSpectrum>& history = m_filters[key];
+    if (history.empty()){
+        history.resize(HISTORY);
+    }
+    FilteredSpectrum& entry = history[spectrum.stamp % HISTORY];
+    entry.source = spectrum.magnitudes;
+    entry.filtered = std::move(copy);
+    entry.norm_sqr = norm_sqr;
+}
+void SpectrumFilterBank::clear(){
+    WriteSpinLock lg(m_lock, PA_CURRENT_FUNCTION);
+    m_filters.clear();
+}
+
+
+
+}
@@ -0,0 +1,84 @@
+/*  Spectrum Filter Bank
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Shares the per-spectrum filtering of SpectrogramMatcher between all the
+ *  audio detectors that run on the same audio feed.
+ *
+ *  Every SpectrogramMatcher filters each incoming spectrum (spike convolution,
+ *  5-frequency averaging or just a frequency range) and computes its norm
+ *  before it can match it. Detectors that use the same filter would all redo
+ *  that work on the same spectrum. With a bank attached, the first matcher to
+ *  see a spectrum publishes the result and the others copy it.
+ *
+ *  AudioInferencePivot owns one of these and hands it to every callback that
+ *  is added to it.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonTools_SpectrumFilterBank_H
+#define PokemonAutomation_CommonTools_SpectrumFilterBank_H
+
+#include <stdint.h>
+#include <memory>
+#include <vector>
+#include <map>
+#include "Common/Cpp/Containers/AlignedVector.h"
+#include "Common/Cpp/Concurrency/SpinLock.h"
+
+namespace PokemonAutomation{
+
+class AudioSpectrum;
+
+
+class SpectrumFilterBank{
+public:
+    //  Two matchers with the same key produce the same filtered spectrum from
+    //  the same input spectrum.
+    struct FilterKey{
+        size_t mode = 0;
+        size_t sample_rate = 0;
+        size_t original_frequencies = 0;
+        size_t freq_start = 0;
+        size_t freq_end = 0;
+
+        bool operator<(const FilterKey& x) const;
+    };
+
+    struct FilteredSpectrum{
+        //  The raw magnitudes this was computed from.
+        std::shared_ptr<const AlignedVector<float>> source;
+        std::shared_ptr<const AlignedVector<float>> filtered;
+        float norm_sqr = 0;
+    };
+
+public:
+    //  If "spectrum" has already been filtered with "key", copy it to "result"
+    //  and return true.
+    bool lookup(const FilterKey& key, const AudioSpectrum& spectrum, FilteredSpectrum& result) const;
+
+    //  Publish the first "length" floats of "filtered" as the result of
+    //  filtering "spectrum" with "key".
+    void publish(
+        const FilterKey& key, const AudioSpectrum& spectrum,
+        const float* filtered, size_t length, float norm_sqr
+    );
+
+    //  Drop everything that has been published.
+    void clear();
+
+
+private:
+    //  How many of the most recent spectrums to remember for each filter.
+    //  Callbacks on the same feed are rarely more than a few spectrums apart.
+    static constexpr size_t HISTORY = 64;
+
+    mutable SpinLock m_lock;
+    //  Indexed by stamp % HISTORY.
+    std::map<FilterKey, std::vector<FilteredSpectrum>> m_filters;
+};
+
+
+
+}
+#endif
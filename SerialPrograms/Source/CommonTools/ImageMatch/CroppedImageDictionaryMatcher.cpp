@@ -4,10 +4,11 @@
  *
  */
 
+#include <cmath>
 #include "Common/Cpp/Exceptions.h"
 #include "CommonFramework/StaticGlobals.h"
 #include "CommonFramework/Logging/Logger.h"
-#include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "CommonFramework/Tools/DebugDumper.h"
 #include "ImageCropper.h"
 //#include "ImageDiff.h"
@@ -78,14 +79,65 @@ ImageMatchResult CroppedImageDictionaryMatcher::match(
         }
     }
 
+    //  Each crop is resized to the template shape before matching. Do that
+    //  once per distinct template shape and share it between templates.
+    struct ScaledCrop{
+        ImageViewRGB32 original;
+        ImageRGB32 scaled;
+        ImageBlockSums sums;
+
+        ScaledCrop(const ImageViewRGB32& crop, size_t width, size_t height)
+            : original(crop)
+        {
+            if (crop && (crop.width() != width || crop.height() != height)){
+                scaled = crop.scale_to(width, height);
+            }
+            sums = ImageBlockSums(image());
+        }
+        ImageViewRGB32 image() const{
+            if (scaled){
+                return scaled;
+            }
+            return original;
+        }
+    };
+    std::map<std::pair<size_t, size_t>, std::vector<ScaledCrop>> scaled_crops;
+
+    //  (template, crop) pairs in the order they were previously compared.
+    std::vector<std::pair<const std::string*, const WeightedExactImageMatcher*>> templates;
+    std::vector<const ScaledCrop*> candidates;
+    std::vector<double> lower_bounds;
     for (const auto& item : m_database){
-        for (const ImageViewRGB32& crop : crops){
-            double alpha = item.second.diff(crop);
-            results.add(alpha, item.first);
-            results.clear_beyond_spread(alpha_spread);
+        const ImageRGB32& image_template = item.second.matcher.image_template();
+        std::vector<ScaledCrop>& scaled = scaled_crops[{image_template.width(), image_template.height()}];
+        if (scaled.empty()){
+            scaled.reserve(crops.size());
+            for (const ImageViewRGB32& crop : crops){
+                scaled.emplace_back(crop, image_template.width(), image_template.height());
+            }
+        }
+        for (const ScaledCrop& crop : scaled){
+            templates.emplace_back(&item.first, &item.second.matcher);
+            candidates.emplace_back(&crop);
+            lower_bounds.emplace_back(item.second.bound.diff_lower_bound(crop.sums));
         }
     }
 
+    std::vector<double> alphas = pruned_match(
+        candidates.size(), 1,
+        lower_bounds, alpha_spread,
+        [&](size_t c, size_t){
+            return templates[c].second->diff(candidates[c]->image());
+        }
+    );
+    for (size_t c = 0; c < candidates.size(); c++){
+        if (std::isinf(alphas[c])){
+            continue;
+        }
+        results.add(alphas[c], *templates[c].first);
+        results.clear_beyond_spread(alpha_spread);
+    }
+
 #if 0
     Color background;
     ImageViewRGB32 processed = cropped[0].image;
@@ -116,7 +168,7 @@ ImageMatchResult CroppedImageDictionaryMatcher::match(
         size_t count = 0;
         for (const auto& result : results.results){
             std::cout << "alpha=" << result.first << ", " << result.second << std::endl;
-            const auto& image_template = m_database.find(result.second)->second.image_template();
+            const auto& image_template = m_database.find(result.second)->second.matcher.image_template();
             dump_debug_image(global_logger_command_line(), "CommonFramework/CroppedImageDictionaryMatcher", "match_result_" + std::to_string(count) + "_" + result.second, image_template);
             ++count;
         }
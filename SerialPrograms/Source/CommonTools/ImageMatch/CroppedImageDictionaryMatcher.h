@@ -10,6 +10,7 @@
 #include <vector>
 #include "ImageMatchResult.h"
 #include "ExactImageMatcher.h"
+#include "ImageMatchPruning.h"
 
 namespace PokemonAutomation{
 namespace ImageMatch{
@@ -34,7 +35,7 @@ protected:
 
 private:
     WeightedExactImageMatcher::InverseStddevWeight m_weight;
-    std::map<std::string, WeightedExactImageMatcher> m_database;
+    std::map<std::string, DictionaryTemplate> m_database;
 };
 
 
@@ -7,7 +7,8 @@
 #include <cmath>
 #include <vector>
 #include "Common/Cpp/Exceptions.h"
-#include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+#include "CommonFramework/StaticGlobals.h"
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "CommonFramework/ImageTools/ImageBoxes.h"
 #include "CommonFramework/ImageTools/ImageDiff.h"
 #include "ExactImageDictionaryMatcher.h"
@@ -126,6 +127,44 @@ double ExactImageDictionaryMatcher::compare(
     return best;
 }
 
+void ExactImageDictionaryMatcher::match_candidates(
+    ImageMatchResult& results,
+    const std::vector<const TemplateEntry*>& candidates,
+    const std::vector<ImageRGB32>& images,
+    double alpha_spread
+){
+    std::vector<ImageBlockSums> sums;
+    sums.reserve(images.size());
+    for (const ImageRGB32& image : images){
+        sums.emplace_back(image);
+    }
+
+    std::vector<double> lower_bounds;
+    lower_bounds.reserve(candidates.size() * images.size());
+    for (const TemplateEntry* item : candidates){
+        for (const ImageBlockSums& image : sums){
+            lower_bounds.emplace_back(item->second.bound.diff_lower_bound(image));
+        }
+    }
+
+    std::vector<double> alphas = pruned_match(
+        candidates.size(), images.size(),
+        lower_bounds, alpha_spread,
+        [&](size_t c, size_t s){
+            return candidates[c]->second.matcher.diff(images[s]);
+        }
+    );
+
+    //  Add in dictionary order so that ties come out the same as before.
+    for (size_t c = 0; c < candidates.size(); c++){
+        if (std::isinf(alphas[c])){
+            continue;
+        }
+        results.add(alphas[c], candidates[c]->first);
+        results.clear_beyond_spread(alpha_spread);
+    }
+}
+
 ImageMatchResult ExactImageDictionaryMatcher::match(
     const ImageViewRGB32& image, const ImageFloatBox& box,
     size_t tolerance,
@@ -138,14 +177,13 @@ ImageMatchResult ExactImageDictionaryMatcher::match(
 
     // Translate the input image area a bit to careate matching candidates.
     std::vector<ImageRGB32> image_set = make_image_set(image, box, m_width, m_height, tolerance);
+
+    std::vector<const TemplateEntry*> candidates;
+    candidates.reserve(m_database.size());
     for (const auto& item : m_database){
-//        if (item.first != "linoone-galar"){
-//            continue;
-//        }
-        double alpha = compare(item.second, image_set);
-        results.add(alpha, item.first);
-        results.clear_beyond_spread(alpha_spread);
+        candidates.emplace_back(&item);
     }
+    match_candidates(results, candidates, image_set, alpha_spread);
 
     return results;
 }
@@ -163,12 +201,17 @@ ImageMatchResult ExactImageDictionaryMatcher::subset_match(
 
     // Translate the input image area a bit to careate matching candidates.
     std::vector<ImageRGB32> image_set = make_image_set(image, box,  m_width, m_height, tolerance);
+
+    std::vector<const TemplateEntry*> candidates;
+    candidates.reserve(subset.size());
     for (const auto& slug : subset){
-        const auto& matcher = image_matcher(slug);
-        double alpha = compare(matcher, image_set);
-        results.add(alpha, slug);
-        results.clear_beyond_spread(alpha_spread);
+        auto it = m_database.find(slug);
+        if (it == m_database.end()){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Unknown slug: " + slug);
+        }
+        candidates.emplace_back(&*it);
     }
+    match_candidates(results, candidates, image_set, alpha_spread);
 
     return results;
 }
@@ -179,7 +222,7 @@ ImageViewRGB32 ExactImageDictionaryMatcher::image_template(const std::string& sl
         throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Unknown slug: " + slug);
     }
 
-    return it->second.image_template();
+    return it->second.matcher.image_template();
 }
 
 const WeightedExactImageMatcher& ExactImageDictionaryMatcher::image_matcher(const std::string& slug) const{
@@ -188,9 +231,11 @@ const WeightedExactImageMatcher& ExactImageDictionaryMatcher::image_matcher(cons
         throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Unknown slug: " + slug);
     }
 
-    return it->second;
+    return it->second.matcher;
 }
 
 
+
+
 }
 }
@@ -13,6 +13,7 @@
 #include "CommonFramework/Logging/Logger.h"
 #include "ImageMatchResult.h"
 #include "ExactImageMatcher.h"
+#include "ImageMatchPruning.h"
 
 namespace PokemonAutomation{
     class ImageViewRGB32;
@@ -66,11 +67,23 @@ public:
 
 
 private:
+    using TemplateEntry = std::pair<const std::string, DictionaryTemplate>;
+
     static double compare(
         const WeightedExactImageMatcher& sprite,
         const std::vector<ImageRGB32>& images
     );
 
+    // Match `images` against `candidates`. Templates whose lower bound is already worse than
+    // the best match + `alpha_spread` are skipped. This gives the same result as comparing
+    // against every template.
+    static void match_candidates(
+        ImageMatchResult& results,
+        const std::vector<const TemplateEntry*>& candidates,
+        const std::vector<ImageRGB32>& images,
+        double alpha_spread
+    );
+
 
 private:
     WeightedExactImageMatcher::InverseStddevWeight m_weight;
@@ -79,11 +92,23 @@ private:
 //    QSize m_dimensions;
     size_t m_width = 0;
     size_t m_height = 0;
-    std::map<std::string, WeightedExactImageMatcher> m_database;
+    std::map<std::string, DictionaryTemplate> m_database;
 };
 
 
 
+// Generate candidate images to be matched against by translating the input image area
+// (`box` on `screen`) around. The candidates are scaled to `width` x `height`.
+// See ExactImageDictionaryMatcher::match() for `tolerance`.
+std::vector<ImageRGB32> make_image_set(
+    const ImageViewRGB32& screen,
+    const ImageFloatBox& box,
+    size_t width, size_t height,
+    size_t tolerance
+);
+
+
+
 }
 }
 #endif
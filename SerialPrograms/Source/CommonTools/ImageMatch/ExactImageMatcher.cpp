@@ -27,7 +27,15 @@ ExactImageMatcher::ExactImageMatcher(ImageRGB32 image)
 //    cout << m_stats.stddev.sum() << endl;
 }
 
-ImageRGB32 ExactImageMatcher::scale_template_brightness(const ImageViewRGB32& image) const{
+ImageViewRGB32 ExactImageMatcher::scale_to_template(const ImageViewRGB32& image, ImageRGB32& buffer) const{
+    //  Resizing to the same shape is a plain copy in every image backend.
+    if (image.width() == m_image.width() && image.height() == m_image.height()){
+        return image;
+    }
+    buffer = image.scale_to(m_image.width(), m_image.height());
+    return buffer;
+}
+FloatPixel ExactImageMatcher::template_brightness_scale(const ImageViewRGB32& image) const{
     FloatPixel image_brightness = pixel_average(image, m_image);
     FloatPixel scale = image_brightness / m_stats.average;
 
@@ -35,11 +43,7 @@ ImageRGB32 ExactImageMatcher::scale_template_brightness(const ImageViewRGB32& im
     if (std::isnan(scale.g)) scale.g = 1.0;
     if (std::isnan(scale.b)) scale.b = 1.0;
     scale.bound(0.85, 1.15);
-
-    ImageRGB32 ret = m_image.copy();
-    scale_brightness(ret, scale);
-//    ret.save("test.png");
-    return ret;
+    return scale;
 }
 
 
@@ -50,19 +54,17 @@ double ExactImageMatcher::rmsd(const ImageViewRGB32& image) const{
 
 //    image.save("test.png");
 
-//    cout << "ExactImageMatcher::rmsd(): image = " << image.width() << " x " << image.height() << endl;
-    ImageRGB32 scaled = image.scale_to(m_image.width(), m_image.height());
-//    cout << "ExactImageMatcher::rmsd(): scaled = " << scaled.width() << " x " << scaled.height() << endl;
-    ImageRGB32 reference = scale_template_brightness(scaled);
+    ImageRGB32 buffer;
+    ImageViewRGB32 scaled = scale_to_template(image, buffer);
+    FloatPixel scale = template_brightness_scale(scaled);
 
 #if 0
     static int c = 0;
     image.save("test-" + std::to_string(c) + "-image.png");
-    reference.save("test-" + std::to_string(c) + "-sprite.png");
     c++;
 #endif
 
-    double rmsd = pixel_RMSD(reference, scaled);
+    double rmsd = pixel_RMSD(m_image, scale, scaled);
 //    cout << "rmsd = " << rmsd << endl;
     return rmsd;
 }
@@ -70,25 +72,19 @@ double ExactImageMatcher::rmsd(const ImageViewRGB32& image, Color background) co
     if (!image){
         return 1000.;
     }
-    ImageRGB32 scaled = image.scale_to(m_image.width(), m_image.height());
-    ImageRGB32 reference = scale_template_brightness(scaled);
-
-#if 0
-    static int c = 0;
-    scaled.save("test-" + std::to_string(c) + "-image.png");
-    reference.save("test-" + std::to_string(c) + "-sprite.png");
-    c++;
-#endif
-
-    return pixel_RMSD(reference, scaled, background);
+    ImageRGB32 buffer;
+    ImageViewRGB32 scaled = scale_to_template(image, buffer);
+    FloatPixel scale = template_brightness_scale(scaled);
+    return pixel_RMSD(m_image, scale, scaled, background);
 }
 double ExactImageMatcher::rmsd_masked(const ImageViewRGB32& image) const{
     if (!image){
         return 1000.;
     }
-    ImageRGB32 scaled = image.scale_to(m_image.width(), m_image.height());
-    ImageRGB32 reference = scale_template_brightness(scaled);
-    return pixel_RMSD_masked(reference, scaled);
+    ImageRGB32 buffer;
+    ImageViewRGB32 scaled = scale_to_template(image, buffer);
+    FloatPixel scale = template_brightness_scale(scaled);
+    return pixel_RMSD_masked(m_image, scale, scaled);
 }
 
 
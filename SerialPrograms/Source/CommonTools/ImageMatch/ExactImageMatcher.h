@@ -53,9 +53,12 @@ public:
     const ImageRGB32& image_template() const { return m_image; }
 
 private:
-    // scale stored image template according to the brightness of `image`, assign
-    // the scaled template to `reference`.
-    ImageRGB32 scale_template_brightness(const ImageViewRGB32& image) const;
+    // Return `image` resized to the template shape. If it already has that shape, `image`
+    // itself is returned and `buffer` is untouched.
+    ImageViewRGB32 scale_to_template(const ImageViewRGB32& image, ImageRGB32& buffer) const;
+    // Return the per-channel multiplier that brings the template brightness to that of `image`.
+    // `image` must have the same shape as the template.
+    FloatPixel template_brightness_scale(const ImageViewRGB32& image) const;
 
 protected:
     ImageRGB32 m_image;
@@ -0,0 +1,116 @@
+/*  Image Match Pruning
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <cmath>
+#include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+#include "ExactImageMatcher.h"
+#include "ImageMatchPruning.h"
+
+namespace PokemonAutomation{
+namespace ImageMatch{
+
+
+
+ImageBlockSums::ImageBlockSums(const ImageViewRGB32& image)
+    : m_width(image.width())
+    , m_height(image.height())
+{
+    size_t blocks_x = (m_width + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    size_t blocks_y = (m_height + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    m_sums.resize(3 * blocks_x * blocks_y, 0);
+    for (size_t r = 0; r < m_height; r++){
+        uint32_t* row = &m_sums[3 * (r / BLOCK_SIZE) * blocks_x];
+        for (size_t c = 0; c < m_width; c++){
+            uint32_t pixel = image.pixel(c, r);
+            uint32_t* sums = row + 3 * (c / BLOCK_SIZE);
+            sums[0] += (pixel >> 16) & 0xff;
+            sums[1] += (pixel >>  8) & 0xff;
+            sums[2] += (pixel >>  0) & 0xff;
+        }
+    }
+}
+
+
+
+ExactImageMatchLowerBound::ExactImageMatchLowerBound(const WeightedExactImageMatcher& matcher)
+    : m_width(matcher.image_template().width())
+    , m_height(matcher.image_template().height())
+    , m_count(0)
+    , m_multiplier(matcher.m_multiplier)
+{
+    const ImageRGB32& image = matcher.image_template();
+    const size_t BLOCK_SIZE = ImageBlockSums::BLOCK_SIZE;
+    size_t blocks_x = (m_width + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    size_t blocks_y = (m_height + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+    for (size_t by = 0; by < blocks_y; by++){
+        size_t r_end = std::min(by * BLOCK_SIZE + BLOCK_SIZE, m_height);
+        for (size_t bx = 0; bx < blocks_x; bx++){
+            size_t c_end = std::min(bx * BLOCK_SIZE + BLOCK_SIZE, m_width);
+
+            Block block{};
+            block.index = (uint32_t)(by * blocks_x + bx);
+            bool opaque = true;
+            for (size_t r = by * BLOCK_SIZE; r < r_end; r++){
+                for (size_t c = bx * BLOCK_SIZE; c < c_end; c++){
+                    uint32_t pixel = image.pixel(c, r);
+
+                    //  Same alpha test as the RMSD kernels.
+                    if ((int32_t)pixel >= 0){
+                        opaque = false;
+                        continue;
+                    }
+                    m_count++;
+                    block.pixels++;
+
+                    //  Range of round(min(x * scale, 255)) for scale in [0.85, 1.15].
+                    for (size_t ch = 0; ch < 3; ch++){
+                        uint32_t x = (pixel >> (16 - 8 * ch)) & 0xff;
+                        block.lo[ch] += 85 * x / 100;
+                        block.hi[ch] += std::min<uint32_t>((115 * x + 99) / 100, 255);
+                    }
+                }
+            }
+            if (opaque){
+                m_blocks.emplace_back(block);
+            }
+        }
+    }
+}
+
+double ExactImageMatchLowerBound::diff_lower_bound(const ImageBlockSums& sums) const{
+    if (sums.width() != m_width || sums.height() != m_height){
+        return 0;
+    }
+    if (m_count == 0 || !(m_multiplier > 0)){
+        return 0;
+    }
+
+    //  Each term is rounded down so that the total stays an integer that is
+    //  no larger than the real sum of squares. The final expression matches
+    //  the one in pixel_RMSD() so the comparison is exact.
+    uint64_t sumsqrs = 0;
+    for (const Block& block : m_blocks){
+        const uint32_t* image = sums.block(block.index);
+        for (size_t ch = 0; ch < 3; ch++){
+            int64_t distance = 0;
+            if (image[ch] > block.hi[ch]){
+                distance = (int64_t)image[ch] - block.hi[ch];
+            }else if (image[ch] < block.lo[ch]){
+                distance = (int64_t)block.lo[ch] - image[ch];
+            }
+            sumsqrs += (uint64_t)(distance * distance) / block.pixels;
+        }
+    }
+
+    double rmsd = std::sqrt((double)sumsqrs / (double)m_count);
+    return rmsd * m_multiplier;
+}
+
+
+
+}
+}
@@ -0,0 +1,144 @@
+/*  Image Match Pruning
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Cheap lower bounds on WeightedExactImageMatcher::diff() used by the
+ *  dictionary matchers to skip templates that cannot end up within
+ *  "alpha_spread" of the best match.
+ *
+ *  The bound is built from 4x4 block sums. For every block where the template
+ *  is fully opaque, the brightness-scaled template (scale in [0.85, 1.15]) has
+ *  a block sum within [sum_lo, sum_hi]. If the image block sum falls outside
+ *  that range, the squared deviation over the block is at least
+ *  (distance)^2 / (pixels in block). Summing these over all blocks never
+ *  exceeds the real sum of squares, so pruning with it does not change any
+ *  match results.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonTools_ImageMatchPruning_H
+#define PokemonAutomation_CommonTools_ImageMatchPruning_H
+
+#include <stdint.h>
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include "ExactImageMatcher.h"
+
+namespace PokemonAutomation{
+namespace ImageMatch{
+
+
+//  Per-block RGB sums of an image that has the same dimensions as a template.
+class ImageBlockSums{
+public:
+    static constexpr size_t BLOCK_SIZE = 4;
+
+public:
+    ImageBlockSums() = default;
+    ImageBlockSums(const ImageViewRGB32& image);
+
+    size_t width() const{ return m_width; }
+    size_t height() const{ return m_height; }
+
+    const uint32_t* block(size_t index) const{ return &m_sums[3 * index]; }
+
+private:
+    size_t m_width = 0;
+    size_t m_height = 0;
+    std::vector<uint32_t> m_sums;
+};
+
+
+//  Precomputed at template add() time.
+class ExactImageMatchLowerBound{
+public:
+    ExactImageMatchLowerBound(const WeightedExactImageMatcher& matcher);
+
+    //  Returns a value that is never larger than "matcher.diff(image)" where
+    //  "image" is the image "sums" was computed from.
+    double diff_lower_bound(const ImageBlockSums& sums) const;
+
+private:
+    struct Block{
+        uint32_t index;
+        uint32_t pixels;
+        uint32_t lo[3];
+        uint32_t hi[3];
+    };
+
+    size_t m_width;
+    size_t m_height;
+    uint64_t m_count;
+    double m_multiplier;
+    std::vector<Block> m_blocks;
+};
+
+
+
+//  A dictionary entry: the matcher and its lower bound.
+struct DictionaryTemplate{
+    DictionaryTemplate(ImageRGB32 image, const WeightedExactImageMatcher::InverseStddevWeight& weight)
+        : matcher(std::move(image), weight)
+        , bound(matcher)
+    {}
+    WeightedExactImageMatcher matcher;
+    ExactImageMatchLowerBound bound;
+};
+
+
+
+//  Branch-and-bound over a list of candidates, each of which can be compared
+//  against several shifted versions of the input image.
+//
+//  "lower_bounds[c * shifts + s]" must never exceed "evaluate(c, s)".
+//
+//  Returns the alpha (min over shifts) of every candidate that was evaluated.
+//  Candidates that were skipped are set to infinity. Every candidate with alpha
+//  within "alpha_spread" of the best is guaranteed to have its exact alpha.
+//
+template <typename Evaluate>
+std::vector<double> pruned_match(
+    size_t candidates, size_t shifts,
+    const std::vector<double>& lower_bounds,
+    double alpha_spread,
+    Evaluate&& evaluate
+){
+    const double INF = std::numeric_limits<double>::infinity();
+
+    std::vector<std::pair<double, size_t>> order;
+    order.reserve(candidates);
+    for (size_t c = 0; c < candidates; c++){
+        const double* bounds = lower_bounds.data() + c * shifts;
+        double bound = shifts == 0 ? 0 : *std::min_element(bounds, bounds + shifts);
+        order.emplace_back(bound, c);
+    }
+    std::sort(order.begin(), order.end());
+
+    std::vector<double> alphas(candidates, INF);
+    double best = INF;
+    for (const auto& item : order){
+        double cutoff = best + alpha_spread;
+        if (item.first > cutoff){
+            break;
+        }
+        size_t c = item.second;
+        const double* bounds = lower_bounds.data() + c * shifts;
+        double alpha = 10000;
+        for (size_t s = 0; s < shifts; s++){
+            if (bounds[s] > cutoff){
+                continue;
+            }
+            alpha = std::min(alpha, evaluate(c, s));
+        }
+        alphas[c] = alpha;
+        best = std::min(best, alpha);
+    }
+    return alphas;
+}
+
+
+
+}
+}
+#endif
@@ -0,0 +1,241 @@
+/*  Image Match Tests
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <set>
+#include <map>
+#include <random>
+#include "CommonFramework/GlobalAutoPaths.h"
+#include "CommonFramework/ImageTypes/ImageRGB32.h"
+#include "CommonFramework/ImageTools/ImageBoxes.h"
+#include "Common/Cpp/TestRunners/UnitTestDatabase.h"
+#include "ImageCropper.h"
+#include "ExactImageDictionaryMatcher.h"
+#include "CroppedImageDictionaryMatcher.h"
+#include "ImageMatch_Tests.h"
+
+namespace PokemonAutomation{
+namespace ImageMatch{
+
+
+
+void add_tests(UnitTestDatabase& database){
+    add_tests_exact_dictionary_pruning(database);
+    add_tests_cropped_dictionary_pruning(database);
+}
+
+
+//  Cut a template out of the screenshot with transparent corners so that some
+//  blocks are not fully opaque.
+static ImageRGB32 make_template(const ImageViewRGB32& image, const ImagePixelBox& box, size_t width, size_t height){
+    ImageRGB32 sprite = extract_box_reference(image, box).scale_to(width, height);
+    for (size_t r = 0; r < height; r++){
+        for (size_t x = 0; x < width; x++){
+            if (r + x < 6 || (height - 1 - r) + (width - 1 - x) < 6){
+                sprite.pixel(x, r) &= 0x00ffffff;
+            }
+        }
+    }
+    return sprite;
+}
+
+static std::string compare_results(const ImageMatchResult& actual, const ImageMatchResult& expected){
+    if (actual.results == expected.results){
+        return "";
+    }
+    return "Pruned match differs from the full search.";
+}
+
+
+
+//  Build a dictionary out of patches of a screenshot, then match boxes all over
+//  the screenshot. The results must be the same as comparing every template
+//  against every translated image.
+class Test_ExactDictionaryPruning : public UnitTest{
+public:
+    Test_ExactDictionaryPruning(const std::string& image)
+        : UnitTest("ImageMatch::ExactDictionaryPruning - " + image)
+        , m_image(UNIT_TEST_RESOURCE_PATH() + image)
+    {}
+
+    virtual UnitTestResult run(Logger& logger, CancellableScope& scope) const override{
+        const size_t WIDTH = 40;
+        const size_t HEIGHT = 30;
+        const size_t TOLERANCE = 2;
+        const double ALPHA_SPREAD = 0.1;
+
+        ImageRGB32 image(m_image);
+        if (image.width() < 4 * WIDTH || image.height() < 4 * HEIGHT){
+            return "Error: image is too small.";
+        }
+
+        std::mt19937 rng(0);
+        auto random_box = [&]{
+            size_t x = rng() % (image.width() - 2 * WIDTH);
+            size_t y = rng() % (image.height() - 2 * HEIGHT);
+            return ImagePixelBox(x, y, x + 2 * WIDTH, y + 2 * HEIGHT);
+        };
+
+        ExactImageDictionaryMatcher matcher({1, 256});
+        std::vector<ImagePixelBox> sources;
+        std::set<std::string> slugs;
+        std::vector<std::string> subset;
+        for (size_t c = 0; c < 50; c++){
+            sources.emplace_back(random_box());
+            std::string slug = "patch-" + std::to_string(c);
+            slugs.insert(slug);
+            if (c % 3 == 0){
+                subset.emplace_back(slug);
+            }
+            matcher.add(slug, make_template(image, sources.back(), WIDTH, HEIGHT));
+        }
+
+        for (size_t c = 0; c < 40; c++){
+            //  Half the boxes sit near a template source, the rest anywhere.
+            ImagePixelBox box = c % 2 == 0 ? sources[c] : random_box();
+            if (c % 2 == 0 && box.min_x > 0){
+                box.min_x--;
+                box.max_x--;
+            }
+            ImageFloatBox float_box = pixelbox_to_floatbox(image, box);
+            std::vector<ImageRGB32> image_set = make_image_set(image, float_box, WIDTH, HEIGHT, TOLERANCE);
+
+            auto full_search = [&](auto& candidates){
+                ImageMatchResult ret;
+                for (const std::string& slug : candidates){
+                    double alpha = 10000;
+                    for (const ImageRGB32& translated : image_set){
+                        alpha = std::min(alpha, matcher.image_matcher(slug).diff(translated));
+                    }
+                    ret.add(alpha, slug);
+                    ret.clear_beyond_spread(ALPHA_SPREAD);
+                }
+                return ret;
+            };
+
+            std::string error = compare_results(
+                matcher.match(image, float_box, TOLERANCE, ALPHA_SPREAD),
+                full_search(slugs)
+            );
+            if (error.empty()){
+                error = compare_results(
+                    matcher.subset_match(subset, image, float_box, TOLERANCE, ALPHA_SPREAD),
+                    full_search(subset)
+                );
+            }
+            if (!error.empty()){
+                return error + " Box: " + std::to_string(c);
+            }
+        }
+
+        return true;
+    }
+
+private:
+    std::string m_image;
+};
+
+void add_tests_exact_dictionary_pruning(UnitTestDatabase& database){
+    database.add<Test_ExactDictionaryPruning>("CommonFramework/BlackBorderDetector/Dark_SV_Crystal_False.png");
+    database.add<Test_ExactDictionaryPruning>("PokemonSV/SandwichIngredientReader/Condiments_eng_9.png");
+    database.add<Test_ExactDictionaryPruning>("PokemonSV/SandwichIngredientReader/Fillings_fra_0.png");
+}
+
+
+
+//  Same as above for CroppedImageDictionaryMatcher, with templates of different
+//  shapes and a fixed list of crops instead of a cropper.
+class Test_CroppedDictionaryPruning : public UnitTest{
+public:
+    Test_CroppedDictionaryPruning(const std::string& image)
+        : UnitTest("ImageMatch::CroppedDictionaryPruning - " + image)
+        , m_image(UNIT_TEST_RESOURCE_PATH() + image)
+    {}
+
+    virtual UnitTestResult run(Logger& logger, CancellableScope& scope) const override{
+        const size_t SHAPES[][2] = {{40, 30}, {24, 36}, {32, 32}};
+        const double ALPHA_SPREAD = 0.1;
+        const WeightedExactImageMatcher::InverseStddevWeight WEIGHT{1, 64};
+
+        ImageRGB32 image(m_image);
+        if (image.width() < 160 || image.height() < 160){
+            return "Error: image is too small.";
+        }
+
+        std::mt19937 rng(0);
+        auto random_box = [&]{
+            size_t width = 40 + rng() % 40;
+            size_t height = 40 + rng() % 40;
+            size_t x = rng() % (image.width() - width);
+            size_t y = rng() % (image.height() - height);
+            return ImagePixelBox(x, y, x + width, y + height);
+        };
+
+        FixedCrops matcher(WEIGHT);
+        std::vector<ImagePixelBox> sources;
+        std::map<std::string, WeightedExactImageMatcher> templates;
+        for (size_t c = 0; c < 30; c++){
+            sources.emplace_back(random_box());
+            const size_t* shape = SHAPES[c % 3];
+            ImageRGB32 sprite = make_template(image, sources.back(), shape[0], shape[1]);
+            std::string slug = "patch-" + std::to_string(c);
+            templates.emplace(
+                std::piecewise_construct,
+                std::forward_as_tuple(slug),
+                std::forward_as_tuple(trim_image_alpha(sprite).copy(), WEIGHT)
+            );
+            matcher.add(slug, sprite);
+        }
+
+        for (size_t c = 0; c < 20; c++){
+            //  A few crops per match, some of them on a template source.
+            matcher.crops.clear();
+            for (size_t i = 0; i < 3; i++){
+                ImagePixelBox box = i == 0 && c % 2 == 0 ? sources[c] : random_box();
+                matcher.crops.emplace_back(extract_box_reference(image, box));
+            }
+
+            ImageMatchResult expected;
+            for (const auto& item : templates){
+                for (const ImageViewRGB32& crop : matcher.crops){
+                    expected.add(item.second.diff(crop), item.first);
+                    expected.clear_beyond_spread(ALPHA_SPREAD);
+                }
+            }
+
+            std::string error = compare_results(matcher.match(image, ALPHA_SPREAD), expected);
+            if (!error.empty()){
+                return error + " Match: " + std::to_string(c);
+            }
+        }
+
+        return true;
+    }
+
+private:
+    class FixedCrops : public CroppedImageDictionaryMatcher{
+    public:
+        using CroppedImageDictionaryMatcher::CroppedImageDictionaryMatcher;
+
+        std::vector<ImageViewRGB32> crops;
+
+    protected:
+        virtual std::vector<ImageViewRGB32> get_crop_candidates(const ImageViewRGB32& image) const override{
+            return crops;
+        }
+    };
+
+    std::string m_image;
+};
+
+void add_tests_cropped_dictionary_pruning(UnitTestDatabase& database){
+    database.add<Test_CroppedDictionaryPruning>("CommonFramework/BlackBorderDetector/Dark_SV_Crystal_False.png");
+    database.add<Test_CroppedDictionaryPruning>("PokemonSV/SandwichIngredientReader/Fillings_fra_0.png");
+}
+
+
+
+}
+}
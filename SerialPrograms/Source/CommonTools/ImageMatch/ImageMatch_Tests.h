@@ -0,0 +1,26 @@
+/*  Image Match Tests
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifndef PokemonAutomation_CommonTools_ImageMatch_Tests_H
+#define PokemonAutomation_CommonTools_ImageMatch_Tests_H
+
+#include "Common/Cpp/TestRunners/UnitTest.h"
+
+namespace PokemonAutomation{
+namespace ImageMatch{
+
+
+
+void add_tests(UnitTestDatabase& database);
+
+void add_tests_exact_dictionary_pruning(UnitTestDatabase& database);
+void add_tests_cropped_dictionary_pruning(UnitTestDatabase& database);
+
+
+
+}
+}
+#endif
@@ -9,6 +9,7 @@
 #include "Kernels/ImageFilters/RGB32_Range/Kernels_ImageFilter_RGB32_Range.h"
 #include "Kernels/ImageFilters/RGB32_EuclideanDistance/Kernels_ImageFilter_RGB32_Euclidean.h"
 #include "Kernels/ImageFilters/RGB32_Brightness/Kernels_ImageFilter_RGB32_Brightness.h"
+#include "Kernels/ImageFilters/RGB32_HSV/Kernels_ImageFilter_RGB32_HSV.h"
 #include "CommonFramework/ImageTypes/ImageViewHSV32.h"
 #include "CommonFramework/ImageTypes/ImageHSV32.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
@@ -235,4 +236,34 @@ ImageRGB32 to_blackwhite_hsv32_range(
     return ret;
 }
 
+ImageRGB32 filter_rgb32_hsv_range(
+    size_t& pixels_in_range,
+    const ImageViewRGB32& image,
+    uint32_t mins, uint32_t maxs, Color replace_with, bool replace_color_within_range
+){
+    ImageRGB32 ret(image.width(), image.height());
+    pixels_in_range = Kernels::filter_rgb32_hsv_range(
+        image.data(), image.bytes_per_row(), image.width(), image.height(),
+        ret.data(), ret.bytes_per_row(),
+        (uint32_t)replace_with, replace_color_within_range,
+        mins, maxs
+    );
+    return ret;
+}
+ImageRGB32 to_blackwhite_rgb32_hsv_range(
+    size_t& pixels_in_range,
+    const ImageViewRGB32& image,
+    bool in_range_black,
+    uint32_t mins, uint32_t maxs
+){
+    ImageRGB32 ret(image.width(), image.height());
+    pixels_in_range = Kernels::to_blackwhite_rgb32_hsv_range(
+        image.data(), image.bytes_per_row(), image.width(), image.height(),
+        ret.data(), ret.bytes_per_row(),
+        in_range_black,
+        mins, maxs
+    );
+    return ret;
+}
+
 }
@@ -176,5 +176,26 @@ ImageRGB32 to_blackwhite_hsv32_range(
 );
 
 
+//  Same as "filter_rgb32_range()", but [mins, maxs] is an HSV32 range.
+//  The conversion to HSV is done on the fly. So this is much cheaper than
+//  building an ImageHSV32 when the HSV image isn't needed afterwards.
+//  Returns the # of pixels inside the range [mins, maxs] as `pixels_in_range`.
+ImageRGB32 filter_rgb32_hsv_range(
+    size_t& pixels_in_range,
+    const ImageViewRGB32& image,
+    uint32_t mins, uint32_t maxs,
+    Color replacement_color, bool replace_color_within_range
+);
+
+//  Same as "to_blackwhite_hsv32_range()", but takes the RGB image directly.
+//  Returns the # of pixels inside the range [mins, maxs] as `pixels_in_range`.
+ImageRGB32 to_blackwhite_rgb32_hsv_range(
+    size_t& pixels_in_range,
+    const ImageViewRGB32& image,
+    bool in_range_black,
+    uint32_t mins, uint32_t maxs
+);
+
+
 }
 #endif
@@ -15,6 +15,7 @@ namespace PokemonAutomation{
 
 class AudioSpectrum;
 class AudioFeed;
+class SpectrumFilterBank;
 
 //  Base class for an audio inference object to be called perioridically by
 //  inference routines in InferenceRoutines.h.
@@ -33,6 +34,11 @@ public:
         AudioFeed& audio_feed
     ) = 0;
 
+    //  Called by AudioInferencePivot when this callback is added to it (and
+    //  with nullptr when it is removed). Callbacks that filter spectrums can
+    //  use "bank" to share that work with other callbacks on the same feed.
+    virtual void set_spectrum_filter_bank(SpectrumFilterBank* bank){}
+
 };
 
 
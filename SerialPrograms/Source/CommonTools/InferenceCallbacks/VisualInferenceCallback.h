@@ -8,7 +8,9 @@
 #define PokemonAutomation_CommonTools_VisualInferenceCallback_H
 
 #include <string>
+#include <vector>
 #include "Common/Cpp/Time.h"
+#include "CommonFramework/ImageTools/ImageBoxes.h"
 #include "InferenceCallback.h"
 
 namespace PokemonAutomation{
@@ -40,6 +42,25 @@ public:
     //  The base class's implementation throws `InternalProgramError`.
     virtual bool process_frame(const ImageViewRGB32& frame, WallClock timestamp);
 
+
+public:
+    //  Optional: Skip frames that didn't change.
+    //
+    //  Return the boxes that process_frame() looks at. If this is not empty,
+    //  the inference pivot will call process_unchanged_frame() instead of
+    //  process_frame() when none of the pixels in these boxes changed since
+    //  the last time process_frame() was called.
+    //
+    //  Only opt in if process_frame() depends on nothing else in the frame.
+    //  The boxes are read once when the callback is added to the pivot.
+    virtual std::vector<ImageFloatBox> change_detection_boxes() const{ return {}; }
+
+    //  Return true if the inference session should stop.
+    //  The default returns false. That is correct if process_frame() only
+    //  depends on the pixels since it would have returned false again.
+    //  Override this if process_frame() also depends on time.
+    virtual bool process_unchanged_frame(const VideoSnapshot& frame){ return false; }
+
 };
 
 
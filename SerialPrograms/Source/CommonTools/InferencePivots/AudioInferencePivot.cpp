@@ -26,6 +26,9 @@ struct AudioInferencePivot::PeriodicCallback{
 
     uint64_t last_seqnum = ~(uint64_t)0;
 
+    //  Reused on every run so that polling doesn't allocate.
+    std::vector<AudioSpectrum> spectrums;
+
     StatAccumulatorI32 stats;
 
     PeriodicCallback(
@@ -45,7 +48,9 @@ struct AudioInferencePivot::PeriodicCallback{
 
 
 AudioInferencePivot::AudioInferencePivot(CancellableScope& scope, AudioFeed& feed)
-    : BusyPeriodicRunner(GlobalThreadPools::unlimited_pivot())
+    //  Run the callbacks that are due together so that the ones that share
+    //  a spectrum filter run back-to-back on the same spectrums.
+    : BusyPeriodicRunner(GlobalThreadPools::unlimited_pivot(), true)
     , m_feed(feed)
 {
     attach(scope);
@@ -71,9 +76,11 @@ void AudioInferencePivot::add_callback(
         std::forward_as_tuple(&callback),
         std::forward_as_tuple(scope, set_when_triggered, callback, period, start_time)
     ).first;
+    callback.set_spectrum_filter_bank(&m_filter_bank);
     try{
         BusyPeriodicRunner::add_event(&iter->second, period);
     }catch (...){
+        callback.set_spectrum_filter_bank(nullptr);
         m_map.erase(iter);
         throw;
     }
@@ -86,22 +93,23 @@ StatAccumulatorI32 AudioInferencePivot::remove_callback(AudioInferenceCallback&
     }
     StatAccumulatorI32 stats = iter->second.stats;
     BusyPeriodicRunner::remove_event(&iter->second);
+    callback.set_spectrum_filter_bank(nullptr);
     m_map.erase(iter);
     return stats;
 }
 void AudioInferencePivot::run(void* event, bool is_back_to_back) noexcept{
     PeriodicCallback& callback = *(PeriodicCallback*)event;
     try{
-        std::vector<AudioSpectrum> spectrums;
+        std::vector<AudioSpectrum>& spectrums = callback.spectrums;
 
         if (callback.last_seqnum == ~(uint64_t)0){
 //            cout << "m_last_timestamp == SIZE_MAX" << endl;
-            spectrums = m_feed.spectrums_latest(1);
+            m_feed.read_spectrums_latest(spectrums, 1);
         }else{
 //            cout << "(m_last_timestamp != SIZE_MAX" << endl;
             //  Note: in this file we never consider the case that stamp may overflow.
             //  It requires on the order of 1e10 years to overflow if we have about 25ms per stamp.
-            spectrums = m_feed.spectrums_since(callback.last_seqnum + 1);
+            m_feed.read_spectrums_since(spectrums, callback.last_seqnum + 1);
         }
         if (spectrums.size() > 0){
             //  spectrums[0] has the newest spectrum with the largest stamp:
@@ -111,6 +119,10 @@ void AudioInferencePivot::run(void* event, bool is_back_to_back) noexcept{
         WallClock time0 = current_time();
         bool stop = callback.callback.process_spectrums(spectrums, m_feed);
         WallClock time1 = current_time();
+
+        //  Don't hold onto the spectrums until the next run.
+        spectrums.clear();
+
         callback.stats += (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count();
         if (stop){
             if (callback.set_when_triggered){
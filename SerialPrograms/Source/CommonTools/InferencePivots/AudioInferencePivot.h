@@ -12,6 +12,7 @@
 #include "CommonFramework/Tools/StatAccumulator.h"
 #include "CommonFramework/VideoPipeline/VideoOverlayTypes.h"
 #include "CommonTools/InferenceCallbacks/AudioInferenceCallback.h"
+#include "CommonTools/Audio/SpectrumFilterBank.h"
 
 namespace PokemonAutomation{
 
@@ -50,6 +51,9 @@ private:
     SpinLock m_lock;
     std::map<AudioInferenceCallback*, PeriodicCallback> m_map;
 
+    //  Filtered spectrums shared by all the callbacks.
+    SpectrumFilterBank m_filter_bank;
+
 //    uint64_t m_last_seqnum = ~(uint64_t)0;
 
     OverlayStatUtilizationPrinter m_printer;
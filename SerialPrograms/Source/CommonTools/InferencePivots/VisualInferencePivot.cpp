@@ -4,8 +4,13 @@
  *
  */
 
+#include <random>
+#include <thread>
 #include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/PrettyPrint.h"
+#include "Common/Cpp/TestRunners/UnitTestDatabase.h"
 #include "CommonFramework/Tools/GlobalThreadPools.h"
+#include "CommonFramework/Options/Environment/PerformanceOptions.h"
 #include "CommonFramework/VideoPipeline/VideoFeed.h"
 #include "VisualInferencePivot.h"
 
@@ -25,25 +30,65 @@ struct VisualInferencePivot::PeriodicCallback{
     WallClock last_timestamp;
     StatAccumulatorI32 stats;
 
+    //  From VisualInferenceCallback::change_detection_boxes().
+    std::vector<ImageFloatBox> change_detection_boxes;
+    //  Tile hashes of the last frame that process_frame() was called on.
+    std::shared_ptr<const ImageTileHashes> last_processed;
+
     PeriodicCallback(
         Cancellable& p_scope,
         std::atomic<InferenceCallback*>* p_set_when_triggered,
         VisualInferenceCallback& p_callback,
         std::chrono::milliseconds p_period,
-        WallClock p_start_time
+        WallClock p_start_time,
+        std::vector<ImageFloatBox> p_change_detection_boxes
     )
         : scope(p_scope)
         , set_when_triggered(p_set_when_triggered)
         , callback(p_callback)
         , period(p_period)
         , last_timestamp(p_start_time)
+        , change_detection_boxes(std::move(p_change_detection_boxes))
     {}
 };
 
 
 
+OverlayStatSnapshot UnchangedFrameStat::get_current(){
+    WallClock now = current_time();
+
+    WriteSpinLock lg(m_lock);
+
+    //  Average over a second. The overlay polls a lot faster than that.
+    if (m_last_update != WallClock::min() && now - m_last_update < std::chrono::seconds(1)){
+        return m_current;
+    }
+    m_last_update = now;
+
+    uint64_t checked = m_checked.load(std::memory_order_relaxed);
+    uint64_t unchanged = m_unchanged.load(std::memory_order_relaxed);
+    uint64_t delta_checked = checked - m_last_checked;
+    uint64_t delta_unchanged = unchanged - m_last_unchanged;
+    m_last_checked = checked;
+    m_last_unchanged = unchanged;
+
+    if (delta_checked == 0){
+        m_current = OverlayStatSnapshot();
+    }else{
+        m_current = OverlayStatSnapshot{
+            "Unchanged Frames: " + tostr_fixed((double)delta_unchanged / delta_checked * 100, 2) + " %"
+        };
+    }
+    return m_current;
+}
+
+
+
 VisualInferencePivot::VisualInferencePivot(CancellableScope& scope, VideoFeed& feed)
-    : BusyPeriodicRunner(GlobalThreadPools::unlimited_pivot())
+    : VisualInferencePivot(scope, feed, PerformanceOptions::instance().PARALLEL_VISUAL_INFERENCE)
+{}
+VisualInferencePivot::VisualInferencePivot(CancellableScope& scope, VideoFeed& feed, bool parallel)
+    : BusyPeriodicRunner(GlobalThreadPools::unlimited_pivot(), parallel)
     , m_feed(feed)
 {
     attach(scope);
@@ -59,6 +104,8 @@ void VisualInferencePivot::add_callback(
     std::chrono::milliseconds period,
     WallClock start_time
 ){
+    std::vector<ImageFloatBox> boxes = callback.change_detection_boxes();
+
     WriteSpinLock lg(m_lock, PA_CURRENT_FUNCTION);
     auto iter = m_map.find(&callback);
     if (iter != m_map.end()){
@@ -67,7 +114,7 @@ void VisualInferencePivot::add_callback(
     iter = m_map.emplace(
         std::piecewise_construct,
         std::forward_as_tuple(&callback),
-        std::forward_as_tuple(scope, set_when_triggered, callback, period, start_time)
+        std::forward_as_tuple(scope, set_when_triggered, callback, period, start_time, std::move(boxes))
     ).first;
     try{
         BusyPeriodicRunner::add_event(&iter->second, period);
@@ -77,33 +124,128 @@ void VisualInferencePivot::add_callback(
     }
 }
 StatAccumulatorI32 VisualInferencePivot::remove_callback(VisualInferenceCallback& callback){
-    WriteSpinLock lg(m_lock, PA_CURRENT_FUNCTION);
-    auto iter = m_map.find(&callback);
-    if (iter == m_map.end()){
-        return StatAccumulatorI32();
+    PeriodicCallback* event;
+    {
+        WriteSpinLock lg(m_lock, PA_CURRENT_FUNCTION);
+        auto iter = m_map.find(&callback);
+        if (iter == m_map.end()){
+            return StatAccumulatorI32();
+        }
+        event = &iter->second;
     }
-    StatAccumulatorI32 stats = iter->second.stats;
-    BusyPeriodicRunner::remove_event(&iter->second);
-    m_map.erase(iter);
+
+    //  This waits for the batch if the callback is running in one. Don't
+    //  hold the spin lock for that.
+    BusyPeriodicRunner::remove_event(event);
+
+    WriteSpinLock lg(m_lock, PA_CURRENT_FUNCTION);
+    StatAccumulatorI32 stats = event->stats;
+    m_map.erase(&callback);
     return stats;
 }
 void VisualInferencePivot::run(void* event, bool is_back_to_back) noexcept{
     PeriodicCallback& callback = *(PeriodicCallback*)event;
     try{
-        //  Reuse the cached screenshot.
-        if (!is_back_to_back || callback.last_timestamp == m_last.timestamp){
+        //  Reuse the cached screenshot unless this callback has already seen
+        //  it or something newer.
+        if (!is_back_to_back || callback.last_timestamp >= m_last.timestamp){
             m_last = m_feed.snapshot_recent_nonblocking(callback.last_timestamp);
         }
+    }catch (...){
+        callback.scope.cancel(std::current_exception());
+        return;
+    }
+
+    //  Never go back in time. The feed may not have anything newer yet.
+    if (!m_last || m_last.timestamp < callback.last_timestamp){
+        return;
+    }
+
+    run_callback(callback, m_last);
+}
+void VisualInferencePivot::run_batch(void* const* events, size_t count, bool is_back_to_back) noexcept{
+    if (count == 1){
+        run(events[0], is_back_to_back);
+        return;
+    }
+
+    //  Grab one screenshot for the entire batch. Only fetch a new one if at
+    //  least one of the callbacks has already seen the cached one.
+    WallClock oldest = WallClock::max();
+    bool stale = !is_back_to_back;
+    for (size_t c = 0; c < count; c++){
+        const PeriodicCallback& callback = *(const PeriodicCallback*)events[c];
+        oldest = std::min(oldest, callback.last_timestamp);
+        stale |= callback.last_timestamp >= m_last.timestamp;
+    }
+    try{
+        if (stale){
+            m_last = m_feed.snapshot_recent_nonblocking(oldest);
+        }
+    }catch (...){
+        for (size_t c = 0; c < count; c++){
+            ((PeriodicCallback*)events[c])->scope.cancel(std::current_exception());
+        }
+        return;
+    }
+
+    if (!m_last){
+        return;
+    }
 
-        if (!m_last){
-            return;
+    //  The snapshot is only guaranteed to be newer than the oldest callback.
+    //  Skip the callbacks that have already seen something newer than it.
+    m_batch.clear();
+    for (size_t c = 0; c < count; c++){
+        PeriodicCallback* callback = (PeriodicCallback*)events[c];
+        if (callback->last_timestamp <= m_last.timestamp){
+            m_batch.emplace_back(callback);
+        }
+    }
+    if (m_batch.empty()){
+        return;
+    }
+
+    //  This thread participates in the work, so even a saturated pool will
+    //  not make this slower than running the callbacks serially.
+    const VideoSnapshot& snapshot = m_last;
+    try{
+        GlobalThreadPools::computation_realtime().run_in_parallel(
+            [&](size_t index){
+                run_callback(*m_batch[index], snapshot);
+            },
+            0, m_batch.size(), 1
+        );
+    }catch (...){
+        //  "run_callback()" doesn't throw. This can only be a dispatch
+        //  failure. Fall back to running everything here.
+        for (PeriodicCallback* callback : m_batch){
+            run_callback(*callback, snapshot);
+        }
+    }
+}
+void VisualInferencePivot::run_callback(PeriodicCallback& callback, const VideoSnapshot& snapshot) noexcept{
+    try{
+        //  Only compare against the last frame that was actually processed.
+        //  Otherwise a slow drift would never be seen as a change.
+        bool unchanged = false;
+        if (!callback.change_detection_boxes.empty() && snapshot.tile_hashes){
+            unchanged = callback.last_processed &&
+                !snapshot.tile_hashes->changed(*callback.last_processed, callback.change_detection_boxes);
+            m_unchanged_stat.report(unchanged);
         }
 
         WallClock time0 = current_time();
-        bool stop = callback.callback.process_frame(m_last);
+        bool stop;
+        if (unchanged){
+            stop = callback.callback.process_unchanged_frame(snapshot);
+        }else{
+            stop = callback.callback.process_frame(snapshot);
+            callback.last_processed = snapshot.tile_hashes;
+        }
         WallClock time1 = current_time();
         callback.stats += (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(time1 - time0).count();
-        callback.last_timestamp = m_last.timestamp;
+        callback.last_timestamp = snapshot.timestamp;
 
         if (stop){
             if (callback.set_when_triggered){
@@ -124,5 +266,122 @@ OverlayStatSnapshot VisualInferencePivot::get_current(){
 
 
 
+//  A feed that returns frames from anywhere between "min_time" and now. So
+//  a batch will often get a frame that is older than what some of its
+//  callbacks have already seen.
+class Test_VisualInferencePivot_Feed : public VideoFeed{
+public:
+    virtual void add_frame_listener(VideoFrameListener& listener) override{}
+    virtual void remove_frame_listener(VideoFrameListener& listener) override{}
+    virtual void reset() override{}
+
+    virtual VideoSnapshot snapshot_latest_blocking() override{
+        return VideoSnapshot(ImageRGB32(8, 8), current_time());
+    }
+    virtual VideoSnapshot snapshot_recent_nonblocking(WallClock min_time) override{
+        WallClock now = current_time();
+        if (min_time >= now){
+            return VideoSnapshot(ImageRGB32(8, 8), now);
+        }
+        std::uniform_int_distribution<WallDuration::rep> distribution(0, (now - min_time).count());
+        return VideoSnapshot(ImageRGB32(8, 8), min_time + WallDuration(distribution(m_rng)));
+    }
+
+    virtual double fps_source() const override{ return 0; }
+    virtual double fps_display() const override{ return 0; }
+
+private:
+    //  Only called from the pivot thread.
+    std::mt19937 m_rng{1};
+};
+
+class Test_VisualInferencePivot_Callback : public VisualInferenceCallback{
+public:
+    Test_VisualInferencePivot_Callback()
+        : VisualInferenceCallback("Test_VisualInferencePivot_Callback")
+    {}
+
+    virtual void make_overlays(VideoOverlaySet& items) const override{}
+    virtual bool process_frame(const VideoSnapshot& frame) override{
+        if (frame.timestamp < m_last){
+            m_went_back = true;
+        }
+        m_last = frame.timestamp;
+        m_frames++;
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        return false;
+    }
+
+    bool went_back() const{ return m_went_back; }
+    size_t frames() const{ return m_frames; }
+
+private:
+    WallClock m_last = WallClock::min();
+    bool m_went_back = false;
+    size_t m_frames = 0;
+};
+
+//  Callbacks with different periods and start times must never see a frame
+//  that is older than one they have already seen. Callbacks are added and
+//  removed while the pivot is running.
+class Test_VisualInferencePivot : public UnitTest{
+public:
+    Test_VisualInferencePivot(bool parallel)
+        : UnitTest(std::string("CommonTools::VisualInferencePivot - ") + (parallel ? "parallel" : "serial"))
+        , m_parallel(parallel)
+    {}
+
+    virtual UnitTestResult run(Logger& logger, CancellableScope& scope) const override{
+        CancellableHolder<CancellableScope> inference_scope(scope);
+        Test_VisualInferencePivot_Feed feed;
+        VisualInferencePivot pivot(inference_scope, feed, m_parallel);
+
+        Test_VisualInferencePivot_Callback callbacks[4];
+        WallClock start = current_time();
+        for (size_t c = 0; c < 4; c++){
+            pivot.add_callback(
+                inference_scope, nullptr, callbacks[c],
+                std::chrono::milliseconds(1 + c), start + std::chrono::milliseconds(5 * c)
+            );
+        }
+
+        Test_VisualInferencePivot_Callback extra;
+        for (size_t c = 0; c < 100; c++){
+            pivot.add_callback(inference_scope, nullptr, extra, std::chrono::milliseconds(1), current_time());
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            pivot.remove_callback(extra);
+        }
+
+        for (Test_VisualInferencePivot_Callback& callback : callbacks){
+            pivot.remove_callback(callback);
+        }
+        inference_scope.throw_if_cancelled_with_exception();
+
+        for (size_t c = 0; c < 4; c++){
+            logger.log("Callback " + std::to_string(c) + ": " + std::to_string(callbacks[c].frames()) + " frames");
+            if (callbacks[c].frames() == 0){
+                return UnitTestResult("Callback " + std::to_string(c) + " never ran.");
+            }
+            if (callbacks[c].went_back()){
+                return UnitTestResult("Callback " + std::to_string(c) + " saw an older frame after a newer one.");
+            }
+        }
+        if (extra.went_back()){
+            return UnitTestResult("The re-added callback saw an older frame after a newer one.");
+        }
+        return true;
+    }
+
+private:
+    bool m_parallel;
+};
+
+void add_tests_VisualInferencePivot(UnitTestDatabase& database){
+    database.add<Test_VisualInferencePivot>(false);
+    database.add<Test_VisualInferencePivot>(true);
+}
+
+
+
 
 }
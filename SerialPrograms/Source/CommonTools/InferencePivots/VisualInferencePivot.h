@@ -7,6 +7,7 @@
 #ifndef PokemonAutomation_CommonTools_VisualInferencePivot_H
 #define PokemonAutomation_CommonTools_VisualInferencePivot_H
 
+#include <atomic>
 #include "Common/Cpp/Concurrency/SpinLock.h"
 #include "Common/Cpp/Concurrency/BusyPeriodicRunner.h"
 #include "CommonFramework/Tools/StatAccumulator.h"
@@ -17,12 +18,40 @@
 namespace PokemonAutomation{
 
 class VideoFeed;
+class UnitTestDatabase;
+
+
+
+//  How many frames were skipped by callbacks that opted into
+//  VisualInferenceCallback::change_detection_boxes().
+class UnchangedFrameStat : public OverlayStat{
+public:
+    void report(bool unchanged){
+        m_checked.fetch_add(1, std::memory_order_relaxed);
+        if (unchanged){
+            m_unchanged.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    virtual OverlayStatSnapshot get_current() override;
+
+private:
+    std::atomic<uint64_t> m_checked{0};
+    std::atomic<uint64_t> m_unchanged{0};
+
+    SpinLock m_lock;
+    WallClock m_last_update = WallClock::min();
+    uint64_t m_last_checked = 0;
+    uint64_t m_last_unchanged = 0;
+    OverlayStatSnapshot m_current;
+};
 
 
 
 class VisualInferencePivot final : public BusyPeriodicRunner, public OverlayStat{
 public:
     VisualInferencePivot(CancellableScope& scope, VideoFeed& feed);
+    VisualInferencePivot(CancellableScope& scope, VideoFeed& feed, bool parallel);
     virtual ~VisualInferencePivot();
 
     //  If this callback returns true:
@@ -40,22 +69,37 @@ public:
     //  Returns the latency stats for the callback. Units are microseconds.
     StatAccumulatorI32 remove_callback(VisualInferenceCallback& callback);
 
+    OverlayStat& unchanged_frame_stat(){ return m_unchanged_stat; }
+
 private:
+    struct PeriodicCallback;
+
     virtual void run(void* event, bool is_back_to_back) noexcept override;
+
+    //  Only used in parallel mode. Callbacks that are due on the same frame
+    //  are fanned out onto the real-time compute pool and joined.
+    virtual void run_batch(void* const* events, size_t count, bool is_back_to_back) noexcept override;
+
+    void run_callback(PeriodicCallback& callback, const VideoSnapshot& snapshot) noexcept;
+
     virtual OverlayStatSnapshot get_current() override;
 
 private:
-    struct PeriodicCallback;
-
     VideoFeed& m_feed;
     SpinLock m_lock;
     std::map<VisualInferenceCallback*, PeriodicCallback> m_map;
     VideoSnapshot m_last;
+    std::vector<PeriodicCallback*> m_batch;
 
     OverlayStatUtilizationPrinter m_printer;
+    UnchangedFrameStat m_unchanged_stat;
 };
 
 
 
+void add_tests_VisualInferencePivot(UnitTestDatabase& database);
+
+
+
 }
 #endif
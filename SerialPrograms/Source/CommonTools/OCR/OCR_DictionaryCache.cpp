@@ -0,0 +1,334 @@
+/*  Dictionary Cache
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <system_error>
+#include "Common/Cpp/Color.h"
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Json/JsonValue.h"
+#include "Common/Cpp/Json/JsonArray.h"
+#include "Common/Cpp/Json/JsonObject.h"
+#include "Common/Cpp/Filesystem/FileIO.h"
+#include "Common/Cpp/Filesystem/Filesystem.h"
+#include "CommonFramework/GlobalAutoPaths.h"
+#include "CommonFramework/Logging/Logger.h"
+#include "OCR_StringNormalization.h"
+#include "OCR_DictionaryCache.h"
+
+//#include <iostream>
+//using std::cout;
+//using std::endl;
+
+namespace PokemonAutomation{
+namespace OCR{
+
+
+
+namespace{
+
+const char CACHE_MAGIC[8] = {'P', 'A', 'O', 'C', 'R', 'D', 'I', 'C'};
+
+//  Bump this whenever the layout or normalize_utf32() changes. Changes to its
+//  data (character reductions, Qt version) are caught by "normalizer_hash".
+const uint32_t CACHE_VERSION = 3;
+
+struct CacheHeader{
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t source_hash;
+    uint64_t source_size;
+    uint64_t normalizer_hash;   //  Of normalization_fingerprint().
+    uint64_t payload_hash;      //  Everything after the header.
+    uint64_t tokens;
+    uint64_t candidates;
+    uint64_t normalized_chars;
+    uint64_t text_bytes;
+};
+struct TokenRecord{
+    uint32_t text_offset;
+    uint32_t text_length;
+    uint32_t candidate_begin;
+    uint32_t candidate_count;
+};
+struct CandidateRecord{
+    uint32_t text_offset;
+    uint32_t text_length;
+    uint32_t normalized_offset;
+    uint32_t normalized_length;
+};
+static_assert(sizeof(CacheHeader) % sizeof(char32_t) == 0);
+static_assert(sizeof(TokenRecord) % sizeof(char32_t) == 0);
+static_assert(sizeof(CandidateRecord) % sizeof(char32_t) == 0);
+
+
+//  64-bit FNV-1a.
+uint64_t hash_bytes(const char* data, size_t bytes){
+    uint64_t hash = 0xcbf29ce484222325;
+    for (size_t c = 0; c < bytes; c++){
+        hash ^= (uint8_t)data[c];
+        hash *= 0x100000001b3;
+    }
+    return hash;
+}
+uint64_t hash_bytes(const std::string& data){
+    return hash_bytes(data.data(), data.size());
+}
+
+//  Unique to this process and call. Concurrent writers of the same cache, in
+//  this or another instance of the program, must not share a temporary file.
+std::string make_temp_path(const std::string& path){
+    static const uint64_t PROCESS_TAG = []{
+        std::random_device device;
+        uint64_t tag = ((uint64_t)device() << 32) | device();
+        return tag ^ (uint64_t)std::chrono::system_clock::now().time_since_epoch().count();
+    }();
+    static std::atomic<uint64_t> counter(0);
+
+    char suffix[48];
+    snprintf(
+        suffix, sizeof(suffix), ".%016llx-%llu.tmp",
+        (unsigned long long)PROCESS_TAG, (unsigned long long)counter++
+    );
+    return path + suffix;
+}
+
+template <typename Type>
+void append_bytes(std::string& payload, const Type* data, size_t count){
+    payload.append(reinterpret_cast<const char*>(data), count * sizeof(Type));
+}
+
+
+
+//  Returns false if the cache is missing, stale or malformed.
+bool read_cache(
+    DictionaryFileContents& contents,
+    const std::string& path,
+    uint64_t source_hash, uint64_t source_size, uint64_t normalizer_hash
+){
+    std::string data;
+    if (!file_to_string(path, data)){
+        return false;
+    }
+
+    CacheHeader header;
+    if (data.size() < sizeof(header)){
+        return false;
+    }
+    memcpy(&header, data.data(), sizeof(header));
+    if (memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 ||
+        header.version != CACHE_VERSION ||
+        header.reserved != 0 ||
+        header.source_hash != source_hash ||
+        header.source_size != source_size ||
+        header.normalizer_hash != normalizer_hash ||
+        header.payload_hash != hash_bytes(data.data() + sizeof(header), data.size() - sizeof(header))
+    ){
+        return false;
+    }
+
+    //  Bound everything before the multiplications below can overflow.
+    if (header.tokens > data.size() ||
+        header.candidates > data.size() ||
+        header.normalized_chars > data.size() ||
+        header.text_bytes > data.size()
+    ){
+        return false;
+    }
+    size_t token_table = sizeof(header);
+    size_t candidate_table = token_table + header.tokens * sizeof(TokenRecord);
+    size_t normalized_blob = candidate_table + header.candidates * sizeof(CandidateRecord);
+    size_t text_blob = normalized_blob + header.normalized_chars * sizeof(char32_t);
+    if (text_blob + header.text_bytes != data.size()){
+        return false;
+    }
+
+    const char* text = data.data() + text_blob;
+    const char32_t* normalized = reinterpret_cast<const char32_t*>(data.data() + normalized_blob);
+
+    DictionaryFileContents ret;
+    ret.reserve(header.tokens);
+    for (size_t t = 0; t < header.tokens; t++){
+        TokenRecord token;
+        memcpy(&token, data.data() + token_table + t * sizeof(TokenRecord), sizeof(token));
+        if ((uint64_t)token.text_offset + token.text_length > header.text_bytes ||
+            (uint64_t)token.candidate_begin + token.candidate_count > header.candidates
+        ){
+            return false;
+        }
+
+        DictionaryFileEntry& entry = ret.emplace_back();
+        entry.token.assign(text + token.text_offset, token.text_length);
+        entry.candidates.reserve(token.candidate_count);
+        entry.normalized.reserve(token.candidate_count);
+        for (size_t c = token.candidate_begin; c < token.candidate_begin + token.candidate_count; c++){
+            CandidateRecord candidate;
+            memcpy(&candidate, data.data() + candidate_table + c * sizeof(CandidateRecord), sizeof(candidate));
+            if ((uint64_t)candidate.text_offset + candidate.text_length > header.text_bytes ||
+                (uint64_t)candidate.normalized_offset + candidate.normalized_length > header.normalized_chars
+            ){
+                return false;
+            }
+            entry.candidates.emplace_back(text + candidate.text_offset, candidate.text_length);
+            entry.normalized.emplace_back(normalized + candidate.normalized_offset, candidate.normalized_length);
+        }
+    }
+
+    contents = std::move(ret);
+    return true;
+}
+
+
+void write_cache(
+    const DictionaryFileContents& contents,
+    const std::string& path,
+    uint64_t source_hash, uint64_t source_size, uint64_t normalizer_hash
+){
+    std::vector<TokenRecord> tokens;
+    std::vector<CandidateRecord> candidates;
+    std::u32string normalized;
+    std::string text;
+    tokens.reserve(contents.size());
+    for (const DictionaryFileEntry& entry : contents){
+        tokens.emplace_back(TokenRecord{
+            (uint32_t)text.size(), (uint32_t)entry.token.size(),
+            (uint32_t)candidates.size(), (uint32_t)entry.candidates.size()
+        });
+        text += entry.token;
+        for (size_t c = 0; c < entry.candidates.size(); c++){
+            candidates.emplace_back(CandidateRecord{
+                (uint32_t)text.size(), (uint32_t)entry.candidates[c].size(),
+                (uint32_t)normalized.size(), (uint32_t)entry.normalized[c].size()
+            });
+            text += entry.candidates[c];
+            normalized += entry.normalized[c];
+        }
+    }
+
+    //  Every offset and length above is at most one of these totals. So if
+    //  they fit, none of the casts to uint32_t truncated.
+    if (text.size() > UINT32_MAX ||
+        normalized.size() > UINT32_MAX ||
+        candidates.size() > UINT32_MAX
+    ){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Dictionary is too large to cache.", path);
+    }
+
+    std::string payload;
+    append_bytes(payload, tokens.data(), tokens.size());
+    append_bytes(payload, candidates.data(), candidates.size());
+    append_bytes(payload, normalized.data(), normalized.size());
+    append_bytes(payload, text.data(), text.size());
+
+    CacheHeader header;
+    memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    header.version = CACHE_VERSION;
+    header.reserved = 0;
+    header.source_hash = source_hash;
+    header.source_size = source_size;
+    header.normalizer_hash = normalizer_hash;
+    header.payload_hash = hash_bytes(payload);
+    header.tokens = tokens.size();
+    header.candidates = candidates.size();
+    header.normalized_chars = normalized.size();
+    header.text_bytes = text.size();
+
+    //  Write to a temporary file and move it into place so that a concurrent
+    //  load never sees a partial cache.
+    Filesystem::create_directories(OCR_CACHE_PATH());
+    std::string temp_path = make_temp_path(path);
+    {
+        FileIO file;
+        if (!file.open(temp_path, FileMode::WRITE | FileMode::BINARY)){
+            throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to create file.", temp_path);
+        }
+        bool ok =
+            file.write(&header, sizeof(header)) == sizeof(header) &&
+            file.write(payload.data(), payload.size()) == payload.size();
+        file.close();
+        if (!ok){
+            Filesystem::remove(temp_path);
+            throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to write file.", temp_path);
+        }
+    }
+    std::error_code error;
+    Filesystem::rename(temp_path, path, error);
+    if (error){
+        Filesystem::remove(temp_path);
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to rename file: " + error.message(), path);
+    }
+}
+
+}
+
+
+
+std::string dictionary_cache_path(const std::string& json_path){
+    size_t slash = json_path.find_last_of("/\\");
+    std::string name = slash == std::string::npos ? json_path : json_path.substr(slash + 1);
+    size_t dot = name.rfind('.');
+    if (dot != std::string::npos){
+        name.resize(dot);
+    }
+
+    char hash[17];
+    snprintf(hash, sizeof(hash), "%016llx", (unsigned long long)hash_bytes(json_path));
+    return OCR_CACHE_PATH() + name + "-" + hash + ".bin";
+}
+
+
+DictionaryFileContents parse_dictionary_json(const JsonObject& json){
+    DictionaryFileContents ret;
+    ret.reserve(json.size());
+    for (const auto& item0 : json){
+        DictionaryFileEntry& entry = ret.emplace_back();
+        entry.token = item0.first;
+        for (const auto& item1 : item0.second.to_array_throw()){
+            const std::string& candidate = item1.to_string_throw();
+            entry.normalized.emplace_back(normalize_utf32(candidate));
+            entry.candidates.emplace_back(candidate);
+        }
+    }
+    return ret;
+}
+
+
+DictionaryFileContents load_dictionary_file(const std::string& json_path){
+    std::string source = file_to_string(json_path);
+    const uint64_t source_hash = hash_bytes(source);
+    const uint64_t source_size = source.size();
+    const uint64_t normalizer_hash = hash_bytes(normalization_fingerprint());
+    const std::string path = dictionary_cache_path(json_path);
+
+    DictionaryFileContents contents;
+    if (read_cache(contents, path, source_hash, source_size, normalizer_hash)){
+        return contents;
+    }
+
+    contents = parse_dictionary_json(parse_json(source).to_object_throw(json_path));
+
+    try{
+        write_cache(contents, path, source_hash, source_size, normalizer_hash);
+        global_logger_tagged().log("DictionaryCache - Rebuilt: " + path);
+    }catch (FileException& e){
+        //  The cache is only an optimization. Keep going without it.
+        global_logger_tagged().log("DictionaryCache - " + e.message(), COLOR_RED);
+    }catch (std::exception& e){
+        global_logger_tagged().log("DictionaryCache - " + std::string(e.what()), COLOR_RED);
+    }
+
+    return contents;
+}
+
+
+
+}
+}
@@ -0,0 +1,60 @@
+/*  Dictionary Cache
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Loading an OCR dictionary from JSON means parsing the JSON and then
+ *  running normalize_utf32() over every candidate. For programs that load
+ *  large dictionaries in every language, this dominates startup.
+ *
+ *  The first load of a dictionary file writes the parsed result (tokens,
+ *  candidates and their normalized forms) to a binary cache. Later loads read
+ *  the cache in one go instead. A cache is only used if it was built from a
+ *  source file with the same size and hash, and with the same normalization
+ *  data. (see normalization_fingerprint()) Otherwise it falls back to the
+ *  JSON and rebuilds the cache.
+ *
+ *  The cache is a header followed by flat token and candidate tables that
+ *  index into two string blobs. It is stored in native byte order. The header
+ *  also has a hash of everything after it, so a damaged cache is rebuilt
+ *  rather than trusted.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonTools_OCR_DictionaryCache_H
+#define PokemonAutomation_CommonTools_OCR_DictionaryCache_H
+
+#include <string>
+#include <vector>
+
+namespace PokemonAutomation{
+    class JsonObject;
+namespace OCR{
+
+
+struct DictionaryFileEntry{
+    std::string token;
+
+    //  In file order. "normalized[i]" is normalize_utf32(candidates[i]).
+    std::vector<std::string> candidates;
+    std::vector<std::u32string> normalized;
+};
+using DictionaryFileContents = std::vector<DictionaryFileEntry>;
+
+
+//  Where the cache for the dictionary at "json_path" is stored.
+//  One file per source path. The hash of the full path keeps files with the
+//  same name in different folders apart.
+std::string dictionary_cache_path(const std::string& json_path);
+
+//  Parse and normalize a dictionary JSON object without any caching.
+DictionaryFileContents parse_dictionary_json(const JsonObject& json);
+
+//  Load the dictionary JSON file at "json_path", going through the cache.
+//  Throws FileException if the JSON file cannot be read.
+DictionaryFileContents load_dictionary_file(const std::string& json_path);
+
+
+
+}
+}
+#endif
@@ -0,0 +1,190 @@
+/*  Dictionary Index
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include "OCR_StringNormalization.h"
+#include "OCR_TextMatcher.h"
+#include "OCR_DictionaryIndex.h"
+
+namespace PokemonAutomation{
+namespace OCR{
+
+
+
+DictionaryIndex::DictionaryIndex(double random_match_chance)
+    : m_random_match_chance(random_match_chance)
+{}
+
+void DictionaryIndex::add_length(size_t length){
+    //  random_match_probability() does not go beyond this. Leave these
+    //  unbounded so they hit the same error as before at match time.
+    if (length > 1000){
+        return;
+    }
+    if (m_log10p.size() <= length){
+        m_log10p.resize(length + 1);
+        m_log10p_lower_bound.resize(length + 1);
+    }
+    std::vector<double>& row = m_log10p[length];
+    if (!row.empty()){
+        return;
+    }
+
+    std::vector<double>& bound = m_log10p_lower_bound[length];
+    row.resize(length + 1);
+    bound.resize(length + 1);
+    row[0] = std::log10(random_match_probability(length, 0, m_random_match_chance));
+    bound[0] = std::numeric_limits<double>::infinity();
+    for (size_t matched = 1; matched <= length; matched++){
+        row[matched] = std::log10(random_match_probability(length, matched, m_random_match_chance));
+        bound[matched] = std::min(bound[matched - 1], row[matched]);
+    }
+}
+double DictionaryIndex::log10p(size_t length, size_t matched) const{
+    if (length < m_log10p.size() && !m_log10p[length].empty()){
+        return m_log10p[length][matched];
+    }
+    return std::log10(random_match_probability(length, matched, m_random_match_chance));
+}
+double DictionaryIndex::log10p_lower_bound(size_t length, size_t matched) const{
+    if (length < m_log10p_lower_bound.size() && !m_log10p_lower_bound[length].empty()){
+        return m_log10p_lower_bound[length][matched];
+    }
+    return -std::numeric_limits<double>::infinity();
+}
+
+void DictionaryIndex::add(const Entry& entry){
+    uint32_t index = (uint32_t)m_candidates.size();
+    m_candidates.emplace_back(Candidate{&entry});
+
+    std::map<char32_t, uint32_t> counts;
+    for (char32_t ch : entry.first){
+        counts[ch]++;
+    }
+    for (const auto& item : counts){
+        m_postings[item.first].emplace_back(Posting{index, item.second});
+    }
+
+    add_length(entry.first.size());
+}
+
+
+
+StringMatchResult DictionaryIndex::match_substring(
+    const std::map<std::u32string, std::set<std::string>>& database,
+    const std::string& text, double log10p_spread
+) const{
+    StringMatchResult results;
+
+    std::u32string normalized = normalize_utf32(text);
+
+    //  Search for exact match of candidate.
+    auto iter = database.find(normalized);
+    if (iter != database.end()){
+        results.exact_match = true;
+        double probability = random_match_probability(normalized.size(), normalized.size(), m_random_match_chance);
+        double log10p = std::log10(probability);
+        for (const auto& target : iter->second){
+            results.add(
+                log10p,
+                StringMatchData{text, normalized, normalized, target}
+            );
+        }
+        return results;
+    }
+
+    std::map<char32_t, uint32_t> text_counts;
+    for (char32_t ch : normalized){
+        text_counts[ch]++;
+    }
+
+    //  Upper bound on the # of matched characters for every candidate that
+    //  shares at least one character with the text. Candidates that share
+    //  none cannot match anything and are skipped by match_substring() too.
+    std::vector<uint32_t> max_matched(m_candidates.size(), 0);
+    std::vector<uint32_t> touched;
+    for (const auto& item : text_counts){
+        auto postings = m_postings.find(item.first);
+        if (postings == m_postings.end()){
+            continue;
+        }
+        for (const Posting& posting : postings->second){
+            uint32_t& matched = max_matched[posting.candidate];
+            if (matched == 0){
+                touched.emplace_back(posting.candidate);
+            }
+            matched += std::min(posting.count, item.second);
+        }
+    }
+
+    std::vector<std::pair<double, uint32_t>> order;
+    order.reserve(touched.size());
+    for (uint32_t index : touched){
+        size_t length = m_candidates[index].entry->first.size();
+        order.emplace_back(log10p_lower_bound(length, max_matched[index]), index);
+    }
+    std::sort(order.begin(), order.end());
+
+    struct Hit{
+        const Entry* entry;
+        double log10p;
+    };
+    std::vector<Hit> hits;
+    double best = std::numeric_limits<double>::infinity();
+    size_t c = 0;
+    for (; c < order.size(); c++){
+        if (order[c].first > best + log10p_spread){
+            break;
+        }
+        const Entry& entry = *m_candidates[order[c].second].entry;
+        size_t token_length = entry.first.size();
+
+        size_t distance = levenshtein_distance_substring(entry.first, normalized);
+
+        size_t matched = token_length - distance;
+        if (matched == 0){
+            continue;
+        }
+        if (distance == 0){
+            results.exact_match = true;
+        }
+
+        double log10p = this->log10p(token_length, matched);
+        hits.emplace_back(Hit{&entry, log10p});
+        best = std::min(best, log10p);
+    }
+
+    //  A skipped candidate can still be an exact substring of the text.
+    for (; c < order.size() && !results.exact_match; c++){
+        const std::u32string& token = m_candidates[order[c].second].entry->first;
+        if (max_matched[order[c].second] == token.size() && normalized.find(token) != std::u32string::npos){
+            results.exact_match = true;
+        }
+    }
+
+    //  Add in dictionary order so that ties come out the same as a full scan.
+    std::sort(
+        hits.begin(), hits.end(),
+        [](const Hit& a, const Hit& b){
+            return a.entry->first < b.entry->first;
+        }
+    );
+    for (const Hit& hit : hits){
+        for (const auto& slug : hit.entry->second){
+            results.add(hit.log10p, StringMatchData{text, normalized, hit.entry->first, slug});
+            results.clear_beyond_spread(log10p_spread);
+        }
+    }
+
+    return results;
+}
+
+
+
+}
+}
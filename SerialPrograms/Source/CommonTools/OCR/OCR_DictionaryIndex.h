@@ -0,0 +1,83 @@
+/*  Dictionary Index
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Index over the candidates of a dictionary so that match_substring()
+ *  does not need to run the edit distance against every candidate.
+ *
+ *  For each OCR read, the character counts of the read give an upper bound
+ *  on how many characters of each candidate can match. That gives a lower
+ *  bound on the candidate's log10p. Candidates are then checked in order of
+ *  that bound until no remaining candidate can land within "log10p_spread"
+ *  of the best match. The returned StringMatchResult is the same as that of
+ *  OCR::match_substring() on the whole dictionary.
+ *
+ */
+
+#ifndef PokemonAutomation_CommonTools_OCR_DictionaryIndex_H
+#define PokemonAutomation_CommonTools_OCR_DictionaryIndex_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <set>
+#include <map>
+#include "OCR_StringMatchResult.h"
+
+namespace PokemonAutomation{
+namespace OCR{
+
+
+class DictionaryIndex{
+public:
+    using Entry = std::pair<const std::u32string, std::set<std::string>>;
+
+public:
+    DictionaryIndex(double random_match_chance);
+
+    //  "entry" is an element of the dictionary map. It must stay alive
+    //  (and keep its address) for the lifetime of this index.
+    void add(const Entry& entry);
+
+    //  Same as OCR::match_substring() with "database" being the map that
+    //  every added entry belongs to.
+    StringMatchResult match_substring(
+        const std::map<std::u32string, std::set<std::string>>& database,
+        const std::string& text, double log10p_spread
+    ) const;
+
+
+private:
+    struct Candidate{
+        const Entry* entry;
+    };
+    struct Posting{
+        uint32_t candidate;
+        uint32_t count;
+    };
+
+    //  log10p of a candidate with the given length and # of matched characters.
+    double log10p(size_t length, size_t matched) const;
+    //  Lowest possible log10p of a candidate with the given length and at
+    //  most "matched" matched characters.
+    double log10p_lower_bound(size_t length, size_t matched) const;
+    void add_length(size_t length);
+
+
+private:
+    double m_random_match_chance;
+    std::vector<Candidate> m_candidates;
+
+    //  Character -> candidates containing it and how many times.
+    std::map<char32_t, std::vector<Posting>> m_postings;
+
+    //  [length][matched]
+    std::vector<std::vector<double>> m_log10p;
+    std::vector<std::vector<double>> m_log10p_lower_bound;
+};
+
+
+
+}
+}
+#endif
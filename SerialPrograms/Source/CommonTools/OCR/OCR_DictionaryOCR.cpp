@@ -23,22 +23,23 @@ namespace OCR{
 
 
 DictionaryOCR::DictionaryOCR(
-    const JsonObject& json,
+    const DictionaryFileContents& contents,
     const std::set<std::string>* subset,
     double random_match_chance,
     bool first_only
 )
     : m_random_match_chance(random_match_chance)
+    , m_index(random_match_chance)
 {
-    for (const auto& item0 : json){
-        const std::string& token = item0.first;
+    for (const DictionaryFileEntry& entry : contents){
+        const std::string& token = entry.token;
         if (subset != nullptr && subset->find(token) == subset->end()){
             continue;
         }
         std::vector<std::string>& candidates = m_database[token];
-        for (const auto& item1 : item0.second.to_array_throw()){
-            const std::string& candidate = item1.to_string_throw();
-            std::u32string normalized = normalize_utf32(candidate);
+        for (size_t c = 0; c < entry.candidates.size(); c++){
+            const std::string& candidate = entry.candidates[c];
+            const std::u32string& normalized = entry.normalized[c];
             std::set<std::string>& set = m_candidate_to_token[normalized];
             if (!set.empty()){
                 global_logger_tagged().log(
@@ -53,12 +54,28 @@ DictionaryOCR::DictionaryOCR(
             }
         }
     }
+    for (const auto& item : m_candidate_to_token){
+        m_index.add(item);
+    }
     global_logger_tagged().log(
         "DictionaryOCR - Tokens: " + std::to_string(m_database.size()) +
         ", Match Candidates: " + std::to_string(m_candidate_to_token.size())
     );
 //    cout << "Tokens: " << m_database.size() << ", Match Candidates: " << m_candidate_to_token.size() << endl;
 }
+DictionaryOCR::DictionaryOCR(
+    const JsonObject& json,
+    const std::set<std::string>* subset,
+    double random_match_chance,
+    bool first_only
+)
+    : DictionaryOCR(
+        parse_dictionary_json(json),
+        subset,
+        random_match_chance,
+        first_only
+    )
+{}
 DictionaryOCR::DictionaryOCR(
     const std::string& json_path,
     const std::set<std::string>* subset,
@@ -66,7 +83,7 @@ DictionaryOCR::DictionaryOCR(
     bool first_only
 )
     : DictionaryOCR(
-        load_json_file(json_path).to_object_throw(json_path),
+        load_dictionary_file(json_path),
         subset,
         random_match_chance,
         first_only
@@ -94,10 +111,7 @@ StringMatchResult DictionaryOCR::match_substring(
     const std::string& text,
     double log10p_spread
 ) const{
-    return OCR::match_substring(
-        m_candidate_to_token, m_random_match_chance,
-        text, log10p_spread
-    );
+    return m_index.match_substring(m_candidate_to_token, text, log10p_spread);
 }
 void DictionaryOCR::add_candidate(std::string token, const std::u32string& candidate){
     if (candidate.size() < 2){
@@ -110,7 +124,8 @@ void DictionaryOCR::add_candidate(std::string token, const std::u32string& candi
     if (iter == m_candidate_to_token.end()){
         //  New candidate. Add it to both maps.
         m_database[token].emplace_back(utf32_to_str(candidate));
-        m_candidate_to_token[candidate].insert(std::move(token));
+        auto inserted = m_candidate_to_token.emplace(candidate, std::set<std::string>{std::move(token)});
+        m_index.add(*inserted.first);
         return;
     }
 
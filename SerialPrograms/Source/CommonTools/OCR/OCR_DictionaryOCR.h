@@ -12,6 +12,8 @@
 #include <map>
 #include "Common/Cpp/Concurrency/SpinLock.h"
 #include "OCR_StringMatchResult.h"
+#include "OCR_DictionaryIndex.h"
+#include "OCR_DictionaryCache.h"
 
 namespace PokemonAutomation{
     class JsonObject;
@@ -20,12 +22,19 @@ namespace OCR{
 
 class DictionaryOCR{
 public:
+    DictionaryOCR(
+        const DictionaryFileContents& contents,
+        const std::set<std::string>* subset,
+        double random_match_chance,
+        bool first_only
+    );
     DictionaryOCR(
         const JsonObject& json,
         const std::set<std::string>* subset,
         double random_match_chance,
         bool first_only
     );
+    //  Goes through the binary dictionary cache. (see "OCR_DictionaryCache.h")
     DictionaryOCR(
         const std::string& json_path,
         const std::set<std::string>* subset,
@@ -51,6 +60,7 @@ private:
     double m_random_match_chance;
     std::map<std::string, std::vector<std::string>> m_database;
     std::map<std::u32string, std::set<std::string>> m_candidate_to_token;
+    DictionaryIndex m_index;
 };
 
 
@@ -147,6 +147,7 @@ std::string read_number_waterfill_no_normalization(
     std::map<size_t, WaterfillObject> map;
     {
         std::unique_ptr<WaterfillSession> session = make_WaterfillSession(matrix);
+        session->set_object_storage(WaterfillObjectStorage::CROPPED);
         auto iter = session->make_iterator(min_digit_area);
         WaterfillObject object;
         while (map.size() < 16 && iter->find_next(object, true)){
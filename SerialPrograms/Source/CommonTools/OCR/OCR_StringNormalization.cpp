@@ -7,6 +7,7 @@
 #include <map>
 #include <QString>
 #include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Filesystem/FileIO.h"
 #include "Common/Cpp/Strings/Unicode.h"
 #include "Common/Cpp/Json/JsonValue.h"
 #include "Common/Cpp/Json/JsonObject.h"
@@ -30,6 +31,18 @@ std::u32string normalize_utf32(const std::string& text){
 
 
 
+const std::string& normalization_fingerprint(){
+    static const std::string fingerprint = []{
+        std::string ret;
+        file_to_string(RESOURCE_PATH() + "Tesseract/CharacterReductions.json", ret);
+        ret += '\0';
+        ret += qVersion();
+        return ret;
+    }();
+    return fingerprint;
+}
+
+
 std::u32string remove_non_alphanumeric(const std::u32string& text){
     std::u32string str;
     for (char32_t ch : text){
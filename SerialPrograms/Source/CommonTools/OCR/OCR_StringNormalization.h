@@ -33,6 +33,12 @@ std::u32string run_character_reductions(const std::u32string& text);
 // 4. Convert all uppercase letters to lowercase.
 std::u32string normalize_utf32(const std::string& text);
 
+// Everything that the result of `normalize_utf32()` depends on besides its input:
+// the contents of CharacterReductions.json and the Qt version, whose Unicode
+// tables do the decomposition. Anything that caches normalized strings must be
+// invalidated when this changes.
+const std::string& normalization_fingerprint();
+
 
 
 }
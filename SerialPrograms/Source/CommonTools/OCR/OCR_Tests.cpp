@@ -4,12 +4,21 @@
  *
  */
 
+#include <random>
+#include <filesystem>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Json/JsonValue.h"
+#include "Common/Cpp/Json/JsonObject.h"
+#include "Common/Cpp/Filesystem/FileIO.h"
 #include "CommonFramework/GlobalAutoPaths.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "Common/Cpp/TestRunners/UnitTestDatabase.h"
 // #include "Common/Cpp/Strings/Unicode.h"
 #include "OCR_Routines.h"
 #include "OCR_StringNormalization.h"
+#include "OCR_TextMatcher.h"
+#include "OCR_DictionaryIndex.h"
+#include "OCR_DictionaryCache.h"
 #include "OCR_Tests.h"
 
 #include <iostream>
@@ -23,6 +32,8 @@ namespace OCR{
 
 void add_tests(UnitTestDatabase& database){
     add_tests_raw_OCR(database);
+    add_tests_dictionary_index(database);
+    add_tests_dictionary_cache(database);
 }
 
 class Test_RawOCR : public UnitTest{
@@ -72,5 +83,202 @@ void add_tests_raw_OCR(UnitTestDatabase& database){
 
 
 
+//  Checks levenshtein_distance_substring() and DictionaryIndex against the
+//  plain DP and the full dictionary scan on random strings.
+class Test_DictionaryIndex : public UnitTest{
+public:
+    Test_DictionaryIndex(uint32_t seed)
+        : UnitTest("OCR::DictionaryIndex - seed " + std::to_string(seed))
+        , m_seed(seed)
+    {}
+
+    virtual UnitTestResult run(Logger& logger, CancellableScope& scope) const override{
+        std::mt19937 rng(m_seed);
+        size_t alphabet = 4 + rng() % 20;
+        auto random_string = [&](size_t length){
+            std::string str;
+            for (size_t c = 0; c < length; c++){
+                str += (char)('a' + rng() % alphabet);
+            }
+            return str;
+        };
+
+        for (size_t c = 0; c < 10000; c++){
+            std::u32string x = normalize_utf32(random_string(rng() % 70));
+            std::u32string y = normalize_utf32(random_string(rng() % 90));
+            if (levenshtein_distance_substring(x, y) != levenshtein_distance_substring_reference(x, y)){
+                logger.log("Edit distance mismatch: " + std::to_string(c));
+                return false;
+            }
+        }
+
+        double random_match_chance = 0.10 + 0.05 * (rng() % 6);
+        std::map<std::u32string, std::set<std::string>> database;
+        std::vector<std::string> tokens;
+        for (size_t c = 0; c < 500; c++){
+            std::string token = random_string(2 + rng() % 15);
+            tokens.emplace_back(token);
+            database[normalize_utf32(token)].insert("slug-" + std::to_string(rng() % 300));
+        }
+        DictionaryIndex index(random_match_chance);
+        for (const auto& item : database){
+            index.add(item);
+        }
+
+        for (size_t c = 0; c < 1000; c++){
+            std::string text = random_string(rng() % 30);
+            if (c % 2 == 0){
+                text = random_string(rng() % 4) + tokens[rng() % tokens.size()] + random_string(rng() % 4);
+                text[rng() % text.size()] = (char)('a' + rng() % alphabet);
+            }
+            double spread = 0.25 * (rng() % 8);
+            StringMatchResult expected = match_substring(database, random_match_chance, text, spread);
+            StringMatchResult actual = index.match_substring(database, text, spread);
+
+            bool ok = expected.exact_match == actual.exact_match && expected.results.size() == actual.results.size();
+            for (auto e = expected.results.begin(), a = actual.results.begin(); ok && e != expected.results.end(); ++e, ++a){
+                ok = e->first == a->first && e->second.target == a->second.target && e->second.token == a->second.token;
+            }
+            if (!ok){
+                logger.log("Dictionary match mismatch: " + text);
+                return false;
+            }
+        }
+        return true;
+    };
+
+private:
+    uint32_t m_seed;
+};
+
+void add_tests_dictionary_index(UnitTestDatabase& database){
+    database.add<Test_DictionaryIndex>(1);
+    database.add<Test_DictionaryIndex>(2);
+    database.add<Test_DictionaryIndex>(3);
+}
+
+
+
+//  Checks that load_dictionary_file() returns exactly what parsing the JSON
+//  returns, whether it builds the cache, reads it, or has to throw away a
+//  stale or damaged one.
+class Test_DictionaryCache : public UnitTest{
+public:
+    Test_DictionaryCache()
+        : UnitTest("OCR::DictionaryCache")
+    {}
+
+    virtual UnitTestResult run(Logger& logger, CancellableScope& scope) const override{
+        std::string json_path = (std::filesystem::temp_directory_path() / "PA-DictionaryCache-Test.json").string();
+        std::string cache_path = dictionary_cache_path(json_path);
+        std::filesystem::remove(cache_path);
+
+        std::string error = run(json_path, cache_path);
+
+        std::filesystem::remove(json_path);
+        std::filesystem::remove(cache_path);
+        return error.empty() ? UnitTestResult(true) : UnitTestResult(error);
+    }
+
+private:
+    static std::string run(const std::string& json_path, const std::string& cache_path){
+        //  Unicode, empty arrays, an empty candidate and repeated candidates.
+        const std::string JSON_A = R"({
+            "pikachu": ["Pikachu", "PIKACHU", "Pika chu"],
+            "flabebe": ["Flab\u00e9b\u00e9", "Flabébé", "フラベベ"],
+            "empty": [],
+            "blank": [""],
+            "nidoran-f": ["Nidoran♀", "Nidoran♀", "니드런♀"]
+        })";
+        const std::string JSON_B = R"({
+            "eevee": ["Eevee", "Évoli", "イーブイ", "伊布"],
+            "mr-mime": ["Mr. Mime", "Mr.Mime"]
+        })";
+
+        std::string error = check_load(json_path, JSON_A, "The first load");
+        if (!error.empty()){
+            return error;
+        }
+        std::string good_cache;
+        if (!file_to_string(cache_path, good_cache) || good_cache.empty()){
+            return "The first load didn't write a cache.";
+        }
+
+        error = check_load(json_path, JSON_A, "Loading from the cache");
+        if (!error.empty()){
+            return error;
+        }
+
+        //  Stale: the JSON changed after the cache was written.
+        error = check_load(json_path, JSON_B, "Loading with a stale cache");
+        if (!error.empty()){
+            return error;
+        }
+        write_bytes(json_path, JSON_A);
+
+        //  Damaged: truncated, extended, every byte of the header flipped (the
+        //  header also holds the hash of the normalization data), and one byte
+        //  flipped in each of the other parts of the file.
+        std::vector<std::string> damaged;
+        damaged.emplace_back(good_cache.substr(0, good_cache.size() - 1));
+        damaged.emplace_back(good_cache + '\0');
+        damaged.emplace_back();
+        for (size_t c = 0; c < good_cache.size(); c += c < 128 ? 1 : 1 + good_cache.size() / 16){
+            std::string file = good_cache;
+            file[c] ^= 0x20;
+            damaged.emplace_back(std::move(file));
+        }
+        {
+            std::string file = good_cache;
+            file.back() ^= 0x20;
+            damaged.emplace_back(std::move(file));
+        }
+        for (size_t c = 0; c < damaged.size(); c++){
+            write_bytes(cache_path, damaged[c]);
+            error = check_load(json_path, JSON_A, "Loading with damaged cache " + std::to_string(c));
+            if (!error.empty()){
+                return error;
+            }
+            if (file_to_string(cache_path) != good_cache){
+                return "Damaged cache " + std::to_string(c) + " wasn't rebuilt.";
+            }
+        }
+        return "";
+    }
+
+    static std::string check_load(const std::string& json_path, const std::string& json, const std::string& what){
+        write_bytes(json_path, json);
+        DictionaryFileContents expected = parse_dictionary_json(parse_json(json).to_object_throw());
+        DictionaryFileContents actual = load_dictionary_file(json_path);
+        if (actual.size() != expected.size()){
+            return what + " returned the wrong number of tokens.";
+        }
+        for (size_t c = 0; c < expected.size(); c++){
+            if (actual[c].token != expected[c].token ||
+                actual[c].candidates != expected[c].candidates ||
+                actual[c].normalized != expected[c].normalized
+            ){
+                return what + " differs from the JSON at token \"" + expected[c].token + "\".";
+            }
+        }
+        return "";
+    }
+
+    static void write_bytes(const std::string& path, const std::string& bytes){
+        FileIO file;
+        if (!file.open(path, FileMode::WRITE | FileMode::BINARY) ||
+            file.write(bytes.data(), bytes.size()) != bytes.size()
+        ){
+            throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to write file.", path);
+        }
+    }
+};
+
+void add_tests_dictionary_cache(UnitTestDatabase& database){
+    database.add<Test_DictionaryCache>();
+}
+
+
+
 }
 }
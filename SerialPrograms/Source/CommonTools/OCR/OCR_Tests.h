@@ -17,6 +17,8 @@ namespace OCR{
 void add_tests(UnitTestDatabase& database);
 
 void add_tests_raw_OCR(UnitTestDatabase& database);
+void add_tests_dictionary_index(UnitTestDatabase& database);
+void add_tests_dictionary_cache(UnitTestDatabase& database);
 
 
 
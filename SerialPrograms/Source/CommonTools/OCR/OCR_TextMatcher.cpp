@@ -6,6 +6,7 @@
 
 #include <cmath>
 #include <vector>
+#include <algorithm>
 #include "Common/Cpp/Exceptions.h"
 #include "Common/Cpp/Concurrency/SpinLock.h"
 #include "Common/Qt/StringToolsQt.h"
@@ -130,7 +131,7 @@ size_t levenshtein_distance(const StringType& x, const StringType& y){
     return v0[ylen];
 }
 template <typename StringType>
-size_t levenshtein_distance_substring(const StringType& substring, const StringType& fullstring){
+size_t levenshtein_distance_substring_reference(const StringType& substring, const StringType& fullstring){
     size_t xlen = fullstring.size();
     size_t ylen = substring.size();
 
@@ -165,8 +166,80 @@ size_t levenshtein_distance_substring(const StringType& substring, const StringT
 
     return min;
 }
+template <typename StringType>
+size_t levenshtein_distance_substring(const StringType& substring, const StringType& fullstring){
+    //  Myers/Hyyrö bit-parallel version of the above. Each column of the DP
+    //  table is stored as vertical +1/-1 deltas packed into a 64-bit word.
+    size_t ylen = substring.size();
+    if (ylen == 0 || ylen > 64){
+        return levenshtein_distance_substring_reference(substring, fullstring);
+    }
+
+    using CharType = typename StringType::value_type;
+
+    //  Bit j of the mask for "c" is set if substring[j] == c.
+    std::vector<std::pair<CharType, uint64_t>> peq;
+    peq.reserve(ylen);
+    for (size_t j = 0; j < ylen; j++){
+        peq.emplace_back(substring[j], (uint64_t)1 << j);
+    }
+    std::sort(
+        peq.begin(), peq.end(),
+        [](const std::pair<CharType, uint64_t>& a, const std::pair<CharType, uint64_t>& b){
+            return a.first < b.first;
+        }
+    );
+    size_t unique = 0;
+    for (size_t j = 0; j < ylen; j++){
+        if (unique != 0 && peq[unique - 1].first == peq[j].first){
+            peq[unique - 1].second |= peq[j].second;
+        }else{
+            peq[unique++] = peq[j];
+        }
+    }
+    peq.resize(unique);
+
+    const uint64_t high_bit = (uint64_t)1 << (ylen - 1);
+    uint64_t pv = ~(uint64_t)0;
+    uint64_t mv = 0;
+    size_t score = ylen;
+    size_t min = ylen;
+
+    for (CharType ch : fullstring){
+        auto iter = std::lower_bound(
+            peq.begin(), peq.end(), ch,
+            [](const std::pair<CharType, uint64_t>& a, CharType b){
+                return a.first < b;
+            }
+        );
+        uint64_t eq = iter != peq.end() && iter->first == ch ? iter->second : 0;
+
+        uint64_t xv = eq | mv;
+        uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        uint64_t ph = mv | ~(xh | pv);
+        uint64_t mh = pv & xh;
+
+        if (ph & high_bit){
+            score++;
+        }else if (mh & high_bit){
+            score--;
+        }
+
+        //  The match may start anywhere in "fullstring", so the top row of the
+        //  table is all zeros and nothing is shifted in.
+        ph <<= 1;
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+
+        min = std::min(min, score);
+    }
+
+    return min;
+}
 template size_t levenshtein_distance<std::u32string>(const std::u32string& x, const std::u32string& y);
 template size_t levenshtein_distance_substring<std::u32string>(const std::u32string& x, const std::u32string& y);
+template size_t levenshtein_distance_substring_reference<std::u32string>(const std::u32string& x, const std::u32string& y);
 
 
 std::map<size_t, std::vector<uint64_t>> binomial_table;
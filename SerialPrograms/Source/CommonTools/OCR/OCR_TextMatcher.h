@@ -57,6 +57,12 @@ size_t levenshtein_distance(const StringType& x, const StringType& y);
 template <typename StringType>
 size_t levenshtein_distance_substring(const StringType& substring, const StringType& fullstring);
 
+// Same as levenshtein_distance_substring(). Uses the plain O(n*m) dynamic programming table
+// instead of the bit-parallel algorithm. Used for substrings longer than 64 characters and for
+// testing.
+template <typename StringType>
+size_t levenshtein_distance_substring_reference(const StringType& substring, const StringType& fullstring);
+
 // Calculate probability that a match of 'matched' characters out of 'total' occurred by random chance.
 // This uses the binomial cumulative distribution function (CDF) to determine statistical significance.
 // Mathematically equivalent to:
@@ -23,6 +23,16 @@ public:
 
     //  This is not const so that detectors can save/cache state.
     virtual bool detect(const ImageViewRGB32& screen) = 0;
+
+    //  Optional: Return the boxes that detect() looks at. If this is not
+    //  empty, DetectorToFinder will reuse the last result of detect() on
+    //  frames where none of the pixels in these boxes changed.
+    //
+    //  Only opt in if detect() depends on nothing else. Finders that override
+    //  process_frame() without calling DetectorToFinder::process_frame() will
+    //  just run detect() as usual.
+    virtual std::vector<ImageFloatBox> change_detection_boxes() const{ return {}; }
+
     //  Called this to lock in the detected state in the detector, if
     //  needed. Leave this function empty if you don't wish the derived
     //  class to "remember" past detection.
@@ -108,7 +118,7 @@ public:
         switch (m_finder_type){
         case FinderType::PRESENT:
         case FinderType::GONE:
-            if (this->detect(frame) == (m_finder_type == FinderType::GONE)){
+            if (detect_or_reuse(frame) == (m_finder_type == FinderType::GONE)){
                 m_start_of_detection = WallClock::min();
                 return false;
             }
@@ -118,12 +128,13 @@ public:
 
             if (timestamp - m_start_of_detection >= m_duration){
                 this->commit_state();
+                m_cached_detection = 0;
                 return true;
             }else{
                 return false;
             }
         case FinderType::CONSISTENT:{
-            const bool result = this->detect(frame);
+            const bool result = detect_or_reuse(frame);
             const bool result_changed = (result && m_last_detected < 0) || (!result && m_last_detected > 0);
 
             m_last_detected = (result ? 1 : -1);
@@ -140,6 +151,7 @@ public:
             if (enough_time){
                 m_consistent_result = m_last_detected > 0;
                 this->commit_state();
+                m_cached_detection = 0;
                 return true;
             }
             
@@ -150,6 +162,24 @@ public:
         return false;
     }
 
+    //  The pivot calls this when none of the detector's change detection boxes
+    //  changed. Run the finder as usual, but reuse the last result of
+    //  detect(). Time still moves forward so the hold duration is unaffected.
+    virtual std::vector<ImageFloatBox> change_detection_boxes() const override{
+        return Detector::change_detection_boxes();
+    }
+    virtual bool process_unchanged_frame(const VideoSnapshot& frame) override{
+        m_reuse_detection = true;
+        try{
+            bool ret = process_frame(frame);
+            m_reuse_detection = false;
+            return ret;
+        }catch (...){
+            m_reuse_detection = false;
+            throw;
+        }
+    }
+
     //  If m_finder_type is CONSISTENT and process_frame() returns true,
     //  whether it is consecutively detected , or consecutively not detected.
     bool consistent_result() const { return m_consistent_result; }
@@ -162,6 +192,17 @@ public:
         m_start_of_detection = WallClock::min();
         m_last_detected = 0;
         m_consistent_result = false;
+        m_cached_detection = 0;
+    }
+
+private:
+    bool detect_or_reuse(const ImageViewRGB32& frame){
+        if (m_reuse_detection && m_cached_detection != 0){
+            return m_cached_detection > 0;
+        }
+        bool detected = this->detect(frame);
+        m_cached_detection = detected ? 1 : -1;
+        return detected;
     }
 
 private:
@@ -170,6 +211,8 @@ private:
     WallClock m_start_of_detection = WallClock::min();
     int8_t m_last_detected = 0; // 0: no prior detection, 1: last detected positive, -1: last detected negative
     bool m_consistent_result = false;
+    bool m_reuse_detection = false;
+    int8_t m_cached_detection = 0; // 0: none, 1: last detect() was true, -1: last detect() was false
 };
 
 
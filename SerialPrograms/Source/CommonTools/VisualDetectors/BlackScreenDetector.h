@@ -31,6 +31,7 @@ public:
 
     virtual void make_overlays(VideoOverlaySet& items) const override;
     virtual bool detect(const ImageViewRGB32& screen) override;
+    virtual std::vector<ImageFloatBox> change_detection_boxes() const override{ return {m_box}; }
 
 private:
     Color m_color;
@@ -49,6 +50,7 @@ public:
 
     virtual void make_overlays(VideoOverlaySet& items) const override;
     virtual bool detect(const ImageViewRGB32& screen) override;
+    virtual std::vector<ImageFloatBox> change_detection_boxes() const override{ return {m_box}; }
 
 private:
     Color m_color;
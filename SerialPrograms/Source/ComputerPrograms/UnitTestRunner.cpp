@@ -6,16 +6,20 @@
 
 #include "Common/Cpp/ScopeExit.h"
 #include "Common/Cpp/PrettyPrint.h"
+#include "Common/Cpp/Json/JsonTools.h"
 #include "Common/Cpp/TestRunners/UnitTestDatabase.h"
 #include "CommonFramework/GlobalAutoPaths.h"
 #include "CommonFramework/ProgramStats/StatsTracking.h"
 #include "CommonFramework/Tools/GlobalThreadPools.h"
+#include "CommonTools/InferencePivots/VisualInferencePivot.h"
 #include "CommonTools/VisualDetectors/BlackBorderDetector.h"
 #include "NintendoSwitch/Inference/NintendoSwitch_CheckOnlineDetector.h"
 #include "NintendoSwitch/Inference/NintendoSwitch_FailedToConnectDetector.h"
 #include "NintendoSwitch/Inference/NintendoSwitch_UpdatePopupDetector.h"
+#include "Pokemon/Pokemon_AdvRng.h"
 #include "UnitTestRunner.h"
 
+#include "CommonTools/ImageMatch/ImageMatch_Tests.h"
 #include "CommonTools/OCR/OCR_Tests.h"
 #include "Kernels/Kernels_Tests.h"
 #include "PokemonFRLG/PokemonFRLG_Tests.h"
@@ -36,9 +40,13 @@ namespace ComputerPrograms{
 UnitTestDatabase make_UNIT_TESTS_ALL(){
     UnitTestDatabase ret;
 
+    add_tests_JsonTools(ret);
     add_tests_BlackBorderDetector(ret);
+    ImageMatch::add_tests(ret);
+    add_tests_VisualInferencePivot(ret);
     OCR::add_tests(ret);
     Kernels::add_tests(ret);
+    Pokemon::add_tests_AdvRng(ret);
     NintendoSwitch::add_tests_CheckOnlineDetector(ret);
     NintendoSwitch::add_tests_FailedToConnectDetector(ret);
     NintendoSwitch::add_tests_UpdatePopupDetector(ret);
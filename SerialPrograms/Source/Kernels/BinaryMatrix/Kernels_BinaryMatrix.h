@@ -124,6 +124,10 @@ public:
     virtual void operator|=(const PackedBinaryMatrix_IB& x) = 0;
     virtual void operator&=(const PackedBinaryMatrix_IB& x) = 0;
 
+    //  OR "x" into this matrix with its top-left corner at (offset_x, offset_y).
+    //  Bits that land outside this matrix are dropped.
+    virtual void or_shifted(const PackedBinaryMatrix_IB& x, size_t offset_x, size_t offset_y) = 0;
+
     // Print entire binary matrix as 0s and 1s. Rows are ended with "\n".
     virtual std::string dump() const = 0;
     // Print part of max as 0s and 1s. Rows are ended with "\n".
@@ -6,6 +6,7 @@
 
 #include "Common/Cpp/Color.h"
 #include "Common/Cpp/Time.h"
+#include "Common/Cpp/TestRunners/UnitTestDatabase.h"
 #include "CommonFramework/GlobalAutoPaths.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
@@ -20,6 +21,7 @@
 #include "Kernels_BinaryMatrix_Tests.h"
 
 #include <functional>
+#include <random>
 #include <iostream>
 using std::cout;
 using std::cerr;
@@ -416,8 +418,85 @@ private:
     std::string m_image;
 };
 
-void add_tests_BinaryMatrix(UnitTestDatabase& database){
+//  Compare PackedBinaryMatrix_IB::or_shifted() against a per-bit reference
+//  at widths and offsets that straddle the 64-bit words.
+class Test_BinaryMatrixOrShifted : public UnitTest{
+public:
+    Test_BinaryMatrixOrShifted()
+        : UnitTest("Kernels::BinaryMatrix - or_shifted")
+    {}
+
+    virtual UnitTestResult run(Logger& logger, CancellableScope& scope) const override{
+        std::vector<BinaryMatrixType> types{BinaryMatrixType::i64x4_Default, BinaryMatrixType::i64x8_Default};
+        if (get_BinaryMatrixType() != BinaryMatrixType::i64x4_Default){
+            types.emplace_back(get_BinaryMatrixType());
+        }
+
+        std::mt19937 rng(0);
+        size_t error_count = 0;
+        for (BinaryMatrixType type : types){
+            for (size_t iter = 0; iter < 200; iter++){
+                size_t dst_width = 1 + rng() % 200;
+                size_t dst_height = 1 + rng() % 40;
+                size_t src_width = 1 + rng() % 200;
+                size_t src_height = 1 + rng() % 40;
+                size_t offset_x = rng() % (dst_width + 10);
+                size_t offset_y = rng() % (dst_height + 4);
+
+                std::unique_ptr<PackedBinaryMatrix_IB> dst = make_PackedBinaryMatrix(type, dst_width, dst_height);
+                std::unique_ptr<PackedBinaryMatrix_IB> src = make_PackedBinaryMatrix(type, src_width, src_height);
+                dst->set_zero();
+                src->set_ones();    //  Dirty the padding so any leak shows up.
+                for (size_t y = 0; y < dst_height; y++){
+                    for (size_t x = 0; x < dst_width; x++){
+                        dst->set(x, y, rng() % 4 == 0);
+                    }
+                }
+                for (size_t y = 0; y < src_height; y++){
+                    for (size_t x = 0; x < src_width; x++){
+                        src->set(x, y, rng() % 2 == 0);
+                    }
+                }
 
+                std::unique_ptr<PackedBinaryMatrix_IB> expected = dst->clone();
+                for (size_t y = 0; y < src_height; y++){
+                    for (size_t x = 0; x < src_width; x++){
+                        size_t dst_x = offset_x + x;
+                        size_t dst_y = offset_y + y;
+                        if (dst_x < dst_width && dst_y < dst_height && src->get(x, y)){
+                            expected->set(dst_x, dst_y, true);
+                        }
+                    }
+                }
+
+                dst->or_shifted(*src, offset_x, offset_y);
+
+                //  Padding bits must stay clear or they leak into later waterfills.
+                std::unique_ptr<PackedBinaryMatrix_IB> padded = make_PackedBinaryMatrix(type, dst_width + 64, dst_height);
+                padded->set_zero();
+                padded->or_shifted(*dst, 0, 0);
+
+                for (size_t y = 0; y < dst_height; y++){
+                    for (size_t x = 0; x < dst_width + 64; x++){
+                        bool want = x < dst_width && expected->get(x, y);
+                        if (padded->get(x, y) != want && error_count++ < 10){
+                            cout << "Error: or_shifted() " << src_width << " x " << src_height
+                                << " onto " << dst_width << " x " << dst_height
+                                << " at (" << offset_x << ", " << offset_y << "): bit ("
+                                << x << ", " << y << ") should be " << want << endl;
+                        }
+                    }
+                }
+            }
+        }
+
+        return error_count == 0;
+    };
+};
+
+
+void add_tests_BinaryMatrix(UnitTestDatabase& database){
+    database.add<Test_BinaryMatrixOrShifted>();
 }
 
 
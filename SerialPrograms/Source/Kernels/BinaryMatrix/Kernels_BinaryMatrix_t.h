@@ -70,6 +70,12 @@ public:
         }
         m_matrix &= static_cast<const PackedBinaryMatrix_t<Tile>&>(x).m_matrix;
     }
+    virtual void or_shifted(const PackedBinaryMatrix_IB& x, size_t offset_x, size_t offset_y) override{
+        if (this->type() != x.type()){
+            throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Mismatching matrix types.");
+        }
+        m_matrix.or_shifted(static_cast<const PackedBinaryMatrix_t<Tile>&>(x).m_matrix, offset_x, offset_y);
+    }
 
     // Print entire binary matrix as 0s and 1s. Rows are ended with "\n".
     virtual std::string dump() const override{ return m_matrix.dump(); }
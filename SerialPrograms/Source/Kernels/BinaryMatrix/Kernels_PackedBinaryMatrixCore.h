@@ -71,6 +71,10 @@ public:
     void operator|=(const PackedBinaryMatrixCore& x);
     void operator&=(const PackedBinaryMatrixCore& x);
 
+    //  OR "x" into this matrix with its top-left corner at (offset_x, offset_y).
+    //  Bits that land outside this matrix are dropped.
+    void or_shifted(const PackedBinaryMatrixCore& x, size_t offset_x, size_t offset_y);
+
 public:
     // How many pixels in an image row, which is equal to how many bits in a binary matrix row 
     size_t width() const{ return m_logical_width; }
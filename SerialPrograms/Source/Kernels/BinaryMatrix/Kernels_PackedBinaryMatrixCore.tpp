@@ -208,6 +208,46 @@ void PackedBinaryMatrixCore<Tile>::operator&=(const PackedBinaryMatrixCore& x){
         m_data[c] &= x.m_data[c];
     }
 }
+template <typename Tile>
+void PackedBinaryMatrixCore<Tile>::or_shifted(const PackedBinaryMatrixCore& x, size_t offset_x, size_t offset_y){
+    static_assert(TILE_WIDTH == 64);
+    if (offset_x >= m_logical_width || offset_y >= m_logical_height){
+        return;
+    }
+
+    size_t height = std::min(x.m_logical_height, m_logical_height - offset_y);
+    size_t src_words = x.word64_width();
+    size_t word_x = offset_x / 64;
+    size_t shift = offset_x % 64;
+
+    //  Don't pick up the padding of "x" or spill into our own.
+    size_t src_bits = x.m_logical_width % 64;
+    uint64_t src_mask = src_bits == 0 ? (uint64_t)-1 : ((uint64_t)1 << src_bits) - 1;
+    size_t dst_bits = m_logical_width % 64;
+    uint64_t dst_mask = dst_bits == 0 ? (uint64_t)-1 : ((uint64_t)1 << dst_bits) - 1;
+
+    for (size_t r = 0; r < height; r++){
+        size_t dst_y = offset_y + r;
+        for (size_t c = 0; c < src_words; c++){
+            size_t dst_x = word_x + c;
+            if (dst_x >= m_tile_width){
+                break;
+            }
+            uint64_t bits = x.word64(c, r);
+            if (c + 1 == src_words){
+                bits &= src_mask;
+            }
+
+            uint64_t lo = bits << shift;
+            word64(dst_x, dst_y) |= dst_x + 1 == m_tile_width ? lo & dst_mask : lo;
+
+            if (shift != 0 && dst_x + 1 < m_tile_width){
+                uint64_t hi = bits >> (64 - shift);
+                word64(dst_x + 1, dst_y) |= dst_x + 2 == m_tile_width ? hi & dst_mask : hi;
+            }
+        }
+    }
+}
 
 
 
@@ -301,12 +341,16 @@ PackedBinaryMatrixCore<Tile> PackedBinaryMatrixCore<Tile>::submatrix(
 
 #if 1
     size_t wbits = width % TILE_WIDTH;
-    for (size_t r = 0; r < tile_height; r++){
-        ret.tile(tile_width - 1, r).clear_padding(wbits, TILE_HEIGHT);
+    if (wbits != 0){
+        for (size_t r = 0; r < tile_height; r++){
+            ret.tile(tile_width - 1, r).clear_padding(wbits, TILE_HEIGHT);
+        }
     }
     size_t hbits = height % TILE_HEIGHT;
-    for (size_t c = 0; c < tile_width; c++){
-        ret.tile(c, tile_height - 1).clear_padding(TILE_WIDTH, hbits);
+    if (hbits != 0){
+        for (size_t c = 0; c < tile_width; c++){
+            ret.tile(c, tile_height - 1).clear_padding(TILE_WIDTH, hbits);
+        }
     }
 #endif
 
@@ -6,10 +6,12 @@
 
 #include "Common/Cpp/Color.h"
 #include "Common/Cpp/Time.h"
+#include "Common/Cpp/TestRunners/UnitTestDatabase.h"
 #include "CommonFramework/GlobalAutoPaths.h"
 #include "CommonFramework/ImageTypes/BinaryImage.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
 #include "CommonFramework/ImageTypes/ImageViewRGB32.h"
+#include "CommonFramework/ImageTypes/ImageHSV32.h"
 #include "Kernels/BinaryMatrix/Kernels_BinaryMatrix.h"
 #ifdef PA_AutoDispatch_arm64_20_M1
 #include "Kernels/BinaryMatrix/Kernels_BinaryMatrixTile_64x8_arm64_NEON.h"
@@ -20,6 +22,7 @@
 #include "Kernels/BinaryImageFilters/Kernels_BinaryImage_BasicFilters.h"
 #include "Kernels/ImageFilters/RGB32_Range/Kernels_ImageFilter_RGB32_Range.h"
 #include "Kernels/ImageFilters/RGB32_EuclideanDistance/Kernels_ImageFilter_RGB32_Euclidean.h"
+#include "Kernels/ImageFilters/RGB32_HSV/Kernels_ImageFilter_RGB32_HSV.h"
 #include "Kernels_ImageFilter_Tests.h"
 #include "Tests/TestUtils.h"
 
@@ -584,12 +587,150 @@ private:
 
 
 
+//  An image that contains every RGB color once with varying alpha.
+ImageRGB32 make_all_rgb32_colors_image(){
+    ImageRGB32 image(4096, 4096);
+    for (size_t y = 0; y < 4096; y++){
+        for (size_t x = 0; x < 4096; x++){
+            uint32_t rgb = (uint32_t)(y * 4096 + x);
+            uint32_t alpha = (uint32_t)(x * 7 + y * 13) << 24;
+            image.pixel(x, y) = alpha | rgb;
+        }
+    }
+    return image;
+}
 
 
-void add_tests_ImageFilters(UnitTestDatabase& database){
+class Test_ImageRGB32ToHSV32 : public UnitTest{
+public:
+    Test_ImageRGB32ToHSV32()
+        : UnitTest("Kernels::ImageRGB32ToHSV32")
+    {}
+
+    virtual UnitTestResult run(Logger& logger, CancellableScope& scope) const override{
+        ImageRGB32 image = make_all_rgb32_colors_image();
+        const size_t width = image.width(), height = image.height();
+        cout << "Testing rgb32_to_hsv32(), image size " << width << " x " << height << endl;
+
+        auto time_start = current_time();
+        ImageHSV32 hsv(image);
+        auto time_end = current_time();
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(time_end - time_start).count();
+        cout << "Kernel time: " << ns / 1000000. << " ms" << endl;
+
+        size_t error_count = 0;
+        time_start = current_time();
+        for (size_t y = 0; y < height; y++){
+            for (size_t x = 0; x < width; x++){
+                uint32_t expected = rgb32_to_hsv32_reference(image.pixel(x, y));
+                uint32_t actual = hsv.pixel(x, y);
+                if (expected != actual && error_count++ < 10){
+                    cout << "Error: wrong HSV at (x,y) = (" << x << ", " << y << "), RGB "
+                        << Color(image.pixel(x, y)).to_string() << ", expected "
+                        << Color(expected).to_string() << ", actual " << Color(actual).to_string() << endl;
+                }
+            }
+        }
+        time_end = current_time();
+        ns = std::chrono::duration_cast<std::chrono::nanoseconds>(time_end - time_start).count();
+        cout << "Scalar time: " << ns / 1000000. << " ms" << endl;
+
+        //  Sub-views with every partial vector width and unaligned starts.
+        for (size_t w = 1; w <= 40; w++){
+            ImageViewRGB32 sub = image.sub_image(w * 97 + 1, w * 89, w, 5);
+            ImageHSV32 sub_hsv(sub);
+            for (size_t y = 0; y < sub.height(); y++){
+                for (size_t x = 0; x < sub.width(); x++){
+                    uint32_t expected = rgb32_to_hsv32_reference(sub.pixel(x, y));
+                    uint32_t actual = sub_hsv.pixel(x, y);
+                    if (expected != actual && error_count++ < 10){
+                        cout << "Error: wrong HSV in sub-image of width " << w << " at (x,y) = (" << x << ", " << y << ")"
+                            << ", expected " << Color(expected).to_string() << ", actual " << Color(actual).to_string() << endl;
+                    }
+                }
+            }
+        }
+
+        return error_count == 0;
+    };
+};
+
+
+class Test_ImageFilterRGB32HsvRange : public UnitTest{
+public:
+    Test_ImageFilterRGB32HsvRange()
+        : UnitTest("Kernels::ImageFilterRGB32HsvRange")
+    {}
+
+    virtual UnitTestResult run(Logger& logger, CancellableScope& scope) const override{
+        ImageRGB32 image = make_all_rgb32_colors_image();
+        ImageViewRGB32 view = image.sub_image(3, 5, 4089, 4091);
+        const size_t width = view.width(), height = view.height();
+        cout << "Testing filter_rgb32_hsv_range(), image size " << width << " x " << height << endl;
+
+        //  H in [20, 60], S in [100, 255], V in [50, 220], any alpha.
+        const uint32_t mins = 0x00146432;
+        const uint32_t maxs = 0xff3cffdc;
+
+        ImageRGB32 image_out(width, height);
+        ImageRGB32 image_out_bw(width, height);
+
+        auto time_start = current_time();
+        size_t pixels_in_range = Kernels::filter_rgb32_hsv_range(
+            view.data(), view.bytes_per_row(), width, height,
+            image_out.data(), image_out.bytes_per_row(),
+            (uint32_t)COLOR_WHITE, true,
+            mins, maxs
+        );
+        auto time_end = current_time();
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(time_end - time_start).count();
+        cout << "One filter time: " << ns / 1000000. << " ms" << endl;
+
+        size_t pixels_in_range_bw = Kernels::to_blackwhite_rgb32_hsv_range(
+            view.data(), view.bytes_per_row(), width, height,
+            image_out_bw.data(), image_out_bw.bytes_per_row(),
+            true,
+            mins, maxs
+        );
+        TEST_RESULT_EQUAL_STR(pixels_in_range, pixels_in_range_bw);
+
+        size_t actual_num_pixels_in_range = 0;
+        size_t error_count = 0;
+        for (size_t y = 0; y < height; y++){
+            for (size_t x = 0; x < width; x++){
+                const uint32_t pixel = view.pixel(x, y);
+                const uint32_t hsv = rgb32_to_hsv32_reference(pixel);
+                bool in_range = true;
+                for (int shift = 0; shift < 32; shift += 8){
+                    uint32_t c = (hsv >> shift) & 0xff;
+                    in_range &= ((mins >> shift) & 0xff) <= c && c <= ((maxs >> shift) & 0xff);
+                }
+                actual_num_pixels_in_range += in_range;
+
+                const Color new_color(image_out.pixel(x, y));
+                const Color new_color_bw(image_out_bw.pixel(x, y));
+                const Color expected = in_range ? COLOR_WHITE : Color(pixel);
+                const Color expected_bw = in_range ? COLOR_BLACK : COLOR_WHITE;
+                if ((new_color != expected || new_color_bw != expected_bw) && error_count++ < 10){
+                    cout << "Error: wrong filter result: old color " << Color(pixel).to_string()
+                        << ", HSV " << Color(hsv).to_string() << ", (x,y) = (" << x << ", " << y << ")"
+                        << ", should be " << (in_range ? "in" : "out of") << " range" << endl;
+                }
+            }
+        }
+        cout << "Found " << actual_num_pixels_in_range << " pixels in range" << endl;
+        TEST_RESULT_EQUAL_STR(pixels_in_range, actual_num_pixels_in_range);
+
+        return error_count == 0;
+    };
+};
 
 
 
+
+void add_tests_ImageFilters(UnitTestDatabase& database){
+    database.add<Test_ImageRGB32ToHSV32>();
+    database.add<Test_ImageFilterRGB32HsvRange>();
 }
 
 
@@ -0,0 +1,260 @@
+/*  Image Filters RGB32 HSV
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/CpuId/CpuId.h"
+#include "Kernels_ImageFilter_RGB32_HSV.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+void rgb32_to_hsv32_Default(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row
+);
+void rgb32_to_hsv32_x64_SSE42(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row
+);
+void rgb32_to_hsv32_x64_AVX2(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row
+);
+void rgb32_to_hsv32_x64_AVX512(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row
+);
+void rgb32_to_hsv32_arm64_NEON(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row
+);
+void rgb32_to_hsv32(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row
+){
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    if (CPU_CAPABILITY_CURRENT.OK_17_Skylake){
+        rgb32_to_hsv32_x64_AVX512(
+            in, in_bytes_per_row, width, height,
+            out, out_bytes_per_row
+        );
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        rgb32_to_hsv32_x64_AVX2(
+            in, in_bytes_per_row, width, height,
+            out, out_bytes_per_row
+        );
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        rgb32_to_hsv32_x64_SSE42(
+            in, in_bytes_per_row, width, height,
+            out, out_bytes_per_row
+        );
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    if (CPU_CAPABILITY_CURRENT.OK_M1){
+        rgb32_to_hsv32_arm64_NEON(
+            in, in_bytes_per_row, width, height,
+            out, out_bytes_per_row
+        );
+        return;
+    }
+#endif
+    rgb32_to_hsv32_Default(
+        in, in_bytes_per_row, width, height,
+        out, out_bytes_per_row
+    );
+}
+
+
+size_t filter_rgb32_hsv_range_Default(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    uint32_t replacement, bool replace_color_within_range,
+    uint32_t mins, uint32_t maxs
+);
+size_t filter_rgb32_hsv_range_x64_SSE42(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    uint32_t replacement, bool replace_color_within_range,
+    uint32_t mins, uint32_t maxs
+);
+size_t filter_rgb32_hsv_range_x64_AVX2(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    uint32_t replacement, bool replace_color_within_range,
+    uint32_t mins, uint32_t maxs
+);
+size_t filter_rgb32_hsv_range_x64_AVX512(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    uint32_t replacement, bool replace_color_within_range,
+    uint32_t mins, uint32_t maxs
+);
+size_t filter_rgb32_hsv_range_arm64_NEON(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    uint32_t replacement, bool replace_color_within_range,
+    uint32_t mins, uint32_t maxs
+);
+size_t filter_rgb32_hsv_range(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    uint32_t replacement, bool replace_color_within_range,
+    uint32_t mins, uint32_t maxs
+){
+    if (width * height > 0xffffffff){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Image is too large. more than 2^32 pixels.");
+    }
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    if (CPU_CAPABILITY_CURRENT.OK_17_Skylake){
+        return filter_rgb32_hsv_range_x64_AVX512(
+            in, in_bytes_per_row, width, height,
+            out, out_bytes_per_row,
+            replacement, replace_color_within_range,
+            mins, maxs
+        );
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        return filter_rgb32_hsv_range_x64_AVX2(
+            in, in_bytes_per_row, width, height,
+            out, out_bytes_per_row,
+            replacement, replace_color_within_range,
+            mins, maxs
+        );
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        return filter_rgb32_hsv_range_x64_SSE42(
+            in, in_bytes_per_row, width, height,
+            out, out_bytes_per_row,
+            replacement, replace_color_within_range,
+            mins, maxs
+        );
+    }
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    if (CPU_CAPABILITY_CURRENT.OK_M1){
+        return filter_rgb32_hsv_range_arm64_NEON(
+            in, in_bytes_per_row, width, height,
+            out, out_bytes_per_row,
+            replacement, replace_color_within_range,
+            mins, maxs
+        );
+    }
+#endif
+    return filter_rgb32_hsv_range_Default(
+        in, in_bytes_per_row, width, height,
+        out, out_bytes_per_row,
+        replacement, replace_color_within_range,
+        mins, maxs
+    );
+}
+
+
+size_t to_blackwhite_rgb32_hsv_range_Default(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    bool in_range_black,
+    uint32_t mins, uint32_t maxs
+);
+size_t to_blackwhite_rgb32_hsv_range_x64_SSE42(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    bool in_range_black,
+    uint32_t mins, uint32_t maxs
+);
+size_t to_blackwhite_rgb32_hsv_range_x64_AVX2(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    bool in_range_black,
+    uint32_t mins, uint32_t maxs
+);
+size_t to_blackwhite_rgb32_hsv_range_x64_AVX512(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    bool in_range_black,
+    uint32_t mins, uint32_t maxs
+);
+size_t to_blackwhite_rgb32_hsv_range_arm64_NEON(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    bool in_range_black,
+    uint32_t mins, uint32_t maxs
+);
+size_t to_blackwhite_rgb32_hsv_range(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    bool in_range_black,
+    uint32_t mins, uint32_t maxs
+){
+    if (width * height > 0xffffffff){
+        throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Image is too large. more than 2^32 pixels.");
+    }
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    if (CPU_CAPABILITY_CURRENT.OK_17_Skylake){
+        return to_blackwhite_rgb32_hsv_range_x64_AVX512(
+            in, in_bytes_per_row, width, height,
+            out, out_bytes_per_row,
+            in_range_black,
+            mins, maxs
+        );
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        return to_blackwhite_rgb32_hsv_range_x64_AVX2(
+            in, in_bytes_per_row, width, height,
+            out, out_bytes_per_row,
+            in_range_black,
+            mins, maxs
+        );
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        return to_blackwhite_rgb32_hsv_range_x64_SSE42(
+            in, in_bytes_per_row, width, height,
+            out, out_bytes_per_row,
+            in_range_black,
+            mins, maxs
+        );
+    }
+#endif
+#ifdef PA_AutoDispatch_arm64_20_M1
+    if (CPU_CAPABILITY_CURRENT.OK_M1){
+        return to_blackwhite_rgb32_hsv_range_arm64_NEON(
+            in, in_bytes_per_row, width, height,
+            out, out_bytes_per_row,
+            in_range_black,
+            mins, maxs
+        );
+    }
+#endif
+    return to_blackwhite_rgb32_hsv_range_Default(
+        in, in_bytes_per_row, width, height,
+        out, out_bytes_per_row,
+        in_range_black,
+        mins, maxs
+    );
+}
+
+
+
+}
+}
@@ -0,0 +1,59 @@
+/*  Image Filters RGB32 HSV
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *  Convert RGB32 images to HSV32 and filter RGB32 images by HSV range.
+ *
+ *  HSV32 pixel layout: alpha is preserved, H is stored in the red byte
+ *  and spans [0, 256) over the full hue circle, S is in the green byte and
+ *  V is in the blue byte.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageFilter_RGB32_HSV_H
+#define PokemonAutomation_Kernels_ImageFilter_RGB32_HSV_H
+
+#include <stdint.h>
+#include <cstddef>
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  Convert the RGB32 image `in` into HSV32 and save it to `out`.
+//  Every implementation is bit-exact with the scalar conversion.
+void rgb32_to_hsv32(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row
+);
+
+
+//  Same as "filter_rgb32_range()", but [mins, maxs] is an HSV32 range.
+//  The pixels are converted to HSV on the fly and the output is RGB32.
+//  If `replace_color_within_range` is true, replace the color within range [mins, maxs] with the color `replacement`.
+//  If `replace_color_within_range` is false, replace the color outside of the range with the color `replacement`.
+//  Returns the # of pixels inside the range [mins, maxs].
+size_t filter_rgb32_hsv_range(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    uint32_t replacement, bool replace_color_within_range,
+    uint32_t mins, uint32_t maxs
+);
+
+
+//  Same as "to_blackwhite_rgb32_range()", but [mins, maxs] is an HSV32 range.
+//  If `in_range_black` is true, pixels inside the range become black and the
+//  rest become white. Otherwise the opposite.
+//  Returns the # of pixels inside the range [mins, maxs].
+size_t to_blackwhite_rgb32_hsv_range(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    bool in_range_black,
+    uint32_t mins, uint32_t maxs
+);
+
+
+
+}
+}
+#endif
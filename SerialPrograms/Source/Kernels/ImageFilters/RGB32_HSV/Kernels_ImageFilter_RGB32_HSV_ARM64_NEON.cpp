@@ -0,0 +1,153 @@
+/*  Image Filters RGB32 HSV
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifdef PA_AutoDispatch_arm64_20_M1
+
+#include <string.h>
+#include "Kernels/Kernels_arm64_NEON.h"
+#include "Kernels/ImageFilters/Kernels_ImageFilter_Basic_Routines.h"
+#include "Kernels/ImageFilters/Kernels_ImageFilter_Basic_Routines_ARM64_NEON.h"
+#include "Kernels_ImageFilter_RGB32_HSV.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+
+//  See "Kernels_ImageFilter_RGB32_HSV_Routines.h" for the math.
+PA_FORCE_INLINE uint32x4_t rgb32_to_hsv32_pixel_arm64_NEON(uint32x4_t pixel){
+    const uint32x4_t mask8 = vdupq_n_u32(0x000000ff);
+    const uint32x4_t ones = vdupq_n_u32(1);
+    uint32x4_t r = vandq_u32(vshrq_n_u32(pixel, 16), mask8);
+    uint32x4_t g = vandq_u32(vshrq_n_u32(pixel, 8), mask8);
+    uint32x4_t b = vandq_u32(pixel, mask8);
+
+    uint32x4_t M = vmaxq_u32(vmaxq_u32(r, g), b);
+    uint32x4_t m = vminq_u32(vminq_u32(r, g), b);
+    uint32x4_t delta = vsubq_u32(M, m);
+
+    //  S = 255 - (255*m + M/2) / M
+    uint32x4_t num = vsubq_u32(vshlq_n_u32(m, 8), m);
+    num = vaddq_u32(num, vshrq_n_u32(M, 1));
+    float32x4_t quot = vdivq_f32(vcvtq_f32_u32(num), vcvtq_f32_u32(vmaxq_u32(M, ones)));
+    uint32x4_t S = vsubq_u32(mask8, vcvtq_u32_f32(quot));
+    S = vandq_u32(S, vtstq_u32(M, M));
+
+    //  H = (256*T + 3*d) / (6*d)
+    uint32x4_t delta2 = vaddq_u32(delta, delta);
+    uint32x4_t delta4 = vaddq_u32(delta2, delta2);
+    uint32x4_t delta6 = vaddq_u32(delta4, delta2);
+
+    uint32x4_t Tr = vsubq_u32(g, b);
+    Tr = vaddq_u32(Tr, vandq_u32(vcgtq_u32(b, g), delta6));
+    uint32x4_t Tg = vaddq_u32(delta2, vsubq_u32(b, r));
+    uint32x4_t Tb = vaddq_u32(delta4, vsubq_u32(r, g));
+
+    uint32x4_t T = vbslq_u32(vceqq_u32(M, g), Tg, Tb);
+    T = vbslq_u32(vceqq_u32(M, r), Tr, T);
+
+    num = vaddq_u32(vshlq_n_u32(T, 8), vaddq_u32(delta2, delta));
+    quot = vdivq_f32(vcvtq_f32_u32(num), vcvtq_f32_u32(vmaxq_u32(delta6, ones)));
+    uint32x4_t H = vandq_u32(vcvtq_u32_f32(quot), mask8);
+
+    pixel = vandq_u32(pixel, vdupq_n_u32(0xff000000));
+    pixel = vorrq_u32(pixel, vshlq_n_u32(H, 16));
+    pixel = vorrq_u32(pixel, vshlq_n_u32(S, 8));
+    pixel = vorrq_u32(pixel, M);
+    return pixel;
+}
+
+
+
+class ConvertRgb32ToHsv32_ARM64_NEON{
+public:
+    static const size_t VECTOR_SIZE = 4;
+    using Mask = size_t;
+
+public:
+    PA_FORCE_INLINE void process_full(uint32_t* out, const uint32_t* in){
+        uint32x4_t pixel = vld1q_u32(in);
+        vst1q_u32(out, rgb32_to_hsv32_pixel_arm64_NEON(pixel));
+    }
+    PA_FORCE_INLINE void process_partial(uint32_t* out, const uint32_t* in, size_t left){
+        uint32_t buffer_in[4] = {}, buffer_out[4];
+        memcpy(buffer_in, in, sizeof(uint32_t) * left);
+        process_full(buffer_out, buffer_in);
+        memcpy(out, buffer_out, sizeof(uint32_t) * left);
+    }
+};
+
+
+
+class PixelTest_Rgb32HsvRange_ARM64_NEON{
+public:
+    static const size_t VECTOR_SIZE = 4;
+    using Mask = size_t;
+
+public:
+    PA_FORCE_INLINE PixelTest_Rgb32HsvRange_ARM64_NEON(
+        uint32_t mins, uint32_t maxs
+    )
+        : m_mins_u8(vreinterpretq_u8_u32(vdupq_n_u32(mins)))
+        , m_maxs_u8(vreinterpretq_u8_u32(vdupq_n_u32(maxs)))
+    {}
+
+    //  Return a mask indicating which lanes are in range.
+    PA_FORCE_INLINE uint32x4_t test_word(uint32x4_t& pixel) const{
+        uint8x16_t in_u8 = vreinterpretq_u8_u32(rgb32_to_hsv32_pixel_arm64_NEON(pixel));
+        uint8x16_t cmp0 = vcgtq_u8(m_mins_u8, in_u8);
+        uint8x16_t cmp1 = vcgtq_u8(in_u8, m_maxs_u8);
+        uint8x16_t cmp_u8 = vorrq_u8(cmp0, cmp1);
+        return vceqq_u32(vreinterpretq_u32_u8(cmp_u8), vdupq_n_u32(0));
+    }
+
+private:
+    uint8x16_t m_mins_u8;
+    uint8x16_t m_maxs_u8;
+};
+
+
+
+void rgb32_to_hsv32_arm64_NEON(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row
+){
+    ConvertRgb32ToHsv32_ARM64_NEON converter;
+    filter_per_pixel(in, in_bytes_per_row, width, height, converter, out, out_bytes_per_row);
+}
+size_t filter_rgb32_hsv_range_arm64_NEON(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    uint32_t replacement, bool replace_color_within_range,
+    uint32_t mins, uint32_t maxs
+){
+    PixelTest_Rgb32HsvRange_ARM64_NEON tester(mins, maxs);
+    FilterImage_Rgb32_ARM64_NEON<PixelTest_Rgb32HsvRange_ARM64_NEON> filter(
+        tester,
+        replacement, replace_color_within_range
+    );
+    filter_per_pixel(in, in_bytes_per_row, width, height, filter, out, out_bytes_per_row);
+    return filter.count();
+}
+size_t to_blackwhite_rgb32_hsv_range_arm64_NEON(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    bool in_range_black,
+    uint32_t mins, uint32_t maxs
+){
+    PixelTest_Rgb32HsvRange_ARM64_NEON tester(mins, maxs);
+    ToBlackWhite_Rgb32_ARM64_NEON<PixelTest_Rgb32HsvRange_ARM64_NEON> filter(
+        tester, in_range_black
+    );
+    filter_per_pixel(in, in_bytes_per_row, width, height, filter, out, out_bytes_per_row);
+    return filter.count();
+}
+
+
+
+}
+}
+#endif
@@ -0,0 +1,74 @@
+/*  Image Filters RGB32 HSV Routines
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *  The integer form of the RGB -> HSV conversion that all the kernels use.
+ *
+ *  With M = max(r, g, b), m = min(r, g, b) and d = M - m:
+ *
+ *      V = M
+ *      S = 255 - (255*m + M/2) / M                     (0 if M == 0)
+ *      H = ((256*T + 3*d) / (6*d)) % 256               (0 if d == 0)
+ *
+ *  where T/d is the hue sextant position in [0, 6):
+ *
+ *      M == r  ->  T = g - b   (+ 6*d if g < b)
+ *      M == g  ->  T = 2*d + b - r
+ *      else    ->  T = 4*d + r - g
+ *
+ *  This is exactly "round(hue * 256 / 6) % 256" without any floating-point.
+ *  Both numerators are less than 2^24 and the quotients are never within
+ *  2^-24 of an integer. So the SIMD kernels may compute them with a single
+ *  correctly-rounded float division followed by truncation and still be
+ *  bit-exact with the integer version.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageFilter_RGB32_HSV_Routines_H
+#define PokemonAutomation_Kernels_ImageFilter_RGB32_HSV_Routines_H
+
+#include <stdint.h>
+#include "Common/Compiler.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+
+PA_FORCE_INLINE uint32_t rgb32_to_hsv32_pixel_Default(uint32_t pixel){
+    uint32_t r = (pixel >> 16) & 0xff;
+    uint32_t g = (pixel >>  8) & 0xff;
+    uint32_t b = pixel & 0xff;
+
+    uint32_t M = r > g ? r : g;
+    M = M > b ? M : b;
+    uint32_t m = r < g ? r : g;
+    m = m < b ? m : b;
+    uint32_t delta = M - m;
+
+    uint32_t S = 0;
+    if (M != 0){
+        S = 255 - (m * 255 + M / 2) / M;
+    }
+
+    uint32_t H = 0;
+    if (delta != 0){
+        uint32_t T;
+        if (M == r){
+            T = g >= b ? g - b : 6*delta + g - b;
+        }else if (M == g){
+            T = 2*delta + b - r;
+        }else{
+            T = 4*delta + r - g;
+        }
+        H = ((256*T + 3*delta) / (6*delta)) & 0xff;
+    }
+
+    return (pixel & 0xff000000) | (H << 16) | (S << 8) | M;
+}
+
+
+
+}
+}
+#endif
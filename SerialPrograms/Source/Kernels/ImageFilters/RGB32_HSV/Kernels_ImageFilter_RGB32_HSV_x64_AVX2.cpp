@@ -0,0 +1,158 @@
+/*  Image Filters RGB32 HSV
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_13_Haswell
+
+#include <immintrin.h>
+#include "Kernels/ImageFilters/Kernels_ImageFilter_Basic_Routines.h"
+#include "Kernels/ImageFilters/Kernels_ImageFilter_Basic_Routines_x64_AVX2.h"
+#include "Kernels_ImageFilter_RGB32_HSV.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+
+//  See "Kernels_ImageFilter_RGB32_HSV_Routines.h" for the math.
+PA_FORCE_INLINE __m256i rgb32_to_hsv32_pixel_x64_AVX2(__m256i pixel){
+    const __m256i mask8 = _mm256_set1_epi32(0x000000ff);
+    __m256i r = _mm256_and_si256(_mm256_srli_epi32(pixel, 16), mask8);
+    __m256i g = _mm256_and_si256(_mm256_srli_epi32(pixel, 8), mask8);
+    __m256i b = _mm256_and_si256(pixel, mask8);
+
+    __m256i M = _mm256_max_epi32(_mm256_max_epi32(r, g), b);
+    __m256i m = _mm256_min_epi32(_mm256_min_epi32(r, g), b);
+    __m256i delta = _mm256_sub_epi32(M, m);
+
+    //  S = 255 - (255*m + M/2) / M
+    __m256i num = _mm256_sub_epi32(_mm256_slli_epi32(m, 8), m);
+    num = _mm256_add_epi32(num, _mm256_srli_epi32(M, 1));
+    __m256 quot = _mm256_div_ps(
+        _mm256_cvtepi32_ps(num),
+        _mm256_cvtepi32_ps(_mm256_max_epi32(M, _mm256_set1_epi32(1)))
+    );
+    __m256i S = _mm256_sub_epi32(mask8, _mm256_cvttps_epi32(quot));
+    S = _mm256_andnot_si256(_mm256_cmpeq_epi32(M, _mm256_setzero_si256()), S);
+
+    //  H = (256*T + 3*d) / (6*d)
+    __m256i delta2 = _mm256_add_epi32(delta, delta);
+    __m256i delta4 = _mm256_add_epi32(delta2, delta2);
+    __m256i delta6 = _mm256_add_epi32(delta4, delta2);
+
+    __m256i Tr = _mm256_sub_epi32(g, b);
+    Tr = _mm256_add_epi32(Tr, _mm256_and_si256(_mm256_cmpgt_epi32(b, g), delta6));
+    __m256i Tg = _mm256_add_epi32(delta2, _mm256_sub_epi32(b, r));
+    __m256i Tb = _mm256_add_epi32(delta4, _mm256_sub_epi32(r, g));
+
+    __m256i T = _mm256_blendv_epi8(Tb, Tg, _mm256_cmpeq_epi32(M, g));
+    T = _mm256_blendv_epi8(T, Tr, _mm256_cmpeq_epi32(M, r));
+
+    num = _mm256_add_epi32(_mm256_slli_epi32(T, 8), _mm256_add_epi32(delta2, delta));
+    quot = _mm256_div_ps(
+        _mm256_cvtepi32_ps(num),
+        _mm256_cvtepi32_ps(_mm256_max_epi32(delta6, _mm256_set1_epi32(1)))
+    );
+    __m256i H = _mm256_and_si256(_mm256_cvttps_epi32(quot), mask8);
+
+    pixel = _mm256_and_si256(pixel, _mm256_set1_epi32(0xff000000));
+    pixel = _mm256_or_si256(pixel, _mm256_slli_epi32(H, 16));
+    pixel = _mm256_or_si256(pixel, _mm256_slli_epi32(S, 8));
+    pixel = _mm256_or_si256(pixel, M);
+    return pixel;
+}
+
+
+
+class ConvertRgb32ToHsv32_x64_AVX2{
+public:
+    static const size_t VECTOR_SIZE = 8;
+    using Mask = PartialWordAccess32_x64_AVX2;
+
+public:
+    PA_FORCE_INLINE void process_full(uint32_t* out, const uint32_t* in){
+        __m256i pixel = _mm256_loadu_si256((const __m256i*)in);
+        pixel = rgb32_to_hsv32_pixel_x64_AVX2(pixel);
+        _mm256_storeu_si256((__m256i*)out, pixel);
+    }
+    PA_FORCE_INLINE void process_partial(uint32_t* out, const uint32_t* in, const Mask& mask){
+        __m256i pixel = mask.load_i32(in);
+        pixel = rgb32_to_hsv32_pixel_x64_AVX2(pixel);
+        mask.store(out, pixel);
+    }
+};
+
+
+
+class PixelTest_Rgb32HsvRange_x64_AVX2{
+public:
+    static const size_t VECTOR_SIZE = 8;
+    using Mask = PartialWordAccess32_x64_AVX2;
+
+public:
+    PA_FORCE_INLINE PixelTest_Rgb32HsvRange_x64_AVX2(
+        uint32_t mins, uint32_t maxs
+    )
+        : m_mins(_mm256_set1_epi32(mins ^ 0x80808080))
+        , m_maxs(_mm256_set1_epi32(maxs ^ 0x80808080))
+    {}
+
+    //  Return a mask indicating which lanes are in range.
+    PA_FORCE_INLINE __m256i test_word(__m256i pixel) const{
+        __m256i hsv = rgb32_to_hsv32_pixel_x64_AVX2(pixel);
+        __m256i adj = _mm256_xor_si256(hsv, _mm256_set1_epi8((uint8_t)0x80));
+        __m256i cmp0 = _mm256_cmpgt_epi8(m_mins, adj);
+        __m256i cmp1 = _mm256_cmpgt_epi8(adj, m_maxs);
+        cmp0 = _mm256_or_si256(cmp0, cmp1);
+        return _mm256_cmpeq_epi32(cmp0, _mm256_setzero_si256());
+    }
+
+private:
+    const __m256i m_mins;
+    const __m256i m_maxs;
+};
+
+
+
+void rgb32_to_hsv32_x64_AVX2(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row
+){
+    ConvertRgb32ToHsv32_x64_AVX2 converter;
+    filter_per_pixel(in, in_bytes_per_row, width, height, converter, out, out_bytes_per_row);
+}
+size_t filter_rgb32_hsv_range_x64_AVX2(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    uint32_t replacement, bool replace_color_within_range,
+    uint32_t mins, uint32_t maxs
+){
+    PixelTest_Rgb32HsvRange_x64_AVX2 tester(mins, maxs);
+    FilterImage_Rgb32_x64_AVX2<PixelTest_Rgb32HsvRange_x64_AVX2> filter(
+        tester,
+        replacement, replace_color_within_range
+    );
+    filter_per_pixel(in, in_bytes_per_row, width, height, filter, out, out_bytes_per_row);
+    return filter.count();
+}
+size_t to_blackwhite_rgb32_hsv_range_x64_AVX2(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    bool in_range_black,
+    uint32_t mins, uint32_t maxs
+){
+    PixelTest_Rgb32HsvRange_x64_AVX2 tester(mins, maxs);
+    ToBlackWhite_Rgb32_x64_AVX2<PixelTest_Rgb32HsvRange_x64_AVX2> filter(
+        tester, in_range_black
+    );
+    filter_per_pixel(in, in_bytes_per_row, width, height, filter, out, out_bytes_per_row);
+    return filter.count();
+}
+
+
+
+}
+}
+#endif
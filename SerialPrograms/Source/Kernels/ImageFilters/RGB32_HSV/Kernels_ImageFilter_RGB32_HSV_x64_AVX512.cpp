@@ -0,0 +1,158 @@
+/*  Image Filters RGB32 HSV
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_17_Skylake
+
+#include <immintrin.h>
+#include "Kernels/ImageFilters/Kernels_ImageFilter_Basic_Routines.h"
+#include "Kernels/ImageFilters/Kernels_ImageFilter_Basic_Routines_x64_AVX512.h"
+#include "Kernels_ImageFilter_RGB32_HSV.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+
+//  See "Kernels_ImageFilter_RGB32_HSV_Routines.h" for the math.
+PA_FORCE_INLINE __m512i rgb32_to_hsv32_pixel_x64_AVX512(__m512i pixel){
+    const __m512i mask8 = _mm512_set1_epi32(0x000000ff);
+    __m512i r = _mm512_and_si512(_mm512_srli_epi32(pixel, 16), mask8);
+    __m512i g = _mm512_and_si512(_mm512_srli_epi32(pixel, 8), mask8);
+    __m512i b = _mm512_and_si512(pixel, mask8);
+
+    __m512i M = _mm512_max_epi32(_mm512_max_epi32(r, g), b);
+    __m512i m = _mm512_min_epi32(_mm512_min_epi32(r, g), b);
+    __m512i delta = _mm512_sub_epi32(M, m);
+
+    //  S = 255 - (255*m + M/2) / M
+    __m512i num = _mm512_sub_epi32(_mm512_slli_epi32(m, 8), m);
+    num = _mm512_add_epi32(num, _mm512_srli_epi32(M, 1));
+    __m512 quot = _mm512_div_ps(
+        _mm512_cvtepi32_ps(num),
+        _mm512_cvtepi32_ps(_mm512_max_epi32(M, _mm512_set1_epi32(1)))
+    );
+    __mmask16 nonzero = _mm512_test_epi32_mask(M, M);
+    __m512i S = _mm512_maskz_sub_epi32(nonzero, mask8, _mm512_cvttps_epi32(quot));
+
+    //  H = (256*T + 3*d) / (6*d)
+    __m512i delta2 = _mm512_add_epi32(delta, delta);
+    __m512i delta4 = _mm512_add_epi32(delta2, delta2);
+    __m512i delta6 = _mm512_add_epi32(delta4, delta2);
+
+    __m512i T = _mm512_add_epi32(delta4, _mm512_sub_epi32(r, g));
+    T = _mm512_mask_add_epi32(
+        T, _mm512_cmpeq_epi32_mask(M, g),
+        delta2, _mm512_sub_epi32(b, r)
+    );
+    __m512i Tr = _mm512_sub_epi32(g, b);
+    Tr = _mm512_mask_add_epi32(Tr, _mm512_cmpgt_epi32_mask(b, g), Tr, delta6);
+    T = _mm512_mask_mov_epi32(T, _mm512_cmpeq_epi32_mask(M, r), Tr);
+
+    num = _mm512_add_epi32(_mm512_slli_epi32(T, 8), _mm512_add_epi32(delta2, delta));
+    quot = _mm512_div_ps(
+        _mm512_cvtepi32_ps(num),
+        _mm512_cvtepi32_ps(_mm512_max_epi32(delta6, _mm512_set1_epi32(1)))
+    );
+    __m512i H = _mm512_and_si512(_mm512_cvttps_epi32(quot), mask8);
+
+    pixel = _mm512_and_si512(pixel, _mm512_set1_epi32(0xff000000));
+    pixel = _mm512_or_si512(pixel, _mm512_slli_epi32(H, 16));
+    pixel = _mm512_or_si512(pixel, _mm512_slli_epi32(S, 8));
+    pixel = _mm512_or_si512(pixel, M);
+    return pixel;
+}
+
+
+
+class ConvertRgb32ToHsv32_x64_AVX512{
+public:
+    static const size_t VECTOR_SIZE = 16;
+    using Mask = PartialWordMask_x64_AVX512;
+
+public:
+    PA_FORCE_INLINE void process_full(uint32_t* out, const uint32_t* in){
+        __m512i pixel = _mm512_loadu_si512((const __m512i*)in);
+        pixel = rgb32_to_hsv32_pixel_x64_AVX512(pixel);
+        _mm512_storeu_si512((__m512i*)out, pixel);
+    }
+    PA_FORCE_INLINE void process_partial(uint32_t* out, const uint32_t* in, const Mask& mask){
+        __m512i pixel = _mm512_maskz_loadu_epi32(mask.m, in);
+        pixel = rgb32_to_hsv32_pixel_x64_AVX512(pixel);
+        _mm512_mask_storeu_epi32(out, mask.m, pixel);
+    }
+};
+
+
+
+class PixelTest_Rgb32HsvRange_x64_AVX512{
+public:
+    static const size_t VECTOR_SIZE = 16;
+    using Mask = PartialWordMask_x64_AVX512;
+
+public:
+    PA_FORCE_INLINE PixelTest_Rgb32HsvRange_x64_AVX512(
+        uint32_t mins, uint32_t maxs
+    )
+        : m_shift(_mm512_set1_epi32(mins))
+        , m_threshold(_mm512_sub_epi8(_mm512_set1_epi32(maxs), m_shift))
+    {}
+
+    //  Return a mask indicating which lanes are in range.
+    PA_FORCE_INLINE __mmask16 test_word(__m512i pixel) const{
+        pixel = rgb32_to_hsv32_pixel_x64_AVX512(pixel);
+        pixel = _mm512_sub_epi8(pixel, m_shift);
+        __mmask64 cmp64 = _mm512_cmple_epu8_mask(pixel, m_threshold);
+        __m512i mask = _mm512_movm_epi8(cmp64);
+        return _mm512_cmpeq_epi32_mask(mask, _mm512_set1_epi32(-1));
+    }
+
+private:
+    const __m512i m_shift;
+    const __m512i m_threshold;
+};
+
+
+
+void rgb32_to_hsv32_x64_AVX512(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row
+){
+    ConvertRgb32ToHsv32_x64_AVX512 converter;
+    filter_per_pixel(in, in_bytes_per_row, width, height, converter, out, out_bytes_per_row);
+}
+size_t filter_rgb32_hsv_range_x64_AVX512(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    uint32_t replacement, bool replace_color_within_range,
+    uint32_t mins, uint32_t maxs
+){
+    PixelTest_Rgb32HsvRange_x64_AVX512 tester(mins, maxs);
+    FilterImage_Rgb32_x64_AVX512<PixelTest_Rgb32HsvRange_x64_AVX512> filter(
+        tester,
+        replacement, replace_color_within_range
+    );
+    filter_per_pixel(in, in_bytes_per_row, width, height, filter, out, out_bytes_per_row);
+    return filter.count();
+}
+size_t to_blackwhite_rgb32_hsv_range_x64_AVX512(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    bool in_range_black,
+    uint32_t mins, uint32_t maxs
+){
+    PixelTest_Rgb32HsvRange_x64_AVX512 tester(mins, maxs);
+    ToBlackWhite_Rgb32_x64_AVX512<PixelTest_Rgb32HsvRange_x64_AVX512> filter(
+        tester, in_range_black
+    );
+    filter_per_pixel(in, in_bytes_per_row, width, height, filter, out, out_bytes_per_row);
+    return filter.count();
+}
+
+
+
+}
+}
+#endif
@@ -0,0 +1,163 @@
+/*  Image Filters RGB32 HSV
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+
+#include <immintrin.h>
+#include "Kernels/ImageFilters/Kernels_ImageFilter_Basic_Routines.h"
+#include "Kernels/ImageFilters/Kernels_ImageFilter_Basic_Routines_x64_SSE42.h"
+#include "Kernels_ImageFilter_RGB32_HSV.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+
+//  See "Kernels_ImageFilter_RGB32_HSV_Routines.h" for the math.
+PA_FORCE_INLINE __m128i rgb32_to_hsv32_pixel_x64_SSE42(__m128i pixel){
+    const __m128i mask8 = _mm_set1_epi32(0x000000ff);
+    __m128i r = _mm_and_si128(_mm_srli_epi32(pixel, 16), mask8);
+    __m128i g = _mm_and_si128(_mm_srli_epi32(pixel, 8), mask8);
+    __m128i b = _mm_and_si128(pixel, mask8);
+
+    __m128i M = _mm_max_epi32(_mm_max_epi32(r, g), b);
+    __m128i m = _mm_min_epi32(_mm_min_epi32(r, g), b);
+    __m128i delta = _mm_sub_epi32(M, m);
+
+    //  S = 255 - (255*m + M/2) / M
+    __m128i num = _mm_sub_epi32(_mm_slli_epi32(m, 8), m);
+    num = _mm_add_epi32(num, _mm_srli_epi32(M, 1));
+    __m128 quot = _mm_div_ps(
+        _mm_cvtepi32_ps(num),
+        _mm_cvtepi32_ps(_mm_max_epi32(M, _mm_set1_epi32(1)))
+    );
+    __m128i S = _mm_sub_epi32(mask8, _mm_cvttps_epi32(quot));
+    S = _mm_andnot_si128(_mm_cmpeq_epi32(M, _mm_setzero_si128()), S);
+
+    //  H = (256*T + 3*d) / (6*d)
+    __m128i delta2 = _mm_add_epi32(delta, delta);
+    __m128i delta4 = _mm_add_epi32(delta2, delta2);
+    __m128i delta6 = _mm_add_epi32(delta4, delta2);
+
+    __m128i Tr = _mm_sub_epi32(g, b);
+    Tr = _mm_add_epi32(Tr, _mm_and_si128(_mm_cmpgt_epi32(b, g), delta6));
+    __m128i Tg = _mm_add_epi32(delta2, _mm_sub_epi32(b, r));
+    __m128i Tb = _mm_add_epi32(delta4, _mm_sub_epi32(r, g));
+
+    __m128i T = _mm_blendv_epi8(Tb, Tg, _mm_cmpeq_epi32(M, g));
+    T = _mm_blendv_epi8(T, Tr, _mm_cmpeq_epi32(M, r));
+
+    num = _mm_add_epi32(_mm_slli_epi32(T, 8), _mm_add_epi32(delta2, delta));
+    quot = _mm_div_ps(
+        _mm_cvtepi32_ps(num),
+        _mm_cvtepi32_ps(_mm_max_epi32(delta6, _mm_set1_epi32(1)))
+    );
+    __m128i H = _mm_and_si128(_mm_cvttps_epi32(quot), mask8);
+
+    pixel = _mm_and_si128(pixel, _mm_set1_epi32(0xff000000));
+    pixel = _mm_or_si128(pixel, _mm_slli_epi32(H, 16));
+    pixel = _mm_or_si128(pixel, _mm_slli_epi32(S, 8));
+    pixel = _mm_or_si128(pixel, M);
+    return pixel;
+}
+
+
+
+class ConvertRgb32ToHsv32_x64_SSE42{
+public:
+    static const size_t VECTOR_SIZE = 4;
+    using Mask = PartialWordMask_x64_SSE42;
+
+public:
+    PA_FORCE_INLINE void process_full(uint32_t* out, const uint32_t* in){
+        __m128i pixel = _mm_loadu_si128((const __m128i*)in);
+        pixel = rgb32_to_hsv32_pixel_x64_SSE42(pixel);
+        _mm_storeu_si128((__m128i*)out, pixel);
+    }
+    PA_FORCE_INLINE void process_partial(uint32_t* out, const uint32_t* in, const Mask& mask){
+        __m128i pixel = mask.loader.load(in);
+        pixel = rgb32_to_hsv32_pixel_x64_SSE42(pixel);
+        size_t left = mask.left;
+        do{
+            out[0] = _mm_cvtsi128_si32(pixel);
+            pixel = _mm_srli_si128(pixel, 4);
+            out++;
+        }while(--left);
+    }
+};
+
+
+
+class PixelTest_Rgb32HsvRange_x64_SSE42{
+public:
+    static const size_t VECTOR_SIZE = 4;
+    using Mask = PartialWordMask_x64_SSE42;
+
+public:
+    PA_FORCE_INLINE PixelTest_Rgb32HsvRange_x64_SSE42(
+        uint32_t mins, uint32_t maxs
+    )
+        : m_mins(_mm_set1_epi32(mins ^ 0x80808080))
+        , m_maxs(_mm_set1_epi32(maxs ^ 0x80808080))
+    {}
+
+    //  Return a mask indicating which lanes are in range.
+    PA_FORCE_INLINE __m128i test_word(__m128i pixel) const{
+        __m128i hsv = rgb32_to_hsv32_pixel_x64_SSE42(pixel);
+        __m128i adj = _mm_xor_si128(hsv, _mm_set1_epi8((uint8_t)0x80));
+        __m128i cmp0 = _mm_cmpgt_epi8(m_mins, adj);
+        __m128i cmp1 = _mm_cmpgt_epi8(adj, m_maxs);
+        cmp0 = _mm_or_si128(cmp0, cmp1);
+        return _mm_cmpeq_epi32(cmp0, _mm_setzero_si128());
+    }
+
+private:
+    const __m128i m_mins;
+    const __m128i m_maxs;
+};
+
+
+
+void rgb32_to_hsv32_x64_SSE42(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row
+){
+    ConvertRgb32ToHsv32_x64_SSE42 converter;
+    filter_per_pixel(in, in_bytes_per_row, width, height, converter, out, out_bytes_per_row);
+}
+size_t filter_rgb32_hsv_range_x64_SSE42(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    uint32_t replacement, bool replace_color_within_range,
+    uint32_t mins, uint32_t maxs
+){
+    PixelTest_Rgb32HsvRange_x64_SSE42 tester(mins, maxs);
+    FilterImage_Rgb32_x64_SSE42<PixelTest_Rgb32HsvRange_x64_SSE42> filter(
+        tester,
+        replacement, replace_color_within_range
+    );
+    filter_per_pixel(in, in_bytes_per_row, width, height, filter, out, out_bytes_per_row);
+    return filter.count();
+}
+size_t to_blackwhite_rgb32_hsv_range_x64_SSE42(
+    const uint32_t* in, size_t in_bytes_per_row, size_t width, size_t height,
+    uint32_t* out, size_t out_bytes_per_row,
+    bool in_range_black,
+    uint32_t mins, uint32_t maxs
+){
+    PixelTest_Rgb32HsvRange_x64_SSE42 tester(mins, maxs);
+    ToBlackWhite_Rgb32_x64_SSE42<PixelTest_Rgb32HsvRange_x64_SSE42> filter(
+        tester, in_range_black
+    );
+    filter_per_pixel(in, in_bytes_per_row, width, height, filter, out, out_bytes_per_row);
+    return filter.count();
+}
+
+
+
+}
+}
+#endif
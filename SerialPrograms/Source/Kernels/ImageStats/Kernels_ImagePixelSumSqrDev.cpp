@@ -11,91 +11,100 @@ namespace PokemonAutomation{
 namespace Kernels{
 
 
-template <SumSquareMode mode>
+template <SumSquareMode mode, bool scale_ref>
 void sum_sqr_deviation_Default(
     uint64_t& count, uint64_t& sumsqrs,
     size_t width, size_t height,
     const uint32_t* ref, size_t ref_bytes_per_line,
     const uint32_t* img, size_t img_bytes_per_line,
-    uint32_t background
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
 );
-template <SumSquareMode mode>
+template <SumSquareMode mode, bool scale_ref>
 void sum_sqr_deviation_x64_SSE41(
     uint64_t& count, uint64_t& sumsqrs,
     size_t width, size_t height,
     const uint32_t* ref, size_t ref_bytes_per_line,
     const uint32_t* img, size_t img_bytes_per_line,
-    uint32_t background
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
 );
-template <SumSquareMode mode>
+template <SumSquareMode mode, bool scale_ref>
 void sum_sqr_deviation_x64_AVX2(
     uint64_t& count, uint64_t& sumsqrs,
     size_t width, size_t height,
     const uint32_t* ref, size_t ref_bytes_per_line,
     const uint32_t* img, size_t img_bytes_per_line,
-    uint32_t background
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
 );
-template <SumSquareMode mode>
+template <SumSquareMode mode, bool scale_ref>
 void sum_sqr_deviation_x64_AVX512(
     uint64_t& count, uint64_t& sumsqrs,
     size_t width, size_t height,
     const uint32_t* ref, size_t ref_bytes_per_line,
     const uint32_t* img, size_t img_bytes_per_line,
-    uint32_t background
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
 );
 
 
 
-template <SumSquareMode mode>
+template <SumSquareMode mode, bool scale_ref = false>
 void sum_sqr_deviation(
     uint64_t& count, uint64_t& sumsqrs,
     size_t width, size_t height,
     const uint32_t* ref, size_t ref_bytes_per_line,
     const uint32_t* img, size_t img_bytes_per_line,
-    uint32_t background = 0
+    uint32_t background = 0,
+    float scaleR = 1, float scaleG = 1, float scaleB = 1
 ){
 #ifdef PA_AutoDispatch_x64_17_Skylake
     if (CPU_CAPABILITY_CURRENT.OK_17_Skylake){
-        sum_sqr_deviation_x64_AVX512<mode>(
+        sum_sqr_deviation_x64_AVX512<mode, scale_ref>(
             count, sumsqrs,
             width, height,
             ref, ref_bytes_per_line,
             img, img_bytes_per_line,
-            background
+            background,
+            scaleR, scaleG, scaleB
         );
         return;
     }
 #endif
 #ifdef PA_AutoDispatch_x64_13_Haswell
     if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
-        sum_sqr_deviation_x64_AVX2<mode>(
+        sum_sqr_deviation_x64_AVX2<mode, scale_ref>(
             count, sumsqrs,
             width, height,
             ref, ref_bytes_per_line,
             img, img_bytes_per_line,
-            background
+            background,
+            scaleR, scaleG, scaleB
         );
         return;
     }
 #endif
 #ifdef PA_AutoDispatch_x64_08_Nehalem
     if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
-        sum_sqr_deviation_x64_SSE41<mode>(
+        sum_sqr_deviation_x64_SSE41<mode, scale_ref>(
             count, sumsqrs,
             width, height,
             ref, ref_bytes_per_line,
             img, img_bytes_per_line,
-            background
+            background,
+            scaleR, scaleG, scaleB
         );
         return;
     }
 #endif
-    sum_sqr_deviation_Default<mode>(
+    sum_sqr_deviation_Default<mode, scale_ref>(
         count, sumsqrs,
         width, height,
         ref, ref_bytes_per_line,
         img, img_bytes_per_line,
-        background
+        background,
+        scaleR, scaleG, scaleB
     );
 }
 
@@ -143,6 +152,57 @@ void sum_sqr_deviation_masked(
 }
 
 
+void sum_sqr_deviation_scaled(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    float scaleR, float scaleG, float scaleB
+){
+    sum_sqr_deviation<SumSquareMode::REFERENCE_ALPHA, true>(
+        count, sumsqrs,
+        width, height,
+        ref, ref_bytes_per_line,
+        img, img_bytes_per_line,
+        0,
+        scaleR, scaleG, scaleB
+    );
+}
+void sum_sqr_deviation_scaled(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    float scaleR, float scaleG, float scaleB,
+    uint32_t background
+){
+    sum_sqr_deviation<SumSquareMode::USE_BACKGROUND, true>(
+        count, sumsqrs,
+        width, height,
+        ref, ref_bytes_per_line,
+        img, img_bytes_per_line,
+        background,
+        scaleR, scaleG, scaleB
+    );
+}
+void sum_sqr_deviation_scaled_masked(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    float scaleR, float scaleG, float scaleB
+){
+    sum_sqr_deviation<SumSquareMode::ARBITRATE_ALPHAS, true>(
+        count, sumsqrs,
+        width, height,
+        ref, ref_bytes_per_line,
+        img, img_bytes_per_line,
+        0,
+        scaleR, scaleG, scaleB
+    );
+}
+
+
 
 }
 }
@@ -63,6 +63,36 @@ void sum_sqr_deviation_masked(
     const uint32_t* img, size_t img_bytes_per_line
 );
 
+//
+//  Same as the above, but each RGB channel of "ref" is multiplied by the
+//  respective scale factor (saturated to 255) before it is compared against
+//  "img". This gives the same result as running "scale_brightness()" on a copy
+//  of "ref" without the copy. Like "scale_brightness()", the x64 SIMD versions
+//  round to nearest and the others truncate.
+//
+void sum_sqr_deviation_scaled(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    float scaleR, float scaleG, float scaleB
+);
+void sum_sqr_deviation_scaled(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    float scaleR, float scaleG, float scaleB,
+    uint32_t background
+);
+void sum_sqr_deviation_scaled_masked(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    float scaleR, float scaleG, float scaleB
+);
+
 
 }
 }
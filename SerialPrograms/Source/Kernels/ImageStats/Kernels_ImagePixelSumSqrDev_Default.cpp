@@ -5,6 +5,7 @@
  */
 
 #include <stdint.h>
+#include <algorithm>
 #include "Common/Compiler.h"
 #include "Common/Cpp/Exceptions.h"
 #include "Kernels_ImagePixelSumSqrDev.h"
@@ -13,18 +14,47 @@ namespace PokemonAutomation{
 namespace Kernels{
 
 
-template <SumSquareMode mode>
+//  Scale the RGB channels of "pixel" the same way as "scale_brightness_Default()". (truncate, saturate at 255)
+struct PixelScaler_Default{
+    float r;
+    float g;
+    float b;
+
+    PixelScaler_Default(float scaleR, float scaleG, float scaleB)
+        : r(std::max(scaleR, 0.0f))
+        , g(std::max(scaleG, 0.0f))
+        , b(std::max(scaleB, 0.0f))
+    {}
+    PA_FORCE_INLINE uint32_t scale(uint32_t pixel) const{
+        float fr = std::min((float)((pixel >> 16) & 0x000000ff) * r, 255.0f);
+        float fg = std::min((float)((pixel >> 8) & 0x000000ff) * g, 255.0f);
+        float fb = std::min((float)(pixel & 0x000000ff) * b, 255.0f);
+        pixel &= 0xff000000;
+        pixel |= (uint32_t)fr << 16;
+        pixel |= (uint32_t)fg << 8;
+        pixel |= (uint32_t)fb;
+        return pixel;
+    }
+};
+
+
+template <SumSquareMode mode, bool scale_ref>
 PA_FORCE_INLINE void sum_sqr_deviation_Default(
     uint64_t& count, uint64_t& sumsqrs,
     uint16_t width,
     const uint32_t* ref, const uint32_t* img,
-    uint32_t background
+    uint32_t background,
+    const PixelScaler_Default& scaler
 ){
     uint32_t total = 0;
     for (size_t c = 0; c < width; c++){
         uint32_t r = ref[c];
         uint32_t i = img[c];
 
+        if (scale_ref){
+            r = scaler.scale(r);
+        }
+
         uint32_t alphaR = (int32_t)r >> 31;
 
         if (mode == SumSquareMode::REFERENCE_ALPHA){
@@ -66,21 +96,23 @@ PA_FORCE_INLINE void sum_sqr_deviation_Default(
     count += total;
 }
 
-template <SumSquareMode mode>
+template <SumSquareMode mode, bool scale_ref>
 void sum_sqr_deviation_Default(
     uint64_t& count, uint64_t& sumsqrs,
     size_t width, size_t height,
     const uint32_t* ref, size_t ref_bytes_per_line,
     const uint32_t* img, size_t img_bytes_per_line,
-    uint32_t background
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
 ){
     if (width > 22017){
         throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Width limit exceeded: " + std::to_string(width));
     }
+    PixelScaler_Default scaler(scaleR, scaleG, scaleB);
     for (size_t r = 0; r < height; r++){
-        sum_sqr_deviation_Default<mode>(
+        sum_sqr_deviation_Default<mode, scale_ref>(
             count, sumsqrs,
-            (uint16_t)width, ref, img, background
+            (uint16_t)width, ref, img, background, scaler
         );
         ref = (const uint32_t*)((const char*)ref + ref_bytes_per_line);
         img = (const uint32_t*)((const char*)img + img_bytes_per_line);
@@ -89,28 +121,58 @@ void sum_sqr_deviation_Default(
 
 
 template
-void sum_sqr_deviation_Default<SumSquareMode::REFERENCE_ALPHA>(
+void sum_sqr_deviation_Default<SumSquareMode::REFERENCE_ALPHA, false>(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+);
+template
+void sum_sqr_deviation_Default<SumSquareMode::REFERENCE_ALPHA, true>(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+);
+template
+void sum_sqr_deviation_Default<SumSquareMode::USE_BACKGROUND, false>(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+);
+template
+void sum_sqr_deviation_Default<SumSquareMode::USE_BACKGROUND, true>(
     uint64_t& count, uint64_t& sumsqrs,
     size_t width, size_t height,
     const uint32_t* ref, size_t ref_bytes_per_line,
     const uint32_t* img, size_t img_bytes_per_line,
-    uint32_t background
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
 );
 template
-void sum_sqr_deviation_Default<SumSquareMode::USE_BACKGROUND>(
+void sum_sqr_deviation_Default<SumSquareMode::ARBITRATE_ALPHAS, false>(
     uint64_t& count, uint64_t& sumsqrs,
     size_t width, size_t height,
     const uint32_t* ref, size_t ref_bytes_per_line,
     const uint32_t* img, size_t img_bytes_per_line,
-    uint32_t background
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
 );
 template
-void sum_sqr_deviation_Default<SumSquareMode::ARBITRATE_ALPHAS>(
+void sum_sqr_deviation_Default<SumSquareMode::ARBITRATE_ALPHAS, true>(
     uint64_t& count, uint64_t& sumsqrs,
     size_t width, size_t height,
     const uint32_t* ref, size_t ref_bytes_per_line,
     const uint32_t* img, size_t img_bytes_per_line,
-    uint32_t background
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
 );
 
 
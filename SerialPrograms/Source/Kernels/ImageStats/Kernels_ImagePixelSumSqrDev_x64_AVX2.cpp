@@ -6,6 +6,8 @@
 
 #ifdef PA_AutoDispatch_x64_13_Haswell
 
+#include <string.h>
+#include <algorithm>
 #include <immintrin.h>
 #include "Common/Cpp/Exceptions.h"
 #include "Kernels/Kernels_x64_AVX2.h"
@@ -16,17 +18,46 @@ namespace PokemonAutomation{
 namespace Kernels{
 
 
-template <SumSquareMode mode>
+template <SumSquareMode mode, bool scale_ref>
 void sum_sqr_deviation_Default(
     uint64_t& count, uint64_t& sumsqrs,
     size_t width, size_t height,
     const uint32_t* ref, size_t ref_bytes_per_line,
     const uint32_t* img, size_t img_bytes_per_line,
-    uint32_t background
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
 );
 
 
 
+//  Scale the RGB channels of "pixel" the same way as "scale_brightness_x64_AVX2()". (round to nearest, saturate at 255)
+struct PixelScaler_x64_AVX2{
+    __m256 r;
+    __m256 g;
+    __m256 b;
+
+    PixelScaler_x64_AVX2(float scaleR, float scaleG, float scaleB)
+        : r(_mm256_set1_ps(std::max(scaleR, 0.0f)))
+        , g(_mm256_set1_ps(std::max(scaleG, 0.0f)))
+        , b(_mm256_set1_ps(std::max(scaleB, 0.0f)))
+    {}
+    PA_FORCE_INLINE __m256i scale(__m256i pixel) const{
+        const __m256i mask8 = _mm256_set1_epi32(0x000000ff);
+        const __m256 max = _mm256_set1_ps(255.0f);
+        __m256i pr = _mm256_and_si256(_mm256_srli_epi32(pixel, 16), mask8);
+        __m256i pg = _mm256_and_si256(_mm256_srli_epi32(pixel, 8), mask8);
+        __m256i pb = _mm256_and_si256(pixel, mask8);
+        pr = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(pr), r), max));
+        pg = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(pg), g), max));
+        pb = _mm256_cvtps_epi32(_mm256_min_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(pb), b), max));
+        pixel = _mm256_and_si256(pixel, _mm256_set1_epi32(0xff000000));
+        pixel = _mm256_or_si256(pixel, _mm256_slli_epi32(pr, 16));
+        pixel = _mm256_or_si256(pixel, _mm256_slli_epi32(pg, 8));
+        return _mm256_or_si256(pixel, pb);
+    }
+};
+
+
 template <SumSquareMode mode>
 PA_FORCE_INLINE void sum_sqr_deviation_x64_AVX2(
     __m256i& total, __m256i& sum,
@@ -75,12 +106,13 @@ PA_FORCE_INLINE void sum_sqr_deviation_x64_AVX2(
     sum = _mm256_add_epi32(sum, r1);
 }
 
-template <SumSquareMode mode>
+template <SumSquareMode mode, bool scale_ref>
 PA_FORCE_INLINE void sum_sqr_deviation_x64_AVX2(
     uint64_t& count, uint64_t& sumsqrs,
     uint16_t width,
     const uint32_t* ref, const uint32_t* img,
-    __m256i background
+    __m256i background,
+    const PixelScaler_x64_AVX2& scaler
 ){
     __m256i total = _mm256_setzero_si256();
     __m256i sum = _mm256_setzero_si256();
@@ -92,6 +124,9 @@ PA_FORCE_INLINE void sum_sqr_deviation_x64_AVX2(
     do{
         __m256i r = _mm256_loadu_si256(ptrR);
         __m256i i = _mm256_loadu_si256(ptrI);
+        if (scale_ref){
+            r = scaler.scale(r);
+        }
         sum_sqr_deviation_x64_AVX2<mode>(total, sum, r, i, background);
         ptrR++;
         ptrI++;
@@ -106,6 +141,9 @@ PA_FORCE_INLINE void sum_sqr_deviation_x64_AVX2(
         __m256i i = _mm256_maskload_epi32((const int*)ptrI, mask);
 
         background = _mm256_and_si256(background, mask);
+        if (scale_ref){
+            r = scaler.scale(r);
+        }
         sum_sqr_deviation_x64_AVX2<mode>(total, sum, r, i, background);
     }
 
@@ -114,32 +152,57 @@ PA_FORCE_INLINE void sum_sqr_deviation_x64_AVX2(
 }
 
 
-template <SumSquareMode mode>
+template <SumSquareMode mode, bool scale_ref>
 void sum_sqr_deviation_x64_AVX2(
     uint64_t& count, uint64_t& sumsqrs,
     size_t width, size_t height,
     const uint32_t* ref, size_t ref_bytes_per_line,
     const uint32_t* img, size_t img_bytes_per_line,
-    uint32_t background
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
 ){
     if (width < 8){
-        sum_sqr_deviation_Default<mode>(
-            count, sumsqrs,
-            width, height,
-            ref, ref_bytes_per_line,
-            img, img_bytes_per_line,
-            background
-        );
+        if (!scale_ref){
+            sum_sqr_deviation_Default<mode, false>(
+                count, sumsqrs,
+                width, height,
+                ref, ref_bytes_per_line,
+                img, img_bytes_per_line,
+                background,
+                1.0f, 1.0f, 1.0f
+            );
+            return;
+        }
+
+        //  The default kernel truncates like scale_brightness_Default(). So
+        //  scale each row here to round the same way as the wide rows.
+        PixelScaler_x64_AVX2 scaler(scaleR, scaleG, scaleB);
+        for (size_t r = 0; r < height; r++){
+            alignas(sizeof(__m256i)) uint32_t buffer[8] = {};
+            memcpy(buffer, ref, width * sizeof(uint32_t));
+            _mm256_store_si256((__m256i*)buffer, scaler.scale(_mm256_load_si256((const __m256i*)buffer)));
+            sum_sqr_deviation_Default<mode, false>(
+                count, sumsqrs,
+                width, 1,
+                buffer, sizeof(buffer),
+                img, img_bytes_per_line,
+                background,
+                1.0f, 1.0f, 1.0f
+            );
+            ref = (const uint32_t*)((const char*)ref + ref_bytes_per_line);
+            img = (const uint32_t*)((const char*)img + img_bytes_per_line);
+        }
         return;
     }
     if (width > 22017){
         throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Width limit exceeded: " + std::to_string(width));
     }
     __m256i vbackground = _mm256_set1_epi32(background);
+    PixelScaler_x64_AVX2 scaler(scaleR, scaleG, scaleB);
     for (size_t r = 0; r < height; r++){
-        sum_sqr_deviation_x64_AVX2<mode>(
+        sum_sqr_deviation_x64_AVX2<mode, scale_ref>(
             count, sumsqrs,
-            (uint16_t)width, ref, img, vbackground
+            (uint16_t)width, ref, img, vbackground, scaler
         );
         ref = (const uint32_t*)((const char*)ref + ref_bytes_per_line);
         img = (const uint32_t*)((const char*)img + img_bytes_per_line);
@@ -148,28 +211,58 @@ void sum_sqr_deviation_x64_AVX2(
 
 
 template
-void sum_sqr_deviation_x64_AVX2<SumSquareMode::REFERENCE_ALPHA>(
+void sum_sqr_deviation_x64_AVX2<SumSquareMode::REFERENCE_ALPHA, false>(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+);
+template
+void sum_sqr_deviation_x64_AVX2<SumSquareMode::REFERENCE_ALPHA, true>(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+);
+template
+void sum_sqr_deviation_x64_AVX2<SumSquareMode::USE_BACKGROUND, false>(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+);
+template
+void sum_sqr_deviation_x64_AVX2<SumSquareMode::USE_BACKGROUND, true>(
     uint64_t& count, uint64_t& sumsqrs,
     size_t width, size_t height,
     const uint32_t* ref, size_t ref_bytes_per_line,
     const uint32_t* img, size_t img_bytes_per_line,
-    uint32_t background
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
 );
 template
-void sum_sqr_deviation_x64_AVX2<SumSquareMode::USE_BACKGROUND>(
+void sum_sqr_deviation_x64_AVX2<SumSquareMode::ARBITRATE_ALPHAS, false>(
     uint64_t& count, uint64_t& sumsqrs,
     size_t width, size_t height,
     const uint32_t* ref, size_t ref_bytes_per_line,
     const uint32_t* img, size_t img_bytes_per_line,
-    uint32_t background
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
 );
 template
-void sum_sqr_deviation_x64_AVX2<SumSquareMode::ARBITRATE_ALPHAS>(
+void sum_sqr_deviation_x64_AVX2<SumSquareMode::ARBITRATE_ALPHAS, true>(
     uint64_t& count, uint64_t& sumsqrs,
     size_t width, size_t height,
     const uint32_t* ref, size_t ref_bytes_per_line,
     const uint32_t* img, size_t img_bytes_per_line,
-    uint32_t background
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
 );
 
 
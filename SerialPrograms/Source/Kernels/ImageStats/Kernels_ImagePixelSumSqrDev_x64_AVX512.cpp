@@ -6,6 +6,8 @@
 
 #ifdef PA_AutoDispatch_x64_17_Skylake
 
+#include <string.h>
+#include <algorithm>
 #include <immintrin.h>
 #include "Common/Cpp/Exceptions.h"
 #include "Kernels/Kernels_x64_AVX512.h"
@@ -19,17 +21,46 @@ namespace PokemonAutomation{
 namespace Kernels{
 
 
-template <SumSquareMode mode>
+template <SumSquareMode mode, bool scale_ref>
 void sum_sqr_deviation_Default(
     uint64_t& count, uint64_t& sumsqrs,
     size_t width, size_t height,
     const uint32_t* ref, size_t ref_bytes_per_line,
     const uint32_t* img, size_t img_bytes_per_line,
-    uint32_t background
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
 );
 
 
 
+//  Scale the RGB channels of "pixel" the same way as "scale_brightness_x64_AVX512()". (round to nearest, saturate at 255)
+struct PixelScaler_x64_AVX512{
+    __m512 r;
+    __m512 g;
+    __m512 b;
+
+    PixelScaler_x64_AVX512(float scaleR, float scaleG, float scaleB)
+        : r(_mm512_set1_ps(std::max(scaleR, 0.0f)))
+        , g(_mm512_set1_ps(std::max(scaleG, 0.0f)))
+        , b(_mm512_set1_ps(std::max(scaleB, 0.0f)))
+    {}
+    PA_FORCE_INLINE __m512i scale(__m512i pixel) const{
+        const __m512i mask8 = _mm512_set1_epi32(0x000000ff);
+        const __m512 max = _mm512_set1_ps(255.0f);
+        __m512i pr = _mm512_and_si512(_mm512_srli_epi32(pixel, 16), mask8);
+        __m512i pg = _mm512_and_si512(_mm512_srli_epi32(pixel, 8), mask8);
+        __m512i pb = _mm512_and_si512(pixel, mask8);
+        pr = _mm512_cvtps_epi32(_mm512_min_ps(_mm512_mul_ps(_mm512_cvtepi32_ps(pr), r), max));
+        pg = _mm512_cvtps_epi32(_mm512_min_ps(_mm512_mul_ps(_mm512_cvtepi32_ps(pg), g), max));
+        pb = _mm512_cvtps_epi32(_mm512_min_ps(_mm512_mul_ps(_mm512_cvtepi32_ps(pb), b), max));
+        pixel = _mm512_and_si512(pixel, _mm512_set1_epi32(0xff000000));
+        pixel = _mm512_or_si512(pixel, _mm512_slli_epi32(pr, 16));
+        pixel = _mm512_or_si512(pixel, _mm512_slli_epi32(pg, 8));
+        return _mm512_or_si512(pixel, pb);
+    }
+};
+
+
 template <SumSquareMode mode>
 PA_FORCE_INLINE void sum_sqr_deviation_x64_AVX512(
     __m512i& total, __m512i& sum,
@@ -85,12 +116,13 @@ PA_FORCE_INLINE void sum_sqr_deviation_x64_AVX512(
     }
 }
 
-template <SumSquareMode mode>
+template <SumSquareMode mode, bool scale_ref>
 PA_FORCE_INLINE void sum_sqr_deviation_x64_AVX512(
     uint64_t& count, uint64_t& sumsqrs,
     uint16_t width,
     const uint32_t* ref, const uint32_t* img,
-    __m512i background
+    __m512i background,
+    const PixelScaler_x64_AVX512& scaler
 ){
     __m512i total = _mm512_setzero_si512();
     __m512i sum = _mm512_setzero_si512();
@@ -102,6 +134,9 @@ PA_FORCE_INLINE void sum_sqr_deviation_x64_AVX512(
     do{
         __m512i r = _mm512_loadu_si512(ptrR);
         __m512i i = _mm512_loadu_si512(ptrI);
+        if (scale_ref){
+            r = scaler.scale(r);
+        }
         sum_sqr_deviation_x64_AVX512<mode>(total, sum, r, i, background);
         ptrR++;
         ptrI++;
@@ -112,6 +147,9 @@ PA_FORCE_INLINE void sum_sqr_deviation_x64_AVX512(
         __m512i r = _mm512_maskz_loadu_epi32(mask, ptrR);
         __m512i i = _mm512_maskz_loadu_epi32(mask, ptrI);
         background = _mm512_maskz_mov_epi32(mask, background);
+        if (scale_ref){
+            r = scaler.scale(r);
+        }
         sum_sqr_deviation_x64_AVX512<mode>(total, sum, r, i, background);
     }
 
@@ -120,32 +158,57 @@ PA_FORCE_INLINE void sum_sqr_deviation_x64_AVX512(
 }
 
 
-template <SumSquareMode mode>
+template <SumSquareMode mode, bool scale_ref>
 void sum_sqr_deviation_x64_AVX512(
     uint64_t& count, uint64_t& sumsqrs,
     size_t width, size_t height,
     const uint32_t* ref, size_t ref_bytes_per_line,
     const uint32_t* img, size_t img_bytes_per_line,
-    uint32_t background
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
 ){
     if (width < 16){
-        sum_sqr_deviation_Default<mode>(
-            count, sumsqrs,
-            width, height,
-            ref, ref_bytes_per_line,
-            img, img_bytes_per_line,
-            background
-        );
+        if (!scale_ref){
+            sum_sqr_deviation_Default<mode, false>(
+                count, sumsqrs,
+                width, height,
+                ref, ref_bytes_per_line,
+                img, img_bytes_per_line,
+                background,
+                1.0f, 1.0f, 1.0f
+            );
+            return;
+        }
+
+        //  The default kernel truncates like scale_brightness_Default(). So
+        //  scale each row here to round the same way as the wide rows.
+        PixelScaler_x64_AVX512 scaler(scaleR, scaleG, scaleB);
+        for (size_t r = 0; r < height; r++){
+            alignas(sizeof(__m512i)) uint32_t buffer[16] = {};
+            memcpy(buffer, ref, width * sizeof(uint32_t));
+            _mm512_store_si512((__m512i*)buffer, scaler.scale(_mm512_load_si512((const __m512i*)buffer)));
+            sum_sqr_deviation_Default<mode, false>(
+                count, sumsqrs,
+                width, 1,
+                buffer, sizeof(buffer),
+                img, img_bytes_per_line,
+                background,
+                1.0f, 1.0f, 1.0f
+            );
+            ref = (const uint32_t*)((const char*)ref + ref_bytes_per_line);
+            img = (const uint32_t*)((const char*)img + img_bytes_per_line);
+        }
         return;
     }
     if (width > 22017){
         throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Width limit exceeded: " + std::to_string(width));
     }
     __m512i vbackground = _mm512_set1_epi32(background);
+    PixelScaler_x64_AVX512 scaler(scaleR, scaleG, scaleB);
     for (size_t r = 0; r < height; r++){
-        sum_sqr_deviation_x64_AVX512<mode>(
+        sum_sqr_deviation_x64_AVX512<mode, scale_ref>(
             count, sumsqrs,
-            (uint16_t)width, ref, img, vbackground
+            (uint16_t)width, ref, img, vbackground, scaler
         );
         ref = (const uint32_t*)((const char*)ref + ref_bytes_per_line);
         img = (const uint32_t*)((const char*)img + img_bytes_per_line);
@@ -154,28 +217,58 @@ void sum_sqr_deviation_x64_AVX512(
 
 
 template
-void sum_sqr_deviation_x64_AVX512<SumSquareMode::REFERENCE_ALPHA>(
+void sum_sqr_deviation_x64_AVX512<SumSquareMode::REFERENCE_ALPHA, false>(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+);
+template
+void sum_sqr_deviation_x64_AVX512<SumSquareMode::REFERENCE_ALPHA, true>(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+);
+template
+void sum_sqr_deviation_x64_AVX512<SumSquareMode::USE_BACKGROUND, false>(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+);
+template
+void sum_sqr_deviation_x64_AVX512<SumSquareMode::USE_BACKGROUND, true>(
     uint64_t& count, uint64_t& sumsqrs,
     size_t width, size_t height,
     const uint32_t* ref, size_t ref_bytes_per_line,
     const uint32_t* img, size_t img_bytes_per_line,
-    uint32_t background
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
 );
 template
-void sum_sqr_deviation_x64_AVX512<SumSquareMode::USE_BACKGROUND>(
+void sum_sqr_deviation_x64_AVX512<SumSquareMode::ARBITRATE_ALPHAS, false>(
     uint64_t& count, uint64_t& sumsqrs,
     size_t width, size_t height,
     const uint32_t* ref, size_t ref_bytes_per_line,
     const uint32_t* img, size_t img_bytes_per_line,
-    uint32_t background
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
 );
 template
-void sum_sqr_deviation_x64_AVX512<SumSquareMode::ARBITRATE_ALPHAS>(
+void sum_sqr_deviation_x64_AVX512<SumSquareMode::ARBITRATE_ALPHAS, true>(
     uint64_t& count, uint64_t& sumsqrs,
     size_t width, size_t height,
     const uint32_t* ref, size_t ref_bytes_per_line,
     const uint32_t* img, size_t img_bytes_per_line,
-    uint32_t background
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
 );
 
 
@@ -6,6 +6,8 @@
 
 #ifdef PA_AutoDispatch_x64_08_Nehalem
 
+#include <string.h>
+#include <algorithm>
 #include <smmintrin.h>
 #include "Common/Cpp/Exceptions.h"
 #include "Kernels/Kernels_x64_SSE41.h"
@@ -16,17 +18,46 @@ namespace PokemonAutomation{
 namespace Kernels{
 
 
-template <SumSquareMode mode>
+template <SumSquareMode mode, bool scale_ref>
 void sum_sqr_deviation_Default(
     uint64_t& count, uint64_t& sumsqrs,
     size_t width, size_t height,
     const uint32_t* ref, size_t ref_bytes_per_line,
     const uint32_t* img, size_t img_bytes_per_line,
-    uint32_t background
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
 );
 
 
 
+//  Scale the RGB channels of "pixel" the same way as "scale_brightness_x64_SSE41()". (round to nearest, saturate at 255)
+struct PixelScaler_x64_SSE41{
+    __m128 r;
+    __m128 g;
+    __m128 b;
+
+    PixelScaler_x64_SSE41(float scaleR, float scaleG, float scaleB)
+        : r(_mm_set1_ps(std::max(scaleR, 0.0f)))
+        , g(_mm_set1_ps(std::max(scaleG, 0.0f)))
+        , b(_mm_set1_ps(std::max(scaleB, 0.0f)))
+    {}
+    PA_FORCE_INLINE __m128i scale(__m128i pixel) const{
+        const __m128i mask8 = _mm_set1_epi32(0x000000ff);
+        const __m128 max = _mm_set1_ps(255.0f);
+        __m128i pr = _mm_and_si128(_mm_srli_epi32(pixel, 16), mask8);
+        __m128i pg = _mm_and_si128(_mm_srli_epi32(pixel, 8), mask8);
+        __m128i pb = _mm_and_si128(pixel, mask8);
+        pr = _mm_cvtps_epi32(_mm_min_ps(_mm_mul_ps(_mm_cvtepi32_ps(pr), r), max));
+        pg = _mm_cvtps_epi32(_mm_min_ps(_mm_mul_ps(_mm_cvtepi32_ps(pg), g), max));
+        pb = _mm_cvtps_epi32(_mm_min_ps(_mm_mul_ps(_mm_cvtepi32_ps(pb), b), max));
+        pixel = _mm_and_si128(pixel, _mm_set1_epi32(0xff000000));
+        pixel = _mm_or_si128(pixel, _mm_slli_epi32(pr, 16));
+        pixel = _mm_or_si128(pixel, _mm_slli_epi32(pg, 8));
+        return _mm_or_si128(pixel, pb);
+    }
+};
+
+
 template <SumSquareMode mode>
 PA_FORCE_INLINE void sum_sqr_deviation_x64_SSE41(
     __m128i& total, __m128i& sum,
@@ -69,12 +100,13 @@ PA_FORCE_INLINE void sum_sqr_deviation_x64_SSE41(
     sum = _mm_add_epi32(sum, r1);
 }
 
-template <SumSquareMode mode>
+template <SumSquareMode mode, bool scale_ref>
 PA_FORCE_INLINE void sum_sqr_deviation_x64_SSE41(
     uint64_t& count, uint64_t& sumsqrs,
     uint16_t width,
     const uint32_t* ref, const uint32_t* img,
-    __m128i background
+    __m128i background,
+    const PixelScaler_x64_SSE41& scaler
 ){
     __m128i total = _mm_setzero_si128();
     __m128i sum = _mm_setzero_si128();
@@ -86,6 +118,9 @@ PA_FORCE_INLINE void sum_sqr_deviation_x64_SSE41(
     do{
         __m128i r = _mm_loadu_si128(ptrR);
         __m128i i = _mm_loadu_si128(ptrI);
+        if (scale_ref){
+            r = scaler.scale(r);
+        }
         sum_sqr_deviation_x64_SSE41<mode>(total, sum, r, i, background);
         ptrR++;
         ptrI++;
@@ -112,6 +147,9 @@ PA_FORCE_INLINE void sum_sqr_deviation_x64_SSE41(
         background = _mm_shuffle_epi8(background, s);
 #endif
 
+        if (scale_ref){
+            r = scaler.scale(r);
+        }
         sum_sqr_deviation_x64_SSE41<mode>(total, sum, r, i, background);
     }
 
@@ -120,32 +158,57 @@ PA_FORCE_INLINE void sum_sqr_deviation_x64_SSE41(
 }
 
 
-template <SumSquareMode mode>
+template <SumSquareMode mode, bool scale_ref>
 void sum_sqr_deviation_x64_SSE41(
     uint64_t& count, uint64_t& sumsqrs,
     size_t width, size_t height,
     const uint32_t* ref, size_t ref_bytes_per_line,
     const uint32_t* img, size_t img_bytes_per_line,
-    uint32_t background
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
 ){
     if (width < 4){
-        sum_sqr_deviation_Default<mode>(
-            count, sumsqrs,
-            width, height,
-            ref, ref_bytes_per_line,
-            img, img_bytes_per_line,
-            background
-        );
+        if (!scale_ref){
+            sum_sqr_deviation_Default<mode, false>(
+                count, sumsqrs,
+                width, height,
+                ref, ref_bytes_per_line,
+                img, img_bytes_per_line,
+                background,
+                1.0f, 1.0f, 1.0f
+            );
+            return;
+        }
+
+        //  The default kernel truncates like scale_brightness_Default(). So
+        //  scale each row here to round the same way as the wide rows.
+        PixelScaler_x64_SSE41 scaler(scaleR, scaleG, scaleB);
+        for (size_t r = 0; r < height; r++){
+            alignas(sizeof(__m128i)) uint32_t buffer[4] = {};
+            memcpy(buffer, ref, width * sizeof(uint32_t));
+            _mm_store_si128((__m128i*)buffer, scaler.scale(_mm_load_si128((const __m128i*)buffer)));
+            sum_sqr_deviation_Default<mode, false>(
+                count, sumsqrs,
+                width, 1,
+                buffer, sizeof(buffer),
+                img, img_bytes_per_line,
+                background,
+                1.0f, 1.0f, 1.0f
+            );
+            ref = (const uint32_t*)((const char*)ref + ref_bytes_per_line);
+            img = (const uint32_t*)((const char*)img + img_bytes_per_line);
+        }
         return;
     }
     if (width > 22017){
         throw InternalProgramError(nullptr, PA_CURRENT_FUNCTION, "Width limit exceeded: " + std::to_string(width));
     }
     __m128i vbackground = _mm_set1_epi32(background);
+    PixelScaler_x64_SSE41 scaler(scaleR, scaleG, scaleB);
     for (size_t r = 0; r < height; r++){
-        sum_sqr_deviation_x64_SSE41<mode>(
+        sum_sqr_deviation_x64_SSE41<mode, scale_ref>(
             count, sumsqrs,
-            (uint16_t)width, ref, img, vbackground
+            (uint16_t)width, ref, img, vbackground, scaler
         );
         ref = (const uint32_t*)((const char*)ref + ref_bytes_per_line);
         img = (const uint32_t*)((const char*)img + img_bytes_per_line);
@@ -154,28 +217,58 @@ void sum_sqr_deviation_x64_SSE41(
 
 
 template
-void sum_sqr_deviation_x64_SSE41<SumSquareMode::REFERENCE_ALPHA>(
+void sum_sqr_deviation_x64_SSE41<SumSquareMode::REFERENCE_ALPHA, false>(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+);
+template
+void sum_sqr_deviation_x64_SSE41<SumSquareMode::REFERENCE_ALPHA, true>(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+);
+template
+void sum_sqr_deviation_x64_SSE41<SumSquareMode::USE_BACKGROUND, false>(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+);
+template
+void sum_sqr_deviation_x64_SSE41<SumSquareMode::USE_BACKGROUND, true>(
     uint64_t& count, uint64_t& sumsqrs,
     size_t width, size_t height,
     const uint32_t* ref, size_t ref_bytes_per_line,
     const uint32_t* img, size_t img_bytes_per_line,
-    uint32_t background
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
 );
 template
-void sum_sqr_deviation_x64_SSE41<SumSquareMode::USE_BACKGROUND>(
+void sum_sqr_deviation_x64_SSE41<SumSquareMode::ARBITRATE_ALPHAS, false>(
     uint64_t& count, uint64_t& sumsqrs,
     size_t width, size_t height,
     const uint32_t* ref, size_t ref_bytes_per_line,
     const uint32_t* img, size_t img_bytes_per_line,
-    uint32_t background
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
 );
 template
-void sum_sqr_deviation_x64_SSE41<SumSquareMode::ARBITRATE_ALPHAS>(
+void sum_sqr_deviation_x64_SSE41<SumSquareMode::ARBITRATE_ALPHAS, true>(
     uint64_t& count, uint64_t& sumsqrs,
     size_t width, size_t height,
     const uint32_t* ref, size_t ref_bytes_per_line,
     const uint32_t* img, size_t img_bytes_per_line,
-    uint32_t background
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
 );
 
 
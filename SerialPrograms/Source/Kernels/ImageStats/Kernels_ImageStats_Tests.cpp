@@ -0,0 +1,424 @@
+/*  Image Stats Tests
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <vector>
+#include <algorithm>
+#include <random>
+#include "Common/Cpp/CpuId/CpuId.h"
+#include "Common/Cpp/TestRunners/UnitTestDatabase.h"
+#include "Kernels/ImageScaleBrightness/Kernels_ImageScaleBrightness.h"
+#include "Kernels_ImagePixelSumSqrDev.h"
+#include "Kernels_ImageTileHash.h"
+#include "Kernels_ImageStats_Tests.h"
+
+#include <iostream>
+using std::cout;
+using std::endl;
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+void scale_brightness_Default(
+    size_t width, size_t height,
+    uint32_t* image, size_t bytes_per_row,
+    float scaleR, float scaleG, float scaleB
+);
+void scale_brightness_x64_SSE41(
+    size_t width, size_t height,
+    uint32_t* image, size_t bytes_per_row,
+    float scaleR, float scaleG, float scaleB
+);
+void scale_brightness_x64_AVX2(
+    size_t width, size_t height,
+    uint32_t* image, size_t bytes_per_row,
+    float scaleR, float scaleG, float scaleB
+);
+void scale_brightness_x64_AVX512(
+    size_t width, size_t height,
+    uint32_t* image, size_t bytes_per_row,
+    float scaleR, float scaleG, float scaleB
+);
+template <SumSquareMode mode, bool scale_ref>
+void sum_sqr_deviation_Default(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+);
+template <SumSquareMode mode, bool scale_ref>
+void sum_sqr_deviation_x64_SSE41(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+);
+template <SumSquareMode mode, bool scale_ref>
+void sum_sqr_deviation_x64_AVX2(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+);
+template <SumSquareMode mode, bool scale_ref>
+void sum_sqr_deviation_x64_AVX512(
+    uint64_t& count, uint64_t& sumsqrs,
+    size_t width, size_t height,
+    const uint32_t* ref, size_t ref_bytes_per_line,
+    const uint32_t* img, size_t img_bytes_per_line,
+    uint32_t background,
+    float scaleR, float scaleG, float scaleB
+);
+void image_tile_hash_Default(
+    uint64_t* hashes,
+    size_t width, size_t height,
+    const uint32_t* image, size_t bytes_per_row
+);
+void image_tile_hash_x64_SSE41(
+    uint64_t* hashes,
+    size_t width, size_t height,
+    const uint32_t* image, size_t bytes_per_row
+);
+
+
+
+namespace{
+
+//  Random pixels with a mix of transparent, opaque and partially transparent
+//  alphas. Rows are padded with garbage to a multiple of 64 bytes, the same as
+//  ImageRGB32. The kernels are allowed to read into the padding.
+struct RandomImage{
+    size_t width;
+    size_t height;
+    size_t bytes_per_row;
+    std::vector<uint32_t> pixels;
+
+    RandomImage(std::mt19937& rng, size_t p_width, size_t p_height)
+        : width(p_width)
+        , height(p_height)
+        , bytes_per_row(((p_width + 15) / 16 + rng() % 2) * 64)
+        , pixels(bytes_per_row / sizeof(uint32_t) * p_height)
+    {
+        for (uint32_t& pixel : pixels){
+            pixel = (uint32_t)rng();
+            switch (rng() % 4){
+            case 0: pixel &= 0x00ffffff; break;
+            case 1: pixel |= 0xff000000; break;
+            }
+        }
+    }
+    uint32_t* data(){
+        return pixels.data();
+    }
+};
+
+}
+
+
+
+class Test_ImagePixelSumSqrDev : public UnitTest{
+public:
+    Test_ImagePixelSumSqrDev()
+        : UnitTest("Kernels::ImagePixelSumSqrDev")
+    {}
+
+    virtual UnitTestResult run(Logger& logger, CancellableScope& scope) const override{
+        std::mt19937 rng(0);
+        size_t error_count = 0;
+
+        const float SCALES[][3] = {
+            {1.0f, 1.0f, 1.0f},
+            {0.85f, 1.15f, 1.0f},
+            {1.15f, 0.9f, 0.85f},
+            {0.0f, 2.0f, 1.5f},
+            {0.5f, 0.5f, 0.5f},
+        };
+
+        for (size_t width = 1; width <= 80; width++){
+            size_t height = 1 + width % 4;
+            RandomImage ref(rng, width, height);
+            RandomImage img(rng, width, height);
+            uint32_t background = (uint32_t)rng();
+
+            //  Make some of the image pixels match the reference exactly.
+            for (size_t r = 0; r < height; r++){
+                for (size_t c = r % 3; c < width; c += 3){
+                    img.pixels[r * img.bytes_per_row / sizeof(uint32_t) + c] =
+                        ref.pixels[r * ref.bytes_per_row / sizeof(uint32_t) + c];
+                }
+            }
+
+            for (const float* scale : SCALES){
+                run_modes(error_count, ref, img, background, scale);
+            }
+
+            //  The fused scaling must match scaling a copy of the reference.
+            for (const float* scale : SCALES){
+                RandomImage scaled = ref;
+                scale_brightness(width, height, scaled.data(), scaled.bytes_per_row, scale[0], scale[1], scale[2]);
+
+                uint64_t count0 = 0, sumsqrs0 = 0;
+                uint64_t count1 = 0, sumsqrs1 = 0;
+                sum_sqr_deviation_scaled(
+                    count0, sumsqrs0, width, height,
+                    ref.data(), ref.bytes_per_row,
+                    img.data(), img.bytes_per_row,
+                    scale[0], scale[1], scale[2]
+                );
+                sum_sqr_deviation(
+                    count1, sumsqrs1, width, height,
+                    scaled.data(), scaled.bytes_per_row,
+                    img.data(), img.bytes_per_row
+                );
+                if ((count0 != count1 || sumsqrs0 != sumsqrs1) && error_count++ < 10){
+                    cout << "Error: sum_sqr_deviation_scaled() differs from scale_brightness() + sum_sqr_deviation()"
+                        << " at width = " << width << endl;
+                }
+            }
+        }
+
+        return error_count == 0;
+    };
+
+private:
+    static void run_modes(
+        size_t& error_count,
+        RandomImage& ref, RandomImage& img, uint32_t background,
+        const float* scale
+    ){
+        compare<SumSquareMode::REFERENCE_ALPHA, false>(error_count, ref, img, background, scale);
+        compare<SumSquareMode::REFERENCE_ALPHA, true>(error_count, ref, img, background, scale);
+        compare<SumSquareMode::USE_BACKGROUND, false>(error_count, ref, img, background, scale);
+        compare<SumSquareMode::USE_BACKGROUND, true>(error_count, ref, img, background, scale);
+        compare<SumSquareMode::ARBITRATE_ALPHAS, false>(error_count, ref, img, background, scale);
+        compare<SumSquareMode::ARBITRATE_ALPHAS, true>(error_count, ref, img, background, scale);
+    }
+
+    template <SumSquareMode mode, bool scale_ref>
+    static void compare(
+        size_t& error_count,
+        RandomImage& ref, RandomImage& img, uint32_t background,
+        const float* scale
+    ){
+        using Function = void (*)(
+            uint64_t& count, uint64_t& sumsqrs,
+            size_t width, size_t height,
+            const uint32_t* ref, size_t ref_bytes_per_line,
+            const uint32_t* img, size_t img_bytes_per_line,
+            uint32_t background,
+            float scaleR, float scaleG, float scaleB
+        );
+        using ScaleFunction = void (*)(
+            size_t width, size_t height,
+            uint32_t* image, size_t bytes_per_row,
+            float scaleR, float scaleG, float scaleB
+        );
+        struct Implementation{
+            const char* name;
+            Function function;
+            ScaleFunction scale_brightness;
+        };
+
+        //  The variants that were compiled in and that this machine can run.
+        //  Each is paired with the scale_brightness() of the same instruction
+        //  set since they must round the same way.
+        std::vector<Implementation> implementations;
+        implementations.emplace_back(Implementation{"Default", sum_sqr_deviation_Default<mode, scale_ref>, scale_brightness_Default});
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+        if (CPU_CAPABILITY_NATIVE.OK_08_Nehalem){
+            implementations.emplace_back(Implementation{"SSE4.1", sum_sqr_deviation_x64_SSE41<mode, scale_ref>, scale_brightness_x64_SSE41});
+        }
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+        if (CPU_CAPABILITY_NATIVE.OK_13_Haswell){
+            implementations.emplace_back(Implementation{"AVX2", sum_sqr_deviation_x64_AVX2<mode, scale_ref>, scale_brightness_x64_AVX2});
+        }
+#endif
+#ifdef PA_AutoDispatch_x64_17_Skylake
+        if (CPU_CAPABILITY_NATIVE.OK_17_Skylake){
+            implementations.emplace_back(Implementation{"AVX512", sum_sqr_deviation_x64_AVX512<mode, scale_ref>, scale_brightness_x64_AVX512});
+        }
+#endif
+
+        for (const Implementation& implementation : implementations){
+            //  Expected: scale a copy of the reference, then compare unscaled.
+            RandomImage scaled = ref;
+            if (scale_ref){
+                implementation.scale_brightness(
+                    scaled.width, scaled.height,
+                    scaled.data(), scaled.bytes_per_row,
+                    scale[0], scale[1], scale[2]
+                );
+            }
+            uint64_t expected_count = 0, expected_sumsqrs = 0;
+            sum_sqr_deviation_Default<mode, false>(
+                expected_count, expected_sumsqrs,
+                scaled.width, scaled.height,
+                scaled.data(), scaled.bytes_per_row,
+                img.data(), img.bytes_per_row,
+                background,
+                1.0f, 1.0f, 1.0f
+            );
+
+            uint64_t count = 0, sumsqrs = 0;
+            implementation.function(
+                count, sumsqrs,
+                ref.width, ref.height,
+                ref.data(), ref.bytes_per_row,
+                img.data(), img.bytes_per_row,
+                background,
+                scale[0], scale[1], scale[2]
+            );
+            if ((count != expected_count || sumsqrs != expected_sumsqrs) && error_count++ < 10){
+                cout << "Error: sum_sqr_deviation() (" << implementation.name << ") differs from scaling a copy"
+                    << ", mode = " << (int)mode << ", scale_ref = " << scale_ref
+                    << ", width = " << ref.width << ", height = " << ref.height
+                    << ", count = " << count << " vs. " << expected_count
+                    << ", sumsqrs = " << sumsqrs << " vs. " << expected_sumsqrs << endl;
+            }
+        }
+    }
+};
+
+
+
+class Test_ImageTileHash : public UnitTest{
+public:
+    Test_ImageTileHash()
+        : UnitTest("Kernels::ImageTileHash")
+    {}
+
+    virtual UnitTestResult run(Logger& logger, CancellableScope& scope) const override{
+        using Function = void (*)(
+            uint64_t* hashes,
+            size_t width, size_t height,
+            const uint32_t* image, size_t bytes_per_row
+        );
+        struct Implementation{
+            const char* name;
+            Function function;
+        };
+
+        //  The SIMD variants that were compiled in and that this machine can run.
+        std::vector<Implementation> implementations;
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+        if (CPU_CAPABILITY_NATIVE.OK_08_Nehalem){
+            implementations.emplace_back(Implementation{"SSE4.1", image_tile_hash_x64_SSE41});
+        }
+#endif
+
+        std::mt19937 rng(0);
+        size_t error_count = 0;
+
+        //  Partial tiles and partial vectors on both axes.
+        for (size_t width = 1; width <= 100; width += 1 + width / 8){
+            for (size_t height : {(size_t)1, (size_t)31, (size_t)32, (size_t)33, (size_t)70}){
+                RandomImage image(rng, width, height);
+                size_t tiles = ((width + IMAGE_HASH_TILE_SIZE - 1) / IMAGE_HASH_TILE_SIZE)
+                    * ((height + IMAGE_HASH_TILE_SIZE - 1) / IMAGE_HASH_TILE_SIZE);
+
+                std::vector<uint64_t> expected(tiles);
+                image_tile_hash_Default(expected.data(), width, height, image.data(), image.bytes_per_row);
+                for (const Implementation& implementation : implementations){
+                    std::vector<uint64_t> actual(tiles);
+                    implementation.function(actual.data(), width, height, image.data(), image.bytes_per_row);
+                    if (actual != expected && error_count++ < 10){
+                        cout << "Error: image_tile_hash() (" << implementation.name << ") differs from the default"
+                            << " at width = " << width << ", height = " << height << endl;
+                    }
+                }
+
+                //  Changing one pixel must change the hash of its tile and no
+                //  other.
+                size_t x = rng() % width;
+                size_t y = rng() % height;
+                uint32_t& pixel = image.pixels[y * image.bytes_per_row / sizeof(uint32_t) + x];
+                pixel ^= (uint32_t)1 << (rng() % 32);
+                std::vector<uint64_t> changed(tiles);
+                image_tile_hash(changed.data(), width, height, image.data(), image.bytes_per_row);
+                size_t tiles_x = (width + IMAGE_HASH_TILE_SIZE - 1) / IMAGE_HASH_TILE_SIZE;
+                size_t tile = y / IMAGE_HASH_TILE_SIZE * tiles_x + x / IMAGE_HASH_TILE_SIZE;
+                for (size_t c = 0; c < tiles; c++){
+                    if ((changed[c] != expected[c]) != (c == tile) && error_count++ < 10){
+                        cout << "Error: image_tile_hash() changed the wrong tiles for a single pixel"
+                            << " at width = " << width << ", height = " << height
+                            << ", x = " << x << ", y = " << y << endl;
+                    }
+                }
+
+                //  Changes to several pixels of the same tile. Each of these
+                //  always cancelled with a linear hash.
+                size_t x0 = x / IMAGE_HASH_TILE_SIZE * IMAGE_HASH_TILE_SIZE;
+                size_t y0 = y / IMAGE_HASH_TILE_SIZE * IMAGE_HASH_TILE_SIZE;
+                size_t x1 = std::min(width, x0 + IMAGE_HASH_TILE_SIZE);
+                size_t y1 = std::min(height, y0 + IMAGE_HASH_TILE_SIZE);
+                auto check_tile_changed = [&](const char* what, auto&& modify){
+                    RandomImage modified = image;
+                    modify(modified);
+                    if (modified.pixels == image.pixels){
+                        return;
+                    }
+                    std::vector<uint64_t> actual(tiles);
+                    image_tile_hash(actual.data(), width, height, modified.data(), modified.bytes_per_row);
+                    if (actual[tile] == changed[tile] && error_count++ < 10){
+                        cout << "Error: image_tile_hash() missed a change (" << what << ")"
+                            << " at width = " << width << ", height = " << height
+                            << ", x = " << x << ", y = " << y << endl;
+                    }
+                };
+                auto at = [](RandomImage& img, size_t px, size_t py) -> uint32_t&{
+                    return img.pixels[py * img.bytes_per_row / sizeof(uint32_t) + px];
+                };
+                if (x1 - x0 >= 2){
+                    size_t xa = x0 + rng() % (x1 - x0);
+                    size_t xb = xa == x0 ? xa + 1 : xa - 1;
+                    check_tile_changed("bit 31 of 2 pixels in a row", [&](RandomImage& img){
+                        at(img, xa, y) ^= 0x80000000;
+                        at(img, xb, y) ^= 0x80000000;
+                    });
+                    check_tile_changed("2 pixels swapped in a row", [&](RandomImage& img){
+                        std::swap(at(img, xa, y), at(img, xb, y));
+                    });
+                }
+                check_tile_changed("red bit 7 of the whole tile", [&](RandomImage& img){
+                    for (size_t py = y0; py < y1; py++){
+                        for (size_t px = x0; px < x1; px++){
+                            at(img, px, py) ^= 0x00800000;
+                        }
+                    }
+                });
+                if (y1 - y0 >= 2){
+                    size_t ya = y0 + rng() % (y1 - y0);
+                    size_t yb = ya == y0 ? ya + 1 : ya - 1;
+                    check_tile_changed("2 pixels in different rows", [&](RandomImage& img){
+                        at(img, x, ya) += (uint32_t)rng() | 1;
+                        at(img, x, yb) -= (uint32_t)rng() | 1;
+                    });
+                }
+            }
+        }
+
+        return error_count == 0;
+    }
+};
+
+
+
+void add_tests_ImageStats(UnitTestDatabase& database){
+    database.add<Test_ImagePixelSumSqrDev>();
+    database.add<Test_ImageTileHash>();
+}
+
+
+
+}
+}
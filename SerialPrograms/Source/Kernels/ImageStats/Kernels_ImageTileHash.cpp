@@ -0,0 +1,44 @@
+/*  Image Tile Hash
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include "Common/Cpp/CpuId/CpuId.h"
+#include "Kernels_ImageTileHash.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+void image_tile_hash_Default(
+    uint64_t* hashes,
+    size_t width, size_t height,
+    const uint32_t* image, size_t bytes_per_row
+);
+void image_tile_hash_x64_SSE41(
+    uint64_t* hashes,
+    size_t width, size_t height,
+    const uint32_t* image, size_t bytes_per_row
+);
+
+
+
+void image_tile_hash(
+    uint64_t* hashes,
+    size_t width, size_t height,
+    const uint32_t* image, size_t bytes_per_row
+){
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        image_tile_hash_x64_SSE41(hashes, width, height, image, bytes_per_row);
+        return;
+    }
+#endif
+    image_tile_hash_Default(hashes, width, height, image, bytes_per_row);
+}
+
+
+
+}
+}
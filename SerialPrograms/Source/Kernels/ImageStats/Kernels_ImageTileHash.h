@@ -0,0 +1,92 @@
+/*  Image Tile Hash
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Hash an image in tiles of 32 x 32 pixels.
+ *
+ *  Each pixel is XORed with 2 keys that depend on its column and each result
+ *  goes through a 32-bit multiply-xorshift mix. Each row of a tile is then
+ *  reduced to 2 x 32-bit sums of the mixed pixels. The 64-bit row sum is
+ *  folded into the tile hash with a 64-bit multiply-xorshift mix.
+ *
+ *  All the mixes are bijections. So a tile that differs in exactly one pixel
+ *  always hashes differently. Changes to several pixels can only cancel if
+ *  the mixed values happen to collide. Unlike a linear sum, there is no
+ *  pattern of changes (in a channel, in a bit or across rows) that always
+ *  cancels. Swapping pixels within a row changes the hash too since the keys
+ *  differ per column.
+ *
+ *  The keys are fixed. This is not meant to resist inputs that are made to
+ *  collide on purpose.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ImageTileHash_H
+#define PokemonAutomation_Kernels_ImageTileHash_H
+
+#include <stdint.h>
+#include <cstddef>
+#include "Common/Compiler.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+constexpr size_t IMAGE_HASH_TILE_SIZE = 32;
+
+
+struct ImageTileHashKeys{
+    alignas(64) uint32_t k0[IMAGE_HASH_TILE_SIZE];
+    alignas(64) uint32_t k1[IMAGE_HASH_TILE_SIZE];
+
+    constexpr ImageTileHashKeys()
+        : k0{}
+        , k1{}
+    {
+        uint64_t state = 0x9e3779b97f4a7c15;
+        for (size_t c = 0; c < IMAGE_HASH_TILE_SIZE; c++){
+            state = state * 6364136223846793005 + 1442695040888963407;
+            k0[c] = (uint32_t)(state >> 32);
+            state = state * 6364136223846793005 + 1442695040888963407;
+            k1[c] = (uint32_t)(state >> 32);
+        }
+    }
+};
+inline constexpr ImageTileHashKeys IMAGE_TILE_HASH_KEYS;
+
+//  The SIMD implementations do the same thing in each lane.
+constexpr uint32_t IMAGE_TILE_HASH_MUL0 = 0x85ebca6b;
+constexpr uint32_t IMAGE_TILE_HASH_MUL1 = 0xc2b2ae35;
+PA_FORCE_INLINE uint32_t image_tile_hash_mix_pixel(uint32_t x){
+    x ^= x >> 16;
+    x *= IMAGE_TILE_HASH_MUL0;
+    x ^= x >> 13;
+    x *= IMAGE_TILE_HASH_MUL1;
+    x ^= x >> 16;
+    return x;
+}
+
+//  Fold the 2 sums of a row into the tile hash.
+PA_FORCE_INLINE uint64_t image_tile_hash_fold_row(uint64_t hash, uint32_t s0, uint32_t s1){
+    uint64_t x = hash ^ ((uint64_t)s1 << 32 | s0);
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111eb;
+    x ^= x >> 31;
+    return x;
+}
+
+
+//  "hashes" is ceil(width / 32) x ceil(height / 32), row-major.
+//  All implementations return the same hashes.
+void image_tile_hash(
+    uint64_t* hashes,
+    size_t width, size_t height,
+    const uint32_t* image, size_t bytes_per_row
+);
+
+
+}
+}
+#endif
@@ -0,0 +1,64 @@
+/*  Image Tile Hash (Default)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <vector>
+#include "Common/Compiler.h"
+#include "Kernels_ImageTileHash.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+PA_FORCE_INLINE void image_tile_hash_row_Default(
+    uint64_t& acc,
+    const uint32_t* pixels, size_t width
+){
+    const ImageTileHashKeys& keys = IMAGE_TILE_HASH_KEYS;
+    uint32_t s0 = 0;
+    uint32_t s1 = 0;
+    for (size_t c = 0; c < width; c++){
+        s0 += image_tile_hash_mix_pixel(pixels[c] ^ keys.k0[c]);
+        s1 += image_tile_hash_mix_pixel(pixels[c] ^ keys.k1[c]);
+    }
+    acc = image_tile_hash_fold_row(acc, s0, s1);
+}
+void image_tile_hash_Default(
+    uint64_t* hashes,
+    size_t width, size_t height,
+    const uint32_t* image, size_t bytes_per_row
+){
+    const size_t TILE = IMAGE_HASH_TILE_SIZE;
+    size_t tiles_x = (width + TILE - 1) / TILE;
+    size_t full_tiles = width / TILE;
+
+    std::vector<uint64_t> acc(tiles_x);
+
+    for (size_t r = 0; r < height; r++){
+        for (size_t tx = 0; tx < full_tiles; tx++){
+            image_tile_hash_row_Default(acc[tx], image + tx * TILE, TILE);
+        }
+        if (full_tiles < tiles_x){
+            image_tile_hash_row_Default(
+                acc[full_tiles],
+                image + full_tiles * TILE, width - full_tiles * TILE
+            );
+        }
+
+        if (r % TILE == TILE - 1 || r + 1 == height){
+            for (size_t tx = 0; tx < tiles_x; tx++){
+                hashes[tx] = acc[tx];
+                acc[tx] = 0;
+            }
+            hashes += tiles_x;
+        }
+
+        image = (const uint32_t*)((const char*)image + bytes_per_row);
+    }
+}
+
+
+}
+}
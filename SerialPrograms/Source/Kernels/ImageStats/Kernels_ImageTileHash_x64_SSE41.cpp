@@ -0,0 +1,107 @@
+/*  Image Tile Hash (x64 SSE4.1)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+
+#include <vector>
+#include <smmintrin.h>
+#include "Kernels/Kernels_x64_SSE41.h"
+#include "Kernels_ImageTileHash.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+PA_FORCE_INLINE void image_tile_hash_row_partial_x64_SSE41(
+    uint64_t& acc,
+    const uint32_t* pixels, size_t width
+){
+    const ImageTileHashKeys& keys = IMAGE_TILE_HASH_KEYS;
+    uint32_t s0 = 0;
+    uint32_t s1 = 0;
+    for (size_t c = 0; c < width; c++){
+        s0 += image_tile_hash_mix_pixel(pixels[c] ^ keys.k0[c]);
+        s1 += image_tile_hash_mix_pixel(pixels[c] ^ keys.k1[c]);
+    }
+    acc = image_tile_hash_fold_row(acc, s0, s1);
+}
+
+
+//  Same as "image_tile_hash_mix_pixel()" in each lane.
+PA_FORCE_INLINE __m128i image_tile_hash_mix_pixels_x64_SSE41(__m128i x){
+    const __m128i MUL0 = _mm_set1_epi32((int32_t)IMAGE_TILE_HASH_MUL0);
+    const __m128i MUL1 = _mm_set1_epi32((int32_t)IMAGE_TILE_HASH_MUL1);
+    x = _mm_xor_si128(x, _mm_srli_epi32(x, 16));
+    x = _mm_mullo_epi32(x, MUL0);
+    x = _mm_xor_si128(x, _mm_srli_epi32(x, 13));
+    x = _mm_mullo_epi32(x, MUL1);
+    x = _mm_xor_si128(x, _mm_srli_epi32(x, 16));
+    return x;
+}
+
+//  A full 32-pixel row of a tile. The keys stay in registers across the
+//  whole image row. Only the reduction to 2 scalars and the fold are done
+//  per tile.
+PA_FORCE_INLINE void image_tile_hash_row_x64_SSE41(
+    uint64_t& acc,
+    const uint32_t* pixels,
+    const __m128i* k0, const __m128i* k1
+){
+    __m128i s0 = _mm_setzero_si128();
+    __m128i s1 = _mm_setzero_si128();
+    for (size_t c = 0; c < IMAGE_HASH_TILE_SIZE / 4; c++){
+        __m128i p = _mm_loadu_si128((const __m128i*)pixels + c);
+        s0 = _mm_add_epi32(s0, image_tile_hash_mix_pixels_x64_SSE41(_mm_xor_si128(p, k0[c])));
+        s1 = _mm_add_epi32(s1, image_tile_hash_mix_pixels_x64_SSE41(_mm_xor_si128(p, k1[c])));
+    }
+    acc = image_tile_hash_fold_row(
+        acc,
+        (uint32_t)reduce32_x64_SSE41(s0),
+        (uint32_t)reduce32_x64_SSE41(s1)
+    );
+}
+void image_tile_hash_x64_SSE41(
+    uint64_t* hashes,
+    size_t width, size_t height,
+    const uint32_t* image, size_t bytes_per_row
+){
+    const size_t TILE = IMAGE_HASH_TILE_SIZE;
+    size_t tiles_x = (width + TILE - 1) / TILE;
+    size_t full_tiles = width / TILE;
+
+    const __m128i* k0 = (const __m128i*)IMAGE_TILE_HASH_KEYS.k0;
+    const __m128i* k1 = (const __m128i*)IMAGE_TILE_HASH_KEYS.k1;
+
+    std::vector<uint64_t> acc(tiles_x);
+
+    for (size_t r = 0; r < height; r++){
+        for (size_t tx = 0; tx < full_tiles; tx++){
+            image_tile_hash_row_x64_SSE41(acc[tx], image + tx * TILE, k0, k1);
+        }
+        if (full_tiles < tiles_x){
+            image_tile_hash_row_partial_x64_SSE41(
+                acc[full_tiles],
+                image + full_tiles * TILE, width - full_tiles * TILE
+            );
+        }
+
+        if (r % TILE == TILE - 1 || r + 1 == height){
+            for (size_t tx = 0; tx < tiles_x; tx++){
+                hashes[tx] = acc[tx];
+                acc[tx] = 0;
+            }
+            hashes += tiles_x;
+        }
+
+        image = (const uint32_t*)((const char*)image + bytes_per_row);
+    }
+}
+
+
+
+}
+}
+#endif
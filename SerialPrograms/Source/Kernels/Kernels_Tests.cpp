@@ -8,7 +8,10 @@
 #include "BinaryMatrix/Kernels_BinaryMatrix_Tests.h"
 #include "ImageFilters/Kernels_ImageFilter_Tests.h"
 #include "ImageScaleBrightness/Kernels_ImageScaleBrightness_Tests.h"
+#include "ImageStats/Kernels_ImageStats_Tests.h"
+#include "ScaleInvariantMatrixMatch/Kernels_ScaleInvariantMatrixMatch_Tests.h"
 #include "Waterfill/Kernels_Waterfill_Tests.h"
+#include "VideoFrameConversion/Kernels_VideoFrameConversion_Tests.h"
 
 namespace PokemonAutomation{
 namespace Kernels{
@@ -19,7 +22,10 @@ void add_tests(UnitTestDatabase& database){
     add_tests_BinaryMatrix(database);
     add_tests_ImageFilters(database);
     add_tests_ImageScaleBrightness(database);
+    add_tests_ImageStats(database);
+    add_tests_ScaleInvariantMatrixMatch(database);
     add_tests_Waterfill(database);
+    add_tests_VideoFrameConversion(database);
 }
 
 
@@ -131,6 +131,36 @@ float compute_error(
 
 
 
+float compute_dot_Default           (size_t width, size_t height, float const* const* A, float const* const* T);
+float compute_dot_min4_x86_SSE      (size_t width, size_t height, float const* const* A, float const* const* T);
+float compute_dot_min8_x86_AVX2     (size_t width, size_t height, float const* const* A, float const* const* T);
+float compute_dot_min16_x86_AVX512  (size_t width, size_t height, float const* const* A, float const* const* T);
+
+float compute_dot(
+    size_t width, size_t height,
+    float const* const* A,
+    float const* const* T
+){
+#ifdef PA_AutoDispatch_x64_17_Skylake
+    if (width >= 16 && CPU_CAPABILITY_CURRENT.OK_17_Skylake){
+        return compute_dot_min16_x86_AVX512(width, height, A, T);
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (width >= 8 && CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        return compute_dot_min8_x86_AVX2(width, height, A, T);
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (width >= 4 && CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        return compute_dot_min4_x86_SSE(width, height, A, T);
+    }
+#endif
+    return compute_dot_Default(width, height, A, T);
+}
+
+
+
 
 
 
@@ -54,6 +54,16 @@ float compute_error(
 
 
 
+//  Compute: sum(A * T)
+//      All pointers must have the same alignment.
+float compute_dot(
+    size_t width, size_t height,
+    float const* const* A,
+    float const* const* T
+);
+
+
+
 
 
 }
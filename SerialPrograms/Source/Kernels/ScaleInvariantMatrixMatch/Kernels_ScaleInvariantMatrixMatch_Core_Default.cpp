@@ -108,6 +108,13 @@ float compute_error_Default(
 ){
     return compute_error<SumError<Context_x86_SSE41>>(width, height, scale, A, TW, W);
 }
+float compute_dot_Default(
+    size_t width, size_t height,
+    float const* const* A,
+    float const* const* T
+){
+    return compute_dot<SumAT<Context_x86_SSE41>>(width, height, A, T);
+}
 
 
 
@@ -123,6 +123,13 @@ float compute_error_min8_x86_AVX2(
 ){
     return compute_error<SumError<Context_x86_AVX2>>(width, height, scale, A, TW, W);
 }
+float compute_dot_min8_x86_AVX2(
+    size_t width, size_t height,
+    float const* const* A,
+    float const* const* T
+){
+    return compute_dot<SumAT<Context_x86_AVX2>>(width, height, A, T);
+}
 
 
 
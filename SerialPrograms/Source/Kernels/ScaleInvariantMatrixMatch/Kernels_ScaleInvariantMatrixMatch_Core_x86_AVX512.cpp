@@ -115,6 +115,13 @@ float compute_error_min16_x86_AVX512(
 ){
     return compute_error<SumError<Context_x86_AVX512>>(width, height, scale, A, TW, W);
 }
+float compute_dot_min16_x86_AVX512(
+    size_t width, size_t height,
+    float const* const* A,
+    float const* const* T
+){
+    return compute_dot<SumAT<Context_x86_AVX512>>(width, height, A, T);
+}
 
 
 
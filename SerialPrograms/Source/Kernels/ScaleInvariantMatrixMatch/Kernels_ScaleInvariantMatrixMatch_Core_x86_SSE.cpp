@@ -117,6 +117,13 @@ float compute_error_min4_x86_SSE(
 ){
     return compute_error<SumError<Context_x86_SSE41>>(width, height, scale, A, TW, W);
 }
+float compute_dot_min4_x86_SSE(
+    size_t width, size_t height,
+    float const* const* A,
+    float const* const* T
+){
+    return compute_dot<SumAT<Context_x86_SSE41>>(width, height, A, T);
+}
 
 
 
@@ -0,0 +1,203 @@
+/*  Scale Invariant Matrix Match Tests
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Check every SIMD variant available on this machine against the default
+ *  implementation. Rows start at every offset within a vector and end at every
+ *  length of the final partial vector. The floats just outside each row are
+ *  poisoned so that a tail load that reads the wrong elements shows up.
+ *
+ */
+
+#include <cmath>
+#include <vector>
+#include <random>
+#include "Common/Cpp/CpuId/CpuId.h"
+#include "Common/Cpp/Containers/AlignedVector.tpp"
+#include "Common/Cpp/TestRunners/UnitTestDatabase.h"
+#include "Kernels_ScaleInvariantMatrixMatch_Tests.h"
+
+#include <iostream>
+using std::cout;
+using std::endl;
+
+namespace PokemonAutomation{
+namespace Kernels{
+namespace ScaleInvariantMatrixMatch{
+
+
+float compute_scale_Default         (size_t width, size_t height, float const* const* A, float const* const* T);
+float compute_scale_min4_x86_SSE    (size_t width, size_t height, float const* const* A, float const* const* T);
+float compute_scale_min8_x86_AVX2   (size_t width, size_t height, float const* const* A, float const* const* T);
+float compute_scale_min16_x86_AVX512(size_t width, size_t height, float const* const* A, float const* const* T);
+
+float compute_scale_Default         (size_t width, size_t height, float const* const* A, float const* const* TW, float const* const* W);
+float compute_scale_min4_x86_SSE    (size_t width, size_t height, float const* const* A, float const* const* TW, float const* const* W);
+float compute_scale_min8_x86_AVX2   (size_t width, size_t height, float const* const* A, float const* const* TW, float const* const* W);
+float compute_scale_min16_x86_AVX512(size_t width, size_t height, float const* const* A, float const* const* TW, float const* const* W);
+
+float compute_error_Default         (size_t width, size_t height, float scale, float const* const* A, float const* const* T);
+float compute_error_min4_x86_SSE    (size_t width, size_t height, float scale, float const* const* A, float const* const* T);
+float compute_error_min8_x86_AVX2   (size_t width, size_t height, float scale, float const* const* A, float const* const* T);
+float compute_error_min16_x86_AVX512(size_t width, size_t height, float scale, float const* const* A, float const* const* T);
+
+float compute_error_Default         (size_t width, size_t height, float scale, float const* const* A, float const* const* TW, float const* const* W);
+float compute_error_min4_x86_SSE    (size_t width, size_t height, float scale, float const* const* A, float const* const* TW, float const* const* W);
+float compute_error_min8_x86_AVX2   (size_t width, size_t height, float scale, float const* const* A, float const* const* TW, float const* const* W);
+float compute_error_min16_x86_AVX512(size_t width, size_t height, float scale, float const* const* A, float const* const* TW, float const* const* W);
+
+float compute_dot_Default           (size_t width, size_t height, float const* const* A, float const* const* T);
+float compute_dot_min4_x86_SSE      (size_t width, size_t height, float const* const* A, float const* const* T);
+float compute_dot_min8_x86_AVX2     (size_t width, size_t height, float const* const* A, float const* const* T);
+float compute_dot_min16_x86_AVX512  (size_t width, size_t height, float const* const* A, float const* const* T);
+
+
+}
+
+
+
+namespace{
+
+using namespace ScaleInvariantMatrixMatch;
+
+struct Implementation{
+    const char* name;
+    size_t min_width;
+    float (*scale)(size_t, size_t, float const* const*, float const* const*);
+    float (*scale_weighted)(size_t, size_t, float const* const*, float const* const*, float const* const*);
+    float (*error)(size_t, size_t, float, float const* const*, float const* const*);
+    float (*error_weighted)(size_t, size_t, float, float const* const*, float const* const*, float const* const*);
+    float (*dot)(size_t, size_t, float const* const*, float const* const*);
+};
+
+const size_t ROW_STRIDE = 128;
+const float POISON = 1e6f;
+
+//  "height" rows of "width" random floats, each starting "offset" floats into
+//  a 64-byte aligned row. Everything else is POISON.
+struct RandomMatrix{
+    AlignedVector<float> buffer;
+    std::vector<const float*> rows;
+
+    RandomMatrix(std::mt19937& rng, size_t width, size_t height, size_t offset)
+        : buffer(ROW_STRIDE * height)
+    {
+        std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
+        for (size_t c = 0; c < buffer.size(); c++){
+            buffer[c] = POISON;
+        }
+        for (size_t r = 0; r < height; r++){
+            float* row = buffer.data() + r * ROW_STRIDE + offset;
+            for (size_t c = 0; c < width; c++){
+                row[c] = distribution(rng);
+            }
+            rows.emplace_back(row);
+        }
+    }
+    float const* const* data() const{
+        return rows.data();
+    }
+};
+
+bool close(float x, float expected){
+    return std::fabs(x - expected) <= 1e-4f * std::max(1.0f, std::fabs(expected));
+}
+
+}
+
+
+
+class Test_ScaleInvariantMatrixMatch : public UnitTest{
+public:
+    Test_ScaleInvariantMatrixMatch()
+        : UnitTest("Kernels::ScaleInvariantMatrixMatch")
+    {}
+
+    virtual UnitTestResult run(Logger& logger, CancellableScope& scope) const override{
+        //  The SIMD variants that were compiled in and that this machine can run.
+        std::vector<Implementation> implementations;
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+        if (CPU_CAPABILITY_NATIVE.OK_08_Nehalem){
+            implementations.emplace_back(Implementation{
+                "SSE", 4,
+                compute_scale_min4_x86_SSE, compute_scale_min4_x86_SSE,
+                compute_error_min4_x86_SSE, compute_error_min4_x86_SSE,
+                compute_dot_min4_x86_SSE
+            });
+        }
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+        if (CPU_CAPABILITY_NATIVE.OK_13_Haswell){
+            implementations.emplace_back(Implementation{
+                "AVX2", 8,
+                compute_scale_min8_x86_AVX2, compute_scale_min8_x86_AVX2,
+                compute_error_min8_x86_AVX2, compute_error_min8_x86_AVX2,
+                compute_dot_min8_x86_AVX2
+            });
+        }
+#endif
+#ifdef PA_AutoDispatch_x64_17_Skylake
+        if (CPU_CAPABILITY_NATIVE.OK_17_Skylake){
+            implementations.emplace_back(Implementation{
+                "AVX512", 16,
+                compute_scale_min16_x86_AVX512, compute_scale_min16_x86_AVX512,
+                compute_error_min16_x86_AVX512, compute_error_min16_x86_AVX512,
+                compute_dot_min16_x86_AVX512
+            });
+        }
+#endif
+        if (implementations.empty()){
+            return UnitTestResult(UnitTestResult::SKIPPED, "No SIMD implementation available on this machine.");
+        }
+
+        std::mt19937 rng(0);
+        size_t error_count = 0;
+
+        for (size_t offset = 0; offset < 16; offset++){
+            for (size_t width = 1; width <= 70; width++){
+                size_t height = 1 + (width + offset) % 3;
+                RandomMatrix A(rng, width, height, offset);
+                RandomMatrix T(rng, width, height, offset);
+                RandomMatrix W(rng, width, height, offset);
+                float scale = 0.5f + (float)(rng() % 1000) / 1000;
+
+                float expected_scale = compute_scale_Default(width, height, A.data(), T.data());
+                float expected_scale_weighted = compute_scale_Default(width, height, A.data(), T.data(), W.data());
+                float expected_error = compute_error_Default(width, height, scale, A.data(), T.data());
+                float expected_error_weighted = compute_error_Default(width, height, scale, A.data(), T.data(), W.data());
+                float expected_dot = compute_dot_Default(width, height, A.data(), T.data());
+
+                for (const Implementation& implementation : implementations){
+                    if (width < implementation.min_width){
+                        continue;
+                    }
+                    auto check = [&](const char* function, float actual, float expected){
+                        if (!close(actual, expected) && error_count++ < 10){
+                            cout << "Error: " << function << " (" << implementation.name << ") differs from the default"
+                                << " at width = " << width << ", height = " << height << ", offset = " << offset
+                                << ": " << actual << " vs. " << expected << endl;
+                        }
+                    };
+                    check("compute_scale()", implementation.scale(width, height, A.data(), T.data()), expected_scale);
+                    check("compute_scale(weighted)", implementation.scale_weighted(width, height, A.data(), T.data(), W.data()), expected_scale_weighted);
+                    check("compute_error()", implementation.error(width, height, scale, A.data(), T.data()), expected_error);
+                    check("compute_error(weighted)", implementation.error_weighted(width, height, scale, A.data(), T.data(), W.data()), expected_error_weighted);
+                    check("compute_dot()", implementation.dot(width, height, A.data(), T.data()), expected_dot);
+                }
+            }
+        }
+
+        return error_count == 0;
+    };
+};
+
+
+
+void add_tests_ScaleInvariantMatrixMatch(UnitTestDatabase& database){
+    database.add<Test_ScaleInvariantMatrixMatch>();
+}
+
+
+
+}
+}
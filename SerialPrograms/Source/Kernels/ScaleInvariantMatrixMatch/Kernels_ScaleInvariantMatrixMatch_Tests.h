@@ -0,0 +1,23 @@
+/*  Scale Invariant Matrix Match Tests
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_ScaleInvariantMatrixMatch_Tests_H
+#define PokemonAutomation_Kernels_ScaleInvariantMatrixMatch_Tests_H
+
+#include "Common/Cpp/TestRunners/UnitTest.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+
+void add_tests_ScaleInvariantMatrixMatch(UnitTestDatabase& database);
+
+
+
+}
+}
+#endif
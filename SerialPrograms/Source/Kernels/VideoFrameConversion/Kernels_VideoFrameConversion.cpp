@@ -0,0 +1,167 @@
+/*  Video Frame Conversion
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include "Common/Cpp/CpuId/CpuId.h"
+#include "Kernels_VideoFrameConversion.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+YUVtoRGBMatrix yuv_to_rgb_matrix(bool bt709, bool full_range){
+    if (full_range){
+        return bt709
+            ? YUVtoRGBMatrix{0, 256, 403, 48, 120, 475}
+            : YUVtoRGBMatrix{0, 256, 359, 88, 183, 454};
+    }else{
+        return bt709
+            ? YUVtoRGBMatrix{16, 298, 459, 55, 136, 541}
+            : YUVtoRGBMatrix{16, 298, 409, 100, 208, 516};
+    }
+}
+
+
+
+void convert_NV12_to_RGB32_Default(
+    const YUVtoRGBMatrix& matrix,
+    size_t width, size_t height,
+    const uint8_t* luma, size_t luma_bytes_per_row,
+    const uint8_t* chroma, size_t chroma_bytes_per_row,
+    uint32_t* image, size_t image_bytes_per_row
+);
+void convert_NV12_to_RGB32_x64_SSE41(
+    const YUVtoRGBMatrix& matrix,
+    size_t width, size_t height,
+    const uint8_t* luma, size_t luma_bytes_per_row,
+    const uint8_t* chroma, size_t chroma_bytes_per_row,
+    uint32_t* image, size_t image_bytes_per_row
+);
+void convert_NV12_to_RGB32_x64_AVX2(
+    const YUVtoRGBMatrix& matrix,
+    size_t width, size_t height,
+    const uint8_t* luma, size_t luma_bytes_per_row,
+    const uint8_t* chroma, size_t chroma_bytes_per_row,
+    uint32_t* image, size_t image_bytes_per_row
+);
+void convert_NV12_to_RGB32(
+    const YUVtoRGBMatrix& matrix,
+    size_t width, size_t height,
+    const uint8_t* luma, size_t luma_bytes_per_row,
+    const uint8_t* chroma, size_t chroma_bytes_per_row,
+    uint32_t* image, size_t image_bytes_per_row
+){
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        convert_NV12_to_RGB32_x64_AVX2(
+            matrix, width, height,
+            luma, luma_bytes_per_row,
+            chroma, chroma_bytes_per_row,
+            image, image_bytes_per_row
+        );
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        convert_NV12_to_RGB32_x64_SSE41(
+            matrix, width, height,
+            luma, luma_bytes_per_row,
+            chroma, chroma_bytes_per_row,
+            image, image_bytes_per_row
+        );
+        return;
+    }
+#endif
+    convert_NV12_to_RGB32_Default(
+        matrix, width, height,
+        luma, luma_bytes_per_row,
+        chroma, chroma_bytes_per_row,
+        image, image_bytes_per_row
+    );
+}
+
+
+
+void convert_YUYV_to_RGB32_Default(
+    const YUVtoRGBMatrix& matrix,
+    size_t width, size_t height,
+    const uint8_t* yuyv, size_t yuyv_bytes_per_row,
+    uint32_t* image, size_t image_bytes_per_row
+);
+void convert_YUYV_to_RGB32_x64_SSE41(
+    const YUVtoRGBMatrix& matrix,
+    size_t width, size_t height,
+    const uint8_t* yuyv, size_t yuyv_bytes_per_row,
+    uint32_t* image, size_t image_bytes_per_row
+);
+void convert_YUYV_to_RGB32_x64_AVX2(
+    const YUVtoRGBMatrix& matrix,
+    size_t width, size_t height,
+    const uint8_t* yuyv, size_t yuyv_bytes_per_row,
+    uint32_t* image, size_t image_bytes_per_row
+);
+void convert_YUYV_to_RGB32(
+    const YUVtoRGBMatrix& matrix,
+    size_t width, size_t height,
+    const uint8_t* yuyv, size_t yuyv_bytes_per_row,
+    uint32_t* image, size_t image_bytes_per_row
+){
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        convert_YUYV_to_RGB32_x64_AVX2(matrix, width, height, yuyv, yuyv_bytes_per_row, image, image_bytes_per_row);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        convert_YUYV_to_RGB32_x64_SSE41(matrix, width, height, yuyv, yuyv_bytes_per_row, image, image_bytes_per_row);
+        return;
+    }
+#endif
+    convert_YUYV_to_RGB32_Default(matrix, width, height, yuyv, yuyv_bytes_per_row, image, image_bytes_per_row);
+}
+
+
+
+void convert_BGRX_to_RGB32_Default(
+    size_t width, size_t height,
+    const uint32_t* bgrx, size_t bgrx_bytes_per_row,
+    uint32_t* image, size_t image_bytes_per_row
+);
+void convert_BGRX_to_RGB32_x64_SSE41(
+    size_t width, size_t height,
+    const uint32_t* bgrx, size_t bgrx_bytes_per_row,
+    uint32_t* image, size_t image_bytes_per_row
+);
+void convert_BGRX_to_RGB32_x64_AVX2(
+    size_t width, size_t height,
+    const uint32_t* bgrx, size_t bgrx_bytes_per_row,
+    uint32_t* image, size_t image_bytes_per_row
+);
+void convert_BGRX_to_RGB32(
+    size_t width, size_t height,
+    const uint32_t* bgrx, size_t bgrx_bytes_per_row,
+    uint32_t* image, size_t image_bytes_per_row
+){
+#ifdef PA_AutoDispatch_x64_13_Haswell
+    if (CPU_CAPABILITY_CURRENT.OK_13_Haswell){
+        convert_BGRX_to_RGB32_x64_AVX2(width, height, bgrx, bgrx_bytes_per_row, image, image_bytes_per_row);
+        return;
+    }
+#endif
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+    if (CPU_CAPABILITY_CURRENT.OK_08_Nehalem){
+        convert_BGRX_to_RGB32_x64_SSE41(width, height, bgrx, bgrx_bytes_per_row, image, image_bytes_per_row);
+        return;
+    }
+#endif
+    convert_BGRX_to_RGB32_Default(width, height, bgrx, bgrx_bytes_per_row, image, image_bytes_per_row);
+}
+
+
+
+}
+}
@@ -0,0 +1,74 @@
+/*  Video Frame Conversion
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Convert raw video frame planes directly into an ARGB32 image.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_VideoFrameConversion_H
+#define PokemonAutomation_Kernels_VideoFrameConversion_H
+
+#include <stdint.h>
+#include <cstddef>
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+//  YUV -> RGB coefficients in 8-bit fixed point. (256 = 1.0)
+//
+//      C = (Y - y_offset) * y_scale
+//      D = U - 128
+//      E = V - 128
+//
+//      R = (C + rv * E + 128) >> 8
+//      G = (C - gu * D - gv * E + 128) >> 8
+//      B = (C + bu * D + 128) >> 8
+//
+struct YUVtoRGBMatrix{
+    int32_t y_offset;
+    int32_t y_scale;
+    int32_t rv;
+    int32_t gu;
+    int32_t gv;
+    int32_t bu;
+};
+
+YUVtoRGBMatrix yuv_to_rgb_matrix(bool bt709, bool full_range);
+
+
+
+//  All outputs have alpha set to 255.
+//  All the SIMD variants are bit-exact with the default implementation.
+
+
+//  NV12: Full resolution Y plane followed by a half resolution interleaved UV plane.
+void convert_NV12_to_RGB32(
+    const YUVtoRGBMatrix& matrix,
+    size_t width, size_t height,
+    const uint8_t* luma, size_t luma_bytes_per_row,
+    const uint8_t* chroma, size_t chroma_bytes_per_row,
+    uint32_t* image, size_t image_bytes_per_row
+);
+
+//  YUYV: Single packed plane. Each pair of pixels is stored as Y0 U Y1 V.
+void convert_YUYV_to_RGB32(
+    const YUVtoRGBMatrix& matrix,
+    size_t width, size_t height,
+    const uint8_t* yuyv, size_t yuyv_bytes_per_row,
+    uint32_t* image, size_t image_bytes_per_row
+);
+
+//  BGRA/BGRX: Already in our pixel layout. Copy it over and force the alpha.
+void convert_BGRX_to_RGB32(
+    size_t width, size_t height,
+    const uint32_t* bgrx, size_t bgrx_bytes_per_row,
+    uint32_t* image, size_t image_bytes_per_row
+);
+
+
+
+}
+}
+#endif
@@ -0,0 +1,60 @@
+/*  Video Frame Conversion (Default)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include "Kernels_VideoFrameConversion_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+void convert_NV12_to_RGB32_Default(
+    const YUVtoRGBMatrix& matrix,
+    size_t width, size_t height,
+    const uint8_t* luma, size_t luma_bytes_per_row,
+    const uint8_t* chroma, size_t chroma_bytes_per_row,
+    uint32_t* image, size_t image_bytes_per_row
+){
+    for (size_t r = 0; r < height; r++){
+        convert_NV12_to_RGB32_row_Default(
+            matrix, 0, width,
+            luma + r * luma_bytes_per_row,
+            chroma + (r / 2) * chroma_bytes_per_row,
+            (uint32_t*)((char*)image + r * image_bytes_per_row)
+        );
+    }
+}
+void convert_YUYV_to_RGB32_Default(
+    const YUVtoRGBMatrix& matrix,
+    size_t width, size_t height,
+    const uint8_t* yuyv, size_t yuyv_bytes_per_row,
+    uint32_t* image, size_t image_bytes_per_row
+){
+    for (size_t r = 0; r < height; r++){
+        convert_YUYV_to_RGB32_row_Default(
+            matrix, 0, width,
+            yuyv + r * yuyv_bytes_per_row,
+            (uint32_t*)((char*)image + r * image_bytes_per_row)
+        );
+    }
+}
+void convert_BGRX_to_RGB32_Default(
+    size_t width, size_t height,
+    const uint32_t* bgrx, size_t bgrx_bytes_per_row,
+    uint32_t* image, size_t image_bytes_per_row
+){
+    for (size_t r = 0; r < height; r++){
+        convert_BGRX_to_RGB32_row_Default(
+            0, width,
+            (const uint32_t*)((const char*)bgrx + r * bgrx_bytes_per_row),
+            (uint32_t*)((char*)image + r * image_bytes_per_row)
+        );
+    }
+}
+
+
+
+}
+}
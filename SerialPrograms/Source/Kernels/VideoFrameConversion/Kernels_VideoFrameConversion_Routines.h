@@ -0,0 +1,79 @@
+/*  Video Frame Conversion Routines
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Scalar per-pixel routines. These define the exact results that every
+ *      SIMD implementation must match. They are also used for the row tails.
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_VideoFrameConversion_Routines_H
+#define PokemonAutomation_Kernels_VideoFrameConversion_Routines_H
+
+#include <algorithm>
+#include "Common/Compiler.h"
+#include "Kernels_VideoFrameConversion.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+PA_FORCE_INLINE uint32_t yuv_to_rgb32_Default(
+    const YUVtoRGBMatrix& matrix,
+    int32_t y, int32_t u, int32_t v
+){
+    int32_t c = (y - matrix.y_offset) * matrix.y_scale + 128;
+    int32_t d = u - 128;
+    int32_t e = v - 128;
+
+    int32_t r = (c + matrix.rv * e) >> 8;
+    int32_t g = (c - matrix.gu * d - matrix.gv * e) >> 8;
+    int32_t b = (c + matrix.bu * d) >> 8;
+
+    r = std::min(std::max(r, 0), 255);
+    g = std::min(std::max(g, 0), 255);
+    b = std::min(std::max(b, 0), 255);
+
+    return 0xff000000 | ((uint32_t)r << 16) | ((uint32_t)g << 8) | (uint32_t)b;
+}
+
+
+//  Convert pixels [start, end) of a single row.
+
+PA_FORCE_INLINE void convert_NV12_to_RGB32_row_Default(
+    const YUVtoRGBMatrix& matrix,
+    size_t start, size_t end,
+    const uint8_t* luma, const uint8_t* chroma,
+    uint32_t* image
+){
+    for (size_t x = start; x < end; x++){
+        const uint8_t* uv = chroma + (x & ~(size_t)1);
+        image[x] = yuv_to_rgb32_Default(matrix, luma[x], uv[0], uv[1]);
+    }
+}
+PA_FORCE_INLINE void convert_YUYV_to_RGB32_row_Default(
+    const YUVtoRGBMatrix& matrix,
+    size_t start, size_t end,
+    const uint8_t* yuyv,
+    uint32_t* image
+){
+    for (size_t x = start; x < end; x++){
+        const uint8_t* pair = yuyv + 2 * (x & ~(size_t)1);
+        image[x] = yuv_to_rgb32_Default(matrix, yuyv[2 * x], pair[1], pair[3]);
+    }
+}
+PA_FORCE_INLINE void convert_BGRX_to_RGB32_row_Default(
+    size_t start, size_t end,
+    const uint32_t* bgrx,
+    uint32_t* image
+){
+    for (size_t x = start; x < end; x++){
+        image[x] = bgrx[x] | 0xff000000;
+    }
+}
+
+
+
+}
+}
+#endif
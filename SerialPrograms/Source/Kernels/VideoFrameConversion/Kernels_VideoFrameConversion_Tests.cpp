@@ -0,0 +1,254 @@
+/*  Video Frame Conversion Tests
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Check that every SIMD variant available on this machine is bit-exact
+ *  with the default implementation.
+ *
+ */
+
+#include <vector>
+#include <random>
+#include "Common/Cpp/CpuId/CpuId.h"
+#include "Common/Cpp/TestRunners/UnitTestDatabase.h"
+#include "Kernels_VideoFrameConversion.h"
+#include "Kernels_VideoFrameConversion_Tests.h"
+
+#include <iostream>
+using std::cout;
+using std::endl;
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+void convert_NV12_to_RGB32_Default(
+    const YUVtoRGBMatrix& matrix,
+    size_t width, size_t height,
+    const uint8_t* luma, size_t luma_bytes_per_row,
+    const uint8_t* chroma, size_t chroma_bytes_per_row,
+    uint32_t* image, size_t image_bytes_per_row
+);
+void convert_NV12_to_RGB32_x64_SSE41(
+    const YUVtoRGBMatrix& matrix,
+    size_t width, size_t height,
+    const uint8_t* luma, size_t luma_bytes_per_row,
+    const uint8_t* chroma, size_t chroma_bytes_per_row,
+    uint32_t* image, size_t image_bytes_per_row
+);
+void convert_NV12_to_RGB32_x64_AVX2(
+    const YUVtoRGBMatrix& matrix,
+    size_t width, size_t height,
+    const uint8_t* luma, size_t luma_bytes_per_row,
+    const uint8_t* chroma, size_t chroma_bytes_per_row,
+    uint32_t* image, size_t image_bytes_per_row
+);
+void convert_YUYV_to_RGB32_Default(
+    const YUVtoRGBMatrix& matrix,
+    size_t width, size_t height,
+    const uint8_t* yuyv, size_t yuyv_bytes_per_row,
+    uint32_t* image, size_t image_bytes_per_row
+);
+void convert_YUYV_to_RGB32_x64_SSE41(
+    const YUVtoRGBMatrix& matrix,
+    size_t width, size_t height,
+    const uint8_t* yuyv, size_t yuyv_bytes_per_row,
+    uint32_t* image, size_t image_bytes_per_row
+);
+void convert_YUYV_to_RGB32_x64_AVX2(
+    const YUVtoRGBMatrix& matrix,
+    size_t width, size_t height,
+    const uint8_t* yuyv, size_t yuyv_bytes_per_row,
+    uint32_t* image, size_t image_bytes_per_row
+);
+void convert_BGRX_to_RGB32_Default(
+    size_t width, size_t height,
+    const uint32_t* bgrx, size_t bgrx_bytes_per_row,
+    uint32_t* image, size_t image_bytes_per_row
+);
+void convert_BGRX_to_RGB32_x64_SSE41(
+    size_t width, size_t height,
+    const uint32_t* bgrx, size_t bgrx_bytes_per_row,
+    uint32_t* image, size_t image_bytes_per_row
+);
+void convert_BGRX_to_RGB32_x64_AVX2(
+    size_t width, size_t height,
+    const uint32_t* bgrx, size_t bgrx_bytes_per_row,
+    uint32_t* image, size_t image_bytes_per_row
+);
+
+
+namespace{
+
+using NV12Function = void (*)(
+    const YUVtoRGBMatrix& matrix,
+    size_t width, size_t height,
+    const uint8_t* luma, size_t luma_bytes_per_row,
+    const uint8_t* chroma, size_t chroma_bytes_per_row,
+    uint32_t* image, size_t image_bytes_per_row
+);
+using YUYVFunction = void (*)(
+    const YUVtoRGBMatrix& matrix,
+    size_t width, size_t height,
+    const uint8_t* yuyv, size_t yuyv_bytes_per_row,
+    uint32_t* image, size_t image_bytes_per_row
+);
+using BGRXFunction = void (*)(
+    size_t width, size_t height,
+    const uint32_t* bgrx, size_t bgrx_bytes_per_row,
+    uint32_t* image, size_t image_bytes_per_row
+);
+
+template <typename Function>
+struct Implementation{
+    const char* name;
+    Function function;
+};
+
+std::vector<uint8_t> random_bytes(std::mt19937& rng, size_t bytes){
+    std::vector<uint8_t> ret(bytes);
+    for (uint8_t& byte : ret){
+        byte = (uint8_t)rng();
+    }
+    return ret;
+}
+
+const uint32_t SENTINEL = 0x12345678;
+
+}
+
+
+
+class Test_VideoFrameConversion : public UnitTest{
+public:
+    Test_VideoFrameConversion()
+        : UnitTest("Kernels::VideoFrameConversion")
+    {}
+
+    virtual UnitTestResult run(Logger& logger, CancellableScope& scope) const override{
+        //  The SIMD variants that were compiled in and that this machine can run.
+        std::vector<Implementation<NV12Function>> nv12;
+        std::vector<Implementation<YUYVFunction>> yuyv;
+        std::vector<Implementation<BGRXFunction>> bgrx;
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+        if (CPU_CAPABILITY_NATIVE.OK_08_Nehalem){
+            nv12.emplace_back(Implementation<NV12Function>{"SSE4.1", convert_NV12_to_RGB32_x64_SSE41});
+            yuyv.emplace_back(Implementation<YUYVFunction>{"SSE4.1", convert_YUYV_to_RGB32_x64_SSE41});
+            bgrx.emplace_back(Implementation<BGRXFunction>{"SSE4.1", convert_BGRX_to_RGB32_x64_SSE41});
+        }
+#endif
+#ifdef PA_AutoDispatch_x64_13_Haswell
+        if (CPU_CAPABILITY_NATIVE.OK_13_Haswell){
+            nv12.emplace_back(Implementation<NV12Function>{"AVX2", convert_NV12_to_RGB32_x64_AVX2});
+            yuyv.emplace_back(Implementation<YUYVFunction>{"AVX2", convert_YUYV_to_RGB32_x64_AVX2});
+            bgrx.emplace_back(Implementation<BGRXFunction>{"AVX2", convert_BGRX_to_RGB32_x64_AVX2});
+        }
+#endif
+        if (nv12.empty()){
+            return UnitTestResult(UnitTestResult::SKIPPED, "No SIMD implementation available on this machine.");
+        }
+
+        const YUVtoRGBMatrix matrices[] = {
+            yuv_to_rgb_matrix(true, false),
+            yuv_to_rgb_matrix(true, true),
+            yuv_to_rgb_matrix(false, false),
+            yuv_to_rgb_matrix(false, true),
+        };
+
+        std::mt19937 rng(0);
+        size_t error_count = 0;
+
+        //  Every partial vector width, odd heights and padded rows.
+        for (size_t width = 1; width <= 70; width++){
+            size_t height = 1 + width % 5;
+            size_t padding = rng() % 17;
+            size_t even_width = (width + 1) & ~(size_t)1;
+
+            size_t luma_bytes_per_row = width + padding;
+            size_t chroma_bytes_per_row = even_width + padding;
+            size_t yuyv_bytes_per_row = 2 * even_width + padding;
+            size_t bgrx_bytes_per_row = 4 * (width + padding);
+            size_t image_bytes_per_row = 4 * (width + 3);
+
+            std::vector<uint8_t> luma = random_bytes(rng, luma_bytes_per_row * height);
+            std::vector<uint8_t> chroma = random_bytes(rng, chroma_bytes_per_row * ((height + 1) / 2));
+            std::vector<uint8_t> yuyv_in = random_bytes(rng, yuyv_bytes_per_row * height);
+            std::vector<uint8_t> bgrx_in = random_bytes(rng, bgrx_bytes_per_row * height);
+
+            const size_t words = image_bytes_per_row / sizeof(uint32_t) * height;
+            std::vector<uint32_t> expected(words);
+            std::vector<uint32_t> actual(words);
+            auto check = [&](const char* kernel, const char* isa){
+                if (expected != actual && error_count++ < 10){
+                    cout << "Error: " << kernel << " (" << isa << ") differs from the default"
+                        << " at width = " << width << ", height = " << height << endl;
+                }
+            };
+
+            for (const YUVtoRGBMatrix& matrix : matrices){
+                std::fill(expected.begin(), expected.end(), SENTINEL);
+                convert_NV12_to_RGB32_Default(
+                    matrix, width, height,
+                    luma.data(), luma_bytes_per_row,
+                    chroma.data(), chroma_bytes_per_row,
+                    expected.data(), image_bytes_per_row
+                );
+                for (const auto& implementation : nv12){
+                    std::fill(actual.begin(), actual.end(), SENTINEL);
+                    implementation.function(
+                        matrix, width, height,
+                        luma.data(), luma_bytes_per_row,
+                        chroma.data(), chroma_bytes_per_row,
+                        actual.data(), image_bytes_per_row
+                    );
+                    check("convert_NV12_to_RGB32()", implementation.name);
+                }
+
+                std::fill(expected.begin(), expected.end(), SENTINEL);
+                convert_YUYV_to_RGB32_Default(
+                    matrix, width, height,
+                    yuyv_in.data(), yuyv_bytes_per_row,
+                    expected.data(), image_bytes_per_row
+                );
+                for (const auto& implementation : yuyv){
+                    std::fill(actual.begin(), actual.end(), SENTINEL);
+                    implementation.function(
+                        matrix, width, height,
+                        yuyv_in.data(), yuyv_bytes_per_row,
+                        actual.data(), image_bytes_per_row
+                    );
+                    check("convert_YUYV_to_RGB32()", implementation.name);
+                }
+            }
+
+            std::fill(expected.begin(), expected.end(), SENTINEL);
+            convert_BGRX_to_RGB32_Default(
+                width, height,
+                (const uint32_t*)bgrx_in.data(), bgrx_bytes_per_row,
+                expected.data(), image_bytes_per_row
+            );
+            for (const auto& implementation : bgrx){
+                std::fill(actual.begin(), actual.end(), SENTINEL);
+                implementation.function(
+                    width, height,
+                    (const uint32_t*)bgrx_in.data(), bgrx_bytes_per_row,
+                    actual.data(), image_bytes_per_row
+                );
+                check("convert_BGRX_to_RGB32()", implementation.name);
+            }
+        }
+
+        return error_count == 0;
+    };
+};
+
+
+
+void add_tests_VideoFrameConversion(UnitTestDatabase& database){
+    database.add<Test_VideoFrameConversion>();
+}
+
+
+
+}
+}
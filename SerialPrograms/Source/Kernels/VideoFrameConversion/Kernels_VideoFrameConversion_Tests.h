@@ -0,0 +1,23 @@
+/*  Video Frame Conversion Tests
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifndef PokemonAutomation_Kernels_VideoFrameConversion_Tests_H
+#define PokemonAutomation_Kernels_VideoFrameConversion_Tests_H
+
+#include "Common/Cpp/TestRunners/UnitTest.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+
+void add_tests_VideoFrameConversion(UnitTestDatabase& database);
+
+
+
+}
+}
+#endif
@@ -0,0 +1,148 @@
+/*  Video Frame Conversion (x64 AVX2)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_13_Haswell
+
+#include <immintrin.h>
+#include "Kernels_VideoFrameConversion_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+struct YUVtoRGBMatrix_x64_AVX2{
+    __m256i y_offset;
+    __m256i y_scale;
+    __m256i rv;
+    __m256i gu;
+    __m256i gv;
+    __m256i bu;
+
+    YUVtoRGBMatrix_x64_AVX2(const YUVtoRGBMatrix& matrix)
+        : y_offset(_mm256_set1_epi32(matrix.y_offset))
+        , y_scale(_mm256_set1_epi32(matrix.y_scale))
+        , rv(_mm256_set1_epi32(matrix.rv))
+        , gu(_mm256_set1_epi32(matrix.gu))
+        , gv(_mm256_set1_epi32(matrix.gv))
+        , bu(_mm256_set1_epi32(matrix.bu))
+    {}
+};
+
+
+//  Convert 8 pixels. Each input lane is a zero-extended 8-bit channel.
+PA_FORCE_INLINE __m256i yuv_to_rgb32_x64_AVX2(
+    const YUVtoRGBMatrix_x64_AVX2& matrix,
+    __m256i y, __m256i u, __m256i v
+){
+    __m256i c = _mm256_mullo_epi32(_mm256_sub_epi32(y, matrix.y_offset), matrix.y_scale);
+    c = _mm256_add_epi32(c, _mm256_set1_epi32(128));
+    __m256i d = _mm256_sub_epi32(u, _mm256_set1_epi32(128));
+    __m256i e = _mm256_sub_epi32(v, _mm256_set1_epi32(128));
+
+    __m256i r = _mm256_add_epi32(c, _mm256_mullo_epi32(matrix.rv, e));
+    __m256i g = _mm256_sub_epi32(c, _mm256_mullo_epi32(matrix.gu, d));
+    g = _mm256_sub_epi32(g, _mm256_mullo_epi32(matrix.gv, e));
+    __m256i b = _mm256_add_epi32(c, _mm256_mullo_epi32(matrix.bu, d));
+
+    r = _mm256_srai_epi32(r, 8);
+    g = _mm256_srai_epi32(g, 8);
+    b = _mm256_srai_epi32(b, 8);
+
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i max = _mm256_set1_epi32(255);
+    r = _mm256_min_epi32(_mm256_max_epi32(r, zero), max);
+    g = _mm256_min_epi32(_mm256_max_epi32(g, zero), max);
+    b = _mm256_min_epi32(_mm256_max_epi32(b, zero), max);
+
+    __m256i pixel = _mm256_or_si256(b, _mm256_slli_epi32(g, 8));
+    pixel = _mm256_or_si256(pixel, _mm256_slli_epi32(r, 16));
+    return _mm256_or_si256(pixel, _mm256_set1_epi32(0xff000000));
+}
+
+
+
+void convert_NV12_to_RGB32_x64_AVX2(
+    const YUVtoRGBMatrix& matrix,
+    size_t width, size_t height,
+    const uint8_t* luma, size_t luma_bytes_per_row,
+    const uint8_t* chroma, size_t chroma_bytes_per_row,
+    uint32_t* image, size_t image_bytes_per_row
+){
+    const YUVtoRGBMatrix_x64_AVX2 m(matrix);
+    const __m256i spread_u = _mm256_setr_epi32(0, 0, 2, 2, 4, 4, 6, 6);
+    const __m256i spread_v = _mm256_setr_epi32(1, 1, 3, 3, 5, 5, 7, 7);
+
+    size_t vector_width = width & ~(size_t)7;
+    for (size_t r = 0; r < height; r++){
+        const uint8_t* Y = luma + r * luma_bytes_per_row;
+        const uint8_t* UV = chroma + (r / 2) * chroma_bytes_per_row;
+        uint32_t* out = (uint32_t*)((char*)image + r * image_bytes_per_row);
+
+        for (size_t x = 0; x < vector_width; x += 8){
+            __m256i y = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(Y + x)));
+            __m256i uv = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(UV + x)));
+            __m256i u = _mm256_permutevar8x32_epi32(uv, spread_u);
+            __m256i v = _mm256_permutevar8x32_epi32(uv, spread_v);
+            _mm256_storeu_si256((__m256i*)(out + x), yuv_to_rgb32_x64_AVX2(m, y, u, v));
+        }
+        convert_NV12_to_RGB32_row_Default(matrix, vector_width, width, Y, UV, out);
+    }
+}
+void convert_YUYV_to_RGB32_x64_AVX2(
+    const YUVtoRGBMatrix& matrix,
+    size_t width, size_t height,
+    const uint8_t* yuyv, size_t yuyv_bytes_per_row,
+    uint32_t* image, size_t image_bytes_per_row
+){
+    const YUVtoRGBMatrix_x64_AVX2 m(matrix);
+
+    //  Split 8 packed pixels into the 8 lumas and the 4 interleaved UV pairs.
+    const __m128i split = _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15);
+    const __m256i spread_u = _mm256_setr_epi32(0, 0, 2, 2, 4, 4, 6, 6);
+    const __m256i spread_v = _mm256_setr_epi32(1, 1, 3, 3, 5, 5, 7, 7);
+
+    size_t vector_width = width & ~(size_t)7;
+    for (size_t r = 0; r < height; r++){
+        const uint8_t* in = yuyv + r * yuyv_bytes_per_row;
+        uint32_t* out = (uint32_t*)((char*)image + r * image_bytes_per_row);
+
+        for (size_t x = 0; x < vector_width; x += 8){
+            __m128i packed = _mm_loadu_si128((const __m128i*)(in + 2 * x));
+            packed = _mm_shuffle_epi8(packed, split);
+            __m256i y = _mm256_cvtepu8_epi32(packed);
+            __m256i uv = _mm256_cvtepu8_epi32(_mm_unpackhi_epi64(packed, packed));
+            __m256i u = _mm256_permutevar8x32_epi32(uv, spread_u);
+            __m256i v = _mm256_permutevar8x32_epi32(uv, spread_v);
+            _mm256_storeu_si256((__m256i*)(out + x), yuv_to_rgb32_x64_AVX2(m, y, u, v));
+        }
+        convert_YUYV_to_RGB32_row_Default(matrix, vector_width, width, in, out);
+    }
+}
+void convert_BGRX_to_RGB32_x64_AVX2(
+    size_t width, size_t height,
+    const uint32_t* bgrx, size_t bgrx_bytes_per_row,
+    uint32_t* image, size_t image_bytes_per_row
+){
+    const __m256i alpha = _mm256_set1_epi32(0xff000000);
+
+    size_t vector_width = width & ~(size_t)7;
+    for (size_t r = 0; r < height; r++){
+        const uint32_t* in = (const uint32_t*)((const char*)bgrx + r * bgrx_bytes_per_row);
+        uint32_t* out = (uint32_t*)((char*)image + r * image_bytes_per_row);
+
+        for (size_t x = 0; x < vector_width; x += 8){
+            __m256i pixel = _mm256_loadu_si256((const __m256i*)(in + x));
+            _mm256_storeu_si256((__m256i*)(out + x), _mm256_or_si256(pixel, alpha));
+        }
+        convert_BGRX_to_RGB32_row_Default(vector_width, width, in, out);
+    }
+}
+
+
+
+}
+}
+#endif
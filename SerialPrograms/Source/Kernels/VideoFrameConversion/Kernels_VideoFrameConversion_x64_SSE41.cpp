@@ -0,0 +1,144 @@
+/*  Video Frame Conversion (x64 SSE4.1)
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#ifdef PA_AutoDispatch_x64_08_Nehalem
+
+#include <smmintrin.h>
+#include "Kernels_VideoFrameConversion_Routines.h"
+
+namespace PokemonAutomation{
+namespace Kernels{
+
+
+struct YUVtoRGBMatrix_x64_SSE41{
+    __m128i y_offset;
+    __m128i y_scale;
+    __m128i rv;
+    __m128i gu;
+    __m128i gv;
+    __m128i bu;
+
+    YUVtoRGBMatrix_x64_SSE41(const YUVtoRGBMatrix& matrix)
+        : y_offset(_mm_set1_epi32(matrix.y_offset))
+        , y_scale(_mm_set1_epi32(matrix.y_scale))
+        , rv(_mm_set1_epi32(matrix.rv))
+        , gu(_mm_set1_epi32(matrix.gu))
+        , gv(_mm_set1_epi32(matrix.gv))
+        , bu(_mm_set1_epi32(matrix.bu))
+    {}
+};
+
+
+//  Convert 4 pixels. Each input lane is a zero-extended 8-bit channel.
+PA_FORCE_INLINE __m128i yuv_to_rgb32_x64_SSE41(
+    const YUVtoRGBMatrix_x64_SSE41& matrix,
+    __m128i y, __m128i u, __m128i v
+){
+    __m128i c = _mm_mullo_epi32(_mm_sub_epi32(y, matrix.y_offset), matrix.y_scale);
+    c = _mm_add_epi32(c, _mm_set1_epi32(128));
+    __m128i d = _mm_sub_epi32(u, _mm_set1_epi32(128));
+    __m128i e = _mm_sub_epi32(v, _mm_set1_epi32(128));
+
+    __m128i r = _mm_add_epi32(c, _mm_mullo_epi32(matrix.rv, e));
+    __m128i g = _mm_sub_epi32(c, _mm_mullo_epi32(matrix.gu, d));
+    g = _mm_sub_epi32(g, _mm_mullo_epi32(matrix.gv, e));
+    __m128i b = _mm_add_epi32(c, _mm_mullo_epi32(matrix.bu, d));
+
+    r = _mm_srai_epi32(r, 8);
+    g = _mm_srai_epi32(g, 8);
+    b = _mm_srai_epi32(b, 8);
+
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i max = _mm_set1_epi32(255);
+    r = _mm_min_epi32(_mm_max_epi32(r, zero), max);
+    g = _mm_min_epi32(_mm_max_epi32(g, zero), max);
+    b = _mm_min_epi32(_mm_max_epi32(b, zero), max);
+
+    __m128i pixel = _mm_or_si128(b, _mm_slli_epi32(g, 8));
+    pixel = _mm_or_si128(pixel, _mm_slli_epi32(r, 16));
+    return _mm_or_si128(pixel, _mm_set1_epi32(0xff000000));
+}
+
+
+
+void convert_NV12_to_RGB32_x64_SSE41(
+    const YUVtoRGBMatrix& matrix,
+    size_t width, size_t height,
+    const uint8_t* luma, size_t luma_bytes_per_row,
+    const uint8_t* chroma, size_t chroma_bytes_per_row,
+    uint32_t* image, size_t image_bytes_per_row
+){
+    const YUVtoRGBMatrix_x64_SSE41 m(matrix);
+    const __m128i shuffle_u = _mm_setr_epi8(0, -1, -1, -1, 0, -1, -1, -1, 2, -1, -1, -1, 2, -1, -1, -1);
+    const __m128i shuffle_v = _mm_setr_epi8(1, -1, -1, -1, 1, -1, -1, -1, 3, -1, -1, -1, 3, -1, -1, -1);
+
+    size_t vector_width = width & ~(size_t)3;
+    for (size_t r = 0; r < height; r++){
+        const uint8_t* Y = luma + r * luma_bytes_per_row;
+        const uint8_t* UV = chroma + (r / 2) * chroma_bytes_per_row;
+        uint32_t* out = (uint32_t*)((char*)image + r * image_bytes_per_row);
+
+        for (size_t x = 0; x < vector_width; x += 4){
+            __m128i y = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(*(const int32_t*)(Y + x)));
+            __m128i uv = _mm_cvtsi32_si128(*(const int32_t*)(UV + x));
+            __m128i u = _mm_shuffle_epi8(uv, shuffle_u);
+            __m128i v = _mm_shuffle_epi8(uv, shuffle_v);
+            _mm_storeu_si128((__m128i*)(out + x), yuv_to_rgb32_x64_SSE41(m, y, u, v));
+        }
+        convert_NV12_to_RGB32_row_Default(matrix, vector_width, width, Y, UV, out);
+    }
+}
+void convert_YUYV_to_RGB32_x64_SSE41(
+    const YUVtoRGBMatrix& matrix,
+    size_t width, size_t height,
+    const uint8_t* yuyv, size_t yuyv_bytes_per_row,
+    uint32_t* image, size_t image_bytes_per_row
+){
+    const YUVtoRGBMatrix_x64_SSE41 m(matrix);
+    const __m128i shuffle_y = _mm_setr_epi8(0, -1, -1, -1, 2, -1, -1, -1, 4, -1, -1, -1, 6, -1, -1, -1);
+    const __m128i shuffle_u = _mm_setr_epi8(1, -1, -1, -1, 1, -1, -1, -1, 5, -1, -1, -1, 5, -1, -1, -1);
+    const __m128i shuffle_v = _mm_setr_epi8(3, -1, -1, -1, 3, -1, -1, -1, 7, -1, -1, -1, 7, -1, -1, -1);
+
+    size_t vector_width = width & ~(size_t)3;
+    for (size_t r = 0; r < height; r++){
+        const uint8_t* in = yuyv + r * yuyv_bytes_per_row;
+        uint32_t* out = (uint32_t*)((char*)image + r * image_bytes_per_row);
+
+        for (size_t x = 0; x < vector_width; x += 4){
+            __m128i packed = _mm_loadl_epi64((const __m128i*)(in + 2 * x));
+            __m128i y = _mm_shuffle_epi8(packed, shuffle_y);
+            __m128i u = _mm_shuffle_epi8(packed, shuffle_u);
+            __m128i v = _mm_shuffle_epi8(packed, shuffle_v);
+            _mm_storeu_si128((__m128i*)(out + x), yuv_to_rgb32_x64_SSE41(m, y, u, v));
+        }
+        convert_YUYV_to_RGB32_row_Default(matrix, vector_width, width, in, out);
+    }
+}
+void convert_BGRX_to_RGB32_x64_SSE41(
+    size_t width, size_t height,
+    const uint32_t* bgrx, size_t bgrx_bytes_per_row,
+    uint32_t* image, size_t image_bytes_per_row
+){
+    const __m128i alpha = _mm_set1_epi32(0xff000000);
+
+    size_t vector_width = width & ~(size_t)3;
+    for (size_t r = 0; r < height; r++){
+        const uint32_t* in = (const uint32_t*)((const char*)bgrx + r * bgrx_bytes_per_row);
+        uint32_t* out = (uint32_t*)((char*)image + r * image_bytes_per_row);
+
+        for (size_t x = 0; x < vector_width; x += 4){
+            __m128i pixel = _mm_loadu_si128((const __m128i*)(in + x));
+            _mm_storeu_si128((__m128i*)(out + x), _mm_or_si128(pixel, alpha));
+        }
+        convert_BGRX_to_RGB32_row_Default(vector_width, width, in, out);
+    }
+}
+
+
+
+}
+}
+#endif
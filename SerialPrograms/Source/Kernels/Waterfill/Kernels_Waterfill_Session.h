@@ -26,12 +26,16 @@ public:
     virtual ~WaterfillSession() = default;
     virtual void set_source(PackedBinaryMatrix_IB& source) = 0;
 
+    //  Choose how objects found with "keep_object" store their bits.
+    //  Default is WaterfillObjectStorage::SPARSE.
+    virtual void set_object_storage(WaterfillObjectStorage storage) = 0;
+
     virtual std::unique_ptr<WaterfillIterator> make_iterator(size_t min_area) = 0;
 
     //  Get the object at the specific bit position.
     //  The object will be removed from the input matrix.
     //  Return true if there is an object at the bit (x, y); false otherwise.
-    //  If keep_object is true, object.object is constructed.
+    //  If keep_object is true, object.object or object.cropped is constructed.
     virtual bool find_object_on_bit(
         WaterfillObject& object, bool keep_object,
         size_t x, size_t y
@@ -51,6 +55,8 @@ public:
     //  Keep_object: returned WaterfillObject has member var `object` assigned that stores
     //    the binary matrix belonging to the pixels of this object. The binary matrix has
     //    the same size as the input image the waterill session runs on.
+    //    If the session uses WaterfillObjectStorage::CROPPED, `cropped` is assigned
+    //    instead and only covers the enclosing rectangle of the object.
     //  Returns false when it reaches the end of iteration.
     virtual bool find_next(WaterfillObject& object, bool keep_object) = 0;
 };
@@ -7,6 +7,7 @@
 #ifndef PokemonAutomation_Kernels_Waterfill_Session_TPP
 #define PokemonAutomation_Kernels_Waterfill_Session_TPP
 
+#include <vector>
 #include <set>
 #include <map>
 #include "Common/Cpp/Exceptions.h"
@@ -73,6 +74,10 @@ public:
         set_source(static_cast<PackedBinaryMatrix_t<Tile>&>(source).get());
     }
 
+    virtual void set_object_storage(WaterfillObjectStorage storage) override{
+        m_storage = storage;
+    }
+
     // In matrix, how many tiles in a row
     size_t tile_width() const{ return m_source->tile_width(); }
     // In matrix, how many tiles in a column
@@ -83,7 +88,7 @@ public:
     //  Get the object at the specific bit position.
     //  The object will be removed from the input matrix.
     //  Return true if there is an object at the bit (x, y); false otherwise.
-    //  If keep_object is true, object.object is constructed.
+    //  If keep_object is true, object.object or object.cropped is constructed.
     virtual bool find_object_on_bit(
         WaterfillObject& object, bool keep_object,
         size_t x, size_t y
@@ -91,7 +96,7 @@ public:
     //  Get the object at the specific tile (tile_x, tile_y).
     //  The object will be removed from the input matrix.
     //  Return true if there is an object at the tile; false otherwise.
-    //  If keep_object is true, object.object is constructed.
+    //  If keep_object is true, object.object or object.cropped is constructed.
     bool find_object_in_tile(
         WaterfillObject& object, bool keep_object,
         size_t tile_x, size_t tile_y
@@ -124,9 +129,12 @@ private:
     PackedBinaryMatrixCore<Tile> m_object;
 //    std::vector<std::pair<size_t, size_t>> m_dirty_tiles;
 
+    WaterfillObjectStorage m_storage = WaterfillObjectStorage::SPARSE;
+
     //  Reused scratch buffers. Only used inside "find_object()".
     BitSet2D m_busy_tiles;
     BitSet2D m_object_tiles;
+    std::vector<TileIndex> m_dirty_tiles;
 };
 
 
@@ -314,7 +322,8 @@ bool WaterfillSession_t<Tile, TileRoutines>::find_object(
     stats.body_y = tile_y * Tile::HEIGHT + bit_y;
 
     std::unique_ptr<std::map<TileIndex, Tile>> sparse_set;
-    if (keep_object){
+    bool crop = keep_object && m_storage == WaterfillObjectStorage::CROPPED;
+    if (keep_object && !crop){
         sparse_set = std::make_unique<std::map<TileIndex, Tile>>();
     }
 
@@ -352,7 +361,12 @@ bool WaterfillSession_t<Tile, TileRoutines>::find_object(
         tile_min_y = std::min(tile_min_y, y);
         tile_max_y = std::max(tile_max_y, y);
 
-        recorded_tile.set_zero();
+        //  Cropping needs the final boundaries. Clear these afterwards.
+        if (crop){
+            m_dirty_tiles.emplace_back(x, y);
+        }else{
+            recorded_tile.set_zero();
+        }
     }
 
 #if 0
@@ -370,6 +384,20 @@ bool WaterfillSession_t<Tile, TileRoutines>::find_object(
         ptr->get().set_data(std::move(*sparse_set));
         object.object = std::move(ptr);
     }
+    if (crop){
+        //  Everything in "m_object" outside of this object is zero. So this
+        //  only picks up the bits of this object.
+        auto ptr = std::make_unique<PackedBinaryMatrix_t<Tile>>();
+        ptr->get() = m_object.submatrix(
+            object.min_x, object.min_y,
+            object.max_x - object.min_x, object.max_y - object.min_y
+        );
+        object.cropped = std::move(ptr);
+        for (TileIndex index : m_dirty_tiles){
+            m_object.tile(index).set_zero();
+        }
+        m_dirty_tiles.clear();
+    }
 
     return true;
 }
@@ -7,6 +7,7 @@
 #include "Common/Cpp/Color.h"
 #include "Common/Cpp/CpuId/CpuId.h"
 #include "Common/Cpp/Time.h"
+#include "Common/Cpp/TestRunners/UnitTestDatabase.h"
 #include "CommonFramework/GlobalAutoPaths.h"
 #include "CommonFramework/ImageTypes/BinaryImage.h"
 #include "CommonFramework/ImageTypes/ImageRGB32.h"
@@ -26,6 +27,7 @@
 #include "Kernels_Waterfill_Tests.h"
 #include "Tests/TestUtils.h"
 
+#include <random>
 #include <iostream>
 using std::cout;
 using std::endl;
@@ -124,10 +126,104 @@ private:
 
 
 
-void add_tests_Waterfill(UnitTestDatabase& database){
+//  Merge pairs of objects stored as "object" (sparse, full image), as
+//  "cropped" (packed, bounding box) or one of each, and check that
+//  packed_matrix() of the result is the union of the two.
+class Test_WaterfillMerge : public UnitTest{
+public:
+    Test_WaterfillMerge()
+        : UnitTest("Kernels::Waterfill - merge_assume_no_overlap")
+    {}
+
+    virtual UnitTestResult run(Logger& logger, CancellableScope& scope) const override{
+        using Kernels::Waterfill::WaterfillObject;
+
+        const size_t width = 300;
+        const size_t height = 50;
+
+        std::mt19937 rng(0);
+        size_t error_count = 0;
+
+        //  A random object in its own rectangle. Bits are set only at
+        //  positions where "taken" is clear so the two sides never overlap.
+        auto make_object = [&](BinaryMatrixType type, bool sparse, std::vector<bool>& taken){
+            size_t min_x = rng() % (width - 1);
+            size_t min_y = rng() % (height - 1);
+            size_t max_x = min_x + 1 + rng() % (width - min_x);
+            size_t max_y = min_y + 1 + rng() % (height - min_y);
+
+            std::unique_ptr<SparseBinaryMatrix_IB> full = make_SparseBinaryMatrix(type, width, height);
+            WaterfillObject obj;
+            for (size_t y = min_y; y < max_y; y++){
+                for (size_t x = min_x; x < max_x; x++){
+                    if (taken[y * width + x] || rng() % 3 != 0){
+                        continue;
+                    }
+                    taken[y * width + x] = true;
+                    full->set(x, y, true);
+                    obj.accumulate_body(x, y, 1, 0, 0);
+                    obj.accumulate_boundary(x, y, 0, 1, 0, 1);
+                }
+            }
+            if (obj.area == 0){
+                return obj;
+            }
+            if (sparse){
+                obj.object = std::move(full);
+            }else{
+                obj.cropped = full->submatrix(obj.min_x, obj.min_y, obj.width(), obj.height());
+            }
+            return obj;
+        };
+
+        for (size_t iter = 0; iter < 400; iter++){
+            //  The merge doesn't depend on the tile type. (or_shifted() is
+            //  tested per type in the BinaryMatrix tests.)
+            BinaryMatrixType type = iter % 8 < 4 ? BinaryMatrixType::i64x4_Default : BinaryMatrixType::i64x8_Default;
+            std::vector<bool> taken(width * height);
+            WaterfillObject merged = make_object(type, iter % 4 == 0 || iter % 4 == 1, taken);
+            WaterfillObject other = make_object(type, iter % 4 == 0 || iter % 4 == 2, taken);
+            if (merged.area == 0 || other.area == 0){
+                continue;
+            }
+            merged.merge_assume_no_overlap(other);
+
+            std::unique_ptr<PackedBinaryMatrix_IB> bits = merged.packed_matrix();
+            if (bits->width() != merged.width() || bits->height() != merged.height()){
+                if (error_count++ < 10){
+                    cout << "Error: iteration " << iter << ", merged matrix is "
+                        << bits->width() << " x " << bits->height() << " but the box is "
+                        << merged.width() << " x " << merged.height() << endl;
+                }
+                continue;
+            }
+            size_t area = 0;
+            for (size_t y = 0; y < height; y++){
+                for (size_t x = 0; x < width; x++){
+                    bool inside = merged.min_x <= x && x < merged.max_x && merged.min_y <= y && y < merged.max_y;
+                    bool actual = inside && bits->get(x - merged.min_x, y - merged.min_y);
+                    area += actual;
+                    if (actual != taken[y * width + x] && error_count++ < 10){
+                        cout << "Error: iteration " << iter << ", bit (" << x << ", " << y
+                            << ") should be " << taken[y * width + x] << endl;
+                    }
+                }
+            }
+            if (area != merged.area && error_count++ < 10){
+                cout << "Error: iteration " << iter << ", merged area is " << merged.area
+                    << " but " << area << " bits are set" << endl;
+            }
+        }
+
+        return error_count == 0;
+    };
+};
 
 
 
+
+void add_tests_Waterfill(UnitTestDatabase& database){
+    database.add<Test_WaterfillMerge>();
 }
 
 
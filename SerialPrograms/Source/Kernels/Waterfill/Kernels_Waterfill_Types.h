@@ -19,6 +19,21 @@ namespace Waterfill{
 
 class WaterfillIterator;
 
+
+//  How a waterfill session stores the bits of the objects it finds when
+//  "keep_object" is true.
+enum class WaterfillObjectStorage{
+    //  "WaterfillObject::object": Sparse matrix with the logical size of the
+    //  source image. Bits are at their image coordinates.
+    SPARSE,
+
+    //  "WaterfillObject::cropped": Packed matrix of just the enclosing
+    //  rectangle. Bit (0, 0) is at (min_x, min_y). This is a single allocation
+    //  the size of the object and is cheap to copy.
+    CROPPED,
+};
+
+
 // An object in the waterfill session.
 // Objects are represented as non-zero bits on the size of an image.
 class WaterfillObject{
@@ -38,9 +53,8 @@ public:
         area = x.area;
         sum_x = x.sum_x;
         sum_y = x.sum_y;
-        if (x.object){
-            object = x.object->clone();
-        }
+        object = x.object ? x.object->clone() : nullptr;
+        cropped = x.cropped ? x.cropped->clone() : nullptr;
     }
 
 public:
@@ -60,11 +74,17 @@ public:
         return Rectangle<size_t>(min_x, min_y, max_x, max_y);
     }
 
-    // Note: `object` must be constructed before calling this function.
+    // Note: `object` or `cropped` must be constructed before calling this function.
     std::unique_ptr<PackedBinaryMatrix_IB> packed_matrix() const{
+        if (cropped){
+            return cropped->clone();
+        }
         return object->submatrix(min_x, min_y, max_x - min_x, max_y - min_y);
     }
 
+    //  "object" is kept only if both sides have it. If either side has
+    //  "cropped", it is rebuilt over the merged rectangle from whichever matrix
+    //  each side has. Any matrix that cannot be rebuilt is dropped.
     void merge_assume_no_overlap(const WaterfillObject& obj){
         if (obj.area == 0){
             return;
@@ -73,15 +93,46 @@ public:
             *this = obj;
             return;
         }
-        min_x = std::min(min_x, obj.min_x);
-        min_y = std::min(min_y, obj.min_y);
-        max_x = std::max(max_x, obj.max_x);
-        max_y = std::max(max_y, obj.max_y);
+
+        size_t new_min_x = std::min(min_x, obj.min_x);
+        size_t new_min_y = std::min(min_y, obj.min_y);
+        size_t new_max_x = std::max(max_x, obj.max_x);
+        size_t new_max_y = std::max(max_y, obj.max_y);
+
+        std::unique_ptr<PackedBinaryMatrix_IB> merged;
+        if ((cropped || obj.cropped) && (cropped || object) && (obj.cropped || obj.object)){
+            merged = make_PackedBinaryMatrix(
+                cropped ? cropped->type() : obj.cropped->type(),
+                new_max_x - new_min_x, new_max_y - new_min_y
+            );
+            or_cropped_into(*merged, new_min_x, new_min_y);
+            obj.or_cropped_into(*merged, new_min_x, new_min_y);
+        }
+        cropped = std::move(merged);
+
+        if (object && obj.object){
+            *object |= *obj.object;
+        }else{
+            object.reset();
+        }
+
+        min_x = new_min_x;
+        min_y = new_min_y;
+        max_x = new_max_x;
+        max_y = new_max_y;
         area += obj.area;
         sum_x += obj.sum_x;
         sum_y += obj.sum_y;
-        if (object && obj.object){
-            *object |= *obj.object;
+    }
+
+private:
+    //  OR the bits of this object into "matrix", whose (0, 0) is at
+    //  (origin_x, origin_y) in image coordinates.
+    void or_cropped_into(PackedBinaryMatrix_IB& matrix, size_t origin_x, size_t origin_y) const{
+        if (cropped){
+            matrix.or_shifted(*cropped, min_x - origin_x, min_y - origin_y);
+        }else{
+            matrix.or_shifted(*packed_matrix(), min_x - origin_x, min_y - origin_y);
         }
     }
 
@@ -126,7 +177,10 @@ public:
     uint64_t sum_x = 0;
     uint64_t sum_y = 0;
 
+    //  Bits of the object. Which one is set depends on the
+    //  WaterfillObjectStorage of the session that found it.
     std::unique_ptr<SparseBinaryMatrix_IB> object;
+    std::unique_ptr<PackedBinaryMatrix_IB> cropped;
 };
 
 
@@ -19,6 +19,7 @@
 #include "CommonFramework/ImageTypes/ImageRGB32_OpenCV.h"
 #include "CommonFramework/VideoPipeline/VideoOverlay.h"
 #include "CommonFramework/VideoPipeline/VideoOverlayScopes.h"
+#include "CommonFramework/Tools/GlobalThreadPools.h"
 #include "ML_YOLOv5Detector.h"
 
 //#include <iostream>
@@ -106,6 +107,103 @@ size_t YOLOv5Detector::label_index(const std::string& label_name) const{
     return m_yolo_session->label_index(label_name);
 }
 
+YOLOv5AsyncDetector::~YOLOv5AsyncDetector(){
+    {
+        std::lock_guard<Mutex> lg(m_lock);
+        m_stopping = true;
+    }
+    m_cv.notify_all();
+    m_worker.wait_and_ignore_exceptions();
+}
+YOLOv5AsyncDetector::YOLOv5AsyncDetector(const std::string& model_path)
+    : m_detector(model_path)
+    , m_label_names(m_detector.session()->get_label_names())
+{
+    m_worker = GlobalThreadPools::unlimited_normal().dispatch_now_blocking(
+        [this]{ worker_loop(); }
+    );
+}
+
+size_t YOLOv5AsyncDetector::label_index(const std::string& label_name) const{
+    for (size_t i = 0; i < m_label_names.size(); i++){
+        if (label_name == m_label_names[i]){
+            return i;
+        }
+    }
+    return SIZE_MAX;
+}
+
+void YOLOv5AsyncDetector::submit(const VideoSnapshot& frame){
+    if (!frame){
+        return;
+    }
+    {
+        std::lock_guard<Mutex> lg(m_lock);
+        m_pending = frame;
+    }
+    m_cv.notify_all();
+}
+
+YOLOv5AsyncDetector::Detections YOLOv5AsyncDetector::latest() const{
+    std::lock_guard<Mutex> lg(m_lock);
+    if (m_error){
+        std::rethrow_exception(m_error);
+    }
+    return m_latest;
+}
+YOLOv5AsyncDetector::Detections YOLOv5AsyncDetector::wait_for(WallClock newer_than, WallClock deadline) const{
+    std::unique_lock<Mutex> lg(m_lock);
+    auto ready = [&]{
+        return m_stopping || m_error || m_latest.timestamp > newer_than;
+    };
+    if (deadline == WallClock::max()){
+        m_cv.wait(lg, ready);
+    }else{
+        m_cv.wait_until(lg, deadline, ready);
+    }
+    if (m_error){
+        std::rethrow_exception(m_error);
+    }
+    return m_latest;
+}
+
+void YOLOv5AsyncDetector::worker_loop(){
+    while (true){
+        VideoSnapshot frame;
+        {
+            std::unique_lock<Mutex> lg(m_lock);
+            m_cv.wait(lg, [this]{ return m_stopping || m_pending; });
+            if (m_stopping){
+                return;
+            }
+            frame = std::move(m_pending);
+            m_pending.clear();
+        }
+
+        //  Run the model outside the lock so that new frames can replace the
+        //  pending one in the meantime.
+        try{
+            m_detector.detect(*frame.frame);
+        }catch (...){
+            {
+                std::lock_guard<Mutex> lg(m_lock);
+                m_error = std::current_exception();
+            }
+            m_cv.notify_all();
+            return;
+        }
+
+        {
+            std::lock_guard<Mutex> lg(m_lock);
+            m_latest.timestamp = frame.timestamp;
+            m_latest.boxes = m_detector.detected_boxes();
+        }
+        m_cv.notify_all();
+    }
+}
+
+
+
 YOLOv5Watcher::YOLOv5Watcher(VideoOverlay& overlay, const std::string& model_path)
     : VisualInferenceCallback("YOLOv5")
     , m_overlay_set(overlay)
@@ -113,33 +211,28 @@ YOLOv5Watcher::YOLOv5Watcher(VideoOverlay& overlay, const std::string& model_pat
 {
 }
 
-bool YOLOv5Watcher::process_frame(const ImageViewRGB32& frame, WallClock timestamp){
-    if (!m_detector.model_loaded()){
+bool YOLOv5Watcher::process_frame(const VideoSnapshot& frame){
+    m_detector.submit(frame);
+
+    YOLOv5AsyncDetector::Detections detections = m_detector.latest();
+    if (detections.timestamp == m_overlay_timestamp){
         return false;
     }
-
-    m_detector.detect(frame);
+    m_overlay_timestamp = detections.timestamp;
 
     m_overlay_set.clear();
-    for (const auto& box : m_detector.detected_boxes()){
-        std::string text = m_detector.session()->label_name(box.label_idx) + ": " + tostr_fixed(box.score, 2);
+    for (const auto& box : detections.boxes){
+        std::string text = m_detector.label_name(box.label_idx) + ": " + tostr_fixed(box.score, 2);
         m_overlay_set.add(COLOR_RED, box.box, text);
     }
-
-    {
-        WriteSpinLock lg(m_output_lock, "YOLOv5Watcher::process_frame()");
-        m_output_boxes = std::move(m_detector.detected_boxes());
-    }
     return false;
 }
 
 
 std::vector<YOLOv5Watcher::DetectionBox> YOLOv5Watcher::detected_boxes(){
-    ReadSpinLock lg(m_output_lock, "YOLOv5Watcher::detected_boxes()");
-    return m_output_boxes;
+    return m_detector.latest().boxes;
 }
 
 
-
 }
 }
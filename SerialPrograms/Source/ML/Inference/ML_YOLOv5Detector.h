@@ -8,8 +8,13 @@
 #define PokemonAutomation_ML_YOLOv5Detector_H
 
 #include <vector>
+#include <exception>
 #include "Common/Cpp/Color.h"
 #include "Common/Cpp/Concurrency/SpinLock.h"
+#include "Common/Cpp/Concurrency/Mutex.h"
+#include "Common/Cpp/Concurrency/ConditionVariable.h"
+#include "Common/Cpp/Concurrency/AsyncTask.h"
+#include "CommonFramework/VideoPipeline/VideoFeed.h"
 #include "CommonFramework/VideoPipeline/VideoOverlayScopes.h"
 #include "CommonTools/InferenceCallbacks/VisualInferenceCallback.h"
 #include "CommonTools/VisualDetector.h"
@@ -54,6 +59,66 @@ protected:
 
 
 
+//  Run a YOLOv5Detector on its own thread so that the caller doesn't have to
+//  wait on the forward pass.
+//
+//  At most one frame waits for the model. Submitting a frame replaces the one
+//  that is waiting. So the model always moves on to the newest frame and never
+//  falls behind the video.
+class YOLOv5AsyncDetector{
+public:
+    using DetectionBox = YOLOv5Session::DetectionBox;
+
+    struct Detections{
+        //  Timestamp of the frame that the boxes are from.
+        //  WallClock::min() if nothing has been detected yet.
+        WallClock timestamp = WallClock::min();
+        std::vector<DetectionBox> boxes;
+    };
+
+    // - model_path: path to the onnx model file. Can be a relative path to `RESOURCE_PATH()`.
+    // If model loading fails, InternalProgramError exception is thrown
+    YOLOv5AsyncDetector(const std::string& model_path);
+    ~YOLOv5AsyncDetector();
+
+    const std::string& label_name(size_t label_idx) const { return m_label_names[label_idx]; }
+    size_t label_index(const std::string& label_name) const;
+
+    //  Queue a frame for detection. Returns immediately.
+    void submit(const VideoSnapshot& frame);
+
+    //  The result of the most recently processed frame.
+    //  If the model failed on a frame, the exception is rethrown here.
+    Detections latest() const;
+
+    //  Wait for the result of a frame taken after "newer_than".
+    //  Returns the latest result if "deadline" is reached first. So check the
+    //  timestamp of what is returned.
+    Detections wait_for(WallClock newer_than, WallClock deadline = WallClock::max()) const;
+
+
+private:
+    void worker_loop();
+
+
+private:
+    YOLOv5Detector m_detector;
+
+    //  Copied out so they can be read while the worker is using the session.
+    std::vector<std::string> m_label_names;
+
+    mutable Mutex m_lock;
+    mutable ConditionVariable m_cv;
+    bool m_stopping = false;
+    VideoSnapshot m_pending;
+    Detections m_latest;
+    std::exception_ptr m_error;
+
+    AsyncTask m_worker;
+};
+
+
+
 class YOLOv5Watcher : public VisualInferenceCallback{
 public:
     using DetectionBox = YOLOv5Session::DetectionBox;
@@ -63,20 +128,34 @@ public:
     virtual ~YOLOv5Watcher(){}
 
     virtual void make_overlays(VideoOverlaySet& items) const override {}
-    virtual bool process_frame(const ImageViewRGB32& frame, WallClock timestamp) override;
+
+    //  This does not wait for the model. The frame is handed off to the
+    //  detector and the overlays are updated with whatever it has finished
+    //  since the last call.
+    virtual bool process_frame(const VideoSnapshot& frame) override;
 
     // Thread-safe: Any thread can read this detection result
     std::vector<DetectionBox> detected_boxes();
 
+    //  Timestamped version of detected_boxes().
+    YOLOv5AsyncDetector::Detections detections(){ return m_detector.latest(); }
+
+    //  Wait for detections from a frame taken after "newer_than". Use this
+    //  after moving the camera so that the next decision isn't made from a
+    //  frame from before the move.
+    YOLOv5AsyncDetector::Detections wait_for(WallClock newer_than, WallClock deadline = WallClock::max()){
+        return m_detector.wait_for(newer_than, deadline);
+    }
+
     const std::string& label_name(size_t label_idx) const {return m_detector.label_name(label_idx);}
     size_t label_index(const std::string& label_name) const {return m_detector.label_index(label_name);}
 
 protected:
     VideoOverlaySet m_overlay_set;
-    YOLOv5Detector m_detector;
+    YOLOv5AsyncDetector m_detector;
 
-    std::vector<DetectionBox> m_output_boxes;
-    SpinLock m_output_lock;  // Protects m_output_boxes
+    //  Timestamp of the detections currently drawn on the overlay.
+    WallClock m_overlay_timestamp = WallClock::min();
 };
 
 
@@ -9,6 +9,7 @@
 #include <string>
 #include <sstream>
 #include <map>
+#include <algorithm>
 //#include <iostream>
 #include <opencv2/imgproc.hpp>
 #include <opencv2/dnn.hpp>
@@ -93,37 +94,77 @@ std::vector<std::string> parse_yolo_metadata_names(const std::string& metadata_v
 }
 
 
-std::tuple<int, int, double, double> resize_image_with_border(
+//  Letterbox "input_image" (8-bit, 3 channels) into a square image of
+//  "target_size", normalize it to [0, 1] and write it in planar (CHW) order to
+//  "output". The border and the transpose are done in the same pass that
+//  writes the output, so there are no intermediate images besides the resize.
+//  Returns the shift and the scale to map boxes back to the input image.
+std::tuple<int, int, double, double> letterbox_to_planar(
     const cv::Mat& input_image,
-    cv::Mat& output_image,
-    int target_width, int target_height,
-    cv::Scalar border_color = cv::Scalar(0,0,0)
+    cv::Mat& resized_scratch,
+    float* output, int target_size,
+    uint8_t border_value
 ){
     int original_width = input_image.cols;
     int original_height = input_image.rows;
 
-    double scale_x = static_cast<double>(target_width) / original_width;
-    double scale_y = static_cast<double>(target_height) / original_height;
+    double scale_x = static_cast<double>(target_size) / original_width;
+    double scale_y = static_cast<double>(target_size) / original_height;
     double scale = std::min(scale_x, scale_y);
 
     int new_width = static_cast<int>(original_width * scale);
     int new_height = static_cast<int>(original_height * scale);
-    new_width = std::min(new_width, target_width);
-    new_height = std::min(new_height, target_height);
+    new_width = std::min(new_width, target_size);
+    new_height = std::min(new_height, target_size);
 
     if (new_width == 0 || new_height == 0){
         throw std::runtime_error("Input Image too small: " + std::to_string(original_width) + " x " + std::to_string(original_height));
     }
 
-    cv::Mat resized_image;
-    cv::resize(input_image, resized_image, cv::Size(new_width, new_height), 0, 0, cv::INTER_LINEAR); // INTER_AREA for shrinking
+    const cv::Mat* resized = &input_image;
+    if (new_width != original_width || new_height != original_height){
+        cv::resize(input_image, resized_scratch, cv::Size(new_width, new_height), 0, 0, cv::INTER_LINEAR); // INTER_AREA for shrinking
+        resized = &resized_scratch;
+    }
+
+    int border_top = (target_size - new_height) / 2;
+    int border_left = (target_size - new_width) / 2;
+    int border_right = border_left + new_width;
+
+    float normalize[256];
+    for (int c = 0; c < 256; c++){
+        normalize[c] = (float)(c * (1.0 / 255.0));
+    }
+    const float border = normalize[border_value];
+
+    const size_t plane_size = (size_t)target_size * target_size;
+    float* planes[3] = {output, output + plane_size, output + 2*plane_size};
+    for (int row = 0; row < target_size; row++){
+        size_t offset = (size_t)row * target_size;
+        int src_row = row - border_top;
+        if (src_row < 0 || src_row >= new_height){
+            for (float* plane : planes){
+                std::fill(plane + offset, plane + offset + target_size, border);
+            }
+            continue;
+        }
 
-    int border_top = (target_height - new_height) / 2;
-    int border_bottom = target_height - new_height - border_top;
-    int border_left = (target_width - new_width) / 2;
-    int border_right = target_width - new_width - border_left;
+        for (float* plane : planes){
+            std::fill(plane + offset, plane + offset + border_left, border);
+            std::fill(plane + offset + border_right, plane + offset + target_size, border);
+        }
 
-    cv::copyMakeBorder(resized_image, output_image, border_top, border_bottom, border_left, border_right, cv::BORDER_CONSTANT, border_color);
+        const uint8_t* src = resized->ptr<uint8_t>(src_row);
+        float* dest0 = planes[0] + offset + border_left;
+        float* dest1 = planes[1] + offset + border_left;
+        float* dest2 = planes[2] + offset + border_left;
+        for (int col = 0; col < new_width; col++){
+            dest0[col] = normalize[src[0]];
+            dest1[col] = normalize[src[1]];
+            dest2[col] = normalize[src[2]];
+            src += 3;
+        }
+    }
 
     return std::make_tuple(
         border_left, border_top,
@@ -188,30 +229,11 @@ void YOLOv5Session::run(const cv::Mat& input_image, std::vector<YOLOv5Session::D
     CV_Assert(input_image.depth() == CV_8U);
     CV_Assert(input_image.channels() == 3);
 
-    cv::Mat image_resized;
-
     int x_shift = 0, y_shift = 0;
     double x_scale = 1.0, y_scale = 1.0;
-    std::tie(x_shift, y_shift, x_scale, y_scale) = resize_image_with_border(input_image, image_resized,
-        YOLO5_INPUT_IMAGE_SIZE, YOLO5_INPUT_IMAGE_SIZE, cv::Scalar(114, 114, 114));
-
-    // Declare a destination Mat for float32
-    cv::Mat image_float;
-
-    // Convert the uint8_image to image_float
-    // The third argument (alpha) is a scaling factor.
-    // For normalization to [0.0, 1.0], use 1.0 / 255.0.
-    // For retaining original values (0-255), use 1.0.
-    image_resized.convertTo(image_float, CV_32F, 1.0 / 255.0); 
-
-    for (int c = 0, i = 0; c < 3; c++){
-        for (int row = 0; row < image_float.rows; row++){
-            for (int col = 0; col < image_float.cols; col++){
-                float pixel_value = image_float.at<cv::Vec3f>(row, col)[c];
-                m_model_input[i++] = pixel_value;
-            }
-        }
-    }
+    std::tie(x_shift, y_shift, x_scale, y_scale) = letterbox_to_planar(
+        input_image, m_resized, m_model_input.data(), YOLO5_INPUT_IMAGE_SIZE, 114
+    );
 
     auto input_tensor = create_tensor<float>(m_memory_info, m_model_input, m_input_shape);
     auto output_tensor = create_tensor<float>(m_memory_info, m_model_output, m_output_shape);
@@ -224,36 +246,55 @@ void YOLOv5Session::run(const cv::Mat& input_image, std::vector<YOLOv5Session::D
     // auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
     // std::cout << "Yolov5 inference time: " << milliseconds << " ms" << std::endl;
 
-    const size_t cand_size = m_label_names.size() + 5;
-
-    std::vector<cv::Rect> pixel_boxes;
-    std::vector<int> indices;
-    std::vector<float> scores;
-    std::vector<size_t> labels;
-
-    for (int i = 0; i < YOLO5_NUM_CANDIDATES; i++){
-        float cx = m_model_output[cand_size*i];
-        float cy = m_model_output[cand_size*i+1];
-        float w = m_model_output[cand_size*i+2];
-        float h = m_model_output[cand_size*i+3];
-        float sc = m_model_output[cand_size*i+4];
+    const size_t num_labels = m_label_names.size();
+    const size_t cand_size = num_labels + 5;
+
+    std::vector<cv::Rect>& pixel_boxes = m_pixel_boxes;
+    std::vector<float>& scores = m_scores;
+    std::vector<size_t>& labels = m_labels;
+    std::vector<int>& indices = m_indices;
+    pixel_boxes.clear();
+    scores.clear();
+    labels.clear();
+    indices.clear();
+
+    //  Most of the candidates are background. Drop everything that NMSBoxes()
+    //  would drop for being under the score threshold before doing anything
+    //  else with it. The label scores are at most 1, so a candidate can't
+    //  pass unless its objectness does.
+    const float* candidate = m_model_output.data();
+    for (int i = 0; i < YOLO5_NUM_CANDIDATES; i++, candidate += cand_size){
+        float sc = candidate[4];
+        if (!(sc > YOLO5_SCORE_THRESHOLD)){
+            continue;
+        }
 
         float max_score = 0.0;
         size_t pred_label = 0;  // predicted label
-        for (size_t j_label = 0; j_label < m_label_names.size(); j_label++){
-            float score = m_model_output[cand_size*i+5+j_label];
+        for (size_t j_label = 0; j_label < num_labels; j_label++){
+            float score = candidate[5 + j_label];
             if (score > max_score){
                 max_score = score;
                 pred_label = j_label;
             }
         }
-        scores.push_back(max_score * sc); // sc is like a global confidence scale?
+        float score = max_score * sc; // sc is like a global confidence scale?
+        if (!(score > YOLO5_SCORE_THRESHOLD)){
+            continue;
+        }
+
+        float cx = candidate[0];
+        float cy = candidate[1];
+        float w = candidate[2];
+        float h = candidate[3];
+        scores.push_back(score);
         pixel_boxes.emplace_back((int)(cx - w / 2 + 0.5), (int)(cy - h / 2 + 0.5), int(w + 0.5), int(h + 0.5));
-        indices.push_back(i);
         labels.push_back(pred_label);
     }
 
-    cv::dnn::NMSBoxes(pixel_boxes, scores, 0.2f, 0.45f, indices);
+    if (!scores.empty()){
+        cv::dnn::NMSBoxes(pixel_boxes, scores, YOLO5_SCORE_THRESHOLD, YOLO5_NMS_THRESHOLD, indices);
+    }
 
     // std::cout << "num found pixel_boxes " << indices.size() << std::endl;
     // return;
@@ -41,6 +41,8 @@ public:
 private:
     const int YOLO5_INPUT_IMAGE_SIZE = 640;
     const int YOLO5_NUM_CANDIDATES = 25200;
+    const float YOLO5_SCORE_THRESHOLD = 0.2f;
+    const float YOLO5_NMS_THRESHOLD = 0.45f;
 
     std::vector<std::string> m_label_names;
 
@@ -54,6 +56,13 @@ private:
 
     std::vector<float> m_model_input;
     std::vector<float> m_model_output;
+
+    //  Scratch space reused across calls to run().
+    cv::Mat m_resized;
+    std::vector<cv::Rect> m_pixel_boxes;
+    std::vector<float> m_scores;
+    std::vector<size_t> m_labels;
+    std::vector<int> m_indices;
 };
 
 // Find the first detection matching the given label ID from a YOLOv5Session detection output.
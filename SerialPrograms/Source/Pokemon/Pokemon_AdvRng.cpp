@@ -6,6 +6,8 @@
 
 #include <cstddef>
 #include <algorithm>
+#include <random>
+#include "CommonFramework/Tools/GlobalThreadPools.h"
 #include "Pokemon_AdvRng.h"
 
 namespace PokemonAutomation{
@@ -43,13 +45,28 @@ AdvRngState rngstate_from_internal_state(uint16_t seed, uint64_t advances, uint3
     return  {seed, advances, method, s0, s1, s2, s3, s4, s5};
 }
 
-AdvRngState rngstate_from_seed(uint16_t seed, uint64_t advances, AdvRngMethod method){
-    uint32_t state = seed;
-    state = increment_internal_rng_state(state);
-    for (uint64_t i=0; i<advances; i++){ 
-        state = increment_internal_rng_state(state);
+//  Same as calling increment_internal_rng_state() "advances" times.
+//  The LCG step is the affine map x -> a*x + c. Composing it with itself by
+//  repeated squaring gets to any advance in O(log(advances)).
+uint32_t jump_internal_rng_state(uint32_t state, uint64_t advances){
+    uint32_t mul = 1;
+    uint32_t add = 0;
+    uint32_t step_mul = 0x41c64e6d;
+    uint32_t step_add = 0x6073;
+    while (advances != 0){
+        if (advances & 1){
+            mul *= step_mul;
+            add = add * step_mul + step_add;
+        }
+        step_add = step_add * step_mul + step_add;
+        step_mul *= step_mul;
+        advances >>= 1;
     }
+    return state * mul + add;
+}
 
+AdvRngState rngstate_from_seed(uint16_t seed, uint64_t advances, AdvRngMethod method){
+    uint32_t state = jump_internal_rng_state(seed, advances + 1);
     return rngstate_from_internal_state(seed, advances, state, method);
 }
 
@@ -770,6 +787,220 @@ std::string gender_to_string(const AdvGender& gender){
 }
 
 
+//  Search Engine
+//
+//  A search is a list of jobs, each of which walks the same number of advances
+//  from its own starting point. (one job per seed and method) Hits must come
+//  out in job order and then in advance order.
+//
+//  The flattened (job, advance) space is cut into fixed-size chunks. Each chunk
+//  jumps straight to its first state, so the chunks are independent and run on
+//  the compute thread pool. Chunk hits are concatenated in chunk order.
+//
+//  Within a chunk, advances are processed in batches. A cheap prefilter runs
+//  over the whole batch first. Only the survivors get the full result built
+//  and checked with check_for_match(). The prefilters only reject advances that
+//  check_for_match() would also reject, so the hits are unchanged.
+
+const uint64_t ADV_SEARCH_CHUNK = (uint64_t)1 << 14;
+const size_t ADV_SEARCH_BATCH = 16;
+
+template <typename HitType, typename ScanJob>
+void run_advance_search(
+    std::vector<HitType>& hits,
+    uint64_t jobs, uint64_t length,
+    ScanJob&& scan_job
+){
+    uint64_t total = jobs * length;
+    if (total == 0){
+        return;
+    }
+
+    size_t chunks = (size_t)((total + ADV_SEARCH_CHUNK - 1) / ADV_SEARCH_CHUNK);
+    std::vector<std::vector<HitType>> chunk_hits(chunks);
+    auto run_chunk = [&](size_t index){
+        uint64_t start = index * ADV_SEARCH_CHUNK;
+        uint64_t end = std::min(start + ADV_SEARCH_CHUNK, total);
+        while (start < end){
+            uint64_t job = start / length;
+            uint64_t first = start % length;
+            uint64_t last = std::min(length, first + (end - start));
+            scan_job(chunk_hits[index], job, first, last);
+            start += last - first;
+        }
+    };
+
+    if (chunks == 1){
+        run_chunk(0);
+    }else{
+        GlobalThreadPools::computation_normal().run_in_parallel(run_chunk, 0, chunks);
+    }
+
+    for (std::vector<HitType>& item : chunk_hits){
+        hits.insert(hits.end(), item.begin(), item.end());
+    }
+}
+
+//  Walk the internal states "state" (at advance "first") through advance
+//  "end" (exclusive) in batches. "prefilter(s)" gets a pointer to s0 of an
+//  advance with s1...s5 after it and returns whether the advance needs a full
+//  check. "check(advance, s0)" does the full check.
+template <typename Prefilter, typename Check>
+void scan_advances(
+    uint32_t state, uint64_t first, uint64_t end,
+    Prefilter&& prefilter, Check&& check
+){
+    uint32_t window[ADV_SEARCH_BATCH + 5];
+    uint8_t pass[ADV_SEARCH_BATCH];
+    for (uint64_t advance = first; advance < end;){
+        window[0] = state;
+        for (size_t c = 1; c < ADV_SEARCH_BATCH + 5; c++){
+            window[c] = increment_internal_rng_state(window[c - 1]);
+        }
+
+        //  Fixed trip count and no early exits so this can be vectorized.
+        for (size_t c = 0; c < ADV_SEARCH_BATCH; c++){
+            pass[c] = prefilter(window + c);
+        }
+
+        size_t count = (size_t)std::min<uint64_t>(ADV_SEARCH_BATCH, end - advance);
+        for (size_t c = 0; c < count; c++){
+            if (pass[c]){
+                check(advance + c, window[c]);
+            }
+        }
+
+        state = window[ADV_SEARCH_BATCH];
+        advance += count;
+    }
+}
+
+//  Nature, ability, gender and shininess only depend on the PID. Written with
+//  bitwise ops instead of branches so scan_advances() can vectorize it.
+class AdvPidFilter{
+public:
+    AdvPidFilter(const AdvRngFilters& target, int16_t gender_threshold, uint16_t tid_xor_sid)
+        : m_any_nature(target.nature == AdvNature::Any)
+        , m_nature((uint32_t)target.nature)
+        , m_any_ability(target.ability == AdvAbility::Any)
+        , m_ability((uint32_t)target.ability)
+        , m_any_gender(target.gender == AdvGender::Any)
+        , m_want_female(0)
+        , m_want_male(0)
+        , m_gender_threshold(gender_threshold)
+        , m_any_shiny(target.shiny == AdvShinyType::Any)
+        , m_want_square(target.shiny == AdvShinyType::Square)
+        , m_want_star(target.shiny == AdvShinyType::Star)
+        , m_want_normal(target.shiny == AdvShinyType::Normal)
+        , m_tid_xor_sid(tid_xor_sid)
+    {
+        //  Genderless Pokemon only match a gender of "Any".
+        if (gender_threshold >= -1){
+            m_want_female = target.gender == AdvGender::Female;
+            m_want_male = target.gender == AdvGender::Male;
+        }
+    }
+
+    uint32_t operator()(uint32_t pid) const{
+        uint32_t nature_ok = m_any_nature | (pid % 25 == m_nature);
+        uint32_t ability_ok = m_any_ability | ((pid & 1) == m_ability);
+
+        uint32_t female = (int32_t)(pid & 0xff) <= m_gender_threshold;
+        uint32_t gender_ok = m_any_gender | (m_want_female & female) | (m_want_male & (female ^ 1));
+
+        uint32_t shiny_xor = ((pid >> 16) ^ (pid & 0xffff)) ^ m_tid_xor_sid;
+        uint32_t shiny_ok = m_any_shiny
+            | (m_want_square & (shiny_xor == 0))
+            | (m_want_star & (shiny_xor - 1 < 7))
+            | (m_want_normal & (shiny_xor >= 8));
+
+        return nature_ok & ability_ok & gender_ok & shiny_ok;
+    }
+
+private:
+    uint32_t m_any_nature;
+    uint32_t m_nature;
+    uint32_t m_any_ability;
+    uint32_t m_ability;
+    uint32_t m_any_gender;
+    uint32_t m_want_female;
+    uint32_t m_want_male;
+    int32_t m_gender_threshold;
+    uint32_t m_any_shiny;
+    uint32_t m_want_square;
+    uint32_t m_want_star;
+    uint32_t m_want_normal;
+    uint32_t m_tid_xor_sid;
+};
+
+//  Slot, level and (except for Unown) nature of a wild encounter are rolled
+//  directly from s0, s1 and s2.
+class AdvWildSlotFilter{
+public:
+    AdvWildSlotFilter(const AdvRngFilters& target, const std::vector<AdvEncounterSlot>& slots, bool super_rod)
+        : m_size(slots.size())
+        , m_super_rod(super_rod)
+        , m_level(target.level)
+        , m_any_nature(target.nature == AdvNature::Any)
+        , m_nature((uint8_t)target.nature)
+    {
+        for (const AdvEncounterSlot& slot : slots){
+            std::string name = slot.species.find("unown") != std::string::npos ? "unown" : slot.species;
+            uint8_t diff = slot.maxlevel - slot.minlevel;
+            if (slot.maxlevel < slot.minlevel){
+                diff = 0;
+            }
+            m_slots.emplace_back(Slot{
+                name == target.species,
+                slot_to_unownform(slot) >= 0,
+                slot.minlevel,
+                diff,
+            });
+        }
+    }
+
+    bool operator()(const uint32_t* s) const{
+        uint8_t slot_num = slot_number_from_roll((s[0] >> 16) % 100, m_size, m_super_rod);
+        const Slot& slot = m_slots[slot_num];
+        if (!slot.species_ok){
+            return false;
+        }
+        uint16_t level_roll = s[1] >> 16;
+        uint8_t level = slot.minlevel + (level_roll % (slot.diff + 1));
+        if (level != m_level){
+            return false;
+        }
+        return slot.unown || m_any_nature || (s[2] >> 16) % 25 == m_nature;
+    }
+
+private:
+    struct Slot{
+        bool species_ok;
+        bool unown;
+        uint8_t minlevel;
+        uint8_t diff;
+    };
+
+    size_t m_size;
+    bool m_super_rod;
+    uint8_t m_level;
+    bool m_any_nature;
+    uint8_t m_nature;
+    std::vector<Slot> m_slots;
+};
+
+std::vector<AdvRngMethod> methods_to_search(const std::vector<AdvRngMethod>& methods, AdvRngMethod target){
+    std::vector<AdvRngMethod> ret;
+    for (AdvRngMethod method : methods){
+        if ((target == AdvRngMethod::Any) || (target == method)){
+            ret.emplace_back(method);
+        }
+    }
+    return ret;
+}
+
+
+
 AdvRngSearcher::AdvRngSearcher(uint16_t seed, AdvRngState state, bool roaming)
     : seed(seed)
     , state(state)
@@ -799,48 +1030,6 @@ AdvPokemonResult AdvRngSearcher::generate_pokemon(){
     return pokemon_from_state(state, roaming);
 }
 
-void AdvRngSearcher::search_advance_range(
-    std::vector<AdvRngState>& hits,
-    AdvRngFilters& target,
-    uint64_t min_advances,
-    uint64_t max_advances,
-    int16_t gender_threshold,
-    uint16_t tid_xor_sid
-){
-    for (uint8_t m=0; m<3; m++){
-        set_state_advances(min_advances);
-
-        AdvRngMethod method;
-        switch (m){
-        case 1:
-            method = AdvRngMethod::Method2;
-            break;
-        case 2:
-            method = AdvRngMethod::Method4;
-            break;
-        case 0:
-        default:
-            method = AdvRngMethod::Method1;
-            break;
-        }
-
-        if ((target.method != AdvRngMethod::Any) && (target.method != method)){
-            continue;
-        }else{
-            state.method = method;
-        }
-
-        for (uint64_t a=min_advances; a<=max_advances; a++){
-            AdvPokemonResult res = pokemon_from_state(state, roaming);
-            bool match = check_for_match(res, target, gender_threshold, tid_xor_sid);
-            if (match){
-               hits.emplace_back(state);
-            }
-            advance_state();
-        }
-    }
-}
-
 std::vector<AdvRngState> AdvRngSearcher::search(
     AdvRngFilters& target,
     const std::vector<uint16_t>& seeds,
@@ -849,11 +1038,38 @@ std::vector<AdvRngState> AdvRngSearcher::search(
     int16_t gender_threshold,
     uint16_t tid_xor_sid
 ){
+    std::vector<AdvRngMethod> methods = methods_to_search(
+        {AdvRngMethod::Method1, AdvRngMethod::Method2, AdvRngMethod::Method4},
+        target.method
+    );
+    uint64_t length = max_advances >= min_advances ? max_advances - min_advances + 1 : 0;
+
+    AdvPidFilter pid_filter(target, gender_threshold, tid_xor_sid);
+    bool roaming = this->roaming;
+
     std::vector<AdvRngState> hits;
-    for (uint16_t seed : seeds){
-        set_seed(seed);
-        search_advance_range(hits, target, min_advances, max_advances, gender_threshold, tid_xor_sid);
-    }
+    run_advance_search(
+        hits, seeds.size() * methods.size(), length,
+        [&](std::vector<AdvRngState>& chunk_hits, uint64_t job, uint64_t first, uint64_t last){
+            uint16_t seed = seeds[job / methods.size()];
+            AdvRngMethod method = methods[job % methods.size()];
+            first += min_advances;
+            last += min_advances;
+            scan_advances(
+                jump_internal_rng_state(seed, first + 1), first, last,
+                [&](const uint32_t* s){
+                    return pid_filter(pid_from_states(s[0], s[1]));
+                },
+                [&](uint64_t advance, uint32_t s0){
+                    AdvRngState state = rngstate_from_internal_state(seed, advance, s0, method);
+                    AdvPokemonResult res = pokemon_from_state(state, roaming);
+                    if (check_for_match(res, target, gender_threshold, tid_xor_sid)){
+                        chunk_hits.emplace_back(state);
+                    }
+                }
+            );
+        }
+    );
     return hits;
 }
 
@@ -888,49 +1104,6 @@ AdvWildPokemonResult AdvRngWildSearcher::generate_pokemon(bool super_rod){
     return wild_pokemon_from_state(state, encounter_slots, super_rod);
 }
 
-void AdvRngWildSearcher::search_advance_range(
-    std::vector<AdvRngState>& hits,
-    AdvRngFilters& target,
-    uint64_t min_advances,
-    uint64_t max_advances,
-    int16_t gender_threshold,
-    bool super_rod,
-    uint16_t tid_xor_sid
-){
-    for (uint8_t m=0; m<3; m++){
-        set_state_advances(min_advances);
-
-        AdvRngMethod method;
-        switch (m){
-        case 1:
-            method = AdvRngMethod::Method2;
-            break;
-        case 2:
-            method = AdvRngMethod::Method4;
-            break;
-        case 0:
-        default:
-            method = AdvRngMethod::Method1;
-            break;
-        }
-
-        if ((target.method != AdvRngMethod::Any) && (target.method != method)){
-            continue;
-        }else{
-            state.method = method;
-        }
-
-        for (uint64_t a=min_advances; a<=max_advances; a++){
-            AdvWildPokemonResult res = wild_pokemon_from_state(state, encounter_slots, super_rod);
-            bool match = check_for_match(res, target, gender_threshold, tid_xor_sid);
-            if (match){
-                hits.emplace_back(state);
-            }
-            advance_state();
-        }
-    }
-}
-
 std::vector<AdvRngState> AdvRngWildSearcher::search(
     AdvRngFilters& target,
     const std::vector<uint16_t>& seeds,
@@ -941,10 +1114,39 @@ std::vector<AdvRngState> AdvRngWildSearcher::search(
     uint16_t tid_xor_sid
 ){
     std::vector<AdvRngState> hits;
-    for (uint16_t seed : seeds){
-        set_seed(seed);
-        search_advance_range(hits, target, min_advances, max_advances, gender_threshold, super_rod, tid_xor_sid);
+    if (encounter_slots.empty()){
+        return hits;
     }
+
+    std::vector<AdvRngMethod> methods = methods_to_search(
+        {AdvRngMethod::Method1, AdvRngMethod::Method2, AdvRngMethod::Method4},
+        target.method
+    );
+    uint64_t length = max_advances >= min_advances ? max_advances - min_advances + 1 : 0;
+
+    AdvWildSlotFilter slot_filter(target, encounter_slots, super_rod);
+    const std::vector<AdvEncounterSlot>& slots = encounter_slots;
+
+    run_advance_search(
+        hits, seeds.size() * methods.size(), length,
+        [&](std::vector<AdvRngState>& chunk_hits, uint64_t job, uint64_t first, uint64_t last){
+            uint16_t seed = seeds[job / methods.size()];
+            AdvRngMethod method = methods[job % methods.size()];
+            first += min_advances;
+            last += min_advances;
+            scan_advances(
+                jump_internal_rng_state(seed, first + 1), first, last,
+                slot_filter,
+                [&](uint64_t advance, uint32_t s0){
+                    AdvRngState state = rngstate_from_internal_state(seed, advance, s0, method);
+                    AdvWildPokemonResult res = wild_pokemon_from_state(state, slots, super_rod);
+                    if (check_for_match(res, target, gender_threshold, tid_xor_sid)){
+                        chunk_hits.emplace_back(state);
+                    }
+                }
+            );
+        }
+    );
     return hits;
 }
 
@@ -1006,77 +1208,9 @@ AdvPokemonResult AdvRngEggSearcher::generate_pokemon(AdvIVs& parentA_ivs, AdvIVs
     return egg_to_pokemon(egg_result, parentA_ivs, parentB_ivs);
 }
 
-void AdvRngEggSearcher::search_pickup_advances_range(
-        std::vector<std::pair<AdvRngState, AdvRngState>>& hits,
-        AdvRngFilters& target,
-        uint16_t held_pid_half,
-        uint64_t min_pickup_advances,
-        uint64_t max_pickup_advances,
-        AdvIVs& parentA_ivs,
-        AdvIVs& parentB_ivs,
-        int16_t gender_threshold,
-        uint16_t tid_xor_sid
-    ){
-    for (uint8_t m=0; m<4; m++){
-        set_pickup_state_advances(min_pickup_advances);
-
-        AdvRngMethod method;
-        switch (m){
-        case 1:
-            method = AdvRngMethod::Method2;
-            break;
-        case 2:
-            method = AdvRngMethod::Method3;
-            break;
-        case 3:
-            method = AdvRngMethod::Method4;
-            break;
-        case 0:
-        default:
-            method = AdvRngMethod::Method1;
-            break;
-        }
-
-        if ((target.method != AdvRngMethod::Any) && (target.method != method)){
-            continue;
-        }else{
-            pickup_state.method = method;
-        }
-
-        for (uint64_t a=min_pickup_advances; a<=max_pickup_advances; a++){
-            AdvEggResult egg_res = egg_from_pickup_state(pickup_state, held_pid_half);
-            AdvPokemonResult poke_res = egg_to_pokemon(egg_res, parentA_ivs, parentB_ivs);
-            bool match = check_for_match(poke_res, target, gender_threshold, tid_xor_sid);
-            if (match){
-                std::pair<AdvRngState, AdvRngState> state_pair = { held_state, pickup_state };
-                hits.emplace_back(state_pair);
-            }
-            advance_pickup_state();
-        }
-    }
-}
-
-void AdvRngEggSearcher::search_pickups(
-    std::vector<std::pair<AdvRngState, AdvRngState>>& hits,
-    AdvRngFilters& target,
-    uint16_t held_pid_half,
-    const std::vector<uint16_t>& pickup_seeds,
-    uint64_t min_pickup_advances,
-    uint64_t max_pickup_advances,
-    AdvIVs& parentA_ivs,
-    AdvIVs& parentB_ivs,
-    int16_t gender_threshold,
-    uint16_t tid_xor_sid
-){
-    for (uint16_t pickup_seed : pickup_seeds){
-        set_pickup_seed(pickup_seed);
-        search_pickup_advances_range(hits, target, held_pid_half, min_pickup_advances, max_pickup_advances, parentA_ivs, parentB_ivs, gender_threshold, tid_xor_sid);
-    }
-}
-
-void AdvRngEggSearcher::search_held_advances_range(
-    std::vector<std::pair<AdvRngState, AdvRngState>>& hits,
+std::vector<std::pair<AdvRngState, AdvRngState>> AdvRngEggSearcher::search(
     AdvRngFilters& target,
+    const std::vector<uint16_t>& held_seeds,
     uint64_t min_held_advances,
     uint64_t max_held_advances,
     const std::vector<uint16_t>& pickup_seeds,
@@ -1088,52 +1222,301 @@ void AdvRngEggSearcher::search_held_advances_range(
     int16_t gender_threshold,
     uint16_t tid_xor_sid
 ){
-    set_held_state_advances(min_held_advances);
-    for (uint64_t a=min_held_advances; a<=max_held_advances; a++){
-        if (egg_held_at_state(held_state.s0, compatibility)){
-            uint16_t held_pid_half = (((held_state.s1) >> 16) % 0xfffe) + 1;
-            search_pickups(
-                hits, target, 
-                held_pid_half, pickup_seeds, 
-                min_pickup_advances, max_pickup_advances,
-                parentA_ivs, parentB_ivs,
-                gender_threshold, tid_xor_sid
+    //  Held advances are cheap to check. Find the ones that hold an egg first
+    //  and then search the pickups of all of them together.
+    std::vector<AdvRngState> held_states;
+    for (uint16_t h_seed : held_seeds){
+        set_held_seed(h_seed);
+        set_held_state_advances(min_held_advances);
+        for (uint64_t a=min_held_advances; a<=max_held_advances; a++){
+            if (egg_held_at_state(held_state.s0, compatibility)){
+                held_states.emplace_back(held_state);
+            }
+            advance_held_state();
+        }
+    }
+
+    std::vector<AdvRngMethod> methods = methods_to_search(
+        {AdvRngMethod::Method1, AdvRngMethod::Method2, AdvRngMethod::Method3, AdvRngMethod::Method4},
+        target.method
+    );
+    uint64_t length = max_pickup_advances >= min_pickup_advances ? max_pickup_advances - min_pickup_advances + 1 : 0;
+
+    AdvPidFilter pid_filter(target, gender_threshold, tid_xor_sid);
+
+    std::vector<std::pair<AdvRngState, AdvRngState>> hits;
+    run_advance_search(
+        hits, held_states.size() * pickup_seeds.size() * methods.size(), length,
+        [&](std::vector<std::pair<AdvRngState, AdvRngState>>& chunk_hits, uint64_t job, uint64_t first, uint64_t last){
+            AdvRngMethod method = methods[job % methods.size()];
+            job /= methods.size();
+            uint16_t seed = pickup_seeds[job % pickup_seeds.size()];
+            const AdvRngState& held = held_states[job / pickup_seeds.size()];
+            uint16_t held_pid_half = ((held.s1 >> 16) % 0xfffe) + 1;
+
+            first += min_pickup_advances;
+            last += min_pickup_advances;
+            scan_advances(
+                jump_internal_rng_state(seed, first + 1), first, last,
+                [&](const uint32_t* s){
+                    return pid_filter((s[0] & 0xffff0000) + held_pid_half);
+                },
+                [&](uint64_t advance, uint32_t s0){
+                    AdvRngState pickup = rngstate_from_internal_state(seed, advance, s0, method);
+                    AdvEggResult egg_res = egg_from_pickup_state(pickup, held_pid_half);
+                    AdvPokemonResult poke_res = egg_to_pokemon(egg_res, parentA_ivs, parentB_ivs);
+                    if (check_for_match(poke_res, target, gender_threshold, tid_xor_sid)){
+                        chunk_hits.emplace_back(held, pickup);
+                    }
+                }
             );
         }
-        
-        advance_held_state();
+    );
+    return hits;
+}
+
+
+
+
+//  Compare the searchers against a plain serial walk over every seed, method
+//  and advance on random targets. The walk steps the LCG one advance at a time,
+//  so it also checks jump_internal_rng_state().
+namespace{
+
+const std::vector<AdvRngMethod> POKEMON_METHODS = {
+    AdvRngMethod::Method1, AdvRngMethod::Method2, AdvRngMethod::Method4,
+};
+const std::vector<AdvRngMethod> EGG_METHODS = {
+    AdvRngMethod::Method1, AdvRngMethod::Method2, AdvRngMethod::Method3, AdvRngMethod::Method4,
+};
+
+template <typename Visit>
+void reference_walk(uint16_t seed, uint64_t min_advances, uint64_t max_advances, Visit&& visit){
+    uint32_t state = increment_internal_rng_state(seed);
+    for (uint64_t a = 0; a <= max_advances; a++){
+        if (a >= min_advances){
+            visit(a, state);
+        }
+        state = increment_internal_rng_state(state);
     }
+}
 
-    
+bool same_state(const AdvRngState& x, const AdvRngState& y){
+    return x.seed == y.seed && x.advance == y.advance && x.method == y.method
+        && x.s0 == y.s0 && x.s1 == y.s1 && x.s2 == y.s2
+        && x.s3 == y.s3 && x.s4 == y.s4 && x.s5 == y.s5;
 }
 
-std::vector<std::pair<AdvRngState, AdvRngState>> AdvRngEggSearcher::search(
-    AdvRngFilters& target,
-    const std::vector<uint16_t>& held_seeds,
-    uint64_t min_held_advances,
-    uint64_t max_held_advances,
-    const std::vector<uint16_t>& pickup_seeds,
-    uint64_t min_pickup_advances,
-    uint64_t max_pickup_advances,
-    AdvIVs& parentA_ivs,
-    AdvIVs& parentB_ivs,
-    AdvEggCompatibility compatibility,
-    int16_t gender_threshold,
-    uint16_t tid_xor_sid
-){
-    std::vector<std::pair<AdvRngState, AdvRngState>> hits;
-    for (uint16_t h_seed : held_seeds){
-        set_held_seed(h_seed);
-        search_held_advances_range(
-            hits, target,
-            min_held_advances, max_held_advances, 
+AdvRngFilters random_filters(std::mt19937& rng, bool egg){
+    AdvRngFilters ret;
+    ret.level = 0;
+    ret.nature = rng() % 2 ? AdvNature::Any : (AdvNature)(rng() % 25);
+    ret.ability = rng() % 2 ? AdvAbility::Any : (AdvAbility)(rng() % 2);
+    ret.gender = rng() % 2 ? AdvGender::Any : (AdvGender)(rng() % 2);
+    switch (rng() % 8){
+    case 0: ret.shiny = AdvShinyType::Normal; break;
+    case 1: ret.shiny = AdvShinyType::Star; break;
+    case 2: ret.shiny = AdvShinyType::Square; break;
+    default: ret.shiny = AdvShinyType::Any;
+    }
+    const std::vector<AdvRngMethod>& methods = egg ? EGG_METHODS : POKEMON_METHODS;
+    size_t method = rng() % (methods.size() + 1);
+    ret.method = method == methods.size() ? AdvRngMethod::Any : methods[method];
+    for (IvRange* range : {&ret.ivs.hp, &ret.ivs.attack, &ret.ivs.defense, &ret.ivs.spatk, &ret.ivs.spdef, &ret.ivs.speed}){
+        range->low = (int8_t)(rng() % 3 == 0 ? rng() % 16 : 0);
+        range->high = (int8_t)(rng() % 3 == 0 ? 16 + rng() % 16 : 31);
+    }
+    return ret;
+}
+
+std::vector<uint16_t> random_seeds(std::mt19937& rng){
+    std::vector<uint16_t> ret(1 + rng() % 3);
+    for (uint16_t& seed : ret){
+        seed = (uint16_t)rng();
+    }
+    return ret;
+}
+
+bool method_selected(AdvRngMethod target, AdvRngMethod method){
+    return target == AdvRngMethod::Any || target == method;
+}
+
+}
+
+
+class Test_AdvRngSearch : public UnitTest{
+public:
+    Test_AdvRngSearch()
+        : UnitTest("Pokemon::AdvRngSearch")
+    {}
+
+    virtual UnitTestResult run(Logger& logger, CancellableScope& scope) const override{
+        std::mt19937 rng(0);
+        for (size_t iteration = 0; iteration < 40; iteration++){
+            std::string error = test_static(rng);
+            if (error.empty()){
+                error = test_wild(rng);
+            }
+            if (error.empty()){
+                error = test_egg(rng);
+            }
+            if (!error.empty()){
+                return error + " (iteration " + std::to_string(iteration) + ")";
+            }
+        }
+        return true;
+    }
+
+private:
+    static std::string test_static(std::mt19937& rng){
+        AdvRngFilters target = random_filters(rng, false);
+        std::vector<uint16_t> seeds = random_seeds(rng);
+        uint64_t min_advances = rng() % 2000;
+        uint64_t max_advances = min_advances + rng() % 30000;
+        int16_t gender_threshold = rng() % 4 == 0 ? -1 : (int16_t)(rng() % 256);
+        uint16_t tid_xor_sid = (uint16_t)rng();
+        bool roaming = rng() % 4 == 0;
+
+        std::vector<AdvRngState> expected;
+        for (uint16_t seed : seeds){
+            for (AdvRngMethod method : POKEMON_METHODS){
+                if (!method_selected(target.method, method)){
+                    continue;
+                }
+                reference_walk(seed, min_advances, max_advances, [&](uint64_t advance, uint32_t s0){
+                    AdvRngState state = rngstate_from_internal_state(seed, advance, s0, method);
+                    if (check_for_match(pokemon_from_state(state, roaming), target, gender_threshold, tid_xor_sid)){
+                        expected.emplace_back(state);
+                    }
+                });
+            }
+        }
+
+        AdvRngSearcher searcher(0, 0, AdvRngMethod::Method1, roaming);
+        std::vector<AdvRngState> hits = searcher.search(target, seeds, min_advances, max_advances, gender_threshold, tid_xor_sid);
+        return compare("AdvRngSearcher", hits, expected);
+    }
+
+    static std::string test_wild(std::mt19937& rng){
+        const size_t SIZES[] = {12, 5, 3, 2};
+        std::vector<AdvEncounterSlot> slots(SIZES[rng() % 4]);
+        for (AdvEncounterSlot& slot : slots){
+            slot.species = rng() % 4 == 0
+                ? std::string("unown-") + (char)('a' + rng() % 26)
+                : "species-" + std::to_string(rng() % 4);
+            slot.minlevel = (uint8_t)(2 + rng() % 4);
+            slot.maxlevel = (uint8_t)(slot.minlevel + rng() % 4 - 1);
+        }
+
+        AdvRngFilters target = random_filters(rng, false);
+        const AdvEncounterSlot& slot = slots[rng() % slots.size()];
+        target.species = slot.species.find("unown") != std::string::npos ? "unown" : slot.species;
+        target.level = slot.minlevel;
+        std::vector<uint16_t> seeds = random_seeds(rng);
+        uint64_t min_advances = rng() % 2000;
+        uint64_t max_advances = min_advances + rng() % 20000;
+        int16_t gender_threshold = rng() % 4 == 0 ? -1 : (int16_t)(rng() % 256);
+        uint16_t tid_xor_sid = (uint16_t)rng();
+        bool super_rod = slots.size() == 5 && rng() % 2;
+
+        std::vector<AdvRngState> expected;
+        for (uint16_t seed : seeds){
+            for (AdvRngMethod method : POKEMON_METHODS){
+                if (!method_selected(target.method, method)){
+                    continue;
+                }
+                reference_walk(seed, min_advances, max_advances, [&](uint64_t advance, uint32_t s0){
+                    AdvRngState state = rngstate_from_internal_state(seed, advance, s0, method);
+                    if (check_for_match(wild_pokemon_from_state(state, slots, super_rod), target, gender_threshold, tid_xor_sid)){
+                        expected.emplace_back(state);
+                    }
+                });
+            }
+        }
+
+        AdvRngWildSearcher searcher(0, 0, slots, AdvRngMethod::Any);
+        std::vector<AdvRngState> hits = searcher.search(target, seeds, min_advances, max_advances, gender_threshold, super_rod, tid_xor_sid);
+        return compare("AdvRngWildSearcher", hits, expected);
+    }
+
+    static std::string test_egg(std::mt19937& rng){
+        AdvRngFilters target = random_filters(rng, true);
+        std::vector<uint16_t> held_seeds = random_seeds(rng);
+        std::vector<uint16_t> pickup_seeds = random_seeds(rng);
+        uint64_t min_held_advances = rng() % 500;
+        uint64_t max_held_advances = min_held_advances + rng() % 20;
+        uint64_t min_pickup_advances = rng() % 500;
+        uint64_t max_pickup_advances = min_pickup_advances + rng() % 3000;
+        AdvIVs parentA_ivs;
+        AdvIVs parentB_ivs;
+        for (int c = 0; c < 6; c++){
+            parentA_ivs[c] = (uint8_t)(rng() % 32);
+            parentB_ivs[c] = (uint8_t)(rng() % 32);
+        }
+        AdvEggCompatibility compatibility = (AdvEggCompatibility)(rng() % 3);
+        int16_t gender_threshold = rng() % 4 == 0 ? -1 : (int16_t)(rng() % 256);
+        uint16_t tid_xor_sid = (uint16_t)rng();
+
+        std::vector<std::pair<AdvRngState, AdvRngState>> expected;
+        for (uint16_t held_seed : held_seeds){
+            reference_walk(held_seed, min_held_advances, max_held_advances, [&](uint64_t held_advance, uint32_t held_s0){
+                if (!egg_held_at_state(held_s0, compatibility)){
+                    return;
+                }
+                AdvRngState held = rngstate_from_internal_state(held_seed, held_advance, held_s0, AdvRngMethod::Any);
+                uint16_t held_pid_half = ((held.s1 >> 16) % 0xfffe) + 1;
+                for (uint16_t pickup_seed : pickup_seeds){
+                    for (AdvRngMethod method : EGG_METHODS){
+                        if (!method_selected(target.method, method)){
+                            continue;
+                        }
+                        reference_walk(pickup_seed, min_pickup_advances, max_pickup_advances, [&](uint64_t advance, uint32_t s0){
+                            AdvRngState pickup = rngstate_from_internal_state(pickup_seed, advance, s0, method);
+                            AdvEggResult egg = egg_from_pickup_state(pickup, held_pid_half);
+                            if (check_for_match(egg_to_pokemon(egg, parentA_ivs, parentB_ivs), target, gender_threshold, tid_xor_sid)){
+                                expected.emplace_back(held, pickup);
+                            }
+                        });
+                    }
+                }
+            });
+        }
+
+        AdvRngEggSearcher searcher(0, 0, 0, 0, AdvRngMethod::Any);
+        std::vector<std::pair<AdvRngState, AdvRngState>> hits = searcher.search(
+            target,
+            held_seeds, min_held_advances, max_held_advances,
             pickup_seeds, min_pickup_advances, max_pickup_advances,
-            parentA_ivs, parentB_ivs, compatibility, 
+            parentA_ivs, parentB_ivs, compatibility,
             gender_threshold, tid_xor_sid
         );
+        if (hits.size() != expected.size()){
+            return "AdvRngEggSearcher: " + std::to_string(hits.size()) + " hits, expected " + std::to_string(expected.size()) + ".";
+        }
+        for (size_t c = 0; c < hits.size(); c++){
+            if (!same_state(hits[c].first, expected[c].first) || !same_state(hits[c].second, expected[c].second)){
+                return "AdvRngEggSearcher: hit " + std::to_string(c) + " differs.";
+            }
+        }
+        return "";
     }
 
-    return hits;
+    static std::string compare(const char* name, const std::vector<AdvRngState>& hits, const std::vector<AdvRngState>& expected){
+        if (hits.size() != expected.size()){
+            return std::string(name) + ": " + std::to_string(hits.size()) + " hits, expected " + std::to_string(expected.size()) + ".";
+        }
+        for (size_t c = 0; c < hits.size(); c++){
+            if (!same_state(hits[c], expected[c])){
+                return std::string(name) + ": hit " + std::to_string(c) + " differs.";
+            }
+        }
+        return "";
+    }
+};
+
+
+void add_tests_AdvRng(UnitTestDatabase& database){
+    database.add<Test_AdvRngSearch>();
 }
 
 
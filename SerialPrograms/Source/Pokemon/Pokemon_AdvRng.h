@@ -11,6 +11,7 @@
 #include <utility>
 #include <vector>
 #include <stdexcept>
+#include "Common/Cpp/TestRunners/UnitTestDatabase.h"
 #include "Pokemon_StatsCalculation.h"
 
 namespace PokemonAutomation{
@@ -238,16 +239,6 @@ public:
         int16_t gender_threshold = 126,
         uint16_t tid_xor_sid = 0
     );
-
-private:
-    void search_advance_range(
-        std::vector<AdvRngState>& hits,
-        AdvRngFilters& target,
-        uint64_t min_advances,
-        uint64_t max_advances,
-        int16_t gender_threshold,
-        uint16_t tid_xor_sid
-    );
 };
 
 class AdvRngWildSearcher{
@@ -274,17 +265,6 @@ public:
         bool super_rod = false,
         uint16_t tid_xor_sid = 0
     );
-
-private:
-    void search_advance_range(
-        std::vector<AdvRngState>& hits,
-        AdvRngFilters& target,
-        uint64_t min_advances,
-        uint64_t max_advances,
-        int16_t gender_threshold,
-        bool super_rod,
-        uint16_t tid_xor_sid
-    );
 };
 
 
@@ -328,49 +308,12 @@ public:
         int16_t gender_threshold = 126,
         uint16_t tid_xor_sid = 0
     );
+};
 
-private:
 
-    void search_held_advances_range(
-        std::vector<std::pair<AdvRngState, AdvRngState>>& hits,
-        AdvRngFilters& target,
-        uint64_t min_held_advances,
-        uint64_t max_held_advances,
-        const std::vector<uint16_t>& pickup_seeds,
-        uint64_t min_pickup_advances,
-        uint64_t max_pickup_advances,
-        AdvIVs& parentA_ivs,
-        AdvIVs& parentB_ivs,
-        AdvEggCompatibility compatibility,
-        int16_t gender_threshold,
-        uint16_t tid_xor_sid
-    );
 
-    void search_pickups(
-        std::vector<std::pair<AdvRngState, AdvRngState>>& hits,
-        AdvRngFilters& target,
-        uint16_t held_pid_half,
-        const std::vector<uint16_t>& pickup_seeds,
-        uint64_t min_pickup_advances,
-        uint64_t max_pickup_advances,
-        AdvIVs& parentA_ivs,
-        AdvIVs& parentB_ivs,
-        int16_t gender_threshold,
-        uint16_t tid_xor_sid
-    );
+void add_tests_AdvRng(UnitTestDatabase& database);
 
-    void search_pickup_advances_range(
-        std::vector<std::pair<AdvRngState, AdvRngState>>& hits,
-        AdvRngFilters& target,
-        uint16_t held_pid_half,
-        uint64_t min_pickup_advances,
-        uint64_t max_pickup_advances,
-        AdvIVs& parentA_ivs,
-        AdvIVs& parentB_ivs,
-        int16_t gender_threshold,
-        uint16_t tid_xor_sid
-    );
-};
 
 
 }
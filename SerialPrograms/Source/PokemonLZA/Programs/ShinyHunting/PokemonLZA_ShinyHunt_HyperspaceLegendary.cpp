@@ -40,6 +40,7 @@ namespace NintendoSwitch {
 namespace PokemonLZA {
 
 using namespace Pokemon;
+using ML::YOLOv5AsyncDetector;
 using ML::YOLOv5Watcher;
 using DetectionBox = ML::YOLOv5Session::DetectionBox;
 
@@ -571,9 +572,17 @@ void hunt_virizion_balcony(
             pbf_move_left_joystick(context, {0, +1}, Seconds(5), 0ms);
             context.wait_for_all_requests();
 
+            //  Only steer from frames taken after the last move finished.
+            //  Otherwise the correction is computed from a stale camera
+            //  position and overshoots.
+            WallClock last_move = current_time();
             while(true){
-                const std::vector<DetectionBox>& detections = yolo_watcher.detected_boxes();
-                const DetectionBox* detection = find_detection(detections, trash_bin_idx);
+                YOLOv5AsyncDetector::Detections detections = yolo_watcher.wait_for(last_move, current_time() + 100ms);
+                if (detections.timestamp <= last_move){
+                    context.throw_if_cancelled();
+                    continue;
+                }
+                const DetectionBox* detection = find_detection(detections.boxes, trash_bin_idx);
                 if (detection == nullptr){
                     context.wait_for(100ms);
                     continue;
@@ -592,6 +601,7 @@ void hunt_virizion_balcony(
                 int duration = static_cast<int>(std::fabs(center_x - 0.5) * 1000);
                 pbf_move_right_joystick(context, {dir_x, 0.0}, Milliseconds(duration), 0ms);
                 context.wait_for_all_requests();
+                last_move = current_time();
             }
         },
         {{yolo_watcher}}
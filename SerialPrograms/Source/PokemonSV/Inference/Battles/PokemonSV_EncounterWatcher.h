@@ -43,6 +43,9 @@ public:
         const std::vector<AudioSpectrum>& new_spectrums,
         AudioFeed& audioFeed
     ) override;
+    virtual void set_spectrum_filter_bank(SpectrumFilterBank* bank) override{
+        m_shiny_sound.set_spectrum_filter_bank(bank);
+    }
 
 private:
     NormalBattleMenuWatcher m_battle_menu;
@@ -160,6 +160,7 @@ std::vector<WaterfillOCRResult> waterfill_OCR(
     std::map<size_t, WaterfillObject> map;
     {
         std::unique_ptr<WaterfillSession> session = make_WaterfillSession(matrix);
+        session->set_object_storage(WaterfillObjectStorage::CROPPED);
         auto iter = session->make_iterator(20);
         WaterfillObject object;
         while (map.size() < 16 && iter->find_next(object, true)){
@@ -62,6 +62,7 @@
 
 //  Deprecated
 #include "Programs/ItemPrinter/PokemonSV_AutoItemPrinter.h"
+#include "Programs/ItemPrinter/PokemonSV_ItemPrinterSeedIndexGenerator.h"
 
 #include "Programs/TestPrograms/PokemonSV_SoundListener.h"
 #include "Programs/FormHunting/PokemonSV_ThreeSegmentDudunsparceFinder.h"
@@ -168,6 +169,7 @@ std::vector<PanelEntry> PanelListFactory::make_panels() const{
         ret.emplace_back("---- Developer Tools ----");
         ret.emplace_back(make_single_switch_program<SoundListener_Descriptor, SoundListener>());
         ret.emplace_back(make_single_switch_program<ThreeSegmentDudunsparceFinder_Descriptor, ThreeSegmentDudunsparceFinder>());
+        ret.emplace_back(make_computer_program<ItemPrinterSeedIndexGenerator_Descriptor, ItemPrinterSeedIndexGenerator>());
     }
 
 #ifdef PA_OFFICIAL
@@ -25,6 +25,7 @@
 #include "Inference/Overworld/PokemonSV_LetsGoKillDetector.h"
 #include "Inference/Picnics/PokemonSV_SandwichRecipeDetector.h"
 #include "Inference/Picnics/PokemonSV_SandwichHandDetector.h"
+#include "Programs/ItemPrinter/PokemonSV_ItemPrinterSeedIndex.h"
 #include "PokemonSV_Tests.h"
 
 namespace PokemonAutomation{
@@ -54,6 +55,7 @@ void add_tests(UnitTestDatabase& database){
     add_tests_TeraTypeReader(database);
     add_tests_NormalBattleMenus(database);
     add_tests_LetsGoKillDetector(database);
+    ItemPrinter::add_tests_ItemPrinterSeedIndex(database);
 }
 
 
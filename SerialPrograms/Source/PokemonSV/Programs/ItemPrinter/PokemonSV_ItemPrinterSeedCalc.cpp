@@ -235,8 +235,28 @@ const char* item_id_to_slug(int item_id){
     }
 }
 
+int item_slug_to_id(const std::string& slug){
+    static const std::map<std::string, int> database = []{
+        std::map<std::string, int> ret;
+        for (int item_id = 0; item_id < 4096; item_id++){
+            const char* item_slug = item_id_to_slug(item_id);
+            if (item_slug != nullptr){
+                ret.emplace(item_slug, item_id);
+            }
+        }
+        return ret;
+    }();
+    auto iter = database.find(slug);
+    if (iter != database.end()){
+        return iter->second;
+    }else{
+        return -1;
+    }
+}
+
 struct ItemPrinterItemData{
     const char* slug;
+    uint16_t item_id;
     uint16_t weight;
     uint8_t min_quantity;
     uint8_t max_quantity;
@@ -266,6 +286,7 @@ std::vector<ItemPrinterItemData> make_item_prize_list(){
         }
         ret.emplace_back(ItemPrinterItemData{
             slug,
+            (uint16_t)item_id,
             (uint16_t)entry.get_integer_throw("EmergePercent", path),
             (uint8_t)entry.get_integer_throw("LotteryItemNumMin", path),
             (uint8_t)entry.get_integer_throw("LotteryItemNumMax", path)
@@ -299,6 +320,7 @@ std::vector<ItemPrinterItemData> make_ball_prize_list(){
         }
         ret.emplace_back(ItemPrinterItemData{
             slug,
+            (uint16_t)item_id,
             (uint16_t)entry.get_integer_throw("EmergePercent", path),
             (uint8_t)entry.get_integer_throw("LotteryItemNumMin", path),
             (uint8_t)entry.get_integer_throw("LotteryItemNumMax", path)
@@ -349,14 +371,7 @@ std::vector<const ItemPrinterItemData*> make_ball_prize_table(){
 }
 
 
-enum class PrintMode{
-    Regular = 0,
-    ItemBonus = 1,
-    BallBonus = 2,
-};
-
-
-std::array<std::string, 10> calculate_prizes(int64_t seed, PrintMode mode){
+std::array<const ItemPrinterItemData*, 10> roll_prize_items(int64_t seed, PrintMode mode, uint8_t* quantities){
     static const std::vector<const ItemPrinterItemData*> ITEM_TABLE = make_item_prize_table();
     static const std::vector<const ItemPrinterItemData*> BALL_TABLE = make_ball_prize_table();
 
@@ -367,7 +382,7 @@ std::array<std::string, 10> calculate_prizes(int64_t seed, PrintMode mode){
     Pokemon::Xoroshiro128Plus rand(seed, 0x82A2B175229D6A5B);
 
     PrintMode return_mode = PrintMode::Regular;
-    std::array<std::string, 10> ret;
+    std::array<const ItemPrinterItemData*, 10> ret;
     for (size_t c = 0; c < 10; c++){
         //  Always check for next bonus mode, even if not possible.
         uint64_t roll = rand.nextInt(1000);
@@ -376,12 +391,14 @@ std::array<std::string, 10> calculate_prizes(int64_t seed, PrintMode mode){
         //  Determine the item to print.
         uint64_t item_roll = rand.nextInt(table.size());
         const ItemPrinterItemData& item = *table[item_roll];
-        ret[c] = item.slug;
+        ret[c] = &item;
 
         //  Determine quantity.
+        uint8_t quantity = item.min_quantity;
         if (item.min_quantity != item.max_quantity){
-            rand.nextInt(item.max_quantity - item.min_quantity + 1);
+            quantity += (uint8_t)rand.nextInt(item.max_quantity - item.min_quantity + 1);
         }
+        quantities[c] = quantity;
 
         //  If we're lucky enough to get a bonus mode, pick one.
         //  Assume the player has both modes unlocked.
@@ -395,6 +412,26 @@ std::array<std::string, 10> calculate_prizes(int64_t seed, PrintMode mode){
     return ret;
 }
 
+std::array<std::string, 10> calculate_prizes(int64_t seed, PrintMode mode){
+    uint8_t quantities[10];
+    std::array<const ItemPrinterItemData*, 10> items = roll_prize_items(seed, mode, quantities);
+    std::array<std::string, 10> ret;
+    for (size_t c = 0; c < 10; c++){
+        ret[c] = items[c]->slug;
+    }
+    return ret;
+}
+
+std::array<PrizeRoll, 10> roll_prizes(int64_t seed, PrintMode mode){
+    uint8_t quantities[10];
+    std::array<const ItemPrinterItemData*, 10> items = roll_prize_items(seed, mode, quantities);
+    std::array<PrizeRoll, 10> ret;
+    for (size_t c = 0; c < 10; c++){
+        ret[c] = PrizeRoll{items[c]->item_id, quantities[c]};
+    }
+    return ret;
+}
+
 
 
 
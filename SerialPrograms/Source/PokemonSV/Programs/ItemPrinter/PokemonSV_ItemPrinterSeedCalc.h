@@ -12,6 +12,9 @@
 #ifndef PokemonAutomation_PokemonSV_ItemPrinterSeedCalc_H
 #define PokemonAutomation_PokemonSV_ItemPrinterSeedCalc_H
 
+#include <stdint.h>
+#include <array>
+#include <string>
 #include "PokemonSV_ItemPrinterDatabase.h"
 
 namespace PokemonAutomation{
@@ -20,8 +23,28 @@ namespace PokemonSV{
 namespace ItemPrinter{
 
 
+enum class PrintMode{
+    Regular = 0,
+    ItemBonus = 1,
+    BallBonus = 2,
+};
+
+struct PrizeRoll{
+    uint16_t item_id;
+    uint8_t quantity;
+};
+
+
 DateSeed calculate_seed_prizes(int64_t seed);
 
+//  Same rolls as calculate_seed_prizes() for a single mode, but returns the
+//  game's item IDs and quantities instead of slugs. Does not allocate.
+std::array<PrizeRoll, 10> roll_prizes(int64_t seed, PrintMode mode);
+
+//  Returns nullptr/-1 if the item is not one the printer can produce.
+const char* item_id_to_slug(int item_id);
+int item_slug_to_id(const std::string& slug);
+
 
 }
 }
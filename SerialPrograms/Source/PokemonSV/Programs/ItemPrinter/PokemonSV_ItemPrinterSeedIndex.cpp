@@ -0,0 +1,353 @@
+/*  Item Printer Seed Index
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <map>
+#include <filesystem>
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Filesystem/FileIO.h"
+#include "Common/Cpp/TestRunners/UnitTestDatabase.h"
+#include "CommonFramework/Tools/GlobalThreadPools.h"
+#include "PokemonSV_ItemPrinterSeedIndex.h"
+
+namespace PokemonAutomation{
+namespace NintendoSwitch{
+namespace PokemonSV{
+namespace ItemPrinter{
+
+
+
+namespace{
+
+const char INDEX_MAGIC[8] = {'P', 'A', 'I', 'P', 'S', 'E', 'E', 'D'};
+const uint32_t INDEX_VERSION = 1;
+
+struct IndexHeader{
+    char magic[8];
+    uint32_t version;
+    uint32_t jobs;
+    int64_t first_seed;
+    int64_t last_seed;
+    uint64_t entries;
+};
+
+bool entry_less(const SeedIndexEntry& a, const SeedIndexEntry& b){
+    if (a.item_id != b.item_id){
+        return a.item_id < b.item_id;
+    }
+    if (a.mode != b.mode){
+        return a.mode < b.mode;
+    }
+    if (a.quantity != b.quantity){
+        return a.quantity > b.quantity;
+    }
+    return a.seed < b.seed;
+}
+
+void add_seed(std::vector<SeedIndexEntry>& entries, int64_t seed, size_t jobs, uint16_t min_quantity){
+    for (PrintMode mode : {PrintMode::Regular, PrintMode::ItemBonus, PrintMode::BallBonus}){
+        std::array<PrizeRoll, 10> prizes = roll_prizes(seed, mode);
+
+        //  Merge repeats of the same item. There are at most 10 so a linear
+        //  scan is cheaper than anything fancier.
+        SeedIndexEntry totals[10];
+        size_t items = 0;
+        for (size_t c = 0; c < jobs; c++){
+            size_t i = 0;
+            while (i < items && totals[i].item_id != prizes[c].item_id){
+                i++;
+            }
+            if (i == items){
+                totals[items++] = SeedIndexEntry{
+                    (uint32_t)seed, prizes[c].item_id, 0, (uint8_t)mode, {}
+                };
+            }
+            totals[i].quantity += prizes[c].quantity;
+        }
+
+        for (size_t i = 0; i < items; i++){
+            if (totals[i].quantity >= min_quantity){
+                entries.emplace_back(totals[i]);
+            }
+        }
+    }
+}
+
+}
+
+
+
+ItemPrinterSeedIndex ItemPrinterSeedIndex::build(
+    int64_t first_seed, int64_t last_seed,
+    ItemPrinterJobs jobs, uint16_t min_quantity
+){
+    if (first_seed < 0 || last_seed > ((int64_t)1 << 32) || first_seed > last_seed){
+        throw InternalProgramError(
+            nullptr, PA_CURRENT_FUNCTION,
+            "Invalid seed range: [" + std::to_string(first_seed) + ", " + std::to_string(last_seed) + ")"
+        );
+    }
+
+    //  Make sure the prize tables are loaded before going parallel.
+    roll_prizes(first_seed, PrintMode::Regular);
+
+    const int64_t BLOCK_SIZE = 1 << 16;
+    size_t blocks = (size_t)((last_seed - first_seed + BLOCK_SIZE - 1) / BLOCK_SIZE);
+    std::vector<std::vector<SeedIndexEntry>> block_entries(blocks);
+    GlobalThreadPools::computation_normal().run_in_parallel(
+        [&](size_t index){
+            int64_t start = first_seed + (int64_t)index * BLOCK_SIZE;
+            int64_t end = std::min(start + BLOCK_SIZE, last_seed);
+            std::vector<SeedIndexEntry>& entries = block_entries[index];
+            for (int64_t seed = start; seed < end; seed++){
+                add_seed(entries, seed, (size_t)jobs, min_quantity);
+            }
+        },
+        0, blocks
+    );
+
+    ItemPrinterSeedIndex ret;
+    ret.m_jobs = jobs;
+    ret.m_first_seed = first_seed;
+    ret.m_last_seed = last_seed;
+
+    size_t total = 0;
+    for (const std::vector<SeedIndexEntry>& entries : block_entries){
+        total += entries.size();
+    }
+    ret.m_entries.reserve(total);
+    for (std::vector<SeedIndexEntry>& entries : block_entries){
+        ret.m_entries.insert(ret.m_entries.end(), entries.begin(), entries.end());
+        entries = std::vector<SeedIndexEntry>();
+    }
+    std::sort(ret.m_entries.begin(), ret.m_entries.end(), entry_less);
+
+    return ret;
+}
+
+
+
+ItemPrinterSeedIndex ItemPrinterSeedIndex::load(const std::string& path){
+    FileIO file;
+    if (!file.open(path, FileMode::READ | FileMode::BINARY)){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to open file.", path);
+    }
+
+    IndexHeader header;
+    if (file.read(&header, sizeof(header)) != sizeof(header) ||
+        memcmp(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0
+    ){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Not an Item Printer seed index.", path);
+    }
+    if (header.version != INDEX_VERSION){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unsupported index version: " + std::to_string(header.version), path);
+    }
+
+    //  Check the entry count against the file length before allocating for it.
+    int64_t file_size = file.seek(0, SEEK_END) ? file.tell() : -1;
+    if (file_size < (int64_t)sizeof(header) || !file.seek(sizeof(header), SEEK_SET)){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to read file.", path);
+    }
+    uint64_t remaining = (uint64_t)file_size - sizeof(header);
+    if (header.entries > remaining / sizeof(SeedIndexEntry)){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Index file is truncated.", path);
+    }
+
+    ItemPrinterSeedIndex ret;
+    ret.m_jobs = (ItemPrinterJobs)header.jobs;
+    ret.m_first_seed = header.first_seed;
+    ret.m_last_seed = header.last_seed;
+    ret.m_entries.resize((size_t)header.entries);
+
+    size_t bytes = ret.m_entries.size() * sizeof(SeedIndexEntry);
+    if (file.read(ret.m_entries.data(), bytes) != bytes){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Index file is truncated.", path);
+    }
+
+    return ret;
+}
+void ItemPrinterSeedIndex::save(const std::string& path) const{
+    IndexHeader header;
+    memcpy(header.magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    header.version = INDEX_VERSION;
+    header.jobs = (uint32_t)m_jobs;
+    header.first_seed = m_first_seed;
+    header.last_seed = m_last_seed;
+    header.entries = m_entries.size();
+
+    FileIO file;
+    if (!file.open(path, FileMode::WRITE | FileMode::BINARY)){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to create file.", path);
+    }
+    size_t bytes = m_entries.size() * sizeof(SeedIndexEntry);
+    if (file.write(&header, sizeof(header)) != sizeof(header) ||
+        file.write(m_entries.data(), bytes) != bytes
+    ){
+        throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to write file.", path);
+    }
+    file.close();
+}
+
+
+
+std::pair<const SeedIndexEntry*, const SeedIndexEntry*> ItemPrinterSeedIndex::item_range(int item_id, PrintMode mode) const{
+    const SeedIndexEntry* begin = m_entries.data();
+    const SeedIndexEntry* end = begin + m_entries.size();
+    if (item_id < 0){
+        return {end, end};
+    }
+    return std::equal_range(
+        begin, end,
+        SeedIndexEntry{0, (uint16_t)item_id, 0, (uint8_t)mode, {}},
+        [](const SeedIndexEntry& a, const SeedIndexEntry& b){
+            if (a.item_id != b.item_id){
+                return a.item_id < b.item_id;
+            }
+            return a.mode < b.mode;
+        }
+    );
+}
+
+std::vector<SeedIndexEntry> ItemPrinterSeedIndex::find(
+    const std::string& slug, PrintMode mode,
+    uint16_t min_quantity, size_t max_results
+) const{
+    auto range = item_range(item_slug_to_id(slug), mode);
+    const SeedIndexEntry* end = std::partition_point(
+        range.first, range.second,
+        [=](const SeedIndexEntry& entry){
+            return entry.quantity >= min_quantity;
+        }
+    );
+    size_t count = std::min<size_t>(end - range.first, max_results);
+    return std::vector<SeedIndexEntry>(range.first, range.first + count);
+}
+
+const SeedIndexEntry* ItemPrinterSeedIndex::best(const std::string& slug, PrintMode mode) const{
+    auto range = item_range(item_slug_to_id(slug), mode);
+    return range.first == range.second ? nullptr : range.first;
+}
+
+
+
+
+class Test_ItemPrinterSeedIndex : public UnitTest{
+public:
+    Test_ItemPrinterSeedIndex()
+        : UnitTest("PokemonSV::ItemPrinterSeedIndex")
+    {}
+
+    virtual UnitTestResult run(Logger& logger, CancellableScope& scope) const override{
+        const int64_t FIRST_SEED = 1717459200;  //  2024-06-04 00:00:00
+        const int64_t LAST_SEED = FIRST_SEED + 100000;
+        const uint16_t MIN_QUANTITY = 2;
+
+        ItemPrinterSeedIndex built = ItemPrinterSeedIndex::build(
+            FIRST_SEED, LAST_SEED, ItemPrinterJobs::Jobs_5, MIN_QUANTITY
+        );
+        if (built.size() == 0){
+            return "The index is empty.";
+        }
+
+        std::string path = (std::filesystem::temp_directory_path() / "PA-ItemPrinterSeedIndex-Test.bin").string();
+        std::string error = round_trip(built, path, MIN_QUANTITY);
+        if (error.empty()){
+            error = reject_truncated(path);
+        }
+        std::filesystem::remove(path);
+        return error.empty() ? UnitTestResult(true) : UnitTestResult(error);
+    }
+
+private:
+    static std::string round_trip(const ItemPrinterSeedIndex& built, const std::string& path, uint16_t min_quantity){
+        built.save(path);
+        ItemPrinterSeedIndex loaded = ItemPrinterSeedIndex::load(path);
+        if (loaded.jobs() != built.jobs() ||
+            loaded.first_seed() != built.first_seed() ||
+            loaded.last_seed() != built.last_seed() ||
+            loaded.size() != built.size() ||
+            memcmp(loaded.entries().data(), built.entries().data(), built.size() * sizeof(SeedIndexEntry)) != 0
+        ){
+            return "The loaded index differs from the saved one.";
+        }
+
+        //  Every seed in the range must be found under every item it prints
+        //  enough of, with the same quantity.
+        for (int64_t seed = built.first_seed(); seed < built.last_seed(); seed += 997){
+            for (PrintMode mode : {PrintMode::Regular, PrintMode::ItemBonus, PrintMode::BallBonus}){
+                std::array<PrizeRoll, 10> prizes = roll_prizes(seed, mode);
+                std::map<uint16_t, uint16_t> totals;
+                for (size_t c = 0; c < (size_t)built.jobs(); c++){
+                    totals[prizes[c].item_id] += prizes[c].quantity;
+                }
+                for (const auto& item : totals){
+                    if (item.second < min_quantity){
+                        continue;
+                    }
+                    std::string slug = item_id_to_slug(item.first);
+                    std::vector<SeedIndexEntry> hits = loaded.find(slug, mode, item.second);
+                    auto iter = std::find_if(
+                        hits.begin(), hits.end(),
+                        [=](const SeedIndexEntry& entry){
+                            return entry.seed == (uint32_t)seed && entry.quantity == item.second;
+                        }
+                    );
+                    if (iter == hits.end()){
+                        return "Seed " + std::to_string(seed) + " is missing from the lookup of " + slug + ".";
+                    }
+                    const SeedIndexEntry* best = loaded.best(slug, mode);
+                    if (best == nullptr || best->quantity < item.second || best->quantity != hits[0].quantity){
+                        return "best() disagrees with find() for " + slug + ".";
+                    }
+                }
+            }
+        }
+        return "";
+    }
+
+    static void write_bytes(const std::string& path, const std::string& bytes){
+        FileIO file;
+        if (!file.open(path, FileMode::WRITE | FileMode::BINARY) ||
+            file.write(bytes.data(), bytes.size()) != bytes.size()
+        ){
+            throw FileException(nullptr, PA_CURRENT_FUNCTION, "Unable to write file.", path);
+        }
+    }
+
+    static std::string reject_truncated(const std::string& path){
+        std::string file = file_to_string(path);
+        write_bytes(path, file.substr(0, file.size() - sizeof(SeedIndexEntry) / 2));
+        try{
+            ItemPrinterSeedIndex::load(path);
+            return "A truncated index was accepted.";
+        }catch (FileException&){}
+
+        //  A corrupt entry count must be rejected before anything is allocated.
+        uint64_t entries = (uint64_t)1 << 60;
+        memcpy(&file[offsetof(IndexHeader, entries)], &entries, sizeof(entries));
+        write_bytes(path, file);
+        try{
+            ItemPrinterSeedIndex::load(path);
+            return "An index with a corrupt entry count was accepted.";
+        }catch (FileException&){}
+        return "";
+    }
+};
+
+
+void add_tests_ItemPrinterSeedIndex(UnitTestDatabase& database){
+    database.add<Test_ItemPrinterSeedIndex>();
+}
+
+
+
+}
+}
+}
+}
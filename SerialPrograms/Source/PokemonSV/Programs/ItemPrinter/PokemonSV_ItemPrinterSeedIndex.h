@@ -0,0 +1,100 @@
+/*  Item Printer Seed Index
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Reverse lookup from (item, mode, quantity) to the date seeds that print
+ *  it. Built offline by sweeping a range of seeds with roll_prizes().
+ *
+ *  The index is a flat array of fixed-size entries sorted by item, mode,
+ *  quantity (descending) and then seed. A query is a binary search so picking
+ *  a target seed does not run the RNG at all.
+ *
+ *  The file is a small header followed by that same array, so it can be read
+ *  in one go or memory-mapped as is. It is stored in native byte order.
+ *
+ */
+
+#ifndef PokemonAutomation_PokemonSV_ItemPrinterSeedIndex_H
+#define PokemonAutomation_PokemonSV_ItemPrinterSeedIndex_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "Common/Cpp/TestRunners/UnitTest.h"
+#include "PokemonSV_ItemPrinterTools.h"
+#include "PokemonSV_ItemPrinterSeedCalc.h"
+
+namespace PokemonAutomation{
+namespace NintendoSwitch{
+namespace PokemonSV{
+namespace ItemPrinter{
+
+
+
+struct SeedIndexEntry{
+    uint32_t seed;
+    uint16_t item_id;
+    uint16_t quantity;  //  Total rolled quantity over all the jobs of the print. (before any bonus)
+    uint8_t mode;       //  PrintMode
+    uint8_t reserved[3];
+};
+static_assert(sizeof(SeedIndexEntry) == 12);
+
+
+class ItemPrinterSeedIndex{
+public:
+    ItemPrinterSeedIndex() = default;
+
+    //  Sweep the seeds [first_seed, last_seed) in parallel. Only keep the items
+    //  that a print of "jobs" jobs produces at least "min_quantity" of.
+    static ItemPrinterSeedIndex build(
+        int64_t first_seed, int64_t last_seed,
+        ItemPrinterJobs jobs, uint16_t min_quantity
+    );
+
+    //  Throws FileException if the file cannot be read or is not an index.
+    static ItemPrinterSeedIndex load(const std::string& path);
+    void save(const std::string& path) const;
+
+public:
+    ItemPrinterJobs jobs() const{ return m_jobs; }
+    int64_t first_seed() const{ return m_first_seed; }
+    int64_t last_seed() const{ return m_last_seed; }
+    size_t size() const{ return m_entries.size(); }
+    const std::vector<SeedIndexEntry>& entries() const{ return m_entries; }
+
+    //  All seeds that print at least "min_quantity" of "slug" in "mode".
+    //  Highest quantity first. Ties are in seed order.
+    std::vector<SeedIndexEntry> find(
+        const std::string& slug, PrintMode mode,
+        uint16_t min_quantity, size_t max_results = (size_t)-1
+    ) const;
+
+    //  The seed that prints the most of "slug" in "mode". Returns nullptr if
+    //  the item is not in the index.
+    const SeedIndexEntry* best(const std::string& slug, PrintMode mode) const;
+
+
+private:
+    //  Range of entries with the given item and mode.
+    std::pair<const SeedIndexEntry*, const SeedIndexEntry*> item_range(int item_id, PrintMode mode) const;
+
+
+private:
+    ItemPrinterJobs m_jobs = ItemPrinterJobs::Jobs_1;
+    int64_t m_first_seed = 0;
+    int64_t m_last_seed = 0;
+    std::vector<SeedIndexEntry> m_entries;
+};
+
+
+
+void add_tests_ItemPrinterSeedIndex(UnitTestDatabase& database);
+
+
+
+}
+}
+}
+}
+#endif
@@ -0,0 +1,143 @@
+/*  Item Printer Seed Index Generator
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ */
+
+#include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/PrettyPrint.h"
+#include "Common/Qt/TimeQt.h"
+#include "CommonFramework/GlobalAutoPaths.h"
+#include "CommonFramework/Tools/ProgramEnvironment.h"
+#include "Pokemon/Pokemon_Strings.h"
+#include "PokemonSV_ItemPrinterSeedIndex.h"
+#include "PokemonSV_ItemPrinterSeedIndexGenerator.h"
+
+namespace PokemonAutomation{
+namespace NintendoSwitch{
+namespace PokemonSV{
+
+
+ItemPrinterSeedIndexGenerator_Descriptor::ItemPrinterSeedIndexGenerator_Descriptor()
+    : ComputerProgramDescriptor(
+        "PokemonSV:ItemPrinterSeedIndexGenerator",
+        Pokemon::STRING_POKEMON + " SV", "Item Printer Seed Index Generator",
+        "",
+        "Find the Item Printer dates that print the most of an item."
+    )
+{}
+
+
+
+ItemPrinterSeedIndexGenerator::ItemPrinterSeedIndexGenerator()
+    : FIRST_DATE(
+        "<b>First Date:</b>",
+        LockMode::LOCK_WHILE_RUNNING,
+        DateTimeOption::DATE_HOUR_MIN_SEC,
+        DateTime{2000, 1, 1, 0, 0, 0},
+        DateTime{2060, 12, 31, 23, 59, 59},
+        DateTime{2024, 1, 1, 0, 0, 0}
+    )
+    , LAST_DATE(
+        "<b>Last Date:</b> (exclusive)",
+        LockMode::LOCK_WHILE_RUNNING,
+        DateTimeOption::DATE_HOUR_MIN_SEC,
+        DateTime{2000, 1, 1, 0, 0, 0},
+        DateTime{2060, 12, 31, 23, 59, 59},
+        DateTime{2025, 1, 1, 0, 0, 0}
+    )
+    , JOBS(
+        "<b>Number of Jobs:</b>",
+        ItemPrinterJobs_Database(),
+        LockMode::LOCK_WHILE_RUNNING,
+        ItemPrinterJobs::Jobs_5
+    )
+    , MIN_QUANTITY(
+        "<b>Minimum Quantity:</b><br>Only index items that a print produces at least this many of.",
+        LockMode::LOCK_WHILE_RUNNING,
+        5, 1
+    )
+    , OUTPUT_FILE(
+        false,
+        "<b>Output File:</b> (Relative to the user folder. Leave blank to not save the index.)",
+        LockMode::LOCK_WHILE_RUNNING,
+        "ItemPrinterSeedIndex.bin",
+        "ItemPrinterSeedIndex.bin"
+    )
+    , ITEM(
+        false,
+        "<b>Item:</b> (slug)<br>Log the best dates to print this item.",
+        LockMode::LOCK_WHILE_RUNNING,
+        "",
+        "ability-patch"
+    )
+    , MAX_RESULTS(
+        "<b>Max Results:</b>",
+        LockMode::LOCK_WHILE_RUNNING,
+        10, 1
+    )
+{
+    PA_ADD_OPTION(FIRST_DATE);
+    PA_ADD_OPTION(LAST_DATE);
+    PA_ADD_OPTION(JOBS);
+    PA_ADD_OPTION(MIN_QUANTITY);
+    PA_ADD_OPTION(OUTPUT_FILE);
+    PA_ADD_OPTION(ITEM);
+    PA_ADD_OPTION(MAX_RESULTS);
+}
+
+
+
+void ItemPrinterSeedIndexGenerator::program(ProgramEnvironment& env, CancellableScope& scope){
+    int64_t first_seed = to_seconds_since_epoch(FIRST_DATE);
+    int64_t last_seed = to_seconds_since_epoch(LAST_DATE);
+    if (first_seed >= last_seed){
+        throw UserSetupError(env.logger(), "The last date must be after the first date.");
+    }
+
+    std::string slug = ITEM;
+    if (!slug.empty() && ItemPrinter::item_slug_to_id(slug) < 0){
+        throw UserSetupError(env.logger(), "The item printer cannot print: " + slug);
+    }
+
+    env.log("Indexing " + tostr_u_commas(last_seed - first_seed) + " seeds...");
+    ItemPrinter::ItemPrinterSeedIndex index = ItemPrinter::ItemPrinterSeedIndex::build(
+        first_seed, last_seed, JOBS, MIN_QUANTITY
+    );
+    env.log("Index has " + tostr_u_commas(index.size()) + " entries.");
+
+    std::string path = OUTPUT_FILE;
+    if (!path.empty()){
+        path = USER_FILE_PATH() + path;
+        index.save(path);
+        env.log("Saved index to: " + path);
+    }
+
+    if (slug.empty()){
+        return;
+    }
+    for (ItemPrinter::PrintMode mode : {
+        ItemPrinter::PrintMode::Regular,
+        ItemPrinter::PrintMode::ItemBonus,
+        ItemPrinter::PrintMode::BallBonus,
+    }){
+        const char* mode_name = mode == ItemPrinter::PrintMode::Regular
+            ? "Regular"
+            : mode == ItemPrinter::PrintMode::ItemBonus ? "Item Bonus" : "Ball Bonus";
+        std::vector<ItemPrinter::SeedIndexEntry> hits = index.find(slug, mode, MIN_QUANTITY, MAX_RESULTS);
+        env.log(std::string(mode_name) + ": " + std::to_string(hits.size()) + " dates");
+        for (const ItemPrinter::SeedIndexEntry& hit : hits){
+            WallClock date = WallClock(std::chrono::seconds(hit.seed));
+            env.log(
+                "    " + std::to_string(hit.quantity) + " x " + slug +
+                " at " + to_utc_time_str(date) + " (seed " + std::to_string(hit.seed) + ")"
+            );
+        }
+    }
+}
+
+
+
+}
+}
+}
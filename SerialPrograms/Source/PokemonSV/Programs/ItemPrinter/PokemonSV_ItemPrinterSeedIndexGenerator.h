@@ -0,0 +1,53 @@
+/*  Item Printer Seed Index Generator
+ *
+ *  From: https://github.com/PokemonAutomation/
+ *
+ *      Build an ItemPrinterSeedIndex over a range of dates and save it. If an
+ *  item is given, also log the best dates to print it.
+ *
+ */
+
+#ifndef PokemonAutomation_PokemonSV_ItemPrinterSeedIndexGenerator_H
+#define PokemonAutomation_PokemonSV_ItemPrinterSeedIndexGenerator_H
+
+#include "Common/Cpp/Options/SimpleIntegerOption.h"
+#include "Common/Cpp/Options/StringOption.h"
+#include "Common/Cpp/Options/DateOption.h"
+#include "Common/Cpp/Options/EnumDropdownOption.h"
+#include "ComputerPrograms/ComputerProgram.h"
+#include "PokemonSV_ItemPrinterTools.h"
+
+namespace PokemonAutomation{
+namespace NintendoSwitch{
+namespace PokemonSV{
+
+
+class ItemPrinterSeedIndexGenerator_Descriptor : public ComputerProgramDescriptor{
+public:
+    ItemPrinterSeedIndexGenerator_Descriptor();
+};
+
+
+
+class ItemPrinterSeedIndexGenerator : public ComputerProgramInstance{
+public:
+    ItemPrinterSeedIndexGenerator();
+
+    virtual void program(ProgramEnvironment& env, CancellableScope& scope) override;
+
+private:
+    DateTimeOption FIRST_DATE;
+    DateTimeOption LAST_DATE;
+    EnumDropdownOption<ItemPrinterJobs> JOBS;
+    SimpleIntegerOption<uint16_t> MIN_QUANTITY;
+    StringOption OUTPUT_FILE;
+    StringOption ITEM;
+    SimpleIntegerOption<uint16_t> MAX_RESULTS;
+};
+
+
+
+}
+}
+}
+#endif
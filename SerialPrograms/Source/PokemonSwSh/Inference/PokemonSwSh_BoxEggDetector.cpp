@@ -31,6 +31,10 @@ const ImageMatch::ExactImageMatcher& EGG_MATCHER(){
     return matcher;
 }
 
+void preload_egg_template(){
+    EGG_MATCHER();
+}
+
 BoxEggDetector::BoxEggDetector(SlotLocation side, uint8_t row, double min_euclidean_distance, Color color)
 : m_min_euclidean_distance_squared(min_euclidean_distance * min_euclidean_distance)
 , m_color(color){
@@ -22,6 +22,8 @@ enum class SlotLocation{
     BOX, //  one of the 5 x 6 slots in the box
 };
 
+void preload_egg_template();
+
 class BoxEggDetector : public StaticScreenDetector{
 public:
     BoxEggDetector(SlotLocation side, uint8_t row, double min_euclidean_distance = 100, Color color = COLOR_BLUE);
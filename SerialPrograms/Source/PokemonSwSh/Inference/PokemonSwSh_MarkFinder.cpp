@@ -112,6 +112,11 @@ bool is_question_mark(const ImageViewRGB32& image, const WaterfillObject& object
     return rmsd <= 100;
 }
 
+void preload_mark_templates(){
+    ExclamationMatcher::instance();
+    QUESTION_TOP();
+}
+
 std::vector<ImagePixelBox> find_exclamation_marks(const ImageViewRGB32& image){
     PackedBinaryMatrix matrix = compress_rgb32_to_binary_range(
         image,
@@ -15,6 +15,8 @@ namespace NintendoSwitch{
 namespace PokemonSwSh{
 
 
+void preload_mark_templates();
+
 std::vector<ImagePixelBox> find_exclamation_marks(const ImageViewRGB32& image);
 std::vector<ImagePixelBox> find_question_marks(const ImageViewRGB32& image);
 
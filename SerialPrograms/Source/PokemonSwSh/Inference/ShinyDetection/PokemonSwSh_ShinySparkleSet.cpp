@@ -88,6 +88,8 @@ void ShinySparkleSetSwSh::update_alphas(){
 
 ShinySparkleSetSwSh find_sparkles(size_t screen_area, WaterfillSession& session){
     ShinySparkleSetSwSh sparkles;
+    //  The detectors below only look at packed_matrix().
+    session.set_object_storage(WaterfillObjectStorage::CROPPED);
     auto finder = session.make_iterator(20);
     WaterfillObject object;
     while (finder->find_next(object, true)){
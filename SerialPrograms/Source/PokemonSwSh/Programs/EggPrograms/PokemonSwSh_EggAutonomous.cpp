@@ -18,6 +18,7 @@
 #include "Pokemon/Pokemon_Notification.h"
 #include "Pokemon/Pokemon_Strings.h"
 #include "PokemonSwSh/Commands/PokemonSwSh_Commands_DateSpam.h"
+#include "PokemonSwSh/Inference/PokemonSwSh_BoxEggDetector.h"
 #include "PokemonSwSh/Inference/PokemonSwSh_BoxEmptySlotDetector.h"
 #include "PokemonSwSh/Inference/PokemonSwSh_BoxGenderDetector.h"
 #include "PokemonSwSh/Inference/PokemonSwSh_BoxShinySymbolDetector.h"
@@ -83,6 +84,11 @@ public:
 std::unique_ptr<StatsTracker> EggAutonomous_Descriptor::make_stats() const{
     return std::unique_ptr<StatsTracker>(new Stats());
 }
+std::vector<WarmupResource> EggAutonomous_Descriptor::warmup_resources() const{
+    return {
+        {"PokemonSwSh:EggTemplate", preload_egg_template},
+    };
+}
 
 
 EggAutonomous::EggAutonomous()
@@ -44,6 +44,7 @@ public:
     EggAutonomous_Descriptor();
     class Stats;
     virtual std::unique_ptr<StatsTracker> make_stats() const override;
+    virtual std::vector<WarmupResource> warmup_resources() const override;
 };
 
 
@@ -16,6 +16,7 @@
 #include "PokemonSwSh/ShinyHuntTracker.h"
 #include "PokemonSwSh/Inference/Battles/PokemonSwSh_StartBattleDetector.h"
 #include "PokemonSwSh/Inference/Battles/PokemonSwSh_BattleMenuDetector.h"
+#include "PokemonSwSh/Inference/PokemonSwSh_MarkFinder.h"
 #include "PokemonSwSh/Programs/PokemonSwSh_GameEntry.h"
 #include "PokemonSwSh/Programs/PokemonSwSh_EncounterHandler.h"
 #include "PokemonSwSh_OverworldMovement.h"
@@ -52,6 +53,11 @@ struct ShinyHuntAutonomousOverworld_Descriptor::Stats : public ShinyHuntTracker{
 std::unique_ptr<StatsTracker> ShinyHuntAutonomousOverworld_Descriptor::make_stats() const{
     return std::unique_ptr<StatsTracker>(new Stats());
 }
+std::vector<WarmupResource> ShinyHuntAutonomousOverworld_Descriptor::warmup_resources() const{
+    return {
+        {"PokemonSwSh:MarkTemplates", preload_mark_templates},
+    };
+}
 
 
 
@@ -34,6 +34,7 @@ public:
 
     struct Stats;
     virtual std::unique_ptr<StatsTracker> make_stats() const override;
+    virtual std::vector<WarmupResource> warmup_resources() const override;
 };
 
 
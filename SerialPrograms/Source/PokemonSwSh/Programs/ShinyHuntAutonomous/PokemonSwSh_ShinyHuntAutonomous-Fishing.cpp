@@ -15,6 +15,7 @@
 #include "PokemonSwSh/Commands/PokemonSwSh_Commands_DateSpam.h"
 #include "PokemonSwSh/ShinyHuntTracker.h"
 #include "PokemonSwSh/Inference/PokemonSwSh_FishingDetector.h"
+#include "PokemonSwSh/Inference/PokemonSwSh_MarkFinder.h"
 #include "PokemonSwSh/Inference/ShinyDetection/PokemonSwSh_ShinyEncounterDetector.h"
 #include "PokemonSwSh/Programs/PokemonSwSh_GameEntry.h"
 #include "PokemonSwSh/Programs/PokemonSwSh_EncounterHandler.h"
@@ -50,6 +51,11 @@ struct ShinyHuntAutonomousFishing_Descriptor::Stats : public ShinyHuntTracker{
 std::unique_ptr<StatsTracker> ShinyHuntAutonomousFishing_Descriptor::make_stats() const{
     return std::unique_ptr<StatsTracker>(new Stats());
 }
+std::vector<WarmupResource> ShinyHuntAutonomousFishing_Descriptor::warmup_resources() const{
+    return {
+        {"PokemonSwSh:MarkTemplates", preload_mark_templates},
+    };
+}
 
 
 
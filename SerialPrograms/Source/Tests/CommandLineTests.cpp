@@ -7,16 +7,27 @@
 
 #include "CommandLineTests.h"
 #include "Common/Cpp/Exceptions.h"
+#include "Common/Cpp/Time.h"
+#include "Common/Cpp/Concurrency/Mutex.h"
+#include "Common/Cpp/Concurrency/Thread.h"
+#include "Common/Cpp/Filesystem/FileIO.h"
+#include "Common/Cpp/Json/JsonValue.h"
+#include "Common/Cpp/Json/JsonArray.h"
+#include "Common/Cpp/Json/JsonObject.h"
 #include "CommonFramework/GlobalSettingsPanel.h"
 #include "CommonFramework/Logging/Logger.h"
+#include "CommonFramework/Tools/GlobalThreadPools.h"
 #include "ComputerPrograms/UnitTestRunner.h"
 #include "TestMap.h"
 #include <QDir>
 #include <QDirIterator>
 #include <QFileInfo>
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <list>
+#include <map>
 #include <functional>
 using std::cout;
 using std::cerr;
@@ -44,26 +55,32 @@ void print_equals(){
         } \
     } while (0)
 
-#define RETURN_IF_TEST_FAILED(test_func, file_path, num_passed) \
-    do { \
-        int _ret = 0; \
-        try{ \
-            _ret = test_func(file_path); \
-        }catch (const std::exception& e){ \
-            cout << "Test: " << (file_path) << " threw exception: " << e.what() << endl; \
-            _ret = 1; \
-        }catch (const Exception& e){\
-           cout << "Test: " << (file_path) << " threw " << e.name() << ": <<<" << e.message() << ">>>" << endl; \
-           _ret = 1; \
-        } \
-        if (_ret > 0){\
-            print_equals(); \
-            cout << "Test: " << (file_path) << " failed." << endl; \
-            return _ret; \
-        }else if (_ret == 0){ \
-            num_passed++; \
-        } \
-    }while (0)
+
+// One test file to run.
+struct TestJob{
+    // "<test space>_<test object>", the key of the test function in TEST_MAP.
+    std::string detector;
+    TestFunction test_func;
+    std::string file_path;
+};
+
+// Result of running one TestJob.
+struct TestResult{
+    // Same as the return of TestFunction: 0 passed, > 0 failed, < 0 skipped.
+    int status = 0;
+    // Set if the test threw.
+    std::string error;
+    double time_ms = 0;
+};
+
+// Latency of one test object over all its non-skipped test files.
+struct DetectorStats{
+    size_t tests = 0;
+    double mean_ms = 0;
+    double p99_ms = 0;
+    double max_ms = 0;
+};
+
 
 bool skip_ignored_path(const QString& file_path, const std::vector<QString>& ignore_list){
     for (const auto& path_prefix : ignore_list){
@@ -75,67 +92,67 @@ bool skip_ignored_path(const QString& file_path, const std::vector<QString>& ign
     return false;
 }
 
-int run_test_obj_dir(TestFunction test_func, const QString& directory_path, size_t& num_passed, const std::vector<QString>& ignore_list){
+void collect_test_obj_dir(
+    std::vector<TestJob>& jobs,
+    const std::string& detector, const TestFunction& test_func,
+    const QString& directory_path, const std::vector<QString>& ignore_list
+){
     QDirIterator file_iter(directory_path, QDir::Filter::Files, QDirIterator::IteratorFlag::Subdirectories);
 
-    bool first_test_file = true;
     while (file_iter.hasNext()){
-        if (first_test_file == false){
-            cout << "-------------------------------------------" << endl;
-        }
-        first_test_file = false;
-
         const QString next_file = file_iter.next();
-        
+
         // If filename or folder name starts with _, its considered a "hidden" file so skip it.
         const QFileInfo file_info(next_file);
         if (file_info.fileName().startsWith('_') || file_info.dir().dirName().startsWith("_")){
             continue;
         }
-        const std::string file_path = next_file.toStdString();
 
         // Check ignore list to determine whether to skip the test
         if (skip_ignored_path(next_file, ignore_list)){
             continue;
         }
 
-        // Call the function to do the actual test:
-        cout << file_path << endl;
-        RETURN_IF_TEST_FAILED(test_func, file_path, num_passed);
+        jobs.emplace_back(TestJob{detector, test_func, next_file.toStdString()});
     }
-
-    return 0;
 }
 
-// Run the tests inside a folder representing a "test object".
+// Collect the tests inside a folder representing a "test object".
 // It is usually defined as one detector, e.g. CommandLineTests/PokemonLA/BattleMenuDetector/
-int run_test_obj(const std::string& test_space, const QFileInfo& obj_info, size_t& num_passed, const std::vector<QString>& ignore_list){
+void collect_test_obj(
+    std::vector<TestJob>& jobs,
+    const std::string& test_space, const QFileInfo& obj_info,
+    const std::vector<QString>& ignore_list
+){
     const std::string test_name = obj_info.fileName().toStdString();
     if (test_name == "." || test_name == ".."){
-        return 0;
+        return;
     }
 
-    print_equals();
     const TestFunction test_func = find_test_function(test_space, test_name);
     if (test_func == nullptr){
         // No corresponding test code, skip the folder.
-        return 0;
+        return;
     }
 
     if (skip_ignored_path(obj_info.filePath(), ignore_list)){
-        return 0;
+        return;
     }
 
-    cout << "Testing " << test_name << ":" << endl;
-
     // Recursively get test filenames, like:
     // ./CommandLineTests/PokemonLA/BattleMenuDetector/IngoBattleMenuDayTime_True.png
-    return run_test_obj_dir(test_func, obj_info.filePath(), num_passed, ignore_list);
+    size_t before = jobs.size();
+    collect_test_obj_dir(jobs, test_space + "_" + test_name, test_func, obj_info.filePath(), ignore_list);
+    cout << "Found " << jobs.size() - before << " test file(s) for " << test_space << "/" << test_name << endl;
 }
 
-// Run the tests inside a folder representing a "test space".
+// Collect the tests inside a folder representing a "test space".
 // It is usually defined as one pokemon game, e.g. CommandLineTests/PokemonLA/
-int run_test_space(const QFileInfo& space_info, size_t& num_passed, const std::vector<QString>& ignore_list){
+int collect_test_space(
+    std::vector<TestJob>& jobs,
+    const QFileInfo& space_info,
+    const std::vector<QString>& ignore_list
+){
     QDir sub_dir(space_info.filePath());
     if (!sub_dir.exists()){
         cerr << "Error: cannot access " << space_info.filePath().toStdString() << endl;
@@ -157,30 +174,15 @@ int run_test_space(const QFileInfo& space_info, size_t& num_passed, const std::v
     // ./CommandLineTests/PokemonLA/BattleMenuDetector/
     const QFileInfoList obj_list = sub_dir.entryInfoList();
     for (const QFileInfo& obj_info : obj_list){
-        RETURN_IF_NOT_ZERO(run_test_obj(test_space, obj_info, num_passed, ignore_list));
+        collect_test_obj(jobs, test_space, obj_info, ignore_list);
     }
 
     return 0;
 }
 
-
-
-
-} // end of anonymous namespace
-
-
-
-int run_command_line_tests(){
-    {
-        cout << "Running parallel unit tests..." << endl;
-        ComputerPrograms::CommandLineUnitTestRunner runner(global_logger_command_line());
-        if (runner.run()){
-            return 1;
-        }
-        cout << "Running parallel unit tests... Done!" << endl;
-    }
-
-
+// Walk the test folder (or the selected test list) and collect all the test
+// files to run. Returns non-zero if the test settings are invalid.
+int collect_tests(std::vector<TestJob>& jobs){
     const auto& root_folder_name = GlobalSettings::instance().COMMAND_LINE_TEST_FOLDER;
 
     QDir test_root_dir(root_folder_name.c_str());
@@ -192,8 +194,6 @@ int run_command_line_tests(){
     QFileInfo test_root_info(root_folder_name.c_str());
     cout << "Looking for tests under test root folder: " << root_folder_name << endl;
 
-    size_t num_passed = 0;
-
     const auto& selected_test_list = GlobalSettings::instance().COMMAND_LINE_TEST_LIST;
 
     // The ignore list will be used to skip path.
@@ -217,90 +217,403 @@ int run_command_line_tests(){
         test_root_dir.setFilter(QDir::Filter::Dirs);
         const QFileInfoList sub_dir_list = test_root_dir.entryInfoList();
         for (const QFileInfo& sub_dir_info : sub_dir_list){
-            RETURN_IF_NOT_ZERO(run_test_space(sub_dir_info, num_passed, ignore_list));
+            RETURN_IF_NOT_ZERO(collect_test_space(jobs, sub_dir_info, ignore_list));
         }
-    }else{
-        // Only run on selected tests
-        for (const std::string& test_path : selected_test_list){
-            const std::string full_path = root_folder_name + "/" + test_path;
-            const QString full_path_cleaned = QDir::cleanPath(QString::fromStdString(full_path));
-
-            if (full_path_cleaned.size() == 0){
-                cerr << "Error: empty path found in TEST_LIST" << endl;
-                return 1;
-            }
+        return 0;
+    }
 
-            if (skip_ignored_path(full_path_cleaned, ignore_list)){
-                continue;
-            }
+    // Only run on selected tests
+    for (const std::string& test_path : selected_test_list){
+        const std::string full_path = root_folder_name + "/" + test_path;
+        const QString full_path_cleaned = QDir::cleanPath(QString::fromStdString(full_path));
+
+        if (full_path_cleaned.size() == 0){
+            cerr << "Error: empty path found in TEST_LIST" << endl;
+            return 1;
+        }
 
-            QFileInfo selected_path_info(full_path_cleaned);
+        if (skip_ignored_path(full_path_cleaned, ignore_list)){
+            continue;
+        }
+
+        QFileInfo selected_path_info(full_path_cleaned);
 
-            if (selected_path_info.exists() == false){
-                cerr << "Error: path " << full_path << " in TEST_LIST does not exist." << endl;
-                return 1;
+        if (selected_path_info.exists() == false){
+            cerr << "Error: path " << full_path << " in TEST_LIST does not exist." << endl;
+            return 1;
+        }
+
+        std::list<QString> path_components;
+        {
+            QString path = full_path_cleaned;
+            QFileInfo cur_info(path);
+            while(cur_info != test_root_info){
+                path_components.push_front(cur_info.fileName());
+                // Go upper one level of folder:
+                path = cur_info.path();
+                cur_info = QFileInfo(path);
             }
+        }
+        // If full_path is "CommandLineTest/PokemonLA/DialogueEllipseDetector/macOS_bright/WendyNight_True.png", then
+        // path_components contains:
+        // - PokemonLA
+        // - DialogueEllipseDetector
+        // - macOS_bright
+        // - WendyNight_True.png
+        if (path_components.size() == 0){
+            cerr << "Error: cannot parse " << full_path << ". Empty path in TEST_LIST?" << endl;
+            return 1;
+        }
+
+        QDir cur_dir(root_folder_name.c_str());
+
+        auto it = path_components.begin();
+        std::string test_space = it->toStdString();
+        QFileInfo test_space_info(cur_dir.filePath(*it));
+        cur_dir = QDir(test_space_info.filePath());
+        if (path_components.size() == 1){
+            RETURN_IF_NOT_ZERO(collect_test_space(jobs, test_space_info, ignore_list));
+            continue;
+        }
+
+        it++;
+        std::string test_name = it->toStdString();
+        QFileInfo test_obj_info(cur_dir.filePath(*it));
+        if (path_components.size() == 2){
+            collect_test_obj(jobs, test_space, test_obj_info, ignore_list);
+            continue;
+        }
+
+        const auto test_func = find_test_function(test_space, test_name);
+        if (test_func == nullptr){
+            return 2;
+        }
+
+        const std::string detector = test_space + "_" + test_name;
+        if (selected_path_info.isFile()){
+            jobs.emplace_back(TestJob{detector, test_func, full_path_cleaned.toStdString()});
+        }else{
+            // selected_path_info is a directory, go through each file recursively in the directory
+            collect_test_obj_dir(jobs, detector, test_func, full_path_cleaned, ignore_list);
+        }
+    } // end selected_test_list
+
+    return 0;
+}
+
+
+
+TestResult run_test(const TestJob& job){
+    TestResult result;
+    WallClock start = current_time();
+    try{
+        result.status = job.test_func(job.file_path);
+    }catch (const std::exception& e){
+        result.error = std::string("threw exception: ") + e.what();
+        result.status = 1;
+    }catch (const Exception& e){
+        result.error = std::string("threw ") + e.name() + ": <<<" + e.message() + ">>>";
+        result.status = 1;
+    }
+    result.time_ms = std::chrono::duration_cast<std::chrono::microseconds>(current_time() - start).count() / 1000.;
+    return result;
+}
+
+// Run all the jobs on "threads" threads. Results are in the same order as "jobs".
+std::vector<TestResult> run_tests(const std::vector<TestJob>& jobs, size_t threads){
+    std::vector<TestResult> results(jobs.size());
+
+    Mutex lock;
+    size_t done = 0;
+    auto run_one = [&](size_t index){
+        const TestJob& job = jobs[index];
+        TestResult& result = results[index];
+        result = run_test(job);
+
+        std::lock_guard<Mutex> lg(lock);
+        done++;
+        cout << "[" << done << "/" << jobs.size() << "] " << job.file_path << ": ";
+        if (result.status > 0){
+            cout << "FAILED";
+        }else if (result.status < 0){
+            cout << "skipped";
+        }else{
+            cout << "passed";
+        }
+        cout << " (" << result.time_ms << " ms)" << endl;
+        if (!result.error.empty()){
+            cout << "Test: " << job.file_path << " " << result.error << endl;
+        }
+    };
+
+    if (threads <= 1){
+        for (size_t c = 0; c < jobs.size(); c++){
+            run_one(c);
+        }
+        return results;
+    }
 
-            std::list<QString> path_components;
-            {
-                QString path = full_path_cleaned;
-                QFileInfo cur_info(path);
-                while(cur_info != test_root_info){
-                    path_components.push_front(cur_info.fileName());
-                    // Go upper one level of folder:
-                    path = cur_info.path();
-                    cur_info = QFileInfo(path);
+    // The test files get their own threads instead of the computation thread
+    // pool. A detector that calls run_in_parallel() on that pool also runs
+    // whatever else is queued on it while it waits. So test files queued there
+    // could run inside another test and be counted in its time.
+    std::atomic<size_t> next(0);
+    std::vector<Thread> workers;
+    for (size_t c = 0; c < threads; c++){
+        workers.emplace_back([&]{
+            while (true){
+                size_t index = next.fetch_add(1);
+                if (index >= jobs.size()){
+                    return;
                 }
+                run_one(index);
             }
-            // If full_path is "CommandLineTest/PokemonLA/DialogueEllipseDetector/macOS_bright/WendyNight_True.png", then
-            // path_components contains:
-            // - PokemonLA
-            // - DialogueEllipseDetector
-            // - macOS_bright
-            // - WendyNight_True.png
-            if (path_components.size() == 0){
-                cerr << "Error: cannot parse " << full_path << ". Empty path in TEST_LIST?" << endl;
-                return 1;
-            }
+        });
+    }
+    for (Thread& worker : workers){
+        worker.join();
+    }
 
-            QDir cur_dir(root_folder_name.c_str());
+    return results;
+}
 
-            auto it = path_components.begin();
-            std::string test_space = it->toStdString();
-            QFileInfo test_space_info(cur_dir.filePath(*it));
-            cur_dir = QDir(test_space_info.filePath());
-            if (path_components.size() == 1){
-                RETURN_IF_NOT_ZERO(run_test_space(test_space_info, num_passed, ignore_list));
-                continue;
-            }
 
-            it++;
-            std::string test_name = it->toStdString();
-            QFileInfo test_obj_info(cur_dir.filePath(*it));
-            if (path_components.size() == 2){
-                RETURN_IF_NOT_ZERO(run_test_obj(test_space, test_obj_info, num_passed, ignore_list));
-                continue;
-            }
 
-            const auto test_func = find_test_function(test_space, test_name);
-            if (test_func == nullptr){
-                return 2;
-            }
+std::map<std::string, DetectorStats> compute_detector_stats(
+    const std::vector<TestJob>& jobs,
+    const std::vector<TestResult>& results
+){
+    std::map<std::string, std::vector<double>> times;
+    for (size_t c = 0; c < jobs.size(); c++){
+        if (results[c].status >= 0){
+            times[jobs[c].detector].emplace_back(results[c].time_ms);
+        }
+    }
+
+    std::map<std::string, DetectorStats> ret;
+    for (auto& item : times){
+        std::vector<double>& detector_times = item.second;
+        std::sort(detector_times.begin(), detector_times.end());
+
+        DetectorStats& stats = ret[item.first];
+        stats.tests = detector_times.size();
+        double sum = 0;
+        for (double time_ms : detector_times){
+            sum += time_ms;
+        }
+        stats.mean_ms = sum / stats.tests;
+        //  Nearest-rank percentile.
+        size_t rank = (stats.tests * 99 + 99) / 100;
+        stats.p99_ms = detector_times[rank - 1];
+        stats.max_ms = detector_times.back();
+    }
+    return ret;
+}
+
+// Compare the mean latencies against a baseline report. Returns the # of
+// detectors that are slower than the baseline by more than "threshold".
+size_t compare_against_baseline(
+    JsonObject& report,
+    const std::map<std::string, DetectorStats>& stats,
+    const std::string& baseline_path, double threshold,
+    bool parallel
+){
+    //  Ignore small absolute differences. They are mostly timer noise.
+    const double MIN_REGRESSION_MS = 1.0;
+
+    JsonValue baseline_json;
+    try{
+        baseline_json = load_json_file(baseline_path);
+    }catch (FileException& e){
+        cerr << "Warning: unable to read baseline: " << e.message() << endl;
+        return 0;
+    }
+    const JsonObject* baseline = baseline_json.to_object() == nullptr
+        ? nullptr
+        : baseline_json.to_object()->get_object("DETECTORS");
+    if (baseline == nullptr){
+        cerr << "Warning: " << baseline_path << " is not a command line test report." << endl;
+        return 0;
+    }
+    if (baseline_json.to_object()->get_boolean_default("PARALLEL", false) != parallel){
+        cerr << "Warning: " << baseline_path << " was not measured in the same (serial/parallel) mode as this run."
+             << " The latencies are not comparable." << endl;
+    }
+
+    JsonObject& detectors = report.get_object_throw("DETECTORS");
+    size_t regressions = 0;
+    for (const auto& item : stats){
+        const JsonObject* baseline_stats = baseline->get_object(item.first);
+        if (baseline_stats == nullptr){
+            continue;
+        }
+        double baseline_mean = baseline_stats->get_double_default("MEAN_MS");
+        double baseline_p99 = baseline_stats->get_double_default("P99_MS");
+
+        JsonObject& detector = detectors.get_object_throw(item.first);
+        detector["BASELINE_MEAN_MS"] = baseline_mean;
+        detector["BASELINE_P99_MS"] = baseline_p99;
+
+        bool regressed =
+            item.second.mean_ms > baseline_mean * (1 + threshold) &&
+            item.second.mean_ms - baseline_mean > MIN_REGRESSION_MS;
+        detector["REGRESSION"] = regressed;
+        if (regressed){
+            regressions++;
+            cout << "Regression: " << item.first << " mean " << item.second.mean_ms
+                 << " ms, baseline " << baseline_mean << " ms" << endl;
+        }
+    }
+    return regressions;
+}
+
+// Write the per-test timings as CSV next to the JSON report.
+void write_csv_report(
+    const std::string& report_path,
+    const std::vector<TestJob>& jobs,
+    const std::vector<TestResult>& results
+){
+    std::string csv_path = report_path;
+    if (csv_path.size() >= 5 && csv_path.compare(csv_path.size() - 5, 5, ".json") == 0){
+        csv_path.resize(csv_path.size() - 5);
+    }
+    csv_path += ".csv";
+
+    std::string csv = "Detector,File,Result,Time (ms)\n";
+    for (size_t c = 0; c < jobs.size(); c++){
+        const TestResult& result = results[c];
+        csv += jobs[c].detector;
+        csv += ",\"" + jobs[c].file_path + "\",";
+        csv += result.status > 0 ? "Failed" : result.status < 0 ? "Skipped" : "Passed";
+        csv += "," + std::to_string(result.time_ms) + "\n";
+    }
+    string_to_file(csv_path, csv);
+}
+
+
+
+} // end of anonymous namespace
+
+
+
+int run_command_line_tests(){
+    {
+        cout << "Running parallel unit tests..." << endl;
+        ComputerPrograms::CommandLineUnitTestRunner runner(global_logger_command_line());
+        if (runner.run()){
+            return 1;
+        }
+        cout << "Running parallel unit tests... Done!" << endl;
+    }
+
+    const GlobalSettings& settings = GlobalSettings::instance();
+
+    std::vector<TestJob> jobs;
+    RETURN_IF_NOT_ZERO(collect_tests(jobs));
+
+    print_equals();
+    const bool parallel = settings.COMMAND_LINE_TEST_PARALLEL;
+    const size_t threads = parallel ? GlobalThreadPools::computation_normal().max_threads() : 1;
+    cout << "Running " << jobs.size() << " test file(s) on " << threads << " thread(s)..." << endl;
+
+    WallClock start = current_time();
+    std::vector<TestResult> results = run_tests(jobs, threads);
+    double total_ms = std::chrono::duration_cast<std::chrono::microseconds>(current_time() - start).count() / 1000.;
+
+    size_t num_passed = 0;
+    size_t num_skipped = 0;
+    std::vector<size_t> failed;
+    for (size_t c = 0; c < results.size(); c++){
+        if (results[c].status > 0){
+            failed.emplace_back(c);
+        }else if (results[c].status < 0){
+            num_skipped++;
+        }else{
+            num_passed++;
+        }
+    }
+
+    std::map<std::string, DetectorStats> stats = compute_detector_stats(jobs, results);
 
-            print_equals();
-            if (selected_path_info.isFile()){
-                // Call the function to do the actual test:
-                RETURN_IF_TEST_FAILED(test_func, full_path_cleaned.toStdString(), num_passed);
-            }else{
-                // selected_path_info is a directory, go through each file recursively in the directory
-                RETURN_IF_NOT_ZERO(run_test_obj_dir(test_func, full_path_cleaned, num_passed, ignore_list));
+    JsonObject report;
+    report["PARALLEL"] = parallel;
+    report["THREADS"] = (int64_t)threads;
+    report["TOTAL_MS"] = total_ms;
+    report["PASSED"] = (int64_t)num_passed;
+    report["FAILED"] = (int64_t)failed.size();
+    report["SKIPPED"] = (int64_t)num_skipped;
+    {
+        JsonArray tests;
+        for (size_t c = 0; c < jobs.size(); c++){
+            const TestResult& result = results[c];
+            JsonObject test;
+            test["DETECTOR"] = jobs[c].detector;
+            test["FILE"] = jobs[c].file_path;
+            test["RESULT"] = result.status > 0 ? "Failed" : result.status < 0 ? "Skipped" : "Passed";
+            test["TIME_MS"] = result.time_ms;
+            if (!result.error.empty()){
+                test["ERROR"] = result.error;
             }
-        } // end selected_test_list
+            tests.push_back(std::move(test));
+        }
+        report["TESTS"] = std::move(tests);
+    }
+    {
+        JsonObject detectors;
+        for (const auto& item : stats){
+            JsonObject detector;
+            detector["TESTS"] = (int64_t)item.second.tests;
+            detector["MEAN_MS"] = item.second.mean_ms;
+            detector["P99_MS"] = item.second.p99_ms;
+            detector["MAX_MS"] = item.second.max_ms;
+            detectors[item.first] = std::move(detector);
+        }
+        report["DETECTORS"] = std::move(detectors);
+    }
+
+    size_t regressions = 0;
+    if (!settings.COMMAND_LINE_TEST_BASELINE.empty()){
+        regressions = compare_against_baseline(
+            report, stats,
+            settings.COMMAND_LINE_TEST_BASELINE,
+            settings.COMMAND_LINE_TEST_REGRESSION_THRESHOLD,
+            parallel
+        );
+        report["REGRESSIONS"] = (int64_t)regressions;
+    }
+
+    if (!settings.COMMAND_LINE_TEST_REPORT.empty()){
+        try{
+            JsonValue(std::move(report)).dump(settings.COMMAND_LINE_TEST_REPORT);
+            write_csv_report(settings.COMMAND_LINE_TEST_REPORT, jobs, results);
+            cout << "Wrote test report to " << settings.COMMAND_LINE_TEST_REPORT << endl;
+        }catch (FileException& e){
+            cerr << "Error: unable to write test report: " << e.message() << endl;
+        }
     }
 
     print_equals();
-    cout << num_passed << " test" << (num_passed > 1 ? "s" : "") << " passed" << std::endl;
-    return 0;
+    for (const auto& item : stats){
+        cout << item.first << ": " << item.second.tests << " test(s), mean "
+             << item.second.mean_ms << " ms, p99 " << item.second.p99_ms << " ms" << endl;
+    }
+    print_equals();
+    for (size_t index : failed){
+        cout << "Test: " << jobs[index].file_path << " failed." << endl;
+    }
+    cout << num_passed << " test" << (num_passed > 1 ? "s" : "") << " passed";
+    if (!failed.empty()){
+        cout << ", " << failed.size() << " failed";
+    }
+    if (regressions != 0){
+        cout << ", " << regressions << " detector(s) regressed";
+    }
+    cout << endl;
+
+    if (!failed.empty()){
+        return 1;
+    }
+    return regressions == 0 ? 0 : 3;
 }
 
 
@@ -49,6 +49,20 @@
  * or serving as an extra file in case some tests need more than one test files. Files whose parent directory name starts with "_"
  * are skipped as well.
  * 
+ *  Timing report:
+ *
+ *  All the test files are collected first and then run one at a time. A failing test does not stop the others. All the failures
+ *  are listed at the end. Set "20-GlobalSettings": "COMMAND_LINE_TESTS": "PARALLEL" to true (or pass --command-line-test-parallel)
+ *  to run them in parallel on their own threads instead. That is faster for checking correctness, but the test files then compete
+ *  for the CPU with each other, so use the default serial mode to make and check against a baseline.
+ *
+ *  Each test file is timed. The times are written to "20-GlobalSettings": "COMMAND_LINE_TESTS": "REPORT" (default
+ *  CommandLineTestReport.json) together with the mean and p99 latency of each test object. The per-file times are also written as
+ *  CSV next to it. If "BASELINE" is set to the path of a previous report, the mean latency of each test object is compared against
+ *  it. A test object whose mean is more than "REGRESSION_THRESHOLD" (default 0.25) slower than in the baseline fails the run.
+ *  Latencies measured in parallel are not comparable to latencies measured serially. The report records the mode, and comparing
+ *  against a baseline made in the other mode prints a warning.
+ *
  *  How to add new test code:
  * 
  *  The test framework calls TestMap.h: find_test_function(test_space, test_obj_name) to find the test function related to a test path.
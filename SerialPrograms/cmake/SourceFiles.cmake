@@ -419,12 +419,16 @@ file(GLOB LIBRARY_SOURCES
     Source/CommonFramework/ImageTools/ImageDiff.h
     Source/CommonFramework/ImageTools/ImageStats.cpp
     Source/CommonFramework/ImageTools/ImageStats.h
+    Source/CommonFramework/ImageTools/ImageTileHashes.cpp
+    Source/CommonFramework/ImageTools/ImageTileHashes.h
     Source/CommonFramework/ImageTypes/BinaryImage.cpp
     Source/CommonFramework/ImageTypes/BinaryImage.h
     Source/CommonFramework/ImageTypes/ImageHSV32.cpp
     Source/CommonFramework/ImageTypes/ImageHSV32.h
     Source/CommonFramework/ImageTypes/ImageRGB32.cpp
     Source/CommonFramework/ImageTypes/ImageRGB32.h
+    Source/CommonFramework/ImageTypes/ImageRGB32Pool.cpp
+    Source/CommonFramework/ImageTypes/ImageRGB32Pool.h
     Source/CommonFramework/ImageTypes/ImageRGB32_OpenCV.cpp
     Source/CommonFramework/ImageTypes/ImageRGB32_OpenCV.h
     Source/CommonFramework/ImageTypes/ImageRGB32_Qt.cpp
@@ -564,6 +568,8 @@ file(GLOB LIBRARY_SOURCES
     Source/CommonFramework/Tools/GlobalThreadPools.h
     Source/CommonFramework/Tools/ProgramEnvironment.cpp
     Source/CommonFramework/Tools/ProgramEnvironment.h
+    Source/CommonFramework/Tools/ResourceWarmup.cpp
+    Source/CommonFramework/Tools/ResourceWarmup.h
     Source/CommonFramework/Tools/StatAccumulator.cpp
     Source/CommonFramework/Tools/StatAccumulator.h
     Source/CommonFramework/Tools/VideoStream.cpp
@@ -622,6 +628,8 @@ file(GLOB LIBRARY_SOURCES
     Source/CommonFramework/VideoPipeline/VideoSourceDescriptor.h
     Source/CommonFramework/VideoPipeline/VideoSources/VideoSource_Camera.cpp
     Source/CommonFramework/VideoPipeline/VideoSources/VideoSource_Camera.h
+    Source/CommonFramework/VideoPipeline/VideoSources/VideoSource_File.cpp
+    Source/CommonFramework/VideoPipeline/VideoSources/VideoSource_File.h
     Source/CommonFramework/VideoPipeline/VideoSources/VideoSource_Null.cpp
     Source/CommonFramework/VideoPipeline/VideoSources/VideoSource_Null.h
     Source/CommonFramework/VideoPipeline/VideoSources/VideoSource_StillImage.cpp
@@ -650,6 +658,8 @@ file(GLOB LIBRARY_SOURCES
     Source/CommonTools/Audio/AudioTemplateCache.h
     Source/CommonTools/Audio/SpectrogramMatcher.cpp
     Source/CommonTools/Audio/SpectrogramMatcher.h
+    Source/CommonTools/Audio/SpectrumFilterBank.cpp
+    Source/CommonTools/Audio/SpectrumFilterBank.h
     Source/CommonTools/DetectedBoxes.cpp
     Source/CommonTools/DetectedBoxes.h
     Source/CommonTools/DetectionDebouncer.h
@@ -666,6 +676,10 @@ file(GLOB LIBRARY_SOURCES
     Source/CommonTools/ImageMatch/ImageCropper.h
     Source/CommonTools/ImageMatch/ImageMatchOption.cpp
     Source/CommonTools/ImageMatch/ImageMatchOption.h
+    Source/CommonTools/ImageMatch/ImageMatch_Tests.cpp
+    Source/CommonTools/ImageMatch/ImageMatch_Tests.h
+    Source/CommonTools/ImageMatch/ImageMatchPruning.cpp
+    Source/CommonTools/ImageMatch/ImageMatchPruning.h
     Source/CommonTools/ImageMatch/ImageMatchResult.cpp
     Source/CommonTools/ImageMatch/ImageMatchResult.h
     Source/CommonTools/ImageMatch/SilhouetteDictionaryMatcher.cpp
@@ -702,6 +716,10 @@ file(GLOB LIBRARY_SOURCES
     Source/CommonTools/InferenceThrottler.h
     Source/CommonTools/MultiConsoleErrors.cpp
     Source/CommonTools/MultiConsoleErrors.h
+    Source/CommonTools/OCR/OCR_DictionaryCache.cpp
+    Source/CommonTools/OCR/OCR_DictionaryCache.h
+    Source/CommonTools/OCR/OCR_DictionaryIndex.cpp
+    Source/CommonTools/OCR/OCR_DictionaryIndex.h
     Source/CommonTools/OCR/OCR_DictionaryMatcher.cpp
     Source/CommonTools/OCR/OCR_DictionaryMatcher.h
     Source/CommonTools/OCR/OCR_DictionaryOCR.cpp
@@ -1002,6 +1020,14 @@ file(GLOB LIBRARY_SOURCES
     Source/Kernels/ImageFilters/RGB32_EuclideanDistance/Kernels_ImageFilter_RGB32_Euclidean_x64_AVX2.cpp
     Source/Kernels/ImageFilters/RGB32_EuclideanDistance/Kernels_ImageFilter_RGB32_Euclidean_x64_AVX512.cpp
     Source/Kernels/ImageFilters/RGB32_EuclideanDistance/Kernels_ImageFilter_RGB32_Euclidean_x64_SSE42.cpp
+    Source/Kernels/ImageFilters/RGB32_HSV/Kernels_ImageFilter_RGB32_HSV.cpp
+    Source/Kernels/ImageFilters/RGB32_HSV/Kernels_ImageFilter_RGB32_HSV.h
+    Source/Kernels/ImageFilters/RGB32_HSV/Kernels_ImageFilter_RGB32_HSV_ARM64_NEON.cpp
+    Source/Kernels/ImageFilters/RGB32_HSV/Kernels_ImageFilter_RGB32_HSV_Default.cpp
+    Source/Kernels/ImageFilters/RGB32_HSV/Kernels_ImageFilter_RGB32_HSV_Routines.h
+    Source/Kernels/ImageFilters/RGB32_HSV/Kernels_ImageFilter_RGB32_HSV_x64_AVX2.cpp
+    Source/Kernels/ImageFilters/RGB32_HSV/Kernels_ImageFilter_RGB32_HSV_x64_AVX512.cpp
+    Source/Kernels/ImageFilters/RGB32_HSV/Kernels_ImageFilter_RGB32_HSV_x64_SSE42.cpp
     Source/Kernels/ImageFilters/RGB32_Range/Kernels_ImageFilter_RGB32_Range.cpp
     Source/Kernels/ImageFilters/RGB32_Range/Kernels_ImageFilter_RGB32_Range.h
     Source/Kernels/ImageFilters/RGB32_Range/Kernels_ImageFilter_RGB32_Range_ARM64_NEON.cpp
@@ -1030,6 +1056,12 @@ file(GLOB LIBRARY_SOURCES
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqr_x64_AVX2.cpp
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqr_x64_AVX512.cpp
     Source/Kernels/ImageStats/Kernels_ImagePixelSumSqr_x64_SSE41.cpp
+    Source/Kernels/ImageStats/Kernels_ImageStats_Tests.cpp
+    Source/Kernels/ImageStats/Kernels_ImageStats_Tests.h
+    Source/Kernels/ImageStats/Kernels_ImageTileHash.cpp
+    Source/Kernels/ImageStats/Kernels_ImageTileHash.h
+    Source/Kernels/ImageStats/Kernels_ImageTileHash_Default.cpp
+    Source/Kernels/ImageStats/Kernels_ImageTileHash_x64_SSE41.cpp
     Source/Kernels/Kernels_Alignment.h
     Source/Kernels/Kernels_BitScan.h
     Source/Kernels/Kernels_BitSet.h
@@ -1049,6 +1081,8 @@ file(GLOB LIBRARY_SOURCES
     Source/Kernels/ScaleInvariantMatrixMatch/Kernels_ScaleInvariantMatrixMatch_Core_x86_AVX512.cpp
     Source/Kernels/ScaleInvariantMatrixMatch/Kernels_ScaleInvariantMatrixMatch_Core_x86_SSE.cpp
     Source/Kernels/ScaleInvariantMatrixMatch/Kernels_ScaleInvariantMatrixMatch_Routines.h
+    Source/Kernels/ScaleInvariantMatrixMatch/Kernels_ScaleInvariantMatrixMatch_Tests.cpp
+    Source/Kernels/ScaleInvariantMatrixMatch/Kernels_ScaleInvariantMatrixMatch_Tests.h
     Source/Kernels/SpikeConvolution/Kernels_SpikeConvolution.cpp
     Source/Kernels/SpikeConvolution/Kernels_SpikeConvolution.h
     Source/Kernels/SpikeConvolution/Kernels_SpikeConvolution_Core_Default.cpp
@@ -1056,6 +1090,14 @@ file(GLOB LIBRARY_SOURCES
     Source/Kernels/SpikeConvolution/Kernels_SpikeConvolution_Core_x86_AVX512.cpp
     Source/Kernels/SpikeConvolution/Kernels_SpikeConvolution_Core_x86_SSE41.cpp
     Source/Kernels/SpikeConvolution/Kernels_SpikeConvolution_Routines.h
+    Source/Kernels/VideoFrameConversion/Kernels_VideoFrameConversion.cpp
+    Source/Kernels/VideoFrameConversion/Kernels_VideoFrameConversion.h
+    Source/Kernels/VideoFrameConversion/Kernels_VideoFrameConversion_Default.cpp
+    Source/Kernels/VideoFrameConversion/Kernels_VideoFrameConversion_Routines.h
+    Source/Kernels/VideoFrameConversion/Kernels_VideoFrameConversion_Tests.cpp
+    Source/Kernels/VideoFrameConversion/Kernels_VideoFrameConversion_Tests.h
+    Source/Kernels/VideoFrameConversion/Kernels_VideoFrameConversion_x64_AVX2.cpp
+    Source/Kernels/VideoFrameConversion/Kernels_VideoFrameConversion_x64_SSE41.cpp
     Source/Kernels/Waterfill/Kernels_Waterfill.cpp
     Source/Kernels/Waterfill/Kernels_Waterfill.h
     Source/Kernels/Waterfill/Kernels_Waterfill_Core_64x16_x64_AVX2.cpp
@@ -2545,6 +2587,10 @@ file(GLOB LIBRARY_SOURCES
     Source/PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterRNGTable.h
     Source/PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterSeedCalc.cpp
     Source/PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterSeedCalc.h
+    Source/PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterSeedIndex.cpp
+    Source/PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterSeedIndex.h
+    Source/PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterSeedIndexGenerator.cpp
+    Source/PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterSeedIndexGenerator.h
     Source/PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterTools.cpp
     Source/PokemonSV/Programs/ItemPrinter/PokemonSV_ItemPrinterTools.h
     Source/PokemonSV/Programs/PokemonSV_AreaZero.cpp